@@ -3,45 +3,49 @@ import os
 import math
 import subprocess
 
-GENERATOR = '../build-release/cmr-generate-graphic'
+GENERATORS = ['../build-release/cmr-generate-graphic']
 
-# Parameter of script: #rows and number of repetitions
+# Parameter of script: #rows, number of repetitions and optionally several generators to be compared, e.g., built
+# from different revisions.
 try:
   numRows = int(sys.argv[1])
   numRepetitions = int(sys.argv[2])
+  if len(sys.argv) > 3:
+    GENERATORS = sys.argv[3:]
 except:
-  print(f'Usage: {sys.argv[0]} #ROWS NUM-REPETITIONS')
+  print(f'Usage: {sys.argv[0]} #ROWS NUM-REPETITIONS [GENERATOR...]')
   sys.exit(1)
 
-sys.stdout.write('rows,cols,#nzs,tTrans,tCheck,tApply,tTotal\n')
+sys.stdout.write('generator,rows,cols,tTrans,tCheck,tApply,tTotal\n')
 sys.stdout.flush()
 
+def parseTime(line):
+  return float(line.split(' in ')[1].split(' ')[0])
+
 def run(numRows, numColumns, repetitions):
-  command = [GENERATOR, str(int(numRows)), str(int(numColumns)), '-b', str(repetitions)]
-  process = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
-  timeTranspose = 0.0
-  timeCheck = 0.0
-  timeApply = 0.0
-  timeTotal = 0.0
-  avgNonzeros = 0
-  for line in process.stdout.decode('utf-8').split('\n'):
-    if line.startswith('Generated a'):
-      avgNonzeros += int(line.split(' ')[5].strip())
-    if line.startswith('Transposition:'):
-      timeTranspose += float(line.split('/')[1].strip())
-    if line.startswith('Check:'):
-      timeCheck += float(line.split('/')[1].strip())
-    if line.startswith('Apply:'):
-      timeApply += float(line.split('/')[1].strip())
-    if line.startswith('Total:'):
-      timeTotal += float(line.split('/')[1].strip())
-  timeTranspose /= repetitions
-  timeCheck /= repetitions
-  timeApply /= repetitions
-  timeTotal /= repetitions
-  avgNonzeros /= repetitions
-  sys.stdout.write(f'{numRows:.0f},{numColumns:.0f},{avgNonzeros:.1f},{timeTranspose},{timeCheck},{timeApply},{timeTotal}\n')
-  sys.stdout.flush()
+  for generator in GENERATORS:
+    command = [generator, str(int(numRows)), str(int(numColumns)), '-B', str(repetitions)]
+    process = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+    timeTranspose = 0.0
+    timeCheck = 0.0
+    timeApply = 0.0
+    timeTotal = 0.0
+    for line in process.stderr.decode('utf-8').split('\n'):
+      line = line.strip()
+      if line.startswith('transpositions:'):
+        timeTranspose += parseTime(line)
+      if line.startswith('column checks:'):
+        timeCheck += parseTime(line)
+      if line.startswith('column additions:'):
+        timeApply += parseTime(line)
+      if line.startswith('total:'):
+        timeTotal += parseTime(line)
+    timeTranspose /= repetitions
+    timeCheck /= repetitions
+    timeApply /= repetitions
+    timeTotal /= repetitions
+    sys.stdout.write(f'{generator},{numRows:.0f},{numColumns:.0f},{timeTranspose},{timeCheck},{timeApply},{timeTotal}\n')
+    sys.stdout.flush()
 
 run(numRows, int(4.0*numRows), numRepetitions)
 sys.exit(0)
@@ -70,6 +70,13 @@ CMR_ERROR CMRcomplementRowColumn(
  * \p pcomplementColumn != \c NULL, then \p *pcomplementRow and \p *pcomplementColumn will indicate the row and column
  * that need to be complemented for obtaining a matrix that is not [totally unimodular](\ref tu).
  * If no row/column needs to be complemented, then the respective variables are set to \c SIZE_MAX.
+ *
+ * The complements of different rows are tested in parallel if \p cmr uses several threads. The reported complement
+ * is the first one that is not totally unimodular, where the complements are ordered by row and then by column, and
+ * where not complementing comes last.
+ *
+ * The time limit covers all tests for total unimodularity. If it is exceeded or if \ref CMRinterrupt is called, then
+ * \ref CMR_ERROR_TIMEOUT is returned.
  */
 
 CMR_EXPORT
@@ -79,7 +86,8 @@ CMR_ERROR CMRtestComplementTotalUnimodularity(
   bool* pisComplementTotallyUnimodular, /**< Pointer for storing whether \f$ M \f$ is complement totally unimodular. */
   size_t* pcomplementRow,               /**< Pointer for storing the row to be complemented (may be \c NULL). */
   size_t* pcomplementColumn,            /**< Pointer for storing the column to be complemented (may be \c NULL). */
-  CMR_CTU_STATISTICS* stats             /**< Statistics for the computation (may be \c NULL). */
+  CMR_CTU_STATISTICS* stats,            /**< Statistics for the computation (may be \c NULL). */
+  double timeLimit                      /**< Time limit to impose. */
 );
 
 #ifdef __cplusplus
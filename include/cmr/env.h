@@ -89,6 +89,88 @@ CMR_ERROR CMRfreeEnvironment(
   CMR** pcmr  /**< Pointer to \ref CMR environment. */
 );
 
+/**
+ * \brief Creates a child of the \ref CMR environment \p cmr that can be used in another thread.
+ *
+ * The child has its own stack memory and error message, and inherits output, verbosity and number of threads. If
+ * \p cmr already runs a thread pool, then the child uses it as well. When the child is freed via
+ * \ref CMRfreeEnvironment, its stack memory is kept by \p cmr and reused by the next child, which makes forking
+ * cheap. Forking and freeing children may happen concurrently from several threads, but \p cmr must neither be freed
+ * nor change its number of threads before all its children are freed.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRforkEnvironment(
+  CMR* cmr,     /**< \ref CMR environment. */
+  CMR** pchild  /**< Pointer at which the child environment shall be allocated. */
+);
+
+/**
+ * \brief Sets the number of threads that algorithms may use.
+ *
+ * The threads are started the first time an algorithm runs tasks in parallel and are terminated when the number of
+ * threads is changed or the environment is freed. Results do not depend on the number of threads. The default is 1.
+ * If the library was built without thread support, all computations run in the calling thread.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRsetNumThreads(
+  CMR* cmr,       /**< \ref CMR environment. */
+  int numThreads  /**< Number of threads, including the calling one; must be at least 1. */
+);
+
+/**
+ * \brief Asks all computations that run with \p cmr or with environments forked from the same one to stop.
+ *
+ * May be called from any thread, e.g., from a signal handler or a host thread while another thread runs a test.
+ * Computations that support a time limit return \ref CMR_ERROR_TIMEOUT as soon as they notice the request, and so do
+ * all subsequent ones until \ref CMRclearInterrupt is called. Time limits themselves are measured in wall-clock time,
+ * and a computation never runs beyond the time limit of a computation that it is part of.
+ */
+
+CMR_EXPORT
+void CMRinterrupt(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
+/**
+ * \brief Withdraws a request of \ref CMRinterrupt.
+ */
+
+CMR_EXPORT
+void CMRclearInterrupt(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
+/**
+ * \brief Sets the maximum number of test results that are remembered by \p cmr.
+ *
+ * If \p capacity is positive, then \ref CMRtestTotalUnimodularity, \ref CMRtestTotalUnimodularityBatch and
+ * \ref CMRtestBinaryRegular remember whether a matrix has the tested property and answer a repeated query in time
+ * almost linear in the number of nonzeros. Matrices are identified by a fingerprint that does not depend on the order
+ * of rows and columns, and a cached result is only used after verifying that the matrices are equal up to this order.
+ * Queries that ask for a decomposition, a submatrix or a minor are always computed. If more than \p capacity results
+ * were stored, then the least recently used ones are forgotten.
+ *
+ * Environments forked from \p cmr share its cache. Changing the capacity forgets all results and must not happen
+ * while computations are carried out. The default capacity is 0, which disables the cache.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRsetResultCacheCapacity(
+  CMR* cmr,         /**< \ref CMR environment that was not forked. */
+  size_t capacity   /**< Maximum number of cached results. */
+);
+
+/**
+ * \brief Returns the number of threads that algorithms may use.
+ */
+
+CMR_EXPORT
+int CMRgetNumThreads(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
 /**
  * \brief Allocates block memory for *\p ptr.
  *
@@ -14,6 +14,8 @@
 #include <cmr/element.h>
 
 #include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,22 +29,37 @@ extern "C" {
  * @{
  */
 
-typedef int CMR_GRAPH_NODE; /**< \brief Reference to a node of \ref CMR_GRAPH. */
-typedef int CMR_GRAPH_EDGE; /**< \brief Reference to an edge of \ref CMR_GRAPH. */
-typedef int CMR_GRAPH_ITER; /**< \brief Reference to an edge iterator of \ref CMR_GRAPH. */
+/**
+ * \brief Signed index type of nodes, edges and arcs of \ref CMR_GRAPH, where -1 means no node, edge or arc.
+ *
+ * It is \c int unless the library is built with the CMake option \c INDEX64, in which case it has 64 bits and graphs
+ * may have more than \c INT_MAX arcs.
+ */
+
+#if defined(CMR_WITH_INDEX64)
+typedef int64_t CMR_GRAPH_INDEX;
+#define CMR_GRAPH_INDEX_MAX INT64_MAX /**< \brief Largest value of \ref CMR_GRAPH_INDEX. */
+#else
+typedef int CMR_GRAPH_INDEX;
+#define CMR_GRAPH_INDEX_MAX INT_MAX   /**< \brief Largest value of \ref CMR_GRAPH_INDEX. */
+#endif /* CMR_WITH_INDEX64 */
+
+typedef CMR_GRAPH_INDEX CMR_GRAPH_NODE; /**< \brief Reference to a node of \ref CMR_GRAPH. */
+typedef CMR_GRAPH_INDEX CMR_GRAPH_EDGE; /**< \brief Reference to an edge of \ref CMR_GRAPH. */
+typedef CMR_GRAPH_INDEX CMR_GRAPH_ITER; /**< \brief Reference to an edge iterator of \ref CMR_GRAPH. */
 
 typedef struct
 {
-  int prev;     /**< \brief Next node in node list. */
-  int next;     /**< \brief Previous node in node list. */
-  int firstOut; /**< \brief First out-arc of this node. */
+  CMR_GRAPH_NODE prev;      /**< \brief Next node in node list. */
+  CMR_GRAPH_NODE next;      /**< \brief Previous node in node list. */
+  CMR_GRAPH_INDEX firstOut; /**< \brief First out-arc of this node. */
 } CMR_GRAPH_NODE_DATA;
 
 typedef struct
 {
-  int target; /**< \brief Target node of this arc. */
-  int prev;   /**< \brief Next arc in out-arc list of source node. */
-  int next;   /**< \brief Previous arc in out-arc list of source node. */
+  CMR_GRAPH_NODE target;  /**< \brief Target node of this arc. */
+  CMR_GRAPH_INDEX prev;   /**< \brief Next arc in out-arc list of source node. */
+  CMR_GRAPH_INDEX next;   /**< \brief Previous arc in out-arc list of source node. */
 } CMR_GRAPH_ARC_DATA;
 
 typedef struct
@@ -50,13 +67,13 @@ typedef struct
   size_t numNodes;            /**< \brief Number of nodes. */
   size_t memNodes;            /**< \brief Number of nodes for which memory is allocated. */
   CMR_GRAPH_NODE_DATA* nodes; /**< \brief Array containing node data. */
-  int firstNode;              /**< \brief Index of first node. */
-  int freeNode;               /**< \brief Beginning of free-list of nodes. */
+  CMR_GRAPH_NODE firstNode;   /**< \brief Index of first node. */
+  CMR_GRAPH_NODE freeNode;    /**< \brief Beginning of free-list of nodes. */
 
   size_t numEdges;            /**< \brief Number of edges. */
   size_t memEdges;            /**< \brief Number of edges for which memory is allocated. */
   CMR_GRAPH_ARC_DATA* arcs;   /**< \brief Array containing arc data. */
-  int freeEdge;               /**< \brief Beginning of free-list of arc. */
+  CMR_GRAPH_EDGE freeEdge;    /**< \brief Beginning of free-list of arc. */
 } CMR_GRAPH;
 
 /**
@@ -147,14 +164,16 @@ CMR_GRAPH_NODE CMRgraphEdgeV(
 
 /**
  * \brief Creates an empty graph.
+ *
+ * Returns \ref CMR_ERROR_OVERFLOW if the nodes or arcs cannot be indexed by \ref CMR_GRAPH_INDEX.
  */
 
 CMR_EXPORT
 CMR_ERROR CMRgraphCreateEmpty(
-  CMR* cmr,             /**< \ref CMR environment. */
-  CMR_GRAPH** pgraph,  /**< Pointer for storing the graph. */
-  int memNodes,       /**< Allocate memory for this number of nodes. */
-  int memEdges        /**< Allocate memory for this number of edges. */
+  CMR* cmr,           /**< \ref CMR environment. */
+  CMR_GRAPH** pgraph, /**< Pointer for storing the graph. */
+  size_t memNodes,    /**< Allocate memory for this number of nodes. */
+  size_t memEdges     /**< Allocate memory for this number of edges. */
 );
 
 /**
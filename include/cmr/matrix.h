@@ -213,9 +213,9 @@ CMR_EXPORT
 CMR_ERROR CMRdblmatCreate(
   CMR* cmr,             /**< \ref CMR environment. */
   CMR_DBLMAT** presult, /**< Pointer for storing the created matrix. */
-  int numRows,          /**< Number of rows. */
-  int numColumns,       /**< Number of columns. */
-  int numNonzeros       /**< Number of nonzeros. */
+  size_t numRows,       /**< Number of rows. */
+  size_t numColumns,    /**< Number of columns. */
+  size_t numNonzeros    /**< Number of nonzeros. */
 );
 
 /**
@@ -228,9 +228,9 @@ CMR_EXPORT
 CMR_ERROR CMRintmatCreate(
   CMR* cmr,             /**< \ref CMR environment. */
   CMR_INTMAT** presult, /**< Pointer for storing the created matrix. */
-  int numRows,          /**< Number of rows. */
-  int numColumns,       /**< Number of columns. */
-  int numNonzeros       /**< Number of nonzeros. */
+  size_t numRows,       /**< Number of rows. */
+  size_t numColumns,    /**< Number of columns. */
+  size_t numNonzeros    /**< Number of nonzeros. */
 );
 
 /**
@@ -242,9 +242,9 @@ CMR_EXPORT
 CMR_ERROR CMRchrmatCreate(
   CMR* cmr,             /**< \ref CMR environment. */
   CMR_CHRMAT** presult, /**< Pointer for storing the created matrix. */
-  int numRows,          /**< Number of rows. */
-  int numColumns,       /**< Number of columns. */
-  int numNonzeros       /**< Number of nonzeros. */
+  size_t numRows,       /**< Number of rows. */
+  size_t numColumns,    /**< Number of columns. */
+  size_t numNonzeros    /**< Number of nonzeros. */
 );
 
 /**
@@ -279,6 +279,8 @@ CMR_ERROR CMRchrmatFree(
 
 /**
  * \brief Changes the number of nonzeros and reallocates corresponding arrays.
+ *
+ * If the matrix was memory-mapped, then its arrays are copied first and the file is unmapped.
  */
 
 CMR_EXPORT
@@ -290,6 +292,8 @@ CMR_ERROR CMRdblmatChangeNumNonzeros(
 
 /**
  * \brief Changes the number of nonzeros and reallocates corresponding arrays.
+ *
+ * If the matrix was memory-mapped, then its arrays are copied first and the file is unmapped.
  */
 
 CMR_EXPORT
@@ -301,6 +305,8 @@ CMR_ERROR CMRintmatChangeNumNonzeros(
 
 /**
  * \brief Changes the number of nonzeros and reallocates corresponding arrays.
+ *
+ * If the matrix was memory-mapped, then its arrays are copied first and the file is unmapped.
  */
 
 CMR_EXPORT
@@ -478,6 +484,48 @@ CMR_ERROR CMRchrmatPrintSparse(
   FILE* stream        /**< File stream to print to. */
 );
 
+/**
+ * \brief Prints a double matrix in binary format.
+ *
+ * The binary format consists of a header followed by the arrays \c rowSlice, \c entryColumns and \c entryValues in
+ * native byte order. It can be read with \ref CMRdblmatCreateFromBinaryStream, also by the other matrix types.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRdblmatPrintBinary(
+  CMR* cmr,           /**< \ref CMR environment. */
+  CMR_DBLMAT* matrix, /**< A matrix. */
+  FILE* stream        /**< File stream to print to. */
+);
+
+/**
+ * \brief Prints a int matrix in binary format.
+ *
+ * The binary format consists of a header followed by the arrays \c rowSlice, \c entryColumns and \c entryValues in
+ * native byte order. It can be read with \ref CMRintmatCreateFromBinaryStream, also by the other matrix types.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRintmatPrintBinary(
+  CMR* cmr,           /**< \ref CMR environment. */
+  CMR_INTMAT* matrix, /**< A matrix. */
+  FILE* stream        /**< File stream to print to. */
+);
+
+/**
+ * \brief Prints a char matrix in binary format.
+ *
+ * The binary format consists of a header followed by the arrays \c rowSlice, \c entryColumns and \c entryValues in
+ * native byte order. It can be read with \ref CMRchrmatCreateFromBinaryStream, also by the other matrix types.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRchrmatPrintBinary(
+  CMR* cmr,           /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix, /**< A matrix. */
+  FILE* stream        /**< File stream to print to. */
+);
+
 /**
  * \brief Prints a double matrix in dense format.
  */
@@ -517,6 +565,72 @@ CMR_ERROR CMRchrmatPrintDense(
   bool header         /**< Whether to print row and column indices. */
 );
 
+/**
+ * \brief Creates a double matrix from triples consisting of (0-based) row, column and value.
+ *
+ * The triples may be given in any order and triples with value zero are ignored. The row-wise representation is
+ * computed by bucketing the triples by column and then by row, which takes linear time.
+ *
+ * Returns \ref CMR_ERROR_INPUT if a row or column is out of range or if two nonzeros have the same position. In this
+ * case, *\p presult will be \c NULL.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRdblmatCreateFromTriples(
+  CMR* cmr,             /**< \ref CMR environment. */
+  size_t numRows,       /**< Number of rows. */
+  size_t numColumns,    /**< Number of columns. */
+  size_t numTriples,    /**< Number of triples. */
+  size_t* rows,         /**< Array with the row of each triple. */
+  size_t* columns,      /**< Array with the column of each triple. */
+  double* values,       /**< Array with the value of each triple. */
+  CMR_DBLMAT** presult  /**< Pointer for storing the matrix. */
+);
+
+/**
+ * \brief Creates an int matrix from triples consisting of (0-based) row, column and value.
+ *
+ * The triples may be given in any order and triples with value zero are ignored. The row-wise representation is
+ * computed by bucketing the triples by column and then by row, which takes linear time.
+ *
+ * Returns \ref CMR_ERROR_INPUT if a row or column is out of range or if two nonzeros have the same position. In this
+ * case, *\p presult will be \c NULL.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRintmatCreateFromTriples(
+  CMR* cmr,             /**< \ref CMR environment. */
+  size_t numRows,       /**< Number of rows. */
+  size_t numColumns,    /**< Number of columns. */
+  size_t numTriples,    /**< Number of triples. */
+  size_t* rows,         /**< Array with the row of each triple. */
+  size_t* columns,      /**< Array with the column of each triple. */
+  int* values,          /**< Array with the value of each triple. */
+  CMR_INTMAT** presult  /**< Pointer for storing the matrix. */
+);
+
+/**
+ * \brief Creates a char matrix from triples consisting of (0-based) row, column and value.
+ *
+ * The triples may be given in any order and triples with value zero are ignored. The row-wise representation is
+ * computed by bucketing the triples by column and then by row, which takes linear time.
+ *
+ * Returns \ref CMR_ERROR_INPUT if a row or column is out of range or if two nonzeros have the same position. In this
+ * case, *\p presult will be \c NULL.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRchrmatCreateFromTriples(
+  CMR* cmr,             /**< \ref CMR environment. */
+  size_t numRows,       /**< Number of rows. */
+  size_t numColumns,    /**< Number of columns. */
+  size_t numTriples,    /**< Number of triples. */
+  size_t* rows,         /**< Array with the row of each triple. */
+  size_t* columns,      /**< Array with the column of each triple. */
+  char* values,         /**< Array with the value of each triple. */
+  CMR_CHRMAT** presult  /**< Pointer for storing the matrix. */
+);
+
 /**
  * \brief Reads a double matrix from a file \p stream in sparse format.
  * 
@@ -595,6 +709,66 @@ CMR_ERROR CMRchrmatCreateFromDenseStream(
   CMR_CHRMAT** presult  /**< Pointer for storing the matrix. */
 );
 
+/**
+ * \brief Reads a double matrix from a file \p stream in binary format.
+ *
+ * If \p stream is a regular file and the matrix was written by \ref CMRdblmatPrintBinary, then the file is
+ * memory-mapped and the arrays of *\p presult point directly into it. Such a matrix can be modified in place. The
+ * arrays are copied before its number of nonzeros is changed via \ref CMRdblmatChangeNumNonzeros. It must be freed
+ * and resized with the same \p cmr. If it is not freed, then \ref CMRfreeEnvironment unmaps the file, which
+ * invalidates its arrays.
+ * Otherwise, the arrays are read and the values are converted if necessary.
+ *
+ * Returns \ref CMR_ERROR_INPUT in case of errors. In this case, *\p presult will be \c NULL.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRdblmatCreateFromBinaryStream(
+  CMR* cmr,             /**< \ref CMR environment. */
+  FILE* stream,         /**< File stream to read from. */
+  CMR_DBLMAT** presult  /**< Pointer for storing the matrix. */
+);
+
+/**
+ * \brief Reads a int matrix from a file \p stream in binary format.
+ *
+ * If \p stream is a regular file and the matrix was written by \ref CMRintmatPrintBinary, then the file is
+ * memory-mapped and the arrays of *\p presult point directly into it. Such a matrix can be modified in place. The
+ * arrays are copied before its number of nonzeros is changed via \ref CMRintmatChangeNumNonzeros. It must be freed
+ * and resized with the same \p cmr. If it is not freed, then \ref CMRfreeEnvironment unmaps the file, which
+ * invalidates its arrays.
+ * Otherwise, the arrays are read and the values are converted if necessary.
+ *
+ * Returns \ref CMR_ERROR_INPUT in case of errors. In this case, *\p presult will be \c NULL.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRintmatCreateFromBinaryStream(
+  CMR* cmr,             /**< \ref CMR environment. */
+  FILE* stream,         /**< File stream to read from. */
+  CMR_INTMAT** presult  /**< Pointer for storing the matrix. */
+);
+
+/**
+ * \brief Reads a char matrix from a file \p stream in binary format.
+ *
+ * If \p stream is a regular file and the matrix was written by \ref CMRchrmatPrintBinary, then the file is
+ * memory-mapped and the arrays of *\p presult point directly into it. Such a matrix can be modified in place. The
+ * arrays are copied before its number of nonzeros is changed via \ref CMRchrmatChangeNumNonzeros. It must be freed
+ * and resized with the same \p cmr. If it is not freed, then \ref CMRfreeEnvironment unmaps the file, which
+ * invalidates its arrays.
+ * Otherwise, the arrays are read and the values are converted if necessary.
+ *
+ * Returns \ref CMR_ERROR_INPUT in case of errors. In this case, *\p presult will be \c NULL.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRchrmatCreateFromBinaryStream(
+  CMR* cmr,             /**< \ref CMR environment. */
+  FILE* stream,         /**< File stream to read from. */
+  CMR_CHRMAT** presult  /**< Pointer for storing the matrix. */
+);
+
 /**
  * \brief Checks whether two double matrices are equal.
  */
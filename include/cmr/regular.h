@@ -74,6 +74,8 @@ typedef struct
   size_t enumerationCount;            /**< Number of calls to enumeration algorithm for candidate 3-separations. */
   double enumerationTime;             /**< Time of enumeration of candidate 3-separations. */
   size_t enumerationCandidatesCount;  /**< Number of enumerated candidates for 3-separations. */
+  size_t cacheHitCount;               /**< Number of invocations answered by the result cache. */
+  size_t cacheMissCount;              /**< Number of invocations not answered by the result cache. */
 } CMR_REGULAR_STATISTICS;
 
 
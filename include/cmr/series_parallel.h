@@ -71,7 +71,8 @@ CMR_EXPORT
 char* CMRspReductionString(
   CMR_SP_REDUCTION reduction, /**< Series-parallel reduction. */
   char* buffer                /**< Buffer to write to.
-                               **  If \c NULL, a static one is used which will be overwritten in the next call.
+                               **  If \c NULL, a static one is used which will be overwritten in the next call
+                               **  of the same thread.
                                **  Otherwise, it must hold at least 51 bytes.
                                **/
 );
@@ -44,6 +44,8 @@ typedef struct
   double totalTime;               /**< Total time of all invocations. */
   CMR_CAMION_STATISTICS camion;   /**< Camion signing. */
   CMR_REGULAR_STATISTICS regular; /**< Regularity test. */
+  size_t cacheHitCount;           /**< Number of invocations answered by the result cache. */
+  size_t cacheMissCount;          /**< Number of invocations not answered by the result cache. */
 } CMR_TU_STATISTICS;
 
 /**
@@ -90,6 +92,38 @@ CMR_ERROR CMRtestTotalUnimodularity(
   double timeLimit                /**< Time limit to impose. */
 );
 
+/**
+ * \brief Result of the test of one matrix by \ref CMRtestTotalUnimodularityBatch.
+ */
+
+typedef struct
+{
+  bool isTotallyUnimodular; /**< \brief Whether the matrix is totally unimodular. */
+  double time;              /**< \brief Wall-clock time of the test in seconds. */
+} CMR_TU_RESULT;
+
+/**
+ * \brief Tests each matrix of a batch for being [totally unimodular](\ref tu).
+ *
+ * This is equivalent to calling \ref CMRtestTotalUnimodularity for each matrix, but cheaper for many small matrices:
+ * the matrices are distributed dynamically among the threads of \p cmr, and each thread reuses its stack memory for all
+ * its tests. The result of matrix \p matrices[i] is stored in \p results[i].
+ *
+ * The time limit covers the whole batch. If a test fails, e.g., because the time limit is exceeded, then the
+ * remaining tests are skipped and its error is returned.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRtestTotalUnimodularityBatch(
+  CMR* cmr,                   /**< \ref CMR environment */
+  size_t numMatrices,         /**< Number of matrices. */
+  CMR_CHRMAT** matrices,      /**< Array with the matrices. */
+  CMR_TU_RESULT* results,     /**< Array of length \p numMatrices for storing the results. */
+  CMR_TU_PARAMETERS* params,  /**< Parameters for the computation (may be \c NULL for defaults). */
+  CMR_TU_STATISTICS* stats,   /**< Statistics for all tests (may be \c NULL). */
+  double timeLimit            /**< Time limit to impose. */
+);
+
 #ifdef __cplusplus
 }
 #endif
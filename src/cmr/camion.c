@@ -49,14 +49,164 @@ typedef struct
   char targetValue;       /**< \brief Entry in current row if a target node, and 0 otherwise. */
 } GRAPH_NODE;
 
+/**
+ * \brief Defines the function searchRow##NAME that signs a row by a breadth-first search whose row slices and entry
+ *        columns are arrays of type \p INDEX and whose entry values are read via \p VALUE from \p VALUES.
+ *
+ * The search starts at the column of the first nonzero of \p row and traverses the bipartite graph of the rows
+ * before \p row and all columns. Whenever it reaches a column of a nonzero of \p row for the first time, the sum of
+ * the entries along the path to the previous such column determines whether that nonzero must change its sign. The
+ * required signs are stored in the targetValue fields of the column nodes.
+ */
+
+#define CAMION_SEARCH_ROW_FUNCTION(NAME, INDEX, VALUES, VALUE) \
+  static \
+  CMR_ERROR searchRow##NAME(CMR* cmr, CMR_CHRMAT* matrix, const INDEX* rowSlice, const INDEX* entryColumns, \
+    VALUES entryValues, const INDEX* transposeSlice, const INDEX* transposeColumns, VALUES transposeValues, \
+    size_t row, GRAPH_NODE* graphNodes, int* bfsQueue, bool change, char* pmodification, bool* prowChanged, \
+    CMR_SUBMAT** psubmatrix) \
+  { \
+    const int firstRowNode = matrix->numColumns; \
+    size_t first = rowSlice[row]; \
+    size_t beyond = rowSlice[row + 1]; \
+    assert(first < beyond); \
+    \
+    /* First nonzero in row determines start column node. */ \
+    int startNode = entryColumns[first]; \
+    /* All columns of the row's nonzeros are target column nodes. */ \
+    for (size_t e = first; e < beyond; ++e) \
+      graphNodes[entryColumns[e]].targetValue = VALUE(entryValues, e); \
+    bfsQueue[0] = startNode; \
+    graphNodes[startNode].status = 1; \
+    int bfsQueueBegin = 0; \
+    int bfsQueueEnd = 1; \
+    \
+    while (bfsQueueBegin < bfsQueueEnd) \
+    { \
+      int currentNode = bfsQueue[bfsQueueBegin]; \
+      assert(graphNodes[currentNode].status == 1); \
+      graphNodes[currentNode].status = 2; \
+      ++bfsQueueBegin; \
+      \
+      if (currentNode >= firstRowNode) \
+      { \
+        int r = currentNode - firstRowNode; \
+        CMRdbgMsg(4, "Current node is %d (row r%d), queue length is %d\n", currentNode, r+1, \
+          bfsQueueEnd - bfsQueueBegin); \
+        \
+        /* Iterate over outgoing edges. */ \
+        first = rowSlice[r]; \
+        beyond = rowSlice[r + 1]; \
+        for (size_t e = first; e < beyond; ++e) \
+        { \
+          int c = entryColumns[e]; \
+          if (graphNodes[c].status == 0) \
+          { \
+            graphNodes[c].status = 1; \
+            graphNodes[c].predecessorNode = currentNode; \
+            graphNodes[c].predecessorValue = VALUE(entryValues, e); \
+            bfsQueue[bfsQueueEnd++] = c; \
+            /* If we reach a target node for the first time, we trace back to the previous target \
+               node (which might be the starting node). */ \
+            if (graphNodes[c].targetValue != 0) \
+            { \
+              int length = 2; \
+              int sum = graphNodes[c].targetValue; \
+              CMRdbgMsg(8, "sum = %d\n", sum); \
+              int pathNode = c; \
+              do \
+              { \
+                sum += graphNodes[pathNode].predecessorValue; \
+                CMRdbgMsg(8, "sum = %d\n", sum); \
+                pathNode = graphNodes[pathNode].predecessorNode; \
+                ++length; \
+              } \
+              while (graphNodes[pathNode].targetValue == 0); \
+              sum += graphNodes[pathNode].targetValue; \
+              CMRdbgMsg(6, "Found a chordless cycle between c%d and c%d with sum %d of length %d\n", c+1, \
+                pathNode+1, sum, length); \
+              \
+              if (sum % 4 != 0) \
+              { \
+                assert(sum % 4 == -2 || sum % 4 == 2); \
+                \
+                /* If we didn't find a submatrix yet: */ \
+                if (psubmatrix && *psubmatrix == NULL) \
+                { \
+                  int i = 1; \
+                  int j = 1; \
+                  CMR_CALL( CMRsubmatCreate(cmr, length/2, length/2, psubmatrix) ); \
+                  CMR_SUBMAT* submatrix = *psubmatrix; \
+                  pathNode = c; \
+                  submatrix->columns[0] = c; \
+                  submatrix->rows[0] = row; \
+                  do \
+                  { \
+                    pathNode = graphNodes[pathNode].predecessorNode; \
+                    if (pathNode >= firstRowNode) \
+                      submatrix->rows[i++] = pathNode - firstRowNode; \
+                    else \
+                      submatrix->columns[j++] = pathNode; \
+                  } \
+                  while (graphNodes[pathNode].targetValue == 0); \
+                  CMR_CALL( CMRsortSubmatrix(cmr, submatrix) ); \
+                  \
+                  CMRdbgMsg(6, "Submatrix filled with %d rows and %d columns.\n", i, j); \
+                } \
+                CMRdbgMsg(6, "Sign change required.\n"); \
+                graphNodes[c].targetValue *= -1; \
+                *pmodification = 'm'; \
+                if (!change) \
+                  return CMR_OKAY; \
+                *prowChanged = true; \
+              } \
+            } \
+          } \
+        } \
+      } \
+      else \
+      { \
+        int c = currentNode; \
+        CMRdbgMsg(4, "Current node is %d (column c%d), queue length is %d\n", currentNode, c+1, \
+          bfsQueueEnd - bfsQueueBegin); \
+        \
+        /* Iterate over outgoing edges. */ \
+        first = transposeSlice[c]; \
+        beyond = transposeSlice[c + 1]; \
+        for (size_t e = first; e < beyond; ++e) \
+        { \
+          size_t r = transposeColumns[e]; \
+          /* Only rows before current iteration row participate. */ \
+          if (r >= row) \
+            break; \
+          if (graphNodes[firstRowNode + r].status == 0) \
+          { \
+            graphNodes[firstRowNode + r].status = 1; \
+            graphNodes[firstRowNode + r].predecessorNode = currentNode; \
+            graphNodes[firstRowNode + r].predecessorValue = VALUE(transposeValues, e); \
+            bfsQueue[bfsQueueEnd++] = firstRowNode + r; \
+          } \
+        } \
+      } \
+    } \
+    \
+    return CMR_OKAY; \
+  }
+
+#define CAMION_VALUE_CHAR(values, e) ((values)[(e)])                  /**< Reads a value from a char array. */
+#define CAMION_VALUE_PACKED(values, e) CMRpackedSignsGet((values), (e)) /**< Reads a value from packed signs. */
+
+CAMION_SEARCH_ROW_FUNCTION(Wide, size_t, const char*, CAMION_VALUE_CHAR)
+CAMION_SEARCH_ROW_FUNCTION(Compact, uint32_t, const CMR_PACKED_SIGNS*, CAMION_VALUE_PACKED)
+
 CMR_ERROR CMRcomputeCamionSignSequentiallyConnected(
   CMR* cmr,                 /**< \ref CMR environment. */
   CMR_CHRMAT* matrix,       /**< The matrix to be signed. */
   CMR_CHRMAT* transpose,    /**< The transpose of \p matrix. */
   bool change,              /**< Whether to modify the matrix. */
+  bool wideIndices,         /**< Whether to scan rows with \c size_t indices even if 32-bit indices suffice. */
   char* pmodification,      /**< Pointer for storing which matrix was modified.*/
-  CMR_SUBMAT** psubmatrix,  /**< Pointer for storing a submatrix with bad determinant (may be \c NULL). */
-  double timeLimit          /**< Time limit to impose. */
+  CMR_SUBMAT** psubmatrix   /**< Pointer for storing a submatrix with bad determinant (may be \c NULL). */
 )
 {
   assert(cmr);
@@ -72,8 +222,8 @@ CMR_ERROR CMRcomputeCamionSignSequentiallyConnected(
   /* If we have more rows than columns, we work with the transpose. */
   if (matrix->numRows > matrix->numColumns)
   {
-    CMR_CALL( CMRcomputeCamionSignSequentiallyConnected(cmr, transpose, matrix, change, pmodification, psubmatrix,
-      timeLimit) );
+    CMR_CALL( CMRcomputeCamionSignSequentiallyConnected(cmr, transpose, matrix, change, wideIndices,
+      pmodification, psubmatrix) );
     assert(*pmodification == 0 || *pmodification == 'm');
     if (psubmatrix && *psubmatrix)
     {
@@ -90,27 +240,39 @@ CMR_ERROR CMRcomputeCamionSignSequentiallyConnected(
   CMRdbgMsg(2, "signSequentiallyConnected.\n");
 
   *pmodification = 0;
-  const int firstRowNode = matrix->numColumns;
   GRAPH_NODE* graphNodes = NULL;
   int* bfsQueue = NULL;
-  int bfsQueueBegin = 0;
-  int bfsQueueEnd = 0;
-  clock_t time = clock();
 
   CMR_CALL(CMRallocStackArray(cmr, &graphNodes, matrix->numColumns + matrix->numRows));
   CMR_CALL(CMRallocStackArray(cmr, &bfsQueue, matrix->numColumns + matrix->numRows));
 
+  /* Every search scans the rows of the matrix and of its transpose, so we do so with 32-bit indices and packed signs
+   * if possible. */
+  bool compact = !wideIndices && CMRcompactIndicesFit((CMR_MATRIX*) matrix)
+    && CMRcompactIndicesFit((CMR_MATRIX*) transpose);
+  CMR_COMPACT_INDICES matrixIndices;
+  CMR_COMPACT_INDICES transposeIndices;
+  CMR_PACKED_SIGNS matrixSigns;
+  CMR_PACKED_SIGNS transposeSigns;
+  if (compact)
+  {
+    CMR_CALL( CMRcompactIndicesInitStack(cmr, &matrixIndices, (CMR_MATRIX*) matrix) );
+    CMR_CALL( CMRcompactIndicesInitStack(cmr, &transposeIndices, (CMR_MATRIX*) transpose) );
+    CMR_CALL( CMRpackedSignsInitStack(cmr, &matrixSigns, matrix) );
+    CMR_CALL( CMRpackedSignsInitStack(cmr, &transposeSigns, transpose) );
+  }
+
   /* Main loop iterates over the rows. */
-  size_t clockRows = matrix->numRows / 100 + 1;
+  CMR_ERROR error = CMR_OKAY;
+  size_t pollCounter = 0;
   for (size_t row = 1; row < matrix->numRows; ++row)
   {
-    if ((row % clockRows) == 0 && ((clock() - time) * 1.0 / CLOCKS_PER_SEC > timeLimit))
+    if (CMRdeadlinePoll(cmr, &pollCounter))
     {
-      CMRfreeStackArray(cmr, &bfsQueue);
-      CMRfreeStackArray(cmr, &graphNodes);
-      return CMR_ERROR_TIMEOUT;
+      error = CMR_ERROR_TIMEOUT;
+      break;
     }
-    
+
     CMRdbgMsg(2, "Before processing row %d:\n", row);
 #if defined(CMR_DEBUG)
     CMRchrmatPrintDense(cmr, matrix, stdout, ' ', true);
@@ -123,7 +285,6 @@ CMR_ERROR CMRcomputeCamionSignSequentiallyConnected(
       graphNodes[v].predecessorNode = -1;
     }
 
-    bool rowChanged = false;
     size_t first = matrix->rowSlice[row];
     size_t beyond = matrix->rowSlice[row + 1];
     if (first == beyond)
@@ -132,151 +293,39 @@ CMR_ERROR CMRcomputeCamionSignSequentiallyConnected(
       continue;
     }
 
-    /* First nonzero in row determines start column node. */
-    int startNode = matrix->entryColumns[first];
-    /* All columns of the row's nonzeros are target column nodes. */
-    for (size_t e = first; e < beyond; ++e)
-      graphNodes[matrix->entryColumns[e]].targetValue = matrix->entryValues[e];
-    bfsQueue[0] = startNode;
-    graphNodes[startNode].status = 1;
-    bfsQueueBegin = 0;
-    bfsQueueEnd = 1;
-
-    while (bfsQueueBegin < bfsQueueEnd)
+    bool rowChanged = false;
+    if (compact)
     {
-      int currentNode = bfsQueue[bfsQueueBegin];
-      assert(graphNodes[currentNode].status == 1);
-      graphNodes[currentNode].status = 2;
-      ++bfsQueueBegin;
-
-      if (currentNode >= firstRowNode)
-      {
-        int r = currentNode - firstRowNode;
-        CMRdbgMsg(4, "Current node is %d (row r%d), queue length is %d\n", currentNode, r+1,
-          bfsQueueEnd - bfsQueueBegin);
-
-        /* Iterate over outgoing edges. */
-        first = matrix->rowSlice[r];
-        beyond = matrix->rowSlice[r + 1];
-        for (size_t e = first; e < beyond; ++e)
-        {
-          int c = matrix->entryColumns[e];
-          if (graphNodes[c].status == 0)
-          {
-            graphNodes[c].status = 1;
-            graphNodes[c].predecessorNode = currentNode;
-            graphNodes[c].predecessorValue = matrix->entryValues[e];
-            bfsQueue[bfsQueueEnd++] = c;
-            /* If we reach a target node for the first time, we trace back to the previous target
-               node (which might be the starting node). */
-            if (graphNodes[c].targetValue != 0)
-            {
-              int length = 2;
-              int sum = graphNodes[c].targetValue;
-              CMRdbgMsg(8, "sum = %d\n", sum);
-              int pathNode = c;
-              do
-              {
-                sum += graphNodes[pathNode].predecessorValue;
-                CMRdbgMsg(8, "sum = %d\n", sum);
-                pathNode = graphNodes[pathNode].predecessorNode;
-                ++length;
-              }
-              while (graphNodes[pathNode].targetValue == 0);
-              sum += graphNodes[pathNode].targetValue;
-              CMRdbgMsg(6, "Found a chordless cycle between c%d and c%d with sum %d of length %d\n", c+1, pathNode+1,
-                sum, length);
-
-              if (sum % 4 != 0)
-              {
-                assert(sum % 4 == -2 || sum % 4 == 2);
-
-                /* If we didn't find a submatrix yet: */
-                if (psubmatrix && *psubmatrix == NULL)
-                {
-                  int i = 1;
-                  int j = 1;
-                  CMR_CALL( CMRsubmatCreate(cmr, length/2, length/2, psubmatrix) );
-                  CMR_SUBMAT* submatrix = *psubmatrix;
-                  pathNode = c;
-                  submatrix->columns[0] = c;
-                  submatrix->rows[0] = row;
-                  do
-                  {
-                    pathNode = graphNodes[pathNode].predecessorNode;
-                    if (pathNode >= firstRowNode)
-                      submatrix->rows[i++] = pathNode - firstRowNode;
-                    else
-                      submatrix->columns[j++] = pathNode;
-                  }
-                  while (graphNodes[pathNode].targetValue == 0);
-                  CMR_CALL( CMRsortSubmatrix(cmr, submatrix) );
-
-                  CMRdbgMsg(6, "Submatrix filled with %d rows and %d columns.\n", i, j);
-                }
-                CMRdbgMsg(6, "Sign change required.\n");
-                graphNodes[c].targetValue *= -1;
-                *pmodification = 'm';
-                if (change)
-                  rowChanged = true;
-                else
-                {
-                  CMRfreeStackArray(cmr, &bfsQueue);
-                  CMRfreeStackArray(cmr, &graphNodes);
-                  return CMR_OKAY;
-                }
-              }
-            }
-          }
-        }
-      }
-      else
-      {
-        int c = currentNode;
-        CMRdbgMsg(4, "Current node is %d (column c%d), queue length is %d\n", currentNode, c+1,
-          bfsQueueEnd - bfsQueueBegin);
-
-        /* Iterate over outgoing edges. */
-        first = transpose->rowSlice[c];
-        beyond = transpose->rowSlice[c + 1];
-        for (size_t e = first; e < beyond; ++e)
-        {
-          size_t r = transpose->entryColumns[e];
-          /* Only rows before current iteration row participate. */
-          if (r >= row)
-            break;
-          if (graphNodes[firstRowNode + r].status == 0)
-          {
-            graphNodes[firstRowNode + r].status = 1;
-            graphNodes[firstRowNode + r].predecessorNode = currentNode;
-            graphNodes[firstRowNode + r].predecessorValue = transpose->entryValues[e];
-            bfsQueue[bfsQueueEnd++] = firstRowNode + r;
-          }
-        }
-      }
+      error = searchRowCompact(cmr, matrix, matrixIndices.rowSlice, matrixIndices.entryColumns, &matrixSigns,
+        transposeIndices.rowSlice, transposeIndices.entryColumns, &transposeSigns, row, graphNodes, bfsQueue, change,
+        pmodification, &rowChanged, psubmatrix);
     }
+    else
+    {
+      error = searchRowWide(cmr, matrix, matrix->rowSlice, matrix->entryColumns, matrix->entryValues,
+        transpose->rowSlice, transpose->entryColumns, transpose->entryValues, row, graphNodes, bfsQueue, change,
+        pmodification, &rowChanged, psubmatrix);
+    }
+    if (error != CMR_OKAY || (*pmodification && !change))
+      break;
 
 #if defined(CMR_DEBUG)
-    for (int v = 0; v < matrix->numColumns + row; ++v)
+    for (size_t v = 0; v < matrix->numColumns + row; ++v)
     {
-      if (v == startNode)
-        CMRdbgMsg(4, "Source node ");
-      else if (graphNodes[v].targetValue != 0)
+      if (graphNodes[v].targetValue != 0)
         CMRdbgMsg(4, "Target node ");
       else
         CMRdbgMsg(4, "Node ");
-      CMRdbgMsg(0, "%d is %s%d and has predecessor %d.\n", v, v >= firstRowNode ? "row r": "column c",
-        (v >= firstRowNode ? v-firstRowNode : v) + 1, graphNodes[v].predecessorNode);
+      CMRdbgMsg(0, "%d is %s%d and has predecessor %d.\n", v, v >= matrix->numColumns ? "row r": "column c",
+        (v >= matrix->numColumns ? v - matrix->numColumns : v) + 1, graphNodes[v].predecessorNode);
     }
 #endif
 
     if (rowChanged)
     {
-      first = matrix->rowSlice[row];
-      beyond = matrix->rowSlice[row + 1];
       for (size_t e = first; e < beyond; ++e)
       {
-        int column = matrix->entryColumns[e];
+        size_t column = matrix->entryColumns[e];
         if (matrix->entryValues[e] != graphNodes[column].targetValue)
         {
           CMRdbgMsg(2, "Sign change at r%d,c%d.\n", row+1, column+1);
@@ -286,23 +335,35 @@ CMR_ERROR CMRcomputeCamionSignSequentiallyConnected(
           assert(entry < SIZE_MAX);
           assert(transpose->entryValues[entry] == -graphNodes[column].targetValue);
           transpose->entryValues[entry] = graphNodes[column].targetValue;
+          if (compact)
+          {
+            CMRpackedSignsSet(&matrixSigns, e, graphNodes[column].targetValue);
+            CMRpackedSignsSet(&transposeSigns, entry, graphNodes[column].targetValue);
+          }
         }
       }
     }
   }
 
 #if defined(CMR_DEBUG)
-  if (change)
+  if (change && error == CMR_OKAY)
   {
     CMRdbgMsg(2, "After signing:\n");
     CMR_CALL( CMRchrmatPrintDense(cmr, matrix, stdout, ' ', true) );
   }
 #endif /* CMR_DEBUG */
 
-  CMRfreeStackArray(cmr, &bfsQueue);
-  CMRfreeStackArray(cmr, &graphNodes);
+  if (compact)
+  {
+    CMR_CALL( CMRpackedSignsClearStack(cmr, &transposeSigns) );
+    CMR_CALL( CMRpackedSignsClearStack(cmr, &matrixSigns) );
+    CMR_CALL( CMRcompactIndicesClearStack(cmr, &transposeIndices) );
+    CMR_CALL( CMRcompactIndicesClearStack(cmr, &matrixIndices) );
+  }
+  CMR_CALL( CMRfreeStackArray(cmr, &bfsQueue) );
+  CMR_CALL( CMRfreeStackArray(cmr, &graphNodes) );
 
-  return CMR_OKAY;
+  return error;
 }
 
 /**
@@ -314,10 +375,10 @@ CMR_ERROR sign(
   CMR* cmr,                     /**< \ref CMR environment. */
   CMR_CHRMAT* matrix,           /**< Matrix \f$ M \f$. */
   bool change,                  /**< Whether the signs of \f$ M \f$ shall be modified. */
+  bool wideIndices,             /**< Whether to scan rows with \c size_t indices even if 32-bit indices suffice. */
   bool* pisCamionSigned,        /**< Pointer for storing whether \f$ M \f$ was already [Camion-signed](\ref camion). */
   CMR_SUBMAT** psubmatrix,      /**< Pointer for storing a non-camion submatrix (may be \c NULL). */
-  CMR_CAMION_STATISTICS* stats, /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit              /**< Time limit to impose. */
+  CMR_CAMION_STATISTICS* stats  /**< Statistics for the computation (may be \c NULL). */
 )
 {
   assert(cmr);
@@ -338,11 +399,12 @@ CMR_ERROR sign(
 
   /* Decompose into 1-connected components. */
 
-  CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(char), sizeof(char), &numComponents, &components, NULL,
-    NULL, NULL, NULL) );
+  CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(char), sizeof(char), true, &numComponents,
+    &components, NULL, NULL, NULL, NULL) );
 
   if (pisCamionSigned)
     *pisCamionSigned = true;
+  CMR_ERROR error = CMR_OKAY;
   for (size_t comp = 0; comp < numComponents; ++comp)
   {
     CMR_SUBMAT* compSubmatrix = NULL;
@@ -350,11 +412,17 @@ CMR_ERROR sign(
     CMRdbgMsg(2, "-> Component %d of size %dx%d\n", comp, components[comp].matrix->numRows,
       components[comp].matrix->numColumns);
 
-    double remainingTime = timeLimit - ((clock() - totalClock) * 1.0 / CLOCKS_PER_SEC);
+    /* On a timeout or an interruption, the components must still be freed. */
     char modified;
-    CMR_CALL( CMRcomputeCamionSignSequentiallyConnected(cmr, (CMR_CHRMAT*) components[comp].matrix,
-      (CMR_CHRMAT*) components[comp].transpose, change, &modified,
-      (psubmatrix && !*psubmatrix) ? &compSubmatrix : NULL, remainingTime) );
+    error = CMRcomputeCamionSignSequentiallyConnected(cmr, (CMR_CHRMAT*) components[comp].matrix,
+      (CMR_CHRMAT*) components[comp].transpose, change, wideIndices, &modified,
+      (psubmatrix && !*psubmatrix) ? &compSubmatrix : NULL);
+    if (error != CMR_OKAY)
+    {
+      if (compSubmatrix)
+        CMR_CALL( CMRsubmatFree(cmr, &compSubmatrix) );
+      break;
+    }
 
     CMRdbgMsg(2, "-> Component %d yields: %c\n", comp, modified ? modified : '0');
 
@@ -453,6 +521,7 @@ CMR_ERROR sign(
     CMRfreeBlockArray(cmr, &components[c].columnsToOriginal);
   }
   CMRfreeBlockArray(cmr, &components);
+  CMR_CALL( error );
 
   if (stats)
   {
@@ -466,11 +535,29 @@ CMR_ERROR sign(
 CMR_ERROR CMRtestCamionSigned(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCamionSigned, CMR_SUBMAT** psubmatrix,
   CMR_CAMION_STATISTICS* stats, double timeLimit)
 {
-  return sign(cmr, matrix, false, pisCamionSigned, psubmatrix, stats, timeLimit);
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = sign(cmr, matrix, false, false, pisCamionSigned, psubmatrix, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  return error;
 }
 
 CMR_ERROR CMRcomputeCamionSigned(CMR* cmr, CMR_CHRMAT* matrix, bool* pwasCamionSigned, CMR_SUBMAT** psubmatrix,
   CMR_CAMION_STATISTICS* stats, double timeLimit)
 {
-  return sign(cmr, matrix, true, pwasCamionSigned, psubmatrix, stats, timeLimit);
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = sign(cmr, matrix, true, false, pwasCamionSigned, psubmatrix, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  return error;
+}
+
+CMR_ERROR CMRcomputeCamionSignedWideIndices(CMR* cmr, CMR_CHRMAT* matrix, bool* pwasCamionSigned,
+  CMR_SUBMAT** psubmatrix, CMR_CAMION_STATISTICS* stats, double timeLimit)
+{
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = sign(cmr, matrix, true, true, pwasCamionSigned, psubmatrix, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  return error;
 }
@@ -3,6 +3,7 @@
 
 #include <cmr/env.h>
 #include <cmr/matrix.h>
+#include <cmr/camion.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,9 +25,25 @@ CMR_ERROR CMRcomputeCamionSignSequentiallyConnected(
   CMR_CHRMAT* matrix,       /**< Matrix \f M \f$. */
   CMR_CHRMAT* transpose,    /**< Transpose \f$ M^{\mathsf{T}} \f$. */
   bool change,              /**< Whether signs of \p matrix should be changed if necessary. */
+  bool wideIndices,         /**< Whether to scan rows with \c size_t indices even if 32-bit indices suffice. */
   char* pmodification,      /**< Pointer for storing which matrix was modified. */
-  CMR_SUBMAT** psubmatrix,  /**< Pointer for storing a submatrix with a bad determinant (may be \c NULL). */
-  double timeLimit          /**< Time limit to impose. */
+  CMR_SUBMAT** psubmatrix   /**< Pointer for storing a submatrix with a bad determinant (may be \c NULL). */
+);
+
+/**
+ * \brief Like \ref CMRcomputeCamionSigned, but scans rows with \c size_t indices even if 32-bit indices suffice.
+ *
+ * This is only used by tests to compare both index widths.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRcomputeCamionSignedWideIndices(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,           /**< Matrix \f$ M \f$. */
+  bool* pwasCamionSigned,       /**< Pointer for storing whether \f$ M \f$ was already Camion-signed. */
+  CMR_SUBMAT** psubmatrix,      /**< Pointer for storing a non-Camion submatrix (may be \c NULL). */
+  CMR_CAMION_STATISTICS* stats, /**< Statistics for the computation (may be \c NULL). */
+  double timeLimit              /**< Time limit to impose. */
 );
 
 #ifdef __cplusplus
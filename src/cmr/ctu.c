@@ -5,6 +5,8 @@
 #include <cmr/tu.h>
 
 #include "env_internal.h"
+#include "threadpool.h"
+#include "tu_internal.h"
 
 #include <assert.h>
 #include <stdint.h>
@@ -44,131 +46,354 @@ CMR_ERROR CMRstatsComplementTotalUnimodularityPrint(FILE* stream, CMR_CTU_STATIS
 }
 
 
-CMR_ERROR CMRcomplementRowColumn(CMR* cmr, CMR_CHRMAT* matrix, size_t complementRow, size_t complementColumn,
-  CMR_CHRMAT** presult)
+/**
+ * \brief Creates the matrix obtained from \p matrix by complementing \p complementRow.
+ *
+ * Every other row is replaced by its symmetric difference with \p complementRow, which takes time linear in their
+ * lengths. All complements that involve \p complementRow can be derived from the result by
+ * \ref complementColumnFromBase. If \p complementRow is \c SIZE_MAX, then the result is a copy of \p matrix. In both
+ * cases, all nonzeros of the result are 1.
+ */
+
+static
+CMR_ERROR createRowComplement(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,     /**< Input matrix. */
+  size_t complementRow,   /**< Row to be complemented (\c SIZE_MAX for no row complement). */
+  CMR_CHRMAT** presult    /**< Pointer for storing the resulting matrix. */
+)
 {
   assert(cmr);
   assert(matrix);
-  assert(complementRow < matrix->numRows || complementRow == SIZE_MAX);
-  assert(complementColumn < matrix->numColumns || complementColumn == SIZE_MAX);
   assert(presult);
 
-  /* We copy directly if no complementing is requested. */
-
-  if (complementRow == SIZE_MAX && complementColumn == SIZE_MAX)
+  size_t numRows = matrix->numRows;
+  size_t* complementEntryColumns = NULL;
+  size_t complementLength = 0;
+  if (complementRow < SIZE_MAX)
   {
-    CMR_CALL( CMRchrmatCopy(cmr, matrix, presult) );
-
-    return CMR_OKAY;
+    complementEntryColumns = &matrix->entryColumns[matrix->rowSlice[complementRow]];
+    complementLength = matrix->rowSlice[complementRow + 1] - matrix->rowSlice[complementRow];
   }
 
-  /* Create a dense copy of the column to be complemented. */
-  char* complementColumnEntries = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &complementColumnEntries, matrix->numRows) );
-  if (complementColumn < SIZE_MAX)
+  /* Count the nonzeros of the symmetric differences. */
+  size_t numNonzeros = 0;
+  for (size_t row = 0; row < numRows; ++row)
   {
-    for (size_t row = 0; row < matrix->numRows; ++row)
+    size_t first = matrix->rowSlice[row];
+    size_t beyond = matrix->rowSlice[row + 1];
+    numNonzeros += beyond - first;
+    if (row == complementRow)
+      continue;
+
+    numNonzeros += complementLength;
+    size_t c = 0;
+    for (size_t entry = first; entry < beyond && c < complementLength; ++entry)
     {
-      size_t e;
-      CMR_CALL( CMRchrmatFindEntry(matrix, row, complementColumn, &e) );
-      complementColumnEntries[row] = (e == SIZE_MAX) ? 0 : 1;
+      while (c < complementLength && complementEntryColumns[c] < matrix->entryColumns[entry])
+        ++c;
+      if (c < complementLength && complementEntryColumns[c] == matrix->entryColumns[entry])
+        numNonzeros -= 2;
     }
   }
-  else
-  {
-    for (size_t row = 0; row < matrix->numRows; ++row)
-      complementColumnEntries[row] = 0;
-  }
 
-  /* Create a dense copy of the row to be complemented. */
-  char* complementRowEntries = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &complementRowEntries, matrix->numColumns) );
-  if (complementRow < SIZE_MAX)
-  {
-    for (size_t column = 0; column < matrix->numColumns; ++column)
-      complementRowEntries[column] = 0;
-    size_t first = matrix->rowSlice[complementRow];
-    size_t beyond = matrix->rowSlice[complementRow + 1];
-    for (size_t entry = first; entry < beyond; ++entry)
-      complementRowEntries[matrix->entryColumns[entry]] = 1;
-  }
-  else
-  {
-    for (size_t column = 0; column < matrix->numColumns; ++column)
-      complementRowEntries[column] = 0;
-  }
-
-  /* Indicator for entry in complementRow, complementColumn. */
-  char complementRowColumn1 = complementColumn < SIZE_MAX ? complementRowEntries[complementColumn] : 0;
-
-  /* Swipe over the matrix to create the complemented one. */
-  CMR_CALL( CMRchrmatCreate(cmr, presult, matrix->numRows, matrix->numColumns, 0) );
+  CMR_CALL( CMRchrmatCreate(cmr, presult, numRows, matrix->numColumns, numNonzeros) );
   CMR_CHRMAT* result = *presult;
-  size_t memNonzeros = matrix->numNonzeros + 256;
-  CMR_CALL( CMRallocBlockArray(cmr, &result->entryColumns, memNonzeros) );
   size_t resultEntry = 0;
-  result->rowSlice[0] = 0;
-  for (size_t row = 0; row < matrix->numRows; ++row)
+  for (size_t row = 0; row < numRows; ++row)
   {
-    size_t matrixEntry = matrix->rowSlice[row];
+    result->rowSlice[row] = resultEntry;
+    size_t entry = matrix->rowSlice[row];
     size_t beyond = matrix->rowSlice[row + 1];
-    size_t matrixColumn = (matrixEntry < beyond) ? matrix->entryColumns[matrixEntry] : SIZE_MAX;
-    for (size_t column = 0; column < matrix->numColumns; ++column)
+    size_t c = (row == complementRow) ? complementLength : 0;
+    while (entry < beyond || c < complementLength)
     {
-      bool isNonzero = (column == matrixColumn);
-      if (isNonzero)
+      size_t column = (entry < beyond) ? matrix->entryColumns[entry] : SIZE_MAX;
+      size_t complementColumn = (c < complementLength) ? complementEntryColumns[c] : SIZE_MAX;
+      if (column < complementColumn)
       {
-        ++matrixEntry;
-        matrixColumn = (matrixEntry < beyond) ? matrix->entryColumns[matrixEntry] : SIZE_MAX;
+        result->entryColumns[resultEntry++] = column;
+        ++entry;
       }
-
-      if (row == complementRow)
+      else if (column > complementColumn)
       {
-        if (column != complementColumn && complementRowColumn1)
-          isNonzero = !isNonzero;
+        result->entryColumns[resultEntry++] = complementColumn;
+        ++c;
       }
       else
       {
-        if (column == complementColumn)
-        {
-          if (complementRowColumn1)
-            isNonzero = !isNonzero;
-        }
-        else
-        {
-          if (complementRowColumn1 + complementColumnEntries[row] + complementRowEntries[column] % 2 == 1)
-            isNonzero = !isNonzero;
-        }
+        ++entry;
+        ++c;
       }
+    }
+  }
+  result->rowSlice[numRows] = resultEntry;
+  assert(resultEntry == numNonzeros);
+  for (size_t e = 0; e < numNonzeros; ++e)
+    result->entryValues[e] = 1;
+
+  return CMR_OKAY;
+}
 
-      if (isNonzero)
+/**
+ * \brief Fills \p result with the complement of \p complementRow and \p complementColumn.
+ *
+ * Let \f$ a \f$ be the entry of the original matrix in \p complementRow and \p complementColumn. Row
+ * \p complementRow of \p rowComplement is complemented if \f$ a = 1 \f$, and another row is complemented if its
+ * original entry in \p complementColumn differs from \f$ a \f$. Complementing excludes \p complementColumn, in which
+ * the entries of these rows are 1. All other rows are copied, and their entries in \p complementColumn are 0. The
+ * arrays of \p result are enlarged if necessary.
+ */
+
+static
+CMR_ERROR complementColumnFromBase(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_CHRMAT* rowComplement,  /**< Matrix obtained by \ref createRowComplement. */
+  size_t complementRow,       /**< Row that was complemented (\c SIZE_MAX for no row complement). */
+  size_t complementColumn,    /**< Column to be complemented. */
+  char* columnEntries,        /**< Array with the entries of the original matrix in \p complementColumn. */
+  size_t* pmemNonzeros,       /**< Pointer to the number of nonzeros that \p result has space for. */
+  CMR_CHRMAT* result          /**< Matrix with the same dimensions as \p rowComplement. */
+)
+{
+  assert(cmr);
+  assert(rowComplement);
+  assert(complementColumn < rowComplement->numColumns);
+  assert(columnEntries);
+  assert(pmemNonzeros);
+  assert(result);
+
+  size_t numRows = rowComplement->numRows;
+  size_t numColumns = rowComplement->numColumns;
+  bool complementRowColumn1 = complementRow < SIZE_MAX && columnEntries[complementRow];
+
+  /* Count the nonzeros, making space if necessary. */
+  size_t numNonzeros = 0;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    size_t length = rowComplement->rowSlice[row + 1] - rowComplement->rowSlice[row];
+    bool complement = (row == complementRow) ? complementRowColumn1 : (complementRowColumn1 != columnEntries[row]);
+    numNonzeros += complement ? numColumns + 1 - length : length;
+  }
+  if (numNonzeros > *pmemNonzeros)
+  {
+    CMR_CALL( CMRchrmatChangeNumNonzeros(cmr, result, numNonzeros) );
+    for (size_t e = *pmemNonzeros; e < numNonzeros; ++e)
+      result->entryValues[e] = 1;
+    *pmemNonzeros = numNonzeros;
+  }
+  result->numNonzeros = numNonzeros;
+
+  size_t resultEntry = 0;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    result->rowSlice[row] = resultEntry;
+    size_t entry = rowComplement->rowSlice[row];
+    size_t beyond = rowComplement->rowSlice[row + 1];
+    bool complement = (row == complementRow) ? complementRowColumn1 : (complementRowColumn1 != columnEntries[row]);
+    if (complement)
+    {
+      for (size_t column = 0; column < numColumns; ++column)
       {
-        if (resultEntry == memNonzeros)
+        if (entry < beyond && rowComplement->entryColumns[entry] == column)
         {
-          memNonzeros *= 2;
-          CMR_CALL( CMRreallocBlockArray(cmr, &result->entryColumns, memNonzeros) );
+          ++entry;
+          if (column != complementColumn)
+            continue;
         }
         result->entryColumns[resultEntry++] = column;
       }
     }
-    result->rowSlice[row + 1] = resultEntry;
+    else
+    {
+      for (; entry < beyond; ++entry)
+        result->entryColumns[resultEntry++] = rowComplement->entryColumns[entry];
+    }
   }
+  result->rowSlice[numRows] = resultEntry;
+  assert(resultEntry == numNonzeros);
 
-  /* Finalize the size of entryColumns, allocate entryValues for the first time and fill the latter with 1s. */
+  return CMR_OKAY;
+}
 
-  if (resultEntry < memNonzeros)
-    CMR_CALL( CMRchrmatChangeNumNonzeros(cmr, result, resultEntry) );
-  for (size_t e = 0; e < resultEntry; ++e)
-    result->entryValues[e] = 1;
+CMR_ERROR CMRcomplementRowColumn(CMR* cmr, CMR_CHRMAT* matrix, size_t complementRow, size_t complementColumn,
+  CMR_CHRMAT** presult)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(complementRow < matrix->numRows || complementRow == SIZE_MAX);
+  assert(complementColumn < matrix->numColumns || complementColumn == SIZE_MAX);
+  assert(presult);
+
+  /* We copy directly if no complementing is requested. */
+
+  if (complementRow == SIZE_MAX && complementColumn == SIZE_MAX)
+  {
+    CMR_CALL( CMRchrmatCopy(cmr, matrix, presult) );
 
-  CMR_CALL( CMRfreeStackArray(cmr, &complementRowEntries) );
-  CMR_CALL( CMRfreeStackArray(cmr, &complementColumnEntries) );
+    return CMR_OKAY;
+  }
+
+  CMR_CHRMAT* rowComplement = NULL;
+  CMR_CALL( createRowComplement(cmr, matrix, complementRow, &rowComplement) );
+  if (complementColumn == SIZE_MAX)
+  {
+    *presult = rowComplement;
+    return CMR_OKAY;
+  }
+
+  char* columnEntries = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnEntries, matrix->numRows) );
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    size_t e;
+    CMR_CALL( CMRchrmatFindEntry(matrix, row, complementColumn, &e) );
+    columnEntries[row] = (e == SIZE_MAX) ? 0 : 1;
+  }
+
+  size_t memNonzeros = rowComplement->numNonzeros;
+  CMR_CALL( CMRchrmatCreate(cmr, presult, matrix->numRows, matrix->numColumns, memNonzeros) );
+  for (size_t e = 0; e < memNonzeros; ++e)
+    (*presult)->entryValues[e] = 1;
+  CMR_CALL( complementColumnFromBase(cmr, rowComplement, complementRow, complementColumn, columnEntries, &memNonzeros,
+    *presult) );
+
+  CMR_CALL( CMRfreeStackArray(cmr, &columnEntries) );
+  CMR_CALL( CMRchrmatFree(cmr, &rowComplement) );
 
   return CMR_OKAY;
 }
 
-CMR_ERROR CMRtestComplementTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool* pisComplementTotallyUnimodular,
-  size_t* pcomplementRow, size_t* pcomplementColumn, CMR_CTU_STATISTICS* stats)
+/**
+ * \brief Data of a task that tests all complements of one row.
+ */
+
+typedef struct
+{
+  CMR_CHRMAT* matrix;       /**< \brief Input matrix (shared). */
+  CMR_CHRMAT* transpose;    /**< \brief Transpose of the input matrix (shared). */
+  size_t complementRow;     /**< \brief Row to be complemented; number of rows for none. */
+  bool tested;              /**< \brief Whether the task was actually executed. */
+  CMR_TU_STATISTICS stats;  /**< \brief Statistics of this task; merged into the caller's afterwards. */
+  bool collectStats;        /**< \brief Whether \ref stats shall be collected. */
+  size_t* pfirstViolation;  /**< \brief Smallest index of a complement known to be non-totally unimodular (shared). */
+  CMR_TASK_GROUP* groups;   /**< \brief Array with the task group of each row (shared). */
+  size_t numTasks;          /**< \brief Length of \ref groups. */
+} ComplementRowTask;
+
+/**
+ * \brief Task function that tests the complements of one row with each column for total unimodularity.
+ *
+ * The complement of row \f$ r \f$ and column \f$ c \f$ has index \f$ r (n+1) + c \f$. Complements whose index exceeds
+ * that of a known non-totally unimodular one are skipped. If a non-totally unimodular complement is found, then the
+ * tasks of all later rows are cancelled.
+ *
+ * The row complement is computed once and each column complement is derived from it. All tests for total
+ * unimodularity share the deadline of the environment.
+ */
+
+static
+CMR_ERROR testComplementRowTask(
+  CMR* cmr,   /**< \ref CMR environment of the executing thread. */
+  void* data  /**< Pointer to \ref ComplementRowTask. */
+)
+{
+  ComplementRowTask* task = (ComplementRowTask*) data;
+  CMR_CHRMAT* matrix = task->matrix;
+  size_t numRows = matrix->numRows;
+  size_t numColumns = matrix->numColumns;
+  size_t complementRow = task->complementRow < numRows ? task->complementRow : SIZE_MAX;
+
+  task->tested = true;
+  if (__atomic_load_n(task->pfirstViolation, __ATOMIC_ACQUIRE) < task->complementRow * (numColumns + 1))
+    return CMR_OKAY;
+
+  CMR_CHRMAT* rowComplement = NULL;
+  CMR_CALL( createRowComplement(cmr, matrix, complementRow, &rowComplement) );
+
+  /* Each task has its own scratch matrix. */
+  char* columnEntries = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnEntries, numRows) );
+  for (size_t row = 0; row < numRows; ++row)
+    columnEntries[row] = 0;
+  size_t memNonzeros = rowComplement->numNonzeros;
+  CMR_CHRMAT* complemented = NULL;
+  CMR_CALL( CMRchrmatCreate(cmr, &complemented, numRows, numColumns, memNonzeros) );
+  for (size_t e = 0; e < memNonzeros; ++e)
+    complemented->entryValues[e] = 1;
+
+  CMR_ERROR error = CMR_OKAY;
+  for (size_t complementColumn = 0; complementColumn <= numColumns; ++complementColumn)
+  {
+    size_t index = task->complementRow * (numColumns + 1) + complementColumn;
+    if (index > __atomic_load_n(task->pfirstViolation, __ATOMIC_ACQUIRE) || CMRtaskIsCancelled(cmr))
+      break;
+
+    if (CMRdeadlineExpired(cmr))
+    {
+      error = CMR_ERROR_TIMEOUT;
+      break;
+    }
+
+    CMR_CHRMAT* testMatrix = rowComplement;
+    if (complementColumn < numColumns)
+    {
+      CMR_CHRMAT* transpose = task->transpose;
+      size_t first = transpose->rowSlice[complementColumn];
+      size_t beyond = transpose->rowSlice[complementColumn + 1];
+      for (size_t entry = first; entry < beyond; ++entry)
+        columnEntries[transpose->entryColumns[entry]] = 1;
+      error = complementColumnFromBase(cmr, rowComplement, complementRow, complementColumn, columnEntries,
+        &memNonzeros, complemented);
+      for (size_t entry = first; entry < beyond; ++entry)
+        columnEntries[transpose->entryColumns[entry]] = 0;
+      if (error != CMR_OKAY)
+        break;
+      testMatrix = complemented;
+    }
+
+    bool isTU = false;
+    error = CMRtestTotalUnimodularity(cmr, testMatrix, &isTU, NULL, NULL, NULL,
+      task->collectStats ? &task->stats : NULL, DBL_MAX);
+    if (error != CMR_OKAY)
+      break;
+
+    /* The result of a cancelled test is meaningless, but then an earlier complement is not totally unimodular. */
+    if (CMRtaskIsCancelled(cmr))
+      break;
+
+    if (!isTU)
+    {
+      size_t firstViolation = __atomic_load_n(task->pfirstViolation, __ATOMIC_ACQUIRE);
+      while (index < firstViolation && !__atomic_compare_exchange_n(task->pfirstViolation, &firstViolation, index,
+        false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+      for (size_t t = task->complementRow + 1; t < task->numTasks; ++t)
+        CMRtaskGroupCancel(&task->groups[t]);
+      break;
+    }
+  }
+
+  CMR_CALL( CMRchrmatFree(cmr, &complemented) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnEntries) );
+  CMR_CALL( CMRchrmatFree(cmr, &rowComplement) );
+
+  return error;
+}
+
+/**
+ * \brief Carries out \ref CMRtestComplementTotalUnimodularity once its deadline was set.
+ */
+
+static
+CMR_ERROR testComplementTotalUnimodularity(
+  CMR* cmr,                             /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,                   /**< Matrix \f$ M \f$. */
+  bool* pisComplementTotallyUnimodular, /**< Pointer for storing whether \f$ M \f$ is complement TU. */
+  size_t* pcomplementRow,               /**< Pointer for storing the row of a bad complement (may be \c NULL). */
+  size_t* pcomplementColumn,            /**< Pointer for storing the column of a bad complement (may be \c NULL). */
+  CMR_CTU_STATISTICS* stats             /**< Statistics for the computation (may be \c NULL). */
+)
 {
   assert(cmr);
   CMRconsistencyAssert( CMRchrmatConsistency(matrix) );
@@ -177,98 +402,78 @@ CMR_ERROR CMRtestComplementTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool
   clock_t totalClock = 0;
   if (stats)
     totalClock = clock();
-  
-  /* Create a dense version on the stack. */
+
+  /* The transpose yields the entries of the complemented columns. */
 
   size_t numRows = matrix->numRows;
   size_t numColumns = matrix->numColumns;
-  char* dense = NULL;
-  size_t sizeDense = numRows * numColumns;
-  CMR_CALL( CMRallocStackArray(cmr, &dense, sizeDense) );
-  for (size_t i = 0; i < sizeDense; ++i)
-    dense[i] = 0;
-  for (size_t row = 0; row < numRows; ++row)
+  CMR_CHRMAT* transpose = NULL;
+  CMR_CALL( CMRchrmatTranspose(cmr, matrix, &transpose) );
+
+  /* The complements of each row are tested by one task. Each task has its own group such that it can cancel the
+   * tasks of the later rows. */
+
+  size_t numTasks = numRows + 1;
+  size_t firstViolation = SIZE_MAX;
+  ComplementRowTask* tasks = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &tasks, numTasks) );
+  CMR_TASK_GROUP* groups = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &groups, numTasks) );
+  for (size_t t = 0; t < numTasks; ++t)
   {
-    size_t first = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row + 1];
-    for (size_t entry = first; entry < beyond; ++entry)
-      dense[numColumns * row + matrix->entryColumns[entry]] = matrix->entryValues[entry];
+    CMR_CALL( CMRtaskGroupInit(cmr, &groups[t]) );
+    ComplementRowTask* task = &tasks[t];
+    task->matrix = matrix;
+    task->transpose = transpose;
+    task->complementRow = t;
+    task->tested = false;
+    task->collectStats = stats;
+    if (stats)
+      CMR_CALL( CMRstatsTotalUnimodularityInit(&task->stats) );
+    task->pfirstViolation = &firstViolation;
+    task->groups = groups;
+    task->numTasks = numTasks;
   }
 
-  /* Create complemented matrices and call test for total unimodularity. */
-  CMR_CHRMAT* complementedMatrix = NULL;
-  CMR_CALL( CMRchrmatCreate(cmr, &complementedMatrix, numRows, numColumns, sizeDense) );
-  for (size_t i = 0; i < sizeDense; ++i)
-    complementedMatrix->entryValues[i] = 1;
-  *pisComplementTotallyUnimodular = true;
-  for (size_t complementRow = 0; complementRow <= numRows && *pisComplementTotallyUnimodular; ++complementRow)
+  CMR_ERROR error = CMR_OKAY;
+  size_t numSpawned = 0;
+  for (; numSpawned < numTasks && error == CMR_OKAY; ++numSpawned)
+    error = CMRtaskSpawn(cmr, &groups[numSpawned], testComplementRowTask, &tasks[numSpawned]);
+
+  /* The tasks refer to this stack frame, so we must wait for all of them, even after an error. */
+  for (size_t t = 0; t < numSpawned; ++t)
   {
-    bool hasComplementRow = complementRow < numRows;
-    for (size_t complementColumn = 0; complementColumn <= numColumns; ++complementColumn)
-    {
-      bool hasComplementColumn = complementColumn < numColumns;
+    if (error != CMR_OKAY)
+      CMRtaskGroupCancel(&groups[t]);
+    CMR_ERROR taskError = CMRtaskWait(cmr, &groups[t]);
+    if (error == CMR_OKAY)
+      error = taskError;
+  }
 
-      /* Indicator for entry in complementRow, complementColumn. */
-      char complementRowColumn1 = hasComplementRow && hasComplementColumn ?
-        dense[numColumns * complementRow + complementColumn] : 0;
+  for (size_t t = 0; t < numTasks && stats; ++t)
+  {
+    if (tasks[t].tested)
+      CMR_CALL( CMRstatsTotalUnimodularityAdd(&stats->tu, &tasks[t].stats) );
+  }
 
-      /* Fill complemented matrix as a sparse char matrix. */
-      complementedMatrix->numNonzeros = 0;
-      complementedMatrix->rowSlice[0] = 0;
-      for (size_t row = 0; row < numRows; ++row)
-      {
-        for (size_t column = 0; column < numColumns; ++column)
-        {
-          bool isNonzero = dense[numColumns * row + column];
-          if (row == complementRow)
-          {
-            if (column != complementColumn && complementRowColumn1)
-              isNonzero = !isNonzero;
-          }
-          else
-          {
-            if (column == complementColumn)
-            {
-              if (complementRowColumn1)
-                isNonzero = !isNonzero;
-            }
-            else
-            {
-              if ((complementRowColumn1 + (hasComplementColumn ? dense[numColumns * row + complementColumn] : 0)
-                + (hasComplementRow ? dense[numColumns * complementRow + column] : 0)) % 2 == 1)
-              {
-                isNonzero = !isNonzero;
-              }
-            }
-          }
-
-          if (isNonzero)
-          {
-            complementedMatrix->entryColumns[complementedMatrix->numNonzeros] = column;
-            complementedMatrix->numNonzeros++;
-          }
-        }
-        complementedMatrix->rowSlice[row + 1] = complementedMatrix->numNonzeros;
-      }
+  CMR_CALL( CMRfreeBlockArray(cmr, &groups) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &tasks) );
+  CMR_CALL( CMRchrmatFree(cmr, &transpose) );
 
-      bool isTU = false;
-      CMR_CALL( CMRtestTotalUnimodularity(cmr, complementedMatrix, &isTU, NULL, NULL, NULL,
-        stats ? &stats->tu : NULL, DBL_MAX) ); /* TODO: Properly deal with time limits. */
-      if (!isTU)
-      {
-        if (pcomplementRow)
-          *pcomplementRow = complementRow;
-        if (pcomplementColumn)
-          *pcomplementColumn = complementColumn;
+  if (error != CMR_OKAY)
+    return error;
 
-        *pisComplementTotallyUnimodular = false;
-        break;
-      }
-    }
+  /* The result is the first non-totally unimodular complement in the order of a sequential sweep. */
+  *pisComplementTotallyUnimodular = firstViolation == SIZE_MAX;
+  if (!*pisComplementTotallyUnimodular)
+  {
+    size_t complementRow = firstViolation / (numColumns + 1);
+    size_t complementColumn = firstViolation % (numColumns + 1);
+    if (pcomplementRow)
+      *pcomplementRow = complementRow < numRows ? complementRow : SIZE_MAX;
+    if (pcomplementColumn)
+      *pcomplementColumn = complementColumn < numColumns ? complementColumn : SIZE_MAX;
   }
-  CMR_CALL( CMRchrmatFree(cmr, &complementedMatrix) );
-
-  CMR_CALL( CMRfreeStackArray(cmr, &dense) );
 
   if (stats)
   {
@@ -278,3 +483,14 @@ CMR_ERROR CMRtestComplementTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool
 
   return CMR_OKAY;
 }
+
+CMR_ERROR CMRtestComplementTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool* pisComplementTotallyUnimodular,
+  size_t* pcomplementRow, size_t* pcomplementColumn, CMR_CTU_STATISTICS* stats, double timeLimit)
+{
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = testComplementTotalUnimodularity(cmr, matrix, pisComplementTotallyUnimodular, pcomplementRow,
+    pcomplementColumn, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  return error;
+}
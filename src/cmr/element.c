@@ -3,7 +3,7 @@
 #include <stdio.h>
 #include <string.h>
 
-static char elementStringBuffer[32];
+static _Thread_local char elementStringBuffer[32]; /**< Per-thread buffer for \ref CMRelementString. */
 
 CMR_EXPORT
 const char* CMRelementString(CMR_ELEMENT element, char* buffer)
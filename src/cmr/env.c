@@ -3,12 +3,21 @@
 // #define REPLACE_STACK_BY_MALLOC /* Uncomment to not use a stack at all, which may help to detect memory corruption. */
 
 #include "env_internal.h"
+#include "threadpool.h"
+#include "result_cache.h"
+#include "graphic_internal.h"
 
 #include <assert.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <float.h>
 #include <stdarg.h>
 #include <string.h>
+#include <time.h>
+
+#if defined(CMR_WITH_MMAP)
+#include <sys/mman.h>
+#endif /* CMR_WITH_MMAP */
 
 static const size_t FIRST_STACK_SIZE = 4096L; /**< Size of the first stack. */
 static const int INITIAL_MEM_STACKS = 16;     /**< Initial number of allocated stacks. */
@@ -17,6 +26,103 @@ static const int INITIAL_MEM_STACKS = 16;     /**< Initial number of allocated s
 static const int PROTECTION = INT_MIN / 42;   /**< Protection bytes to detect corruption. */
 #endif /* !NDEBUG */
 
+/**
+ * \brief Initializes the stack memory of \p cmr, reusing spare stacks of \p parent if possible.
+ */
+
+static
+CMR_ERROR initStacks(
+  CMR* cmr,   /**< \ref CMR environment. */
+  CMR* parent /**< Environment to take spare stacks from, or \c NULL. */
+)
+{
+  CMR_SPARE_STACKS* spare = NULL;
+  if (parent)
+  {
+    while (__atomic_test_and_set(&parent->spareStacksLock, __ATOMIC_ACQUIRE));
+    spare = parent->spareStacks;
+    if (spare)
+      parent->spareStacks = spare->next;
+    __atomic_clear(&parent->spareStacksLock, __ATOMIC_RELEASE);
+  }
+
+  if (spare)
+  {
+    cmr->stacks = spare->stacks;
+    cmr->numStacks = spare->numStacks;
+    cmr->memStacks = spare->memStacks;
+    cmr->graphicWorkspace = spare->graphicWorkspace;
+    cmr->currentStack = 0;
+    free(spare);
+    return CMR_OKAY;
+  }
+
+  cmr->stacks = malloc(INITIAL_MEM_STACKS * sizeof(CMR_STACK));
+  if (!cmr->stacks)
+    return CMR_ERROR_MEMORY;
+  cmr->stacks[0].memory = malloc(FIRST_STACK_SIZE * sizeof(char));
+  if (!cmr->stacks[0].memory)
+  {
+    free(cmr->stacks);
+    return CMR_ERROR_MEMORY;
+  }
+  cmr->stacks[0].top = FIRST_STACK_SIZE;
+  cmr->memStacks = INITIAL_MEM_STACKS;
+  cmr->numStacks = 1;
+  cmr->currentStack = 0;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Frees the stack memory and the graphic workspace of \p cmr or hands them to its parent for reuse.
+ */
+
+static
+CMR_ERROR freeStacks(
+  CMR* cmr  /**< \ref CMR environment. */
+)
+{
+  /* Stacks can only be reused if they are empty. */
+  CMR_SPARE_STACKS* spare = NULL;
+  if (cmr->parent && cmr->currentStack == 0 && cmr->stacks[0].top == FIRST_STACK_SIZE)
+    spare = malloc(sizeof(CMR_SPARE_STACKS));
+
+  if (spare)
+  {
+    spare->stacks = cmr->stacks;
+    spare->numStacks = cmr->numStacks;
+    spare->memStacks = cmr->memStacks;
+    spare->graphicWorkspace = cmr->graphicWorkspace;
+    cmr->graphicWorkspace = NULL;
+    CMR* parent = cmr->parent;
+    while (__atomic_test_and_set(&parent->spareStacksLock, __ATOMIC_ACQUIRE));
+    spare->next = parent->spareStacks;
+    parent->spareStacks = spare;
+    __atomic_clear(&parent->spareStacksLock, __ATOMIC_RELEASE);
+  }
+  else
+  {
+    for (size_t s = 0; s < cmr->numStacks; ++s)
+      free(cmr->stacks[s].memory);
+    free(cmr->stacks);
+    CMR_CALL( CMRgraphicWorkspaceFree(cmr, &cmr->graphicWorkspace) );
+  }
+
+  while (cmr->spareStacks)
+  {
+    spare = cmr->spareStacks;
+    cmr->spareStacks = spare->next;
+    for (size_t s = 0; s < spare->numStacks; ++s)
+      free(spare->stacks[s].memory);
+    free(spare->stacks);
+    CMR_CALL( CMRgraphicWorkspaceFree(cmr, &spare->graphicWorkspace) );
+    free(spare);
+  }
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRcreateEnvironment(CMR** pcmr)
 {
   if (!pcmr)
@@ -31,28 +137,66 @@ CMR_ERROR CMRcreateEnvironment(CMR** pcmr)
   cmr->output = stdout;
   cmr->closeOutput = false;
   cmr->numThreads = 1;
+  cmr->threadPool = NULL;
+  cmr->threadIndex = 0;
+  cmr->ownsThreadPool = false;
+  cmr->taskGroup = NULL;
+  cmr->interrupted = 0;
+  cmr->deadline.time = DBL_MAX;
+  cmr->deadline.pinterrupted = &cmr->interrupted;
   cmr->verbosity = 1;
+  cmr->parent = NULL;
+  cmr->spareStacks = NULL;
+  cmr->spareStacksLock = false;
+  cmr->mappings = NULL;
+  cmr->resultCache = NULL;
+  cmr->graphicWorkspace = NULL;
 
   /* Initialize stack memory. */
-  cmr->stacks = malloc(INITIAL_MEM_STACKS * sizeof(CMR_STACK));
-  if (!cmr->stacks)
+  if (initStacks(cmr, NULL) != CMR_OKAY)
   {
     free(*pcmr);
     *pcmr = NULL;
     return CMR_ERROR_MEMORY;
   }
-  cmr->stacks[0].memory = malloc(FIRST_STACK_SIZE * sizeof(char));
-  if (!cmr->stacks[0].memory)
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRforkEnvironment(CMR* cmr, CMR** pchild)
+{
+  if (!cmr || !pchild)
+    return CMR_ERROR_INPUT;
+
+  *pchild = (CMR*) malloc(sizeof(CMR));
+  CMR* child = *pchild;
+  if (!child)
+    return CMR_ERROR_MEMORY;
+
+  child->errorMessage = NULL;
+  child->output = cmr->output;
+  child->closeOutput = false;
+  child->numThreads = cmr->numThreads;
+  child->threadPool = cmr->threadPool;
+  child->threadIndex = 0;
+  child->ownsThreadPool = false;
+  child->taskGroup = NULL;
+  child->interrupted = 0;
+  child->deadline = cmr->deadline;
+  child->verbosity = cmr->verbosity;
+  child->parent = cmr;
+  child->spareStacks = NULL;
+  child->spareStacksLock = false;
+  child->mappings = NULL;
+  child->resultCache = NULL;
+  child->graphicWorkspace = NULL;
+
+  if (initStacks(child, cmr) != CMR_OKAY)
   {
-    free(cmr->stacks);
-    free(cmr);
-    *pcmr = NULL;
+    free(*pchild);
+    *pchild = NULL;
     return CMR_ERROR_MEMORY;
   }
-  cmr->stacks[0].top = FIRST_STACK_SIZE;
-  cmr->memStacks = INITIAL_MEM_STACKS;
-  cmr->numStacks = 1;
-  cmr->currentStack = 0;
 
   return CMR_OKAY;
 }
@@ -64,21 +208,63 @@ CMR_ERROR CMRfreeEnvironment(CMR** pcmr)
 
   CMR* cmr = *pcmr;
 
+  if (cmr->ownsThreadPool)
+    CMR_CALL( CMRthreadpoolFree(cmr, &cmr->threadPool) );
+
+  CMR_CALL( CMRresultCacheFree(cmr, &cmr->resultCache) );
+
+  /* Matrices that are still mapped were not freed by the caller; their arrays become invalid now. */
+  while (cmr->mappings)
+  {
+    CMR_MAPPING* mapping = cmr->mappings;
+    cmr->mappings = mapping->next;
+#if defined(CMR_WITH_MMAP)
+    munmap(mapping->address, mapping->length);
+#endif /* CMR_WITH_MMAP */
+    CMR_CALL( CMRfreeBlock(cmr, &mapping) );
+  }
+
   if (cmr->errorMessage)
     free(cmr->errorMessage);
 
   if (cmr->closeOutput)
     fclose(cmr->output);
 
-  for (size_t s = 0; s < cmr->numStacks; ++s)
-    free(cmr->stacks[s].memory);
-  free(cmr->stacks);
+  CMR_CALL( freeStacks(cmr) );
   free(*pcmr);
   *pcmr = NULL;
 
   return CMR_OKAY;
 }
 
+CMR_ERROR CMRsetNumThreads(CMR* cmr, int numThreads)
+{
+  assert(cmr);
+
+  if (numThreads < 1)
+    return CMR_ERROR_INPUT;
+
+  /* Environments of pool workers cannot change the pool. */
+  if (cmr->threadPool && !cmr->ownsThreadPool)
+    return CMR_ERROR_INVALID;
+
+  if (cmr->threadPool && numThreads != cmr->numThreads)
+  {
+    CMR_CALL( CMRthreadpoolFree(cmr, &cmr->threadPool) );
+    cmr->ownsThreadPool = false;
+  }
+  cmr->numThreads = numThreads;
+
+  return CMR_OKAY;
+}
+
+int CMRgetNumThreads(CMR* cmr)
+{
+  assert(cmr);
+
+  return cmr->numThreads;
+}
+
 CMR_ERROR _CMRallocBlock(CMR* cmr, void** ptr, size_t size)
 {
   assert(cmr);
@@ -410,3 +596,73 @@ char* CMRconsistencyMessage(const char* format, ...)
 
   return strdup(buffer);
 }
+
+double CMRwallClock(void)
+{
+  struct timespec now;
+#if defined(_WIN32)
+  timespec_get(&now, TIME_UTC);
+#else
+  clock_gettime(CLOCK_MONOTONIC, &now);
+#endif /* _WIN32 */
+
+  return now.tv_sec + now.tv_nsec * 1.0e-9;
+}
+
+double CMRdeadlineEnter(CMR* cmr, double timeLimit)
+{
+  assert(cmr);
+
+  double previous = cmr->deadline.time;
+  if (timeLimit < DBL_MAX)
+  {
+    double deadline = CMRwallClock() + timeLimit;
+    if (deadline < previous)
+      cmr->deadline.time = deadline;
+  }
+
+  return previous;
+}
+
+void CMRdeadlineLeave(CMR* cmr, double previous)
+{
+  assert(cmr);
+
+  cmr->deadline.time = previous;
+}
+
+bool CMRdeadlineExpired(CMR* cmr)
+{
+  assert(cmr);
+
+  if (__atomic_load_n(cmr->deadline.pinterrupted, __ATOMIC_RELAXED))
+    return true;
+
+  return cmr->deadline.time < DBL_MAX && CMRwallClock() > cmr->deadline.time;
+}
+
+double CMRdeadlineRemaining(CMR* cmr)
+{
+  assert(cmr);
+
+  if (__atomic_load_n(cmr->deadline.pinterrupted, __ATOMIC_RELAXED))
+    return 0.0;
+  if (cmr->deadline.time == DBL_MAX)
+    return DBL_MAX;
+
+  return cmr->deadline.time - CMRwallClock();
+}
+
+void CMRinterrupt(CMR* cmr)
+{
+  assert(cmr);
+
+  __atomic_store_n(cmr->deadline.pinterrupted, 1, __ATOMIC_RELAXED);
+}
+
+void CMRclearInterrupt(CMR* cmr)
+{
+  assert(cmr);
+
+  __atomic_store_n(cmr->deadline.pinterrupted, 0, __ATOMIC_RELAXED);
+}
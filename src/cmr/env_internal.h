@@ -41,6 +41,45 @@ typedef struct
   size_t top;   /**< \brief First used byte. */
 } CMR_STACK;
 
+/**
+ * \brief Array of stacks of a freed forked environment, kept by its parent for reuse.
+ */
+
+typedef struct _CMR_SPARE_STACKS
+{
+  CMR_STACK* stacks;              /**< \brief Array of stacks. */
+  size_t numStacks;               /**< \brief Number of allocated stacks in stack array. */
+  size_t memStacks;               /**< \brief Memory for stack array. */
+  struct _CMR_GRAPHIC_WORKSPACE* graphicWorkspace;  /**< \brief Graphic workspace of the freed environment, or \c NULL. */
+  struct _CMR_SPARE_STACKS* next; /**< \brief Next spare stack array. */
+} CMR_SPARE_STACKS;
+
+/**
+ * \brief Memory-mapped file whose contents are referenced by a matrix.
+ */
+
+typedef struct _CMR_MAPPING
+{
+  void* matrix;               /**< \brief Matrix whose arrays point into the mapped memory. */
+  void* address;              /**< \brief Start of the mapped memory. */
+  size_t length;              /**< \brief Length of the mapped memory in bytes. */
+  struct _CMR_MAPPING* next;  /**< \brief Next mapping. */
+} CMR_MAPPING;
+
+/**
+ * \brief Point in time at which the computations carried out with an environment must stop.
+ *
+ * Public functions with a \c timeLimit parameter narrow the deadline via \ref CMRdeadlineEnter for their duration.
+ * Algorithms do not compute remaining times but poll the deadline via \ref CMRdeadlineExpired or, in tight loops, via
+ * \ref CMRdeadlinePoll. Tasks run with the deadline that was in effect when their group was initialized.
+ */
+
+typedef struct
+{
+  double time;        /**< \brief Wall-clock time (see \ref CMRwallClock) at which computations must stop. */
+  int* pinterrupted;  /**< \brief Interrupt flag shared by an environment and all environments forked from it. */
+} CMR_DEADLINE;
+
 struct CMR_ENVIRONMENT
 {
   char* errorMessage;   /**< \brief Error message. */
@@ -49,11 +88,25 @@ struct CMR_ENVIRONMENT
   bool closeOutput;     /**< \brief Whether to close the output stream at the end. */
   int verbosity;        /**< \brief Verbosity level. */
   int numThreads;       /**< \brief Number of threads to use. */
+  struct _CMR_THREADPOOL* threadPool; /**< \brief Thread pool for parallel tasks (\c NULL if not yet created). */
+  size_t threadIndex;   /**< \brief Index of the worker of \ref threadPool that uses this environment. */
+  bool ownsThreadPool;  /**< \brief Whether \ref threadPool is freed together with this environment. */
+  struct _CMR_TASK_GROUP* taskGroup;  /**< \brief Group of the task currently executed with this environment. */
+  CMR_DEADLINE deadline;  /**< \brief Deadline of the current computation. */
+  int interrupted;      /**< \brief Interrupt flag referred to by the deadlines of this environment and its children. */
 
   size_t numStacks;     /**< \brief Number of allocated stacks in stack array. */
   size_t memStacks;     /**< \brief Memory for stack array. */
   size_t currentStack;  /**< \brief Index of last used stack. */
   CMR_STACK* stacks;     /**< \brief Array of stacks. */
+
+  struct CMR_ENVIRONMENT* parent;   /**< \brief Environment this one was forked from, or \c NULL. */
+  CMR_SPARE_STACKS* spareStacks;    /**< \brief Stacks of freed forked environments. */
+  bool spareStacksLock;             /**< \brief Spin lock protecting \ref spareStacks. */
+
+  CMR_MAPPING* mappings;            /**< \brief Memory-mapped files of matrices created with this environment. */
+  struct _CMR_RESULT_CACHE* resultCache;  /**< \brief Cache of test results, or \c NULL; unused if forked. */
+  struct _CMR_GRAPHIC_WORKSPACE* graphicWorkspace;  /**< \brief Memory reused by (co)graphicness tests, or \c NULL. */
 };
 
 #include <cmr/env.h>
@@ -147,6 +200,76 @@ size_t CMRgetStackUsage(
   CMR* cmr  /**< \ref CMR environment. */
 );
 
+/**
+ * \brief Returns the current time in seconds according to a monotonic wall clock.
+ *
+ * Only differences of returned values are meaningful. In contrast to \c clock(), which measures the processor time of
+ * all threads, this is suitable for time limits of parallel computations.
+ */
+
+double CMRwallClock(void);
+
+/**
+ * \brief Narrows the deadline of \p cmr to at most \p timeLimit seconds from now.
+ *
+ * Returns the previous deadline, which must be restored via \ref CMRdeadlineLeave before returning, also on errors.
+ */
+
+double CMRdeadlineEnter(
+  CMR* cmr,         /**< \ref CMR environment. */
+  double timeLimit  /**< Time limit in seconds. */
+);
+
+/**
+ * \brief Restores the deadline of \p cmr that was returned by \ref CMRdeadlineEnter.
+ */
+
+void CMRdeadlineLeave(
+  CMR* cmr,         /**< \ref CMR environment. */
+  double previous   /**< Deadline returned by \ref CMRdeadlineEnter. */
+);
+
+/**
+ * \brief Returns \c true if the deadline of \p cmr has passed or if \ref CMRinterrupt was called.
+ */
+
+bool CMRdeadlineExpired(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
+/**
+ * \brief Returns the number of seconds until the deadline of \p cmr.
+ *
+ * This is meant for calling public functions with a \c timeLimit parameter from within the library.
+ */
+
+double CMRdeadlineRemaining(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
+#define CMR_DEADLINE_POLL_INTERVAL 64 /**< Number of calls of \ref CMRdeadlinePoll per reading of the clock. */
+
+/**
+ * \brief Amortized variant of \ref CMRdeadlineExpired for tight loops.
+ *
+ * Only every \ref CMR_DEADLINE_POLL_INTERVAL calls with the same counter \p *pcounter read the clock; the interrupt
+ * flag is cheap and checked on every call.
+ */
+
+static inline
+bool CMRdeadlinePoll(
+  CMR* cmr,         /**< \ref CMR environment. */
+  size_t* pcounter  /**< Pointer to a counter of the calling loop, initialized with 0. */
+)
+{
+  if (__atomic_load_n(cmr->deadline.pinterrupted, __ATOMIC_RELAXED))
+    return true;
+  if (++(*pcounter) < CMR_DEADLINE_POLL_INTERVAL)
+    return false;
+  *pcounter = 0;
+  return CMRdeadlineExpired(cmr);
+}
+
 char* CMRconsistencyMessage(const char* format, ...);
 
 #if !defined(NDEBUG)
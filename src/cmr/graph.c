@@ -41,7 +41,7 @@ void CMRgraphEnsureConsistent(CMR* cmr, CMR_GRAPH* graph)
 
   /* Count free nodes. */
 
-  int countFree = 0;
+  size_t countFree = 0;
   CMR_GRAPH_NODE v = graph->freeNode;
   while (isValid(v))
   {
@@ -73,7 +73,7 @@ void CMRgraphEnsureConsistent(CMR* cmr, CMR_GRAPH* graph)
   assert(countIncident + countLoops == 2 * graph->numEdges);
 
   countFree = 0;
-  int e = graph->freeEdge;
+  CMR_GRAPH_EDGE e = graph->freeEdge;
 
   CMRdbgMsg(0, "freeEdge = %d\n", e);
 
@@ -88,22 +88,26 @@ void CMRgraphEnsureConsistent(CMR* cmr, CMR_GRAPH* graph)
   CMRdbgMsg(0, "Consistency checked.\n");
 }
 
-CMR_ERROR CMRgraphCreateEmpty(CMR* cmr, CMR_GRAPH** pgraph, int memNodes, int memEdges)
+CMR_ERROR CMRgraphCreateEmpty(CMR* cmr, CMR_GRAPH** pgraph, size_t memNodes, size_t memEdges)
 {
   assert(cmr);
   assert(pgraph);
   assert(*pgraph == NULL);
 
+  /* Arc 2e+1 of edge e must be representable. */
+  if (memNodes > CMR_GRAPH_INDEX_MAX || memEdges > CMR_GRAPH_INDEX_MAX / 2)
+    return CMR_ERROR_OVERFLOW;
+
   CMR_CALL( CMRallocBlock(cmr, pgraph) );
   CMR_GRAPH* graph = *pgraph;
   graph->numNodes = 0;
-  if (memNodes <= 0)
+  if (memNodes == 0)
     memNodes = 1;
   graph->memNodes = memNodes;
   graph->nodes = NULL;
   CMR_CALL( CMRallocBlockArray(cmr, &graph->nodes, memNodes) );
   graph->numEdges = 0;
-  if (memEdges <= 0)
+  if (memEdges == 0)
     memEdges = 1;
   graph->memEdges = memEdges;
   graph->arcs = NULL;
@@ -186,10 +190,14 @@ CMR_ERROR CMRgraphAddNode(CMR* cmr, CMR_GRAPH *graph, CMR_GRAPH_NODE* pnode)
   /* If the free list is empty, we have reallocate. */
   if (!isValid(graph->freeNode))
   {
-    int mem = (graph->memNodes < 256 ? 0 : 256) + 2 * graph->memNodes;
+    if (graph->memNodes >= CMR_GRAPH_INDEX_MAX)
+      return CMR_ERROR_OVERFLOW;
+    size_t mem = (graph->memNodes < 256 ? 0 : 256) + 2 * graph->memNodes;
+    if (mem > CMR_GRAPH_INDEX_MAX)
+      mem = CMR_GRAPH_INDEX_MAX;
     CMR_CALL( CMRreallocBlockArray(cmr, &graph->nodes, mem) );
     assert(graph->nodes);
-    for (int v = graph->memNodes; v < mem-1; ++v)
+    for (size_t v = graph->memNodes; v < mem-1; ++v)
       graph->nodes[v].next = v+1;
     graph->nodes[mem-1].next = -1;
     graph->freeNode = graph->memNodes;
@@ -235,10 +243,14 @@ CMR_ERROR CMRgraphAddEdge(CMR* cmr, CMR_GRAPH* graph, CMR_GRAPH_NODE u, CMR_GRAP
 
   if (!isValid(graph->freeEdge))
   {
-    int newMemEdges = (graph->memEdges < 1024 ? 0 : 1024) + 2 * graph->memEdges;
+    if (graph->memEdges >= CMR_GRAPH_INDEX_MAX / 2)
+      return CMR_ERROR_OVERFLOW;
+    size_t newMemEdges = (graph->memEdges < 1024 ? 0 : 1024) + 2 * graph->memEdges;
+    if (newMemEdges > CMR_GRAPH_INDEX_MAX / 2)
+      newMemEdges = CMR_GRAPH_INDEX_MAX / 2;
     CMR_CALL( CMRreallocBlockArray(cmr, &graph->arcs, 2*newMemEdges) );
     assert(graph->arcs);
-    for (int e = graph->memEdges; e < newMemEdges-1; ++e)
+    for (size_t e = graph->memEdges; e < newMemEdges-1; ++e)
       graph->arcs[2*e].next = (e+1);
     graph->arcs[2*newMemEdges-2].next = -1;
     graph->freeEdge = graph->memEdges;
@@ -248,14 +260,14 @@ CMR_ERROR CMRgraphAddEdge(CMR* cmr, CMR_GRAPH* graph, CMR_GRAPH_NODE u, CMR_GRAP
   /* Add to list. */
 
   CMR_GRAPH_EDGE edge = graph->freeEdge;
-  int arc = 2*edge;
+  CMR_GRAPH_INDEX arc = 2*edge;
   graph->freeEdge = graph->arcs[arc].next;
   graph->numEdges++;
 
   /* Add arc to list of outgoing arcs from u. */
 
   graph->arcs[arc].target = v;
-  int firstOut = graph->nodes[u].firstOut;
+  CMR_GRAPH_INDEX firstOut = graph->nodes[u].firstOut;
   graph->arcs[arc].prev = -1;
   graph->arcs[arc].next = firstOut;
   if (isValid(firstOut))
@@ -328,7 +340,7 @@ CMR_ERROR CMRgraphDeleteEdge(CMR* cmr, CMR_GRAPH* graph, CMR_GRAPH_EDGE e)
 
   assert(isValid(e));
 
-  int arc = 2*e;
+  CMR_GRAPH_INDEX arc = 2*e;
   CMR_GRAPH_NODE u = graph->arcs[arc+1].target;
   CMR_GRAPH_NODE v = graph->arcs[arc].target;
 
@@ -380,11 +392,11 @@ CMR_ERROR CMRgraphPrint(FILE* stream, CMR_GRAPH* graph)
   printf("Graph with %ld nodes and %ld edges.\n", CMRgraphNumNodes(graph), CMRgraphNumEdges(graph));
   for (CMR_GRAPH_NODE v = CMRgraphNodesFirst(graph); CMRgraphNodesValid(graph, v); v = CMRgraphNodesNext(graph, v))
   {
-    fprintf(stream, "Node %d:\n", v);
+    fprintf(stream, "Node %ld:\n", (long) v);
     for (CMR_GRAPH_ITER i = CMRgraphIncFirst(graph, v); CMRgraphIncValid(graph, i); i = CMRgraphIncNext(graph, i))
     {
-      fprintf(stream, "  Edge %d: {%d,%d} {arc = %d}\n", CMRgraphIncEdge(graph, i), CMRgraphIncSource(graph, i),
-        CMRgraphIncTarget(graph, i), i);
+      fprintf(stream, "  Edge %ld: {%ld,%ld} {arc = %ld}\n", (long) CMRgraphIncEdge(graph, i),
+        (long) CMRgraphIncSource(graph, i), (long) CMRgraphIncTarget(graph, i), (long) i);
     }
   }
 
@@ -402,7 +414,7 @@ CMR_ERROR CMRgraphMergeNodes(CMR* cmr, CMR_GRAPH* graph, CMR_GRAPH_NODE u, CMR_G
   assert(v < (long) graph->memNodes);
   assert(u != v);
 
-  int a;
+  CMR_GRAPH_INDEX a;
   while ((a = graph->nodes[v].firstOut) >= 0)
   {
     graph->nodes[v].firstOut = graph->arcs[a].next;
@@ -514,7 +526,7 @@ CMR_ERROR CMRgraphCreateFromEdgeList(CMR* cmr, CMR_GRAPH** pgraph, CMR_ELEMENT**
       /* Add node label. */
       if (pnodeLabels)
       {
-        if (uNode >= (int)memNodeLabels)
+        if ((size_t) uNode >= memNodeLabels)
         {
           memNodeLabels *= 2;
           CMR_CALL( CMRreallocBlockArray(cmr, pnodeLabels, memNodeLabels) );
@@ -538,7 +550,7 @@ CMR_ERROR CMRgraphCreateFromEdgeList(CMR* cmr, CMR_GRAPH** pgraph, CMR_ELEMENT**
       /* Add node label. */
       if (pnodeLabels)
       {
-        if (vNode >= (int)memNodeLabels)
+        if ((size_t) vNode >= memNodeLabels)
         {
           memNodeLabels *= 2;
           CMR_CALL( CMRreallocBlockArray(cmr, pnodeLabels, memNodeLabels) );
@@ -569,13 +581,13 @@ CMR_ERROR CMRgraphCreateFromEdgeList(CMR* cmr, CMR_GRAPH** pgraph, CMR_ELEMENT**
 
     if (pedgeElements)
     {
-      if (edge >= (int)memEdgeElements)
+      if ((size_t) edge >= memEdgeElements)
       {
         do
         {
           memEdgeElements *= 2;
         }
-        while (edge >= (int)memEdgeElements);
+        while ((size_t) edge >= memEdgeElements);
         CMR_CALL( CMRreallocBlockArray(cmr, pedgeElements, memEdgeElements) );
       }
 
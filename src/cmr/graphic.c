@@ -5,6 +5,7 @@
 #include <cmr/graphic.h>
 
 #include "env_internal.h"
+#include "graphic_internal.h"
 #include "matrix_internal.h"
 #include "one_sum.h"
 #include "heap.h"
@@ -74,10 +75,10 @@ typedef enum
 
 typedef struct
 {
-  DIJKSTRA_STAGE stage;     /**< \brief At which stage of the algorithm is this node? */
-  int predecessor;          /**< \brief Predecessor node in shortest-path branching, or -1 for a root. */
-  CMR_GRAPH_EDGE rootEdge;  /**< \brief The actual edge towards the predecessor, or -1 for a root./ */
-  bool reversed;            /**< \brief Whether the edge towards the predecessor is reversed. */
+  DIJKSTRA_STAGE stage;       /**< \brief At which stage of the algorithm is this node? */
+  CMR_GRAPH_NODE predecessor; /**< \brief Predecessor node in shortest-path branching, or -1 for a root. */
+  CMR_GRAPH_EDGE rootEdge;    /**< \brief The actual edge towards the predecessor, or -1 for a root./ */
+  bool reversed;              /**< \brief Whether the edge towards the predecessor is reversed. */
 } DijkstraNodeData;
 
 CMR_ERROR CMRcomputeRepresentationMatrix(CMR* cmr, CMR_GRAPH* digraph, bool ternary, CMR_CHRMAT** ptranspose,
@@ -437,6 +438,24 @@ typedef struct
   DEC_NODE representativeNode;  /**< \brief Next representative of same node towards root, or -1 if root. */
 } DecNodeData;
 
+/**
+ * \brief Data of an edge that is accessed when traversing the decomposition.
+ *
+ * The remaining data is stored separately in \ref DecEdgeInfo such that more edges fit into a cache line.
+ */
+
+typedef struct
+{
+  DEC_MEMBER member;      /**< \brief Member this edge belongs to or -1 if in free list. */
+  DEC_NODE head;          /**< \brief Head node of this edge for a rigid member, -1 otherwise. */
+  DEC_NODE tail;          /**< \brief Tail node of this edge for a rigid member, -1 otherwise. */
+  DEC_EDGE next;          /**< \brief Next edge of this member. */
+} DecEdgeData;
+
+/**
+ * \brief Data of an edge that is only accessed when modifying the decomposition or for specific edges.
+ */
+
 typedef struct
 {
   CMR_ELEMENT element;    /**< \brief Element corresponding to this edge.
@@ -444,19 +463,13 @@ typedef struct
                            * 1, 2, ..., m indicate rows, -1,-2, ..., -n indicate columns,
                            * and for (small) k >= 0, MAX_INT-k and -MAX_INT+k indicate
                            * markers of the parent and to the parent, respectively. */
-  DEC_MEMBER member;      /**< \brief Member this edge belongs to or -1 if in free list. */
-  DEC_NODE head;          /**< \brief Head node of this edge for a rigid member, -1 otherwise. */
-  DEC_NODE tail;          /**< \brief Tail node of this edge for a rigid member, -1 otherwise. */
-  DEC_EDGE prev;          /**< \brief Next edge of this member. */
-  DEC_EDGE next;          /**< \brief Previous edge of this member. */
+  DEC_EDGE prev;          /**< \brief Previous edge of this member. */
   DEC_MEMBER childMember; /**< \brief Child member linked to this edge, or -1. */
-} DecEdgeData;
+} DecEdgeInfo;
 
 typedef struct
 {
   DEC_MEMBER_TYPE type;                 /**< \brief Type of member. Only valid for representative member. */
-  DEC_MEMBER representativeMember;      /**< \brief Representative of member, or -1 if this is a representative member. */
-  DEC_MEMBER parentMember;              /**< \brief Parent member of this member or -1 for a root. Only valid for representative member. */
   int numEdges;                         /**< \brief Number of edges. Only valid for representative member. */
   DEC_EDGE markerToParent;              /**< \brief Parent marker edge. Only valid for representative member. */
   DEC_EDGE markerOfParent;              /**< \brief Child marker of parent to which this member is linked. Only valid if root representative. */
@@ -474,6 +487,65 @@ typedef struct
   DEC_EDGE edge;  /**< \brief Edge corresponding to this column or -1. */
 } DecColumnData;
 
+/**
+ * \brief Type of a record in the undo log of a decomposition.
+ */
+
+typedef enum
+{
+  DEC_UNDO_MEMBER = 0,  /**< \brief Previous data of a member. */
+  DEC_UNDO_EDGE = 1,    /**< \brief Previous data of an edge. */
+  DEC_UNDO_NODE = 2     /**< \brief Previous data of a node. */
+} DEC_UNDO_TYPE;
+
+/**
+ * \brief Record in the undo log of a decomposition, storing the data of a member, edge or node before it was modified.
+ */
+
+typedef struct
+{
+  DEC_UNDO_TYPE type;         /**< \brief Type of the modified object. */
+  size_t index;               /**< \brief Index of the modified member, edge or node. */
+  union
+  {
+    struct
+    {
+      DEC_MEMBER_DATA data;             /**< \brief Previous data of the member. */
+      DEC_MEMBER representativeMember;  /**< \brief Previous representative of the member. */
+      DEC_MEMBER parentMember;          /**< \brief Previous parent of the member. */
+    } member;
+    struct
+    {
+      DecEdgeData data;                 /**< \brief Previous data of the edge. */
+      DecEdgeInfo info;                 /**< \brief Previous additional data of the edge. */
+    } edge;
+    DecNodeData node;                   /**< \brief Previous data of the node. */
+  } data;
+} DecUndo;
+
+/**
+ * \brief Checkpoint of a decomposition to which it can be rolled back.
+ *
+ * Besides the length of the undo log it stores all counters of the decomposition.
+ */
+
+typedef struct
+{
+  size_t stamp;                     /**< \brief Unique stamp of the checkpoint. */
+  size_t numUndos;                  /**< \brief Length of the undo log when the checkpoint was created. */
+  size_t numMembers;                /**< \brief Number of members. */
+  size_t memEdges;                  /**< \brief Allocated memory for edges. */
+  size_t numEdges;                  /**< \brief Number of used edges. */
+  DEC_EDGE firstFreeEdge;           /**< \brief First edge in free list or -1. */
+  size_t memNodes;                  /**< \brief Allocated memory for nodes. */
+  size_t numNodes;                  /**< \brief Number of nodes. */
+  DEC_NODE firstFreeNode;           /**< \brief First node in free list or -1. */
+  size_t numRows;                   /**< \brief Number of rows. */
+  size_t numColumns;                /**< \brief Number of columns. */
+  size_t numMarkerPairs;            /**< \brief Number of marker edge pairs in t-decomposition. */
+  size_t parallelParentChildVisit;  /**< \brief Visit counter for \ref parallelParentChildCheckReducedMembers. */
+} DecCheckpoint;
+
 typedef struct
 {
   CMR* cmr;                         /**< \brief \ref CMR environment. */
@@ -481,10 +553,13 @@ typedef struct
   size_t memMembers;                /**< \brief Allocated memory for members. */
   size_t numMembers;                /**< \brief Number of members. */
   DEC_MEMBER_DATA* members;         /**< \brief Array of members. */
+  DEC_MEMBER* representatives;      /**< \brief Representative of each member, or -1 for a representative member. */
+  DEC_MEMBER* parentMembers;        /**< \brief Parent member of each representative member, or -1 for a root. */
 
   size_t memEdges;                  /**< \brief Allocated memory for edges. */
   size_t numEdges;                  /**< \brief Number of used edges. */
   DecEdgeData* edges;               /**< \brief Array of edges. */
+  DecEdgeInfo* edgeInfo;            /**< \brief Array of additional data of edges; see \ref DecEdgeInfo. */
   DEC_EDGE firstFreeEdge;           /**< \brief First edge in free list or -1. */
 
   size_t memNodes;                  /**< \brief Allocated memory for nodes. */
@@ -502,8 +577,153 @@ typedef struct
 
   size_t numMarkerPairs;            /**< \brief Number of marker edge pairs in t-decomposition. */
   size_t parallelParentChildVisit;  /**< \brief Visit counter for \ref parallelParentChildCheckReducedMembers. */
+
+  size_t memUndos;                  /**< \brief Allocated memory for \c undos. */
+  size_t numUndos;                  /**< \brief Length of the undo log. */
+  DecUndo* undos;                   /**< \brief Undo log; only written while there is a checkpoint. */
+
+  size_t memCheckpoints;            /**< \brief Allocated memory for \c checkpoints. */
+  size_t numCheckpoints;            /**< \brief Number of checkpoints. */
+  DecCheckpoint* checkpoints;       /**< \brief Stack of checkpoints. */
+  size_t lastStamp;                 /**< \brief Stamp of the most recently created checkpoint. */
+  size_t memMemberStamps;           /**< \brief Allocated memory for \c memberStamps. */
+  size_t* memberStamps;             /**< \brief Stamp of the checkpoint for which each member was last logged. */
+  size_t memEdgeStamps;             /**< \brief Allocated memory for \c edgeStamps. */
+  size_t* edgeStamps;               /**< \brief Stamp of the checkpoint for which each edge was last logged. */
+  size_t memNodeStamps;             /**< \brief Allocated memory for \c nodeStamps. */
+  size_t* nodeStamps;               /**< \brief Stamp of the checkpoint for which each node was last logged. */
 } Dec;
 
+/**
+ * \brief Enlarges the undo log of \p dec.
+ */
+
+static
+CMR_ERROR enlargeUndos(
+  Dec* dec  /**< Decomposition. */
+)
+{
+  assert(dec);
+
+  dec->memUndos = 2 * dec->memUndos + 256;
+  CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->undos, dec->memUndos) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Returns \c true if an object of \p dec can be logged without enlarging the undo log.
+ */
+
+static inline
+bool undoAvailable(
+  Dec* dec  /**< Decomposition. */
+)
+{
+  assert(dec);
+
+  return dec->numCheckpoints == 0 || dec->numUndos < dec->memUndos;
+}
+
+/**
+ * \brief Records the data of \p member in the undo log of \p dec before it is modified.
+ *
+ * Does nothing if there is no checkpoint, if \p member was created after the last one or if it was already logged
+ * for it.
+ */
+
+static inline
+CMR_ERROR undoMember(
+  Dec* dec,         /**< Decomposition. */
+  DEC_MEMBER member /**< Member that is going to be modified. */
+)
+{
+  assert(dec);
+
+  if (dec->numCheckpoints == 0)
+    return CMR_OKAY;
+  DecCheckpoint* checkpoint = &dec->checkpoints[dec->numCheckpoints - 1];
+  if (member >= checkpoint->numMembers || dec->memberStamps[member] == checkpoint->stamp)
+    return CMR_OKAY;
+  dec->memberStamps[member] = checkpoint->stamp;
+
+  if (dec->numUndos == dec->memUndos)
+    CMR_CALL( enlargeUndos(dec) );
+  DecUndo* undo = &dec->undos[dec->numUndos++];
+  undo->type = DEC_UNDO_MEMBER;
+  undo->index = member;
+  undo->data.member.data = dec->members[member];
+  undo->data.member.representativeMember = dec->representatives[member];
+  undo->data.member.parentMember = dec->parentMembers[member];
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Records the data of \p edge in the undo log of \p dec before it is modified.
+ *
+ * Does nothing if there is no checkpoint, if \p edge was allocated after the last one or if it was already logged
+ * for it.
+ */
+
+static inline
+CMR_ERROR undoEdge(
+  Dec* dec,     /**< Decomposition. */
+  DEC_EDGE edge /**< Edge that is going to be modified. */
+)
+{
+  assert(dec);
+
+  if (dec->numCheckpoints == 0)
+    return CMR_OKAY;
+  DecCheckpoint* checkpoint = &dec->checkpoints[dec->numCheckpoints - 1];
+  if (edge >= checkpoint->memEdges || dec->edgeStamps[edge] == checkpoint->stamp)
+    return CMR_OKAY;
+  dec->edgeStamps[edge] = checkpoint->stamp;
+
+  if (dec->numUndos == dec->memUndos)
+    CMR_CALL( enlargeUndos(dec) );
+  DecUndo* undo = &dec->undos[dec->numUndos++];
+  undo->type = DEC_UNDO_EDGE;
+  undo->index = edge;
+  undo->data.edge.data = dec->edges[edge];
+  undo->data.edge.info = dec->edgeInfo[edge];
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Records the data of \p node in the undo log of \p dec before it is modified.
+ *
+ * Does nothing if there is no checkpoint, if \p node was allocated after the last one or if it was already logged
+ * for it.
+ */
+
+static inline
+CMR_ERROR undoNode(
+  Dec* dec,     /**< Decomposition. */
+  DEC_NODE node /**< Node that is going to be modified. */
+)
+{
+  assert(dec);
+
+  if (dec->numCheckpoints == 0)
+    return CMR_OKAY;
+  DecCheckpoint* checkpoint = &dec->checkpoints[dec->numCheckpoints - 1];
+  if (node >= checkpoint->memNodes || dec->nodeStamps[node] == checkpoint->stamp)
+    return CMR_OKAY;
+  dec->nodeStamps[node] = checkpoint->stamp;
+
+  if (dec->numUndos == dec->memUndos)
+    CMR_CALL( enlargeUndos(dec) );
+  DecUndo* undo = &dec->undos[dec->numUndos++];
+  undo->type = DEC_UNDO_NODE;
+  undo->index = node;
+  undo->data.node = dec->nodes[node];
+
+  return CMR_OKAY;
+}
+
 /**
  * \brief Returns \c true if and only \p member is a representative member.
  */
@@ -516,7 +736,7 @@ bool isRepresentativeMember(
 {
   assert(dec);
 
-  return dec->members[member].representativeMember == SIZE_MAX;
+  return dec->representatives[member] == SIZE_MAX;
 }
 
 /**
@@ -531,14 +751,18 @@ DEC_MEMBER findMember(
 {
   DEC_MEMBER current = member;
   DEC_MEMBER next;
-  while ((next = dec->members[current].representativeMember) != SIZE_MAX)
+  while ((next = dec->representatives[current]) != SIZE_MAX)
     current = next;
   DEC_MEMBER root = current;
   current = member;
-  while ((next = dec->members[current].representativeMember) != SIZE_MAX)
+  while ((next = dec->representatives[current]) != SIZE_MAX)
   {
-    if (next != root)
-      dec->members[current].representativeMember = root;
+    /* Path compression is skipped if it cannot be logged without allocating memory. */
+    if (next != root && undoAvailable(dec))
+    {
+      undoMember(dec, current);
+      dec->representatives[current] = root;
+    }
     current = next;
   }
   return root;
@@ -558,7 +782,7 @@ DEC_MEMBER findMemberParent(
 {
   assert(isRepresentativeMember(dec, member));
 
-  DEC_MEMBER someParent = dec->members[member].parentMember;
+  DEC_MEMBER someParent = dec->parentMembers[member];
   if (someParent != SIZE_MAX)
     return findMember(dec, someParent);
   else
@@ -608,7 +832,7 @@ char* consistencyEdges(
           return CMRconsistencyMessage("edge %d of member %d out of range.", member, edge);
         if (dec->edges[edge].next == SIZE_MAX || dec->edges[edge].next > dec->memEdges)
           return CMRconsistencyMessage("edge %d of member %d has next out of range", member, edge);
-        if (dec->edges[dec->edges[edge].next].prev != edge)
+        if (dec->edgeInfo[dec->edges[edge].next].prev != edge)
           return CMRconsistencyMessage("member %d has inconsistent edge list", member);
         if (findEdgeMember(dec, edge) != member)
           return CMRconsistencyMessage("edge %d belongs to member %d but is in member %d's edge list.", edge,
@@ -720,7 +944,7 @@ char* consistencyTree(
 
     int length = 0;
     DEC_MEMBER current;
-    for (current = dec->members[member].parentMember; current != SIZE_MAX; current = dec->members[current].parentMember)
+    for (current = dec->parentMembers[member]; current != SIZE_MAX; current = dec->parentMembers[current])
     {
       ++length;
       if (length > dec->numMembers)
@@ -758,13 +982,13 @@ char* consistencyParentChild(
     if (!isRepresentativeMember(dec, member))
       continue;
 
-    if (dec->members[member].parentMember >= dec->memMembers)
+    if (dec->parentMembers[member] >= dec->memMembers)
     {
       CMRfreeStackArray(dec->cmr, &countChildren);
       return CMRconsistencyMessage("parent member of %d is out of range", member);
     }
-    if (dec->members[member].parentMember != SIZE_MAX)
-      countChildren[dec->members[member].parentMember]++;
+    if (dec->parentMembers[member] != SIZE_MAX)
+      countChildren[dec->parentMembers[member]]++;
   }
 
   for (DEC_MEMBER member = 0; member < dec->numMembers; ++member)
@@ -777,31 +1001,31 @@ char* consistencyParentChild(
       continue;
     do
     {
-      if (dec->edges[edge].childMember != SIZE_MAX)
+      if (dec->edgeInfo[edge].childMember != SIZE_MAX)
       {
         countChildren[member]--;
 
-        if (findMember(dec, dec->members[findMember(dec, dec->edges[edge].childMember)].parentMember) != findMember(dec, member))
+        if (findMember(dec, dec->parentMembers[findMember(dec, dec->edgeInfo[edge].childMember)]) != findMember(dec, member))
         {
           CMRfreeStackArray(dec->cmr, &countChildren);
           return CMRconsistencyMessage("member %d has child edge %d for child %d whose parent member is %d",
-            member, edge, findMember(dec, dec->edges[edge].childMember),
-            findMember(dec, dec->members[findMember(dec, dec->edges[edge].childMember)].parentMember));
+            member, edge, findMember(dec, dec->edgeInfo[edge].childMember),
+            findMember(dec, dec->parentMembers[findMember(dec, dec->edgeInfo[edge].childMember)]));
         }
-        if (dec->members[findMember(dec, dec->edges[edge].childMember)].markerOfParent != edge)
+        if (dec->members[findMember(dec, dec->edgeInfo[edge].childMember)].markerOfParent != edge)
         {
           CMRfreeStackArray(dec->cmr, &countChildren);
           return CMRconsistencyMessage("member %d has child edge %d for child %d whose parent's markerOfParent is %d",
-            member, edge, findMember(dec, dec->edges[edge].childMember),
-            dec->members[findMember(dec, dec->edges[edge].childMember)].markerOfParent);
+            member, edge, findMember(dec, dec->edgeInfo[edge].childMember),
+            dec->members[findMember(dec, dec->edgeInfo[edge].childMember)].markerOfParent);
         }
-        DEC_EDGE markerChild = dec->members[findMember(dec, dec->edges[edge].childMember)].markerToParent;
-        if (dec->edges[markerChild].element != -dec->edges[edge].element)
+        DEC_EDGE markerChild = dec->members[findMember(dec, dec->edgeInfo[edge].childMember)].markerToParent;
+        if (dec->edgeInfo[markerChild].element != -dec->edgeInfo[edge].element)
         {
           CMRfreeStackArray(dec->cmr, &countChildren);
           return CMRconsistencyMessage("marker edges %d and %d of members %d (parent) and %d (child) have names %d and %d.",
-            edge, markerChild, member, findEdgeMember(dec, markerChild), dec->edges[edge].element,
-            dec->edges[markerChild].element);
+            edge, markerChild, member, findEdgeMember(dec, markerChild), dec->edgeInfo[edge].element,
+            dec->edgeInfo[markerChild].element);
         }
       }
       edge = dec->edges[edge].next;
@@ -960,8 +1184,12 @@ DEC_NODE findNode(
   current = node;
   while ((next = dec->nodes[current].representativeNode) != SIZE_MAX)
   {
-    if (next != root)
+    /* Path compression is skipped if it cannot be logged without allocating memory. */
+    if (next != root && undoAvailable(dec))
+    {
+      undoNode(dec, current);
       dec->nodes[current].representativeNode = root;
+    }
     current = next;
   }
   return root;
@@ -1018,6 +1246,7 @@ CMR_ERROR createNode(
   if (node != SIZE_MAX)
   {
     CMRdbgMsg(10, "createNode returns free node %d.\n", node);
+    CMR_CALL( undoNode(dec, node) );
     dec->firstFreeNode = dec->nodes[node].representativeNode;
   }
   else
@@ -1056,21 +1285,25 @@ CMR_ERROR addEdgeToMembersEdgeList(
   assert(edge != SIZE_MAX);
 
   DEC_MEMBER member = findEdgeMember(dec, edge);
+  CMR_CALL( undoMember(dec, member) );
+  CMR_CALL( undoEdge(dec, edge) );
   DEC_EDGE first = dec->members[member].firstEdge;
   if (first != SIZE_MAX)
   {
     assert(dec->members[member].numEdges > 0);
-    DEC_EDGE last = dec->edges[first].prev;
+    DEC_EDGE last = dec->edgeInfo[first].prev;
+    CMR_CALL( undoEdge(dec, first) );
+    CMR_CALL( undoEdge(dec, last) );
     dec->edges[edge].next = first;
-    dec->edges[edge].prev = last;
-    dec->edges[first].prev = edge;
+    dec->edgeInfo[edge].prev = last;
+    dec->edgeInfo[first].prev = edge;
     dec->edges[last].next =  edge;
   }
   else
   {
     assert(dec->members[member].numEdges == 0);
     dec->edges[edge].next = edge;
-    dec->edges[edge].prev = edge;
+    dec->edgeInfo[edge].prev = edge;
   }
   dec->members[member].firstEdge = edge;
   dec->members[member].numEdges++;
@@ -1091,6 +1324,7 @@ CMR_ERROR removeEdgeFromMembersEdgeList(
   assert(dec);
 
   DEC_MEMBER member = findEdgeMember(dec, edge);
+  CMR_CALL( undoMember(dec, member) );
   if (dec->members[member].numEdges == 1)
     dec->members[member].firstEdge = -1;
   else
@@ -1100,8 +1334,10 @@ CMR_ERROR removeEdgeFromMembersEdgeList(
 
     assert(dec->members[member].firstEdge != edge);
 
-    dec->edges[dec->edges[edge].prev].next = dec->edges[edge].next;
-    dec->edges[dec->edges[edge].next].prev = dec->edges[edge].prev;
+    CMR_CALL( undoEdge(dec, dec->edgeInfo[edge].prev) );
+    CMR_CALL( undoEdge(dec, dec->edges[edge].next) );
+    dec->edges[dec->edgeInfo[edge].prev].next = dec->edges[edge].next;
+    dec->edgeInfo[dec->edges[edge].next].prev = dec->edgeInfo[edge].prev;
   }
 
   dec->members[member].numEdges--;
@@ -1128,12 +1364,16 @@ CMR_ERROR replaceEdgeInMembersEdgeList(
   DEC_MEMBER member = findEdgeMember(dec, oldEdge);
   assert(findEdgeMember(dec, newEdge) == member);
 
+  CMR_CALL( undoEdge(dec, newEdge) );
+  CMR_CALL( undoEdge(dec, dec->edges[oldEdge].next) );
+  CMR_CALL( undoEdge(dec, dec->edgeInfo[oldEdge].prev) );
+  CMR_CALL( undoMember(dec, member) );
   dec->edges[newEdge].tail = dec->edges[oldEdge].tail;
   dec->edges[newEdge].head = dec->edges[oldEdge].head;
   dec->edges[newEdge].next = dec->edges[oldEdge].next;
-  dec->edges[newEdge].prev = dec->edges[oldEdge].prev;
-  dec->edges[dec->edges[oldEdge].next].prev = newEdge;
-  dec->edges[dec->edges[oldEdge].prev].next = newEdge;
+  dec->edgeInfo[newEdge].prev = dec->edgeInfo[oldEdge].prev;
+  dec->edgeInfo[dec->edges[oldEdge].next].prev = newEdge;
+  dec->edges[dec->edgeInfo[oldEdge].prev].next = newEdge;
   if (dec->members[member].firstEdge == oldEdge)
     dec->members[member].firstEdge = newEdge;
 
@@ -1159,12 +1399,14 @@ CMR_ERROR createEdge(
   if (edge != SIZE_MAX)
   {
     CMRdbgMsg(12, "Creating edge %d by using a free edge.\n", edge);
+    CMR_CALL( undoEdge(dec, edge) );
     dec->firstFreeEdge = dec->edges[edge].next;
   }
   else /* No edge in free list, so we enlarge the array. */
   {
     int newSize = 2 * dec->memEdges + 16;
     CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->edges, newSize) );
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->edgeInfo, newSize) );
     for (int e = dec->memEdges + 1; e < newSize; ++e)
     {
       dec->edges[e].next = e+1;
@@ -1179,7 +1421,7 @@ CMR_ERROR createEdge(
 
   dec->edges[edge].tail = -1;
   dec->edges[edge].head = -1;
-  dec->edges[edge].element = 0;
+  dec->edgeInfo[edge].element = 0;
   dec->edges[edge].member = member;
   dec->numEdges++;
 
@@ -1214,27 +1456,28 @@ CMR_ERROR createMarkerEdgePair(
   /* Create the child marker edge of the parent member. */
 
   CMR_CALL( createEdge(dec, parentMember, pMarkerOfParent) );
-  DecEdgeData* data = &dec->edges[*pMarkerOfParent];
-  data->tail = markerOfParentTail;
-  data->head = markerOfParentHead;
-  data->childMember = childMember;
-  data->element = -INT_MAX + dec->numMarkerPairs;
+  DEC_EDGE edge = *pMarkerOfParent;
+  dec->edges[edge].tail = markerOfParentTail;
+  dec->edges[edge].head = markerOfParentHead;
+  dec->edgeInfo[edge].childMember = childMember;
+  dec->edgeInfo[edge].element = -INT_MAX + dec->numMarkerPairs;
   CMRdbgMsg(12, "Created child marker edge {%d,%d} <%s> of parent member %d.\n", markerOfParentTail, markerOfParentHead,
-    CMRelementString(data->element, NULL), parentMember);
+    CMRelementString(dec->edgeInfo[edge].element, NULL), parentMember);
 
   /* Create the parent marker edge of the child member. */
 
   CMR_CALL( createEdge(dec, childMember, pMarkerToParent) );
-  data = &dec->edges[*pMarkerToParent];
-  data->tail = markerToParentTail;
-  data->head = markerToParentHead;
-  data->childMember = -1;
-  dec->members[childMember].parentMember = parentMember;
+  edge = *pMarkerToParent;
+  dec->edges[edge].tail = markerToParentTail;
+  dec->edges[edge].head = markerToParentHead;
+  dec->edgeInfo[edge].childMember = -1;
+  CMR_CALL( undoMember(dec, childMember) );
+  dec->parentMembers[childMember] = parentMember;
   dec->members[childMember].markerOfParent = *pMarkerOfParent;
   dec->members[childMember].markerToParent = *pMarkerToParent;
-  data->element = INT_MAX - dec->numMarkerPairs;
+  dec->edgeInfo[edge].element = INT_MAX - dec->numMarkerPairs;
   CMRdbgMsg(12, "Created child marker edge {%d,%d} <%s> of child member %d.\n", markerToParentTail, markerToParentHead,
-    CMRelementString(data->element, NULL), childMember);
+    CMRelementString(dec->edgeInfo[edge].element, NULL), childMember);
 
   /* Increase counter of used marker pairs. */
   dec->numMarkerPairs++;
@@ -1259,17 +1502,19 @@ CMR_ERROR createMember(
   {
     dec->memMembers = 16 + 2 * dec->memMembers;
     CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->members, dec->memMembers) );
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->representatives, dec->memMembers) );
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->parentMembers, dec->memMembers) );
   }
 
   DEC_MEMBER_DATA* data = &dec->members[dec->numMembers];
   data->markerOfParent = -1;
   data->markerToParent = -1;
   data->firstEdge = -1;
-  data->representativeMember = -1;
   data->numEdges = 0;
-  data->parentMember = -1;
   data->type = type;
   data->lastParallelParentChildVisit = 0;
+  dec->representatives[dec->numMembers] = -1;
+  dec->parentMembers[dec->numMembers] = -1;
   *pmember = dec->numMembers;
   dec->numMembers++;
 
@@ -1279,78 +1524,83 @@ CMR_ERROR createMember(
 }
 
 /**
- * \brief Creates an empty decomposition.
+ * \brief Empties the decomposition \p dec.
+ *
+ * The memory of \p dec is kept and enlarged if it is smaller than requested.
  */
 
-CMR_ERROR decCreate(
-  CMR* cmr,           /**< \ref CMR environment. */
-  Dec** pdec,       /**< Pointer to new decomposition. .*/
-  size_t memEdges,     /**< Initial memory for edges of the decomposition. */
-  size_t memNodes,     /**< Initial memory for nodes of the decomposition. */
-  size_t memMembers,   /**< Initial memory for members of the decomposition. */
-  size_t memRows,      /**< Initial memory for rows. */
-  size_t memColumns    /**< Initial memory for columns. */
+static
+CMR_ERROR decClear(
+  Dec* dec,           /**< Decomposition. */
+  size_t memEdges,    /**< Minimum memory for edges of the decomposition. */
+  size_t memNodes,    /**< Minimum memory for nodes of the decomposition. */
+  size_t memMembers,  /**< Minimum memory for members of the decomposition. */
+  size_t memRows,     /**< Minimum memory for rows. */
+  size_t memColumns   /**< Minimum memory for columns. */
 )
 {
-  assert(cmr);
-  assert(pdec);
-  assert(!*pdec);
+  assert(dec);
 
-  CMR_CALL( CMRallocBlock(cmr, pdec) );
-  Dec* dec = *pdec;
-  dec->cmr = cmr;
-  dec->memMembers = memMembers;
+  if (memMembers > dec->memMembers)
+  {
+    dec->memMembers = memMembers;
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->members, dec->memMembers) );
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->representatives, dec->memMembers) );
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->parentMembers, dec->memMembers) );
+  }
   dec->numMembers = 0;
-  dec->members = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &dec->members, dec->memMembers) );
 
   if (memNodes < 1)
     memNodes = 1;
-  dec->memNodes = memNodes;
-  dec->nodes = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &dec->nodes, memNodes) );
+  if (memNodes > dec->memNodes)
+  {
+    dec->memNodes = memNodes;
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->nodes, dec->memNodes) );
+  }
   dec->numNodes = 0;
-  for (size_t v = 0; v < memNodes; ++v)
+  for (size_t v = 0; v < dec->memNodes; ++v)
     dec->nodes[v].representativeNode = v+1;
-  dec->nodes[memNodes-1].representativeNode = SIZE_MAX;
+  dec->nodes[dec->memNodes-1].representativeNode = SIZE_MAX;
   dec->firstFreeNode = 0;
 
   if (memEdges < 1)
     memEdges = 1;
-  dec->memEdges = memEdges;
-  dec->edges = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &dec->edges, memEdges) );
+  if (memEdges > dec->memEdges)
+  {
+    dec->memEdges = memEdges;
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->edges, dec->memEdges) );
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->edgeInfo, dec->memEdges) );
+  }
   dec->numEdges = 0;
   dec->numMarkerPairs = 0;
   dec->parallelParentChildVisit = 0;
 
   /* Initialize free list with unused edges. */
-  if (memEdges > dec->numEdges)
+  for (size_t e = 0; e < dec->memEdges; ++e)
   {
-    for (size_t e = dec->numEdges; e < memEdges; ++e)
-    {
-      dec->edges[e].next = e+1;
-      dec->edges[e].member = -1;
-    }
-    dec->edges[memEdges-1].next = -1;
-    dec->firstFreeEdge = dec->numEdges;
+    dec->edges[e].next = e+1;
+    dec->edges[e].member = -1;
   }
-  else
-    dec->firstFreeEdge = -1;
+  dec->edges[dec->memEdges-1].next = -1;
+  dec->firstFreeEdge = 0;
 
+  if (memRows > dec->memRows)
+  {
+    dec->memRows = memRows;
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->rowEdges, dec->memRows) );
+  }
   dec->numRows = 0;
-  dec->memRows = memRows;
-  dec->rowEdges = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &dec->rowEdges, dec->memRows) );
-  for (size_t r = 0; r < dec->numRows; ++r)
-    dec->rowEdges[r].edge = -1;
 
+  if (memColumns > dec->memColumns)
+  {
+    dec->memColumns = memColumns;
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->columnEdges, dec->memColumns) );
+  }
   dec->numColumns = 0;
-  dec->memColumns = memColumns;
-  dec->columnEdges = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &dec->columnEdges, dec->memColumns) );
-  for (size_t c = 0; c < dec->numColumns; ++c)
-    dec->columnEdges[c].edge = -1;
+
+  /* The stamps are kept since lastStamp is never reset. */
+  dec->numUndos = 0;
+  dec->numCheckpoints = 0;
 
 #if defined(CMR_DEBUG_CONSISTENCY)
   CMRconsistencyAssert( decConsistency(dec) );
@@ -1359,6 +1609,57 @@ CMR_ERROR decCreate(
   return CMR_OKAY;
 }
 
+/**
+ * \brief Creates an empty decomposition.
+ */
+
+CMR_ERROR decCreate(
+  CMR* cmr,           /**< \ref CMR environment. */
+  Dec** pdec,         /**< Pointer to new decomposition. .*/
+  size_t memEdges,    /**< Initial memory for edges of the decomposition. */
+  size_t memNodes,    /**< Initial memory for nodes of the decomposition. */
+  size_t memMembers,  /**< Initial memory for members of the decomposition. */
+  size_t memRows,     /**< Initial memory for rows. */
+  size_t memColumns   /**< Initial memory for columns. */
+)
+{
+  assert(cmr);
+  assert(pdec);
+  assert(!*pdec);
+
+  CMR_CALL( CMRallocBlock(cmr, pdec) );
+  Dec* dec = *pdec;
+  dec->cmr = cmr;
+  dec->memMembers = 0;
+  dec->members = NULL;
+  dec->representatives = NULL;
+  dec->parentMembers = NULL;
+  dec->memNodes = 0;
+  dec->nodes = NULL;
+  dec->memEdges = 0;
+  dec->edges = NULL;
+  dec->edgeInfo = NULL;
+  dec->memRows = 0;
+  dec->rowEdges = NULL;
+  dec->memColumns = 0;
+  dec->columnEdges = NULL;
+  dec->memUndos = 0;
+  dec->undos = NULL;
+  dec->memCheckpoints = 0;
+  dec->checkpoints = NULL;
+  dec->lastStamp = 0;
+  dec->memMemberStamps = 0;
+  dec->memberStamps = NULL;
+  dec->memEdgeStamps = 0;
+  dec->edgeStamps = NULL;
+  dec->memNodeStamps = 0;
+  dec->nodeStamps = NULL;
+
+  CMR_CALL( decClear(dec, memEdges, memNodes, memMembers, memRows, memColumns) );
+
+  return CMR_OKAY;
+}
+
 /**
  * \brief Frees the decomposition \p *pdec.
  */
@@ -1372,15 +1673,173 @@ CMR_ERROR decFree(
 
   Dec* dec = *pdec;
   CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->members) );
+  CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->representatives) );
+  CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->parentMembers) );
   CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->edges) );
+  CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->edgeInfo) );
   CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->nodes) );
   CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->rowEdges) );
   CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->columnEdges) );
+  if (dec->undos)
+    CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->undos) );
+  if (dec->checkpoints)
+    CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->checkpoints) );
+  if (dec->memberStamps)
+    CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->memberStamps) );
+  if (dec->edgeStamps)
+    CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->edgeStamps) );
+  if (dec->nodeStamps)
+    CMR_CALL( CMRfreeBlockArray(dec->cmr, &dec->nodeStamps) );
   CMR_CALL( CMRfreeBlock(dec->cmr, pdec) );
 
   return CMR_OKAY;
 }
 
+/**
+ * \brief Creates a checkpoint of \p dec to which it can be rolled back via \ref decRollback.
+ *
+ * While there is a checkpoint, every member, edge or node is recorded in the undo log before it is modified, except
+ * for those created after the last checkpoint.
+ */
+
+static
+CMR_ERROR decCheckpoint(
+  Dec* dec,           /**< Decomposition. */
+  size_t* pcheckpoint /**< Pointer for storing the checkpoint (may be \c NULL). */
+)
+{
+  assert(dec);
+
+  if (dec->numCheckpoints == dec->memCheckpoints)
+  {
+    dec->memCheckpoints = 2 * dec->memCheckpoints + 16;
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->checkpoints, dec->memCheckpoints) );
+  }
+
+  /* Only objects that exist now can be logged for this checkpoint. */
+  if (dec->memMemberStamps < dec->numMembers)
+  {
+    size_t newSize = 2 * dec->numMembers;
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->memberStamps, newSize) );
+    for (size_t m = dec->memMemberStamps; m < newSize; ++m)
+      dec->memberStamps[m] = 0;
+    dec->memMemberStamps = newSize;
+  }
+  if (dec->memEdgeStamps < dec->memEdges)
+  {
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->edgeStamps, dec->memEdges) );
+    for (size_t e = dec->memEdgeStamps; e < dec->memEdges; ++e)
+      dec->edgeStamps[e] = 0;
+    dec->memEdgeStamps = dec->memEdges;
+  }
+  if (dec->memNodeStamps < dec->memNodes)
+  {
+    CMR_CALL( CMRreallocBlockArray(dec->cmr, &dec->nodeStamps, dec->memNodes) );
+    for (size_t v = dec->memNodeStamps; v < dec->memNodes; ++v)
+      dec->nodeStamps[v] = 0;
+    dec->memNodeStamps = dec->memNodes;
+  }
+
+  DecCheckpoint* checkpoint = &dec->checkpoints[dec->numCheckpoints];
+  checkpoint->stamp = ++dec->lastStamp;
+  checkpoint->numUndos = dec->numUndos;
+  checkpoint->numMembers = dec->numMembers;
+  checkpoint->memEdges = dec->memEdges;
+  checkpoint->numEdges = dec->numEdges;
+  checkpoint->firstFreeEdge = dec->firstFreeEdge;
+  checkpoint->memNodes = dec->memNodes;
+  checkpoint->numNodes = dec->numNodes;
+  checkpoint->firstFreeNode = dec->firstFreeNode;
+  checkpoint->numRows = dec->numRows;
+  checkpoint->numColumns = dec->numColumns;
+  checkpoint->numMarkerPairs = dec->numMarkerPairs;
+  checkpoint->parallelParentChildVisit = dec->parallelParentChildVisit;
+  if (pcheckpoint)
+    *pcheckpoint = dec->numCheckpoints;
+  dec->numCheckpoints++;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Rolls \p dec back to the state at \p checkpoint, which is removed together with all later checkpoints.
+ *
+ * Takes time proportional to the number of modifications since \p checkpoint. Arrays that were enlarged keep their
+ * memory, and their new entries are put into the free lists.
+ */
+
+static
+CMR_ERROR decRollback(
+  Dec* dec,         /**< Decomposition. */
+  size_t checkpoint /**< Checkpoint created by \ref decCheckpoint. */
+)
+{
+  assert(dec);
+  assert(checkpoint < dec->numCheckpoints);
+
+  DecCheckpoint* data = &dec->checkpoints[checkpoint];
+
+  /* Restore the modified objects in reverse order such that the oldest data remains. */
+  for (size_t u = dec->numUndos; u > data->numUndos; --u)
+  {
+    DecUndo* undo = &dec->undos[u-1];
+    if (undo->type == DEC_UNDO_MEMBER)
+    {
+      dec->members[undo->index] = undo->data.member.data;
+      dec->representatives[undo->index] = undo->data.member.representativeMember;
+      dec->parentMembers[undo->index] = undo->data.member.parentMember;
+    }
+    else if (undo->type == DEC_UNDO_EDGE)
+    {
+      dec->edges[undo->index] = undo->data.edge.data;
+      dec->edgeInfo[undo->index] = undo->data.edge.info;
+    }
+    else
+    {
+      assert(undo->type == DEC_UNDO_NODE);
+      dec->nodes[undo->index] = undo->data.node;
+    }
+  }
+  dec->numUndos = data->numUndos;
+
+  /* Edges and nodes beyond the old memory did not exist, so we prepend them to the free lists. */
+  dec->firstFreeEdge = data->firstFreeEdge;
+  if (dec->memEdges > data->memEdges)
+  {
+    for (size_t e = data->memEdges; e < dec->memEdges; ++e)
+    {
+      dec->edges[e].next = e+1;
+      dec->edges[e].member = -1;
+    }
+    dec->edges[dec->memEdges-1].next = dec->firstFreeEdge;
+    dec->firstFreeEdge = data->memEdges;
+  }
+  dec->firstFreeNode = data->firstFreeNode;
+  if (dec->memNodes > data->memNodes)
+  {
+    for (size_t v = data->memNodes; v < dec->memNodes; ++v)
+      dec->nodes[v].representativeNode = v+1;
+    dec->nodes[dec->memNodes-1].representativeNode = dec->firstFreeNode;
+    dec->firstFreeNode = data->memNodes;
+  }
+
+  /* The entries of rowEdges and columnEdges are never modified after their creation. */
+  dec->numMembers = data->numMembers;
+  dec->numEdges = data->numEdges;
+  dec->numNodes = data->numNodes;
+  dec->numRows = data->numRows;
+  dec->numColumns = data->numColumns;
+  dec->numMarkerPairs = data->numMarkerPairs;
+  dec->parallelParentChildVisit = data->parallelParentChildVisit;
+  dec->numCheckpoints = checkpoint;
+
+#if defined(CMR_DEBUG_CONSISTENCY)
+  CMRconsistencyAssert( decConsistency(dec) );
+#endif /* CMR_DEBUG_CONSISTENCY */
+
+  return CMR_OKAY;
+}
+
 /**
  * \brief Creates a graph represented by given decomposition.
  */
@@ -1447,7 +1906,7 @@ CMR_ERROR decToGraph(
           &graphEdge) );
         decEdgesToGraphEdges[edge] = graphEdge;
         if (localEdgeElements)
-          localEdgeElements[graphEdge] = dec->edges[edge].element;
+          localEdgeElements[graphEdge] = dec->edgeInfo[edge].element;
         edge = dec->edges[edge].next;
       }
       while (edge != dec->members[member].firstEdge);
@@ -1462,7 +1921,7 @@ CMR_ERROR decToGraph(
         CMR_CALL( CMRgraphAddEdge(dec->cmr, graph, graphHead, graphTail, &graphEdge) );
         decEdgesToGraphEdges[edge] = graphEdge;
         if (localEdgeElements)
-          localEdgeElements[graphEdge] = dec->edges[edge].element;
+          localEdgeElements[graphEdge] = dec->edgeInfo[edge].element;
         edge = dec->edges[edge].next;
       }
       while (edge != dec->members[member].firstEdge);
@@ -1480,7 +1939,7 @@ CMR_ERROR decToGraph(
         CMR_CALL( CMRgraphAddEdge(dec->cmr, graph, v, w, &graphEdge) );
         decEdgesToGraphEdges[edge] = graphEdge;
         if (localEdgeElements)
-          localEdgeElements[graphEdge] = dec->edges[edge].element;
+          localEdgeElements[graphEdge] = dec->edgeInfo[edge].element;
 
         edge = dec->edges[edge].next;
         v = w;
@@ -1488,7 +1947,7 @@ CMR_ERROR decToGraph(
       CMR_CALL( CMRgraphAddEdge(dec->cmr, graph, v, firstNode, &graphEdge) );
       decEdgesToGraphEdges[edge] = graphEdge;
       if (localEdgeElements)
-        localEdgeElements[graphEdge] = dec->edges[edge].element;
+        localEdgeElements[graphEdge] = dec->edgeInfo[edge].element;
     }
     else
     {
@@ -1499,7 +1958,7 @@ CMR_ERROR decToGraph(
       CMR_CALL( CMRgraphAddEdge(dec->cmr, graph, v, v, &graphEdge) );
       decEdgesToGraphEdges[edge] = graphEdge;
       if (localEdgeElements)
-        localEdgeElements[graphEdge] = dec->edges[edge].element;
+        localEdgeElements[graphEdge] = dec->edgeInfo[edge].element;
     }
   }
 
@@ -1512,7 +1971,7 @@ CMR_ERROR decToGraph(
 
     for (size_t m = 0; m < dec->numMembers; ++m)
     {
-      if (!isRepresentativeMember(dec, m) || dec->members[m].parentMember == SIZE_MAX)
+      if (!isRepresentativeMember(dec, m) || dec->parentMembers[m] == SIZE_MAX)
         continue;
 
       CMR_GRAPH_EDGE parent = decEdgesToGraphEdges[dec->members[m].markerOfParent];
@@ -1523,9 +1982,9 @@ CMR_ERROR decToGraph(
       CMR_GRAPH_NODE childV = CMRgraphEdgeV(graph, child);
 
       CMRdbgMsg(2, "Merging edges %d = {%d,%d} <%s>", parent, parentU, parentV,
-        CMRelementString(dec->edges[dec->members[m].markerOfParent].element, NULL));
+        CMRelementString(dec->edgeInfo[dec->members[m].markerOfParent].element, NULL));
       CMRdbgMsg(0, " and %d = {%d,%d} <%s>.\n", child, childU, childV,
-        CMRelementString(dec->edges[dec->members[m].markerToParent].element, NULL));
+        CMRelementString(dec->edgeInfo[dec->members[m].markerToParent].element, NULL));
 
       CMR_CALL( CMRgraphMergeNodes(dec->cmr, graph, parentU, childU) );
       CMR_CALL( CMRgraphDeleteNode(dec->cmr, graph, childU) );
@@ -1640,9 +2099,9 @@ void edgeToDot(
     fprintf(stream, "    %c_%ld_%d [shape=box];\n", type, member, v);
     fprintf(stream, "    %c_p_%ld [style=dashed];\n", type, member);
   }
-  else if (dec->edges[edge].childMember != SIZE_MAX)
+  else if (dec->edgeInfo[edge].childMember != SIZE_MAX)
   {
-    DEC_MEMBER child = findMember(dec, dec->edges[edge].childMember);
+    DEC_MEMBER child = findMember(dec, dec->edgeInfo[edge].childMember);
     char childType = (dec->members[child].type == DEC_MEMBER_TYPE_PARALLEL) ?
       'P' : (dec->members[child].type == DEC_MEMBER_TYPE_SERIES ? 'S' : 'R');
     fprintf(stream, "    %c_%ld_%d -- %c_c_%ld [label=\"%ld\",style=dotted%s];\n", type, member, u, type, child, edge, redStyle);
@@ -1657,7 +2116,7 @@ void edgeToDot(
   {
     fflush(stdout);
     fprintf(stream, "    %c_%ld_%d -- %c_%ld_%d [label=\"%ld <%s>\",style=bold%s];\n", type, member, u, type, member, v,
-      edge, CMRelementString(dec->edges[edge].element, NULL), redStyle);
+      edge, CMRelementString(dec->edgeInfo[edge].element, NULL), redStyle);
     fprintf(stream, "    %c_%ld_%d [shape=box];\n", type, member, u);
     fprintf(stream, "    %c_%ld_%d [shape=box];\n", type, member, v);
   }
@@ -1841,6 +2300,143 @@ CMR_ERROR newcolumnFree(
   return CMR_OKAY;
 }
 
+struct _CMR_GRAPHIC_WORKSPACE
+{
+  Dec* dec;                 /**< \brief Spare decomposition, or \c NULL. */
+  DEC_NEWCOLUMN* newcolumn; /**< \brief Spare \ref DEC_NEWCOLUMN structure, or \c NULL. */
+};
+
+CMR_ERROR CMRgraphicWorkspaceFree(CMR* cmr, CMR_GRAPHIC_WORKSPACE** pworkspace)
+{
+  assert(cmr);
+  assert(pworkspace);
+
+  CMR_GRAPHIC_WORKSPACE* workspace = *pworkspace;
+  if (!workspace)
+    return CMR_OKAY;
+
+  if (workspace->newcolumn)
+    CMR_CALL( newcolumnFree(cmr, &workspace->newcolumn) );
+  if (workspace->dec)
+  {
+    workspace->dec->cmr = cmr;
+    CMR_CALL( decFree(&workspace->dec) );
+  }
+  CMR_CALL( CMRfreeBlock(cmr, pworkspace) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Creates a decomposition and a \ref DEC_NEWCOLUMN structure for testing a matrix for cographicness.
+ *
+ * The initial memory is derived from the size of the matrix. The structures of the \ref CMR_GRAPHIC_WORKSPACE of
+ * \p cmr are used if they are not much larger than needed. They must be handed back via \ref decRelease.
+ */
+
+static
+CMR_ERROR decAcquire(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  size_t numRows,             /**< Number of rows of the matrix, which are added as columns. */
+  size_t numColumns,          /**< Number of columns of the matrix. */
+  size_t numNonzeros,         /**< Number of nonzeros of the matrix. */
+  Dec** pdec,                 /**< Pointer for storing the decomposition. */
+  DEC_NEWCOLUMN** pnewcolumn  /**< Pointer for storing the newcolumn structure. */
+)
+{
+  assert(cmr);
+  assert(pdec);
+  assert(pnewcolumn);
+
+  /* Each row and each column with a nonzero becomes an edge, and each member gets at most one pair of markers. */
+  size_t numElements = numRows + (numNonzeros < numColumns ? numNonzeros : numColumns);
+  size_t memEdges = 2 * numElements + 16;
+  size_t memNodes = numElements + 16;
+  size_t memMembers = numElements + 16;
+
+  CMR_GRAPHIC_WORKSPACE* workspace = cmr->graphicWorkspace;
+  if (workspace && workspace->dec)
+  {
+    /* Clearing takes time proportional to the memory, so decompositions of much larger matrices are not reused. */
+    Dec* dec = workspace->dec;
+    if (dec->memEdges <= 4 * memEdges && dec->memNodes <= 4 * memNodes && dec->memMembers <= 4 * memMembers)
+    {
+      dec->cmr = cmr;
+      CMR_CALL( decClear(dec, memEdges, memNodes, memMembers, numColumns, numRows) );
+      *pdec = dec;
+      *pnewcolumn = workspace->newcolumn;
+      workspace->dec = NULL;
+      workspace->newcolumn = NULL;
+      return CMR_OKAY;
+    }
+
+    CMR_CALL( newcolumnFree(cmr, &workspace->newcolumn) );
+    dec->cmr = cmr;
+    CMR_CALL( decFree(&workspace->dec) );
+  }
+
+  CMR_CALL( decCreate(cmr, pdec, memEdges, memNodes, memMembers, numColumns, numRows) );
+  CMR_CALL( newcolumnCreate(cmr, pnewcolumn) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Hands a decomposition and a \ref DEC_NEWCOLUMN structure obtained via \ref decAcquire back to the
+ *        \ref CMR_GRAPHIC_WORKSPACE of \p cmr, or frees them if it already holds some.
+ */
+
+static
+CMR_ERROR decRelease(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  Dec** pdec,                 /**< Pointer to the decomposition. */
+  DEC_NEWCOLUMN** pnewcolumn  /**< Pointer to the newcolumn structure. */
+)
+{
+  assert(cmr);
+  assert(pdec && *pdec);
+  assert(pnewcolumn && *pnewcolumn);
+
+  if (!cmr->graphicWorkspace)
+  {
+    CMR_CALL( CMRallocBlock(cmr, &cmr->graphicWorkspace) );
+    cmr->graphicWorkspace->dec = NULL;
+    cmr->graphicWorkspace->newcolumn = NULL;
+  }
+
+  CMR_GRAPHIC_WORKSPACE* workspace = cmr->graphicWorkspace;
+  if (workspace->dec)
+  {
+    CMR_CALL( newcolumnFree(cmr, pnewcolumn) );
+    CMR_CALL( decFree(pdec) );
+    return CMR_OKAY;
+  }
+
+  /* The entries of members, edges and nodes that were merged are not cleaned up after a check, so we reset all. */
+  DEC_NEWCOLUMN* newcolumn = *pnewcolumn;
+  for (size_t m = 0; m < newcolumn->memReducedMembers; ++m)
+  {
+    newcolumn->memberInfo[m].reducedMember = NULL;
+    newcolumn->memberInfo[m].rootDepthMinimizer = NULL;
+  }
+  for (size_t e = 0; e < newcolumn->memEdgesInPath; ++e)
+    newcolumn->edgesInPath[e] = false;
+  for (size_t v = 0; v < newcolumn->memNodesDegree; ++v)
+    newcolumn->nodesDegree[v] = 0;
+  newcolumn->numReducedMembers = 0;
+  newcolumn->numReducedComponents = 0;
+  newcolumn->numPathEdges = 0;
+  newcolumn->firstPathEdge = NULL;
+  newcolumn->usedChildrenStorage = 0;
+
+  workspace->dec = *pdec;
+  workspace->newcolumn = newcolumn;
+  *pdec = NULL;
+  *pnewcolumn = NULL;
+
+  return CMR_OKAY;
+}
+
 
 /**
  * \brief Removes all path edges.
@@ -1954,6 +2550,7 @@ CMR_ERROR parallelParentChildCheckMember(
   if (dec->members[childMember].lastParallelParentChildVisit == dec->parallelParentChildVisit)
     return CMR_OKAY;
 
+  CMR_CALL( undoMember(dec, childMember) );
   dec->members[childMember].lastParallelParentChildVisit = dec->parallelParentChildVisit;
   DEC_MEMBER parentMember = findMemberParent(dec, member);
   CMRdbgMsg(10, "Consider child member %d of %d with parent %d.\n", childMember, member, parentMember);
@@ -1991,13 +2588,15 @@ CMR_ERROR parallelParentChildCheckMember(
           dec->edges[markerOfParent].head, newParallel, &newMarkerToParent, -1, -1) );
 
         CMR_CALL( replaceEdgeInMembersEdgeList(dec, markerOfParent, newMarkerOfParent) );
-        dec->edges[markerOfParent].childMember = member;
+        CMR_CALL( undoEdge(dec, markerOfParent) );
+        dec->edgeInfo[markerOfParent].childMember = member;
         dec->edges[markerOfParent].member = newParallel;
         dec->edges[markerOfParent].tail = -1;
         dec->edges[markerOfParent].head = -1;
         CMR_CALL( addEdgeToMembersEdgeList(dec, markerOfParent) );
         CMR_CALL( addEdgeToMembersEdgeList(dec, newMarkerToParent) );
-        dec->members[member].parentMember = newParallel;
+        CMR_CALL( undoMember(dec, member) );
+        dec->parentMembers[member] = newParallel;
         parentMember = newParallel;
       }
 
@@ -2007,11 +2606,13 @@ CMR_ERROR parallelParentChildCheckMember(
         childMarkerEdge, member, parentMember);
 
       CMR_CALL( removeEdgeFromMembersEdgeList(dec, childMarkerEdge) );
+      CMR_CALL( undoEdge(dec, childMarkerEdge) );
       dec->edges[childMarkerEdge].member = parentMember;
       CMR_CALL( addEdgeToMembersEdgeList(dec, childMarkerEdge) );
       dec->edges[childMarkerEdge].tail = -1;
       dec->edges[childMarkerEdge].head = -1;
-      dec->members[childMember].parentMember = parentMember;
+      CMR_CALL( undoMember(dec, childMember) );
+      dec->parentMembers[childMember] = parentMember;
 
       debugDot(dec, NULL);
     }
@@ -2392,10 +2993,10 @@ CMR_ERROR completeReducedDecomposition(
       DEC_EDGE edge;
       CMR_CALL( createEdge(dec, member, &edge) );
       CMR_CALL( addEdgeToMembersEdgeList(dec, edge) );
-      dec->edges[edge].element = CMRrowToElement(r);
+      dec->edgeInfo[edge].element = CMRrowToElement(r);
       dec->edges[edge].head = -1;
       dec->edges[edge].tail = -1;
-      dec->edges[edge].childMember = -1;
+      dec->edgeInfo[edge].childMember = -1;
 
       CMRdbgMsg(8, "New row %d is edge %d of member %d.\n", r, edge, member);
 
@@ -2498,7 +3099,7 @@ CMR_ERROR createReducedDecompositionPathEdges(
       CMR_CALL( createPathEdge(dec, newcolumn, edge, reducedMember) );
 
       CMRdbgMsg(6, "Edge %d <%s> belongs to reduced member %ld which is %s member %d.\n", edge,
-        CMRelementString(dec->edges[edge].element, NULL), (reducedMember - newcolumn->reducedMembers),
+        CMRelementString(dec->edgeInfo[edge].element, NULL), (reducedMember - newcolumn->reducedMembers),
         memberTypeString(reducedMember->member), reducedMember->member);
     }
   }
@@ -2657,7 +3258,7 @@ CMR_ERROR determineTypeSeries(
   if (depth == 0)
   {
     /* We assume that we are not the root of the whole decomposition. */
-    assert(dec->members[member].parentMember != SIZE_MAX);
+    assert(dec->parentMembers[member] != SIZE_MAX);
 
     /* Tested in TypingRootSeriesDoubleChild */
     newcolumn->remainsGraphic = (numTwoEnds == 0);
@@ -3573,7 +4174,7 @@ CMR_ERROR moveReducedRoot(
     CMRdbgMsg(6, "Reduced %s member %d closes a cycle with a 1- or 2-end child marker edge.\n",
       memberTypeString(dec->members[member].type), member);
 
-    DEC_MEMBER childMember = findMember(dec, dec->edges[childMarkerEdges[0]].childMember);
+    DEC_MEMBER childMember = findMember(dec, dec->edgeInfo[childMarkerEdges[0]].childMember);
 
     /* Find the unique child member in order to process that. */
     for (int c = 0; c < reducedMember->numChildren; ++c)
@@ -3686,6 +4287,7 @@ CMR_ERROR setEdgeNodes(
   assert(dec);
   assert(edge < dec->memEdges);
 
+  CMR_CALL( undoEdge(dec, edge) );
   dec->edges[edge].tail = tail;
   dec->edges[edge].head = head;
 
@@ -3738,6 +4340,17 @@ CMR_ERROR mergeMemberIntoParent(
   CMRdbgMsg(10, "Merging member %d into %d, identifying %d = {%d,%d} with %d = {%d,%d}.\n", member, parentMember,
     childEdge, childEdgeNodes[0], childEdgeNodes[1], parentEdge, parentEdgeNodes[0], parentEdgeNodes[1]);
 
+  CMR_CALL( undoNode(dec, childEdgeNodes[0]) );
+  CMR_CALL( undoNode(dec, childEdgeNodes[1]) );
+  CMR_CALL( undoMember(dec, member) );
+  CMR_CALL( undoMember(dec, parentMember) );
+  CMR_CALL( undoEdge(dec, parentEdge) );
+  CMR_CALL( undoEdge(dec, childEdge) );
+  CMR_CALL( undoEdge(dec, dec->edges[parentEdge].next) );
+  CMR_CALL( undoEdge(dec, dec->edgeInfo[parentEdge].prev) );
+  CMR_CALL( undoEdge(dec, dec->edges[childEdge].next) );
+  CMR_CALL( undoEdge(dec, dec->edgeInfo[childEdge].prev) );
+
   /* Identify nodes. */
 
   dec->nodes[childEdgeNodes[0]].representativeNode = parentEdgeNodes[headToHead ? 0 : 1];
@@ -3745,16 +4358,16 @@ CMR_ERROR mergeMemberIntoParent(
 
   /* Identify members. */
 
-  dec->members[member].representativeMember = parentMember;
+  dec->representatives[member] = parentMember;
 
   /* We add the member's edges to the parent's edge list and thereby remove the two marker edges. */
   if (dec->members[parentMember].firstEdge == parentEdge)
     dec->members[parentMember].firstEdge = dec->edges[parentEdge].next;
 
-  dec->edges[dec->edges[parentEdge].next].prev = dec->edges[childEdge].prev;
-  dec->edges[dec->edges[parentEdge].prev].next = dec->edges[childEdge].next;
-  dec->edges[dec->edges[childEdge].next].prev = dec->edges[parentEdge].prev;
-  dec->edges[dec->edges[childEdge].prev].next = dec->edges[parentEdge].next;
+  dec->edgeInfo[dec->edges[parentEdge].next].prev = dec->edgeInfo[childEdge].prev;
+  dec->edges[dec->edgeInfo[parentEdge].prev].next = dec->edges[childEdge].next;
+  dec->edgeInfo[dec->edges[childEdge].next].prev = dec->edgeInfo[parentEdge].prev;
+  dec->edges[dec->edgeInfo[childEdge].prev].next = dec->edges[parentEdge].next;
   dec->members[parentMember].numEdges += dec->members[member].numEdges - 2;
   dec->numEdges -= 2;
   dec->edges[parentEdge].next = dec->firstFreeEdge;
@@ -3798,6 +4411,7 @@ CMR_ERROR createParallelNodes(
     assert(dec->edges[edge].tail == SIZE_MAX);
     assert(dec->edges[edge].head == SIZE_MAX);
 
+    CMR_CALL( undoEdge(dec, edge) );
     dec->edges[edge].tail = tail;
     dec->edges[edge].head = head;
     edge = dec->edges[edge].next;
@@ -3835,14 +4449,20 @@ CMR_ERROR splitParallel(
   CMR_CALL( addEdgeToMembersEdgeList(dec, markerOfChildParallel) );
 
   CMR_CALL( removeEdgeFromMembersEdgeList(dec, edge1) );
+  CMR_CALL( undoEdge(dec, edge1) );
   dec->edges[edge1].member = childParallel;
   CMR_CALL( addEdgeToMembersEdgeList(dec, edge1) );
-  dec->members[findMember(dec, dec->edges[edge1].childMember)].parentMember = childParallel;
+  DEC_MEMBER childMember1 = findMember(dec, dec->edgeInfo[edge1].childMember);
+  CMR_CALL( undoMember(dec, childMember1) );
+  dec->parentMembers[childMember1] = childParallel;
 
   CMR_CALL( removeEdgeFromMembersEdgeList(dec, edge2) );
+  CMR_CALL( undoEdge(dec, edge2) );
   dec->edges[edge2].member = childParallel;
   CMR_CALL( addEdgeToMembersEdgeList(dec, edge2) );
-  dec->members[findMember(dec, dec->edges[edge2].childMember)].parentMember = childParallel;
+  DEC_MEMBER childMember2 = findMember(dec, dec->edgeInfo[edge2].childMember);
+  CMR_CALL( undoMember(dec, childMember2) );
+  dec->parentMembers[childMember2] = childParallel;
 
   if (pChildParallel)
     *pChildParallel = childParallel;
@@ -3911,8 +4531,8 @@ CMR_ERROR addColumnProcessParallel(
 
       assert(dec->members[member].numEdges == 3);
       CMR_CALL( createParallelNodes(dec, member) );
-      CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[0]].childMember, true) );
-      CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[1]].childMember,
+      CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[0]].childMember, true) );
+      CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[1]].childMember,
         reducedMember->firstPathEdge == NULL && reducedMember->type != TYPE_DOUBLE_CHILD) );
 
       debugDot(dec, newcolumn);
@@ -3940,7 +4560,7 @@ CMR_ERROR addColumnProcessParallel(
     }
     while (edge != dec->members[member].firstEdge);
 
-    CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[0]].childMember,
+    CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[0]].childMember,
       !reducedMember->firstPathEdge) );
 
     debugDot(dec, newcolumn);
@@ -3950,7 +4570,7 @@ CMR_ERROR addColumnProcessParallel(
 }
 
 static inline
-void flipEdge(
+CMR_ERROR flipEdge(
   Dec* dec,    /**< t-decomposition. */
   DEC_EDGE edge /**< edge. */
 )
@@ -3958,7 +4578,10 @@ void flipEdge(
   assert(dec);
   assert(edge < dec->memEdges);
 
+  CMR_CALL( undoEdge(dec, edge) );
   SWAP_INTS(dec->edges[edge].tail, dec->edges[edge].head);
+
+  return CMR_OKAY;
 }
 
 /**
@@ -4053,7 +4676,7 @@ CMR_ERROR addColumnProcessRigid(
         (pathEndNodes[0] == childMarkerNodes[0] || pathEndNodes[0] == childMarkerNodes[1])
         ? pathEndNodes[1] : pathEndNodes[0] ) );
 
-      DEC_MEMBER childMember = findMember(dec, dec->edges[childMarkerEdges[0]].childMember);
+      DEC_MEMBER childMember = findMember(dec, dec->edgeInfo[childMarkerEdges[0]].childMember);
       bool headToHead = pathEndNodes[0] == childMarkerNodes[1] || pathEndNodes[1] == childMarkerNodes[1];
       assert(headToHead || pathEndNodes[0] == childMarkerNodes[0] || pathEndNodes[1] == childMarkerNodes[0]);
 
@@ -4067,8 +4690,8 @@ CMR_ERROR addColumnProcessRigid(
       assert(reducedComponent->numTerminals == 2);
 
       DEC_MEMBER childMember[2] = {
-        findMember(dec, dec->edges[childMarkerEdges[0]].childMember),
-        findMember(dec, dec->edges[childMarkerEdges[1]].childMember)
+        findMember(dec, dec->edgeInfo[childMarkerEdges[0]].childMember),
+        findMember(dec, dec->edgeInfo[childMarkerEdges[1]].childMember)
       };
 
       /* Count to how many path end nodes each child marker is incident. */
@@ -4108,9 +4731,11 @@ CMR_ERROR addColumnProcessRigid(
 
         DEC_MEMBER newParallel = -1;
         CMR_CALL( createMember(dec, DEC_MEMBER_TYPE_PARALLEL, &newParallel) );
-        dec->members[newParallel].parentMember = member;
-        dec->members[childMember[0]].parentMember = newParallel;
-        dec->members[childMember[1]].parentMember = newParallel;
+        dec->parentMembers[newParallel] = member;
+        CMR_CALL( undoMember(dec, childMember[0]) );
+        CMR_CALL( undoMember(dec, childMember[1]) );
+        dec->parentMembers[childMember[0]] = newParallel;
+        dec->parentMembers[childMember[1]] = newParallel;
 
         DEC_EDGE markerOfParent, markerToParent;
         CMR_CALL( createMarkerEdgePair(dec, member, &markerOfParent, childMarkerNodes[0], childMarkerNodes[1],
@@ -4118,9 +4743,11 @@ CMR_ERROR addColumnProcessRigid(
 
         CMR_CALL( replaceEdgeInMembersEdgeList(dec, childMarkerEdges[0], markerOfParent) );
         CMR_CALL( addEdgeToMembersEdgeList(dec, markerToParent) );
+        CMR_CALL( undoEdge(dec, childMarkerEdges[0]) );
         dec->edges[childMarkerEdges[0]].member = newParallel;
         CMR_CALL( addEdgeToMembersEdgeList(dec, childMarkerEdges[0]) );
         CMR_CALL( removeEdgeFromMembersEdgeList(dec, childMarkerEdges[1]) );
+        CMR_CALL( undoEdge(dec, childMarkerEdges[1]) );
         dec->edges[childMarkerEdges[1]].member = newParallel;
         CMR_CALL( addEdgeToMembersEdgeList(dec, childMarkerEdges[1]) );
 
@@ -4134,10 +4761,10 @@ CMR_ERROR addColumnProcessRigid(
 
         /* We have to merge in the parallel. */
         CMR_CALL( createParallelNodes(dec, newParallel) );
-        CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[0]].childMember, true) );
+        CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[0]].childMember, true) );
         /* If there is no path, then we merge heads to heads. Otherwise, one head is mapped to tail, such that the path
          * is used. */
-        CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[1]].childMember, numPathEndNodes == 0) );
+        CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[1]].childMember, numPathEndNodes == 0) );
 
         debugDot(dec, newcolumn);
 
@@ -4187,7 +4814,7 @@ CMR_ERROR addColumnProcessRigid(
 
       CMR_CALL( addTerminal(dec, reducedComponent, member, pathEndNodes[1]) );
       if (parentMarkerNodes[0] == pathEndNodes[0])
-        flipEdge(dec, dec->members[member].markerToParent);
+        CMR_CALL( flipEdge(dec, dec->members[member].markerToParent) );
     }
     else
     {
@@ -4208,14 +4835,14 @@ CMR_ERROR addColumnProcessRigid(
         /* Flip parent if necessary. */
         if (pathEndNodes[0] == parentMarkerNodes[0])
         {
-          flipEdge(dec, dec->members[member].markerToParent);
+          CMR_CALL( flipEdge(dec, dec->members[member].markerToParent) );
           SWAP_INTS(parentMarkerNodes[0], parentMarkerNodes[1]);
         }
 
         assert(pathEndNodes[0] == parentMarkerNodes[1]);
 
         /* Merge child. */
-        CMR_CALL( mergeMemberIntoParent(dec, findMember(dec, dec->edges[childMarkerEdges[0]].childMember),
+        CMR_CALL( mergeMemberIntoParent(dec, findMember(dec, dec->edgeInfo[childMarkerEdges[0]].childMember),
           pathEndNodes[1] == childMarkerNodes[1]) );
         debugDot(dec, newcolumn);
       }
@@ -4225,9 +4852,9 @@ CMR_ERROR addColumnProcessRigid(
 
         /* Parent marker and child marker must be next to each other. */
         if (parentMarkerNodes[0] == childMarkerNodes[0] || parentMarkerNodes[0] == childMarkerNodes[1])
-          flipEdge(dec, dec->members[member].markerToParent);
+          CMR_CALL( flipEdge(dec, dec->members[member].markerToParent) );
 
-        CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[0]].childMember,
+        CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[0]].childMember,
           parentMarkerNodes[0] == childMarkerNodes[1] || parentMarkerNodes[1] == childMarkerNodes[1]) );
 
         debugDot(dec, newcolumn);
@@ -4258,21 +4885,25 @@ CMR_ERROR createEdgeParallel(
   DEC_MEMBER parentMember = findEdgeMember(dec, edge);
   DEC_MEMBER newParallel = -1;
   CMR_CALL( createMember(dec, DEC_MEMBER_TYPE_PARALLEL, &newParallel) );
-  dec->members[newParallel].parentMember = parentMember;
+  dec->parentMembers[newParallel] = parentMember;
 
   DEC_EDGE markerOfParent, markerToParent;
   CMR_CALL( createMarkerEdgePair(dec, parentMember, &markerOfParent, dec->edges[edge].tail, dec->edges[edge].head,
     newParallel, &markerToParent, -1, -1) );
+  CMR_CALL( undoEdge(dec, dec->edges[edge].next) );
+  CMR_CALL( undoEdge(dec, dec->edgeInfo[edge].prev) );
+  CMR_CALL( undoMember(dec, parentMember) );
   dec->edges[markerOfParent].next = dec->edges[edge].next;
-  dec->edges[markerOfParent].prev = dec->edges[edge].prev;
+  dec->edgeInfo[markerOfParent].prev = dec->edgeInfo[edge].prev;
   assert(dec->edges[markerOfParent].next != markerOfParent);
-  dec->edges[dec->edges[markerOfParent].next].prev = markerOfParent;
-  dec->edges[dec->edges[markerOfParent].prev].next = markerOfParent;
+  dec->edgeInfo[dec->edges[markerOfParent].next].prev = markerOfParent;
+  dec->edges[dec->edgeInfo[markerOfParent].prev].next = markerOfParent;
   if (dec->members[parentMember].firstEdge == edge)
     dec->members[parentMember].firstEdge = markerOfParent;
 
   CMR_CALL( addEdgeToMembersEdgeList(dec, markerToParent) );
 
+  CMR_CALL( undoEdge(dec, edge) );
   dec->edges[edge].member = newParallel;
   CMR_CALL( addEdgeToMembersEdgeList(dec, edge) );
 
@@ -4366,11 +4997,11 @@ CMR_ERROR splitSeries(
     {
 #if defined(CMR_DEBUG_SPLITTING)
       CMRdbgMsg(8, "Edge %d <%d>", edge, dec->edges[edge].name);
-      if (dec->edges[edge].childMember != SIZE_MAX)
-        CMRdbgMsg(0, " (with child %d)", dec->edges[edge].childMember);
+      if (dec->edgeInfo[edge].childMember != SIZE_MAX)
+        CMRdbgMsg(0, " (with child %d)", dec->edgeInfo[edge].childMember);
       if (edge == dec->members[member].markerToParent)
-        CMRdbgMsg(0, " (with parent %d)", dec->members[member].parentMember);
-      CMRdbgMsg(0, " (prev = %d, next = %d)", dec->edges[edge].prev, dec->edges[edge].next);
+        CMRdbgMsg(0, " (with parent %d)", dec->parentMembers[member]);
+      CMRdbgMsg(0, " (prev = %d, next = %d)", dec->edgeInfo[edge].prev, dec->edges[edge].next);
 #endif /* CMR_DEBUG_SPLITTING*/
 
       /* Evaluate predicate. */
@@ -4392,23 +5023,29 @@ CMR_ERROR splitSeries(
       assert(edge != dec->members[member].markerToParent);
 
       /* Remove edge from old edge list. */
-      DEC_EDGE oldPrev = dec->edges[edge].prev;
+      DEC_EDGE oldPrev = dec->edgeInfo[edge].prev;
       DEC_EDGE oldNext = dec->edges[edge].next;
+      CMR_CALL( undoEdge(dec, edge) );
+      CMR_CALL( undoEdge(dec, oldPrev) );
+      CMR_CALL( undoEdge(dec, oldNext) );
+      CMR_CALL( undoMember(dec, member) );
       dec->edges[oldPrev].next = oldNext;
-      dec->edges[oldNext].prev = oldPrev;
+      dec->edgeInfo[oldNext].prev = oldPrev;
       dec->members[member].numEdges--;
 
       /* Add edge to new edge list. */
-      DEC_EDGE newPrev = dec->edges[seriesParentMarker].prev;
+      DEC_EDGE newPrev = dec->edgeInfo[seriesParentMarker].prev;
+      CMR_CALL( undoEdge(dec, newPrev) );
       dec->edges[newPrev].next = edge;
-      dec->edges[seriesParentMarker].prev = edge;
-      dec->edges[edge].prev = newPrev;
+      dec->edgeInfo[seriesParentMarker].prev = edge;
+      dec->edgeInfo[edge].prev = newPrev;
       dec->edges[edge].next = seriesParentMarker;
       dec->edges[edge].member = series;
-      if (dec->edges[edge].childMember != SIZE_MAX)
+      if (dec->edgeInfo[edge].childMember != SIZE_MAX)
       {
-        assert( dec->members[dec->edges[edge].childMember].parentMember == member);
-        dec->members[dec->edges[edge].childMember].parentMember = series;
+        assert( dec->parentMembers[dec->edgeInfo[edge].childMember] == member);
+        CMR_CALL( undoMember(dec, dec->edgeInfo[edge].childMember) );
+        dec->parentMembers[dec->edgeInfo[edge].childMember] = series;
       }
       dec->members[series].numEdges++;
 
@@ -4428,11 +5065,14 @@ CMR_ERROR splitSeries(
     DEC_EDGE memberChildMarker, parallelParentMarker;
     CMR_CALL( createMarkerEdgePair(dec, member, &memberChildMarker, -1, -1, parallel, &parallelParentMarker, -1, -1) );
     CMR_CALL( addEdgeToMembersEdgeList(dec, parallelParentMarker) );
-    DEC_EDGE oldPrev = dec->edges[firstEdge].prev;
+    DEC_EDGE oldPrev = dec->edgeInfo[firstEdge].prev;
+    CMR_CALL( undoEdge(dec, oldPrev) );
+    CMR_CALL( undoEdge(dec, firstEdge) );
+    CMR_CALL( undoMember(dec, member) );
     dec->edges[memberChildMarker].next = firstEdge;
-    dec->edges[memberChildMarker].prev = oldPrev;
+    dec->edgeInfo[memberChildMarker].prev = oldPrev;
     dec->edges[oldPrev].next = memberChildMarker;
-    dec->edges[firstEdge].prev = memberChildMarker;
+    dec->edgeInfo[firstEdge].prev = memberChildMarker;
     dec->members[member].numEdges++;
 
 #if defined(CMR_DEBUG_SPLITTING)
@@ -4551,7 +5191,7 @@ CMR_ERROR addColumnProcessSeries(
 
       debugDot(dec, newcolumn);
 
-      DEC_EDGE childMember = dec->edges[representativeEdge].childMember;
+      DEC_EDGE childMember = dec->edgeInfo[representativeEdge].childMember;
       DEC_NODE tail = SIZE_MAX;
       DEC_NODE head = SIZE_MAX;
       if (childMember == SIZE_MAX)
@@ -4605,7 +5245,8 @@ CMR_ERROR addColumnProcessSeries(
         CMR_CALL( setEdgeNodes(dec, dec->members[member].markerToParent, a, b) );
         CMR_CALL( setEdgeNodes(dec, childMarkerEdges[0], c, b) );
         CMR_CALL( addTerminal(dec, reducedComponent, member, a) );
-        CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[0]].childMember, true) );
+        CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[0]].childMember, true) );
+        CMR_CALL( undoMember(dec, member) );
         dec->members[member].type = DEC_MEMBER_TYPE_RIGID;
       }
       else
@@ -4645,7 +5286,7 @@ CMR_ERROR addColumnProcessSeries(
         CMR_CALL( setEdgeNodes(dec, pathEdge, a, b) );
         CMR_CALL( setEdgeNodes(dec, childMarkerEdges[0], c, a) );
         CMR_CALL( addTerminal(dec, reducedComponent, member, b) );
-        CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[0]].childMember, true) );
+        CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[0]].childMember, true) );
       }
       debugDot(dec, newcolumn);
     }
@@ -4759,8 +5400,9 @@ CMR_ERROR addColumnProcessSeries(
         CMRdbgMsg(8 + 2*depth, "Non-path edge %d = {%d, %d}\n", nonPathEdge, d, a);
       }
 
-      CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[0]].childMember, true) );
-      CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[1]].childMember, true) );
+      CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[0]].childMember, true) );
+      CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[1]].childMember, true) );
+      CMR_CALL( undoMember(dec, member) );
       dec->members[member].type = DEC_MEMBER_TYPE_RIGID;
     }
   }
@@ -4893,7 +5535,7 @@ CMR_ERROR addColumnProcessSeries(
       }
       debugDot(dec, newcolumn);
 
-      CMR_CALL( mergeMemberIntoParent(dec, dec->edges[childMarkerEdges[0]].childMember, true) );
+      CMR_CALL( mergeMemberIntoParent(dec, dec->edgeInfo[childMarkerEdges[0]].childMember, true) );
       debugDot(dec, newcolumn);
 
       return CMR_OKAY;
@@ -4992,11 +5634,14 @@ CMR_ERROR doReorderComponent(
 
   CMRdbgMsg(8, "Flipping parenting of member %d with old parent %d and new parent %d.\n", member, oldParent, newParent);
 
+  CMR_CALL( undoMember(dec, member) );
+  CMR_CALL( undoEdge(dec, markerOfNewParent) );
+  CMR_CALL( undoEdge(dec, newMarkerToParent) );
   dec->members[member].markerToParent = newMarkerToParent;
   dec->members[member].markerOfParent = markerOfNewParent;
-  dec->members[member].parentMember = newParent;
-  dec->edges[markerOfNewParent].childMember = member;
-  dec->edges[newMarkerToParent].childMember = -1;
+  dec->parentMembers[member] = newParent;
+  dec->edgeInfo[markerOfNewParent].childMember = member;
+  dec->edgeInfo[newMarkerToParent].childMember = -1;
 
   if (oldMarkerToParent != SIZE_MAX)
     CMR_CALL( doReorderComponent(dec, oldParent, member, oldMarkerOfParent, oldMarkerToParent) );
@@ -5020,7 +5665,7 @@ CMR_ERROR reorderComponent(
 
   CMRdbgMsg(4, "Making member %d the new root of its component.\n", newRoot);
 
-  if (dec->members[newRoot].parentMember != SIZE_MAX)
+  if (dec->parentMembers[newRoot] != SIZE_MAX)
   {
     CMR_CALL( doReorderComponent(dec, findMemberParent(dec, newRoot), newRoot,
       dec->members[newRoot].markerOfParent, dec->members[newRoot].markerToParent) );
@@ -5095,11 +5740,11 @@ CMR_ERROR addColumnApply(
     DEC_EDGE newEdge;
     CMR_CALL( createEdge(dec, -1, &newEdge) );
     componentNewEdges[i] = newEdge;
-    dec->edges[newEdge].childMember = -1;
+    dec->edgeInfo[newEdge].childMember = -1;
     dec->edges[newEdge].member = findMember(dec, reducedComponent->terminalMember[0]);
     dec->edges[newEdge].head = reducedComponent->terminalNode[0];
     dec->edges[newEdge].tail = reducedComponent->terminalNode[1];
-    dec->edges[newEdge].element = 0;
+    dec->edgeInfo[newEdge].element = 0;
     CMR_CALL( addEdgeToMembersEdgeList(dec, newEdge) );
   }
 
@@ -5118,14 +5763,14 @@ CMR_ERROR addColumnApply(
     DEC_MEMBER loopEdge;
     CMR_CALL( createEdge(dec, loopMember, &loopEdge) );
     CMR_CALL( addEdgeToMembersEdgeList(dec, loopEdge) );
-    dec->edges[loopEdge].element = CMRcolumnToElement(column);
-    dec->edges[loopEdge].childMember = -1;
+    dec->edgeInfo[loopEdge].element = CMRcolumnToElement(column);
+    dec->edgeInfo[loopEdge].childMember = -1;
   }
   else if (newcolumn->numReducedComponents == 1)
   {
     DEC_EDGE columnEdge = componentNewEdges[0];
-    dec->edges[columnEdge].element = CMRcolumnToElement(column);
-    dec->edges[columnEdge].childMember = -1;
+    dec->edgeInfo[columnEdge].element = CMRcolumnToElement(column);
+    dec->edgeInfo[columnEdge].childMember = -1;
   }
   else
   {
@@ -5136,10 +5781,10 @@ CMR_ERROR addColumnApply(
 
     DEC_EDGE columnEdge;
     CMR_CALL( createEdge(dec, series, &columnEdge) );
-    dec->edges[columnEdge].childMember = -1;
+    dec->edgeInfo[columnEdge].childMember = -1;
     dec->edges[columnEdge].head = -1;
     dec->edges[columnEdge].tail = -1;
-    dec->edges[columnEdge].element = CMRcolumnToElement(column);
+    dec->edgeInfo[columnEdge].element = CMRcolumnToElement(column);
     CMR_CALL( addEdgeToMembersEdgeList(dec, columnEdge) );
 
     for (size_t i = 0; i < newcolumn->numReducedComponents; ++i)
@@ -5155,22 +5800,23 @@ CMR_ERROR addColumnApply(
 
       if (i == maxDepthComponent)
       {
-        dec->edges[markerEdge].childMember = -1;
-        dec->edges[markerEdge].element = INT_MAX - dec->numMarkerPairs;
-        dec->members[series].parentMember = partnerMember;
+        dec->edgeInfo[markerEdge].childMember = -1;
+        dec->edgeInfo[markerEdge].element = INT_MAX - dec->numMarkerPairs;
+        dec->parentMembers[series] = partnerMember;
         dec->members[series].markerToParent = markerEdge;
         dec->members[series].markerOfParent = newEdge;
-        dec->edges[newEdge].element = -INT_MAX + dec->numMarkerPairs;
-        dec->edges[newEdge].childMember = series;
+        dec->edgeInfo[newEdge].element = -INT_MAX + dec->numMarkerPairs;
+        dec->edgeInfo[newEdge].childMember = series;
       }
       else
       {
-        dec->edges[markerEdge].childMember = partnerMember;
+        CMR_CALL( undoMember(dec, partnerMember) );
+        dec->edgeInfo[markerEdge].childMember = partnerMember;
         dec->members[partnerMember].markerOfParent = markerEdge;
         dec->members[partnerMember].markerToParent = newEdge;
-        dec->members[partnerMember].parentMember = series;
-        dec->edges[markerEdge].element = INT_MAX - dec->numMarkerPairs;
-        dec->edges[newEdge].element = -INT_MAX + dec->numMarkerPairs;
+        dec->parentMembers[partnerMember] = series;
+        dec->edgeInfo[markerEdge].element = INT_MAX - dec->numMarkerPairs;
+        dec->edgeInfo[newEdge].element = -INT_MAX + dec->numMarkerPairs;
       }
 
       dec->numMarkerPairs++;
@@ -5191,72 +5837,310 @@ CMR_ERROR addColumnApply(
   return CMR_OKAY;
 }
 
+/**
+ * \brief Incremental cographicness test for views of a fixed matrix.
+ *
+ * The rows of a view are added to the decomposition one by one, creating a checkpoint before each of them. When the
+ * next view is tested, the decomposition is rolled back only to the first row whose nonzeros differ from those in
+ * the previous view, which avoids repeating the work for the common leading rows.
+ */
+
+typedef struct
+{
+  CMR* cmr;                   /**< \brief \ref CMR environment that owns the decomposition. */
+  CMR_CHRMAT* matrix;         /**< \brief Underlying matrix of the views. */
+  Dec* dec;                   /**< \brief Decomposition of the first \c numApplied rows of the previous view. */
+  DEC_NEWCOLUMN* newcolumn;   /**< \brief Information for adding a row. */
+  size_t numApplied;          /**< \brief Number of rows that were added; equal to the number of checkpoints. */
+  bool* rowsMasked;           /**< \brief Array indicating the masked rows of the previous view. */
+  bool* columnsMasked;        /**< \brief Array indicating the masked columns of the previous view. */
+  size_t* firstRows;          /**< \brief Array with the first row of each column with a nonzero, or \c SIZE_MAX. */
+  size_t* rowEntries;         /**< \brief Array for storing the unmasked nonzeros of a row. */
+} IncrementalCographicness;
+
+/**
+ * \brief Creates an \ref IncrementalCographicness structure for views of \p matrix.
+ */
+
+static
+CMR_ERROR incrementalCographicnessCreate(
+  CMR* cmr,                               /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,                     /**< Underlying matrix of the views. */
+  IncrementalCographicness** pincremental /**< Pointer for storing the structure. */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(pincremental);
+
+  CMR_CALL( CMRallocBlock(cmr, pincremental) );
+  IncrementalCographicness* incremental = *pincremental;
+  incremental->cmr = cmr;
+  incremental->matrix = matrix;
+  incremental->dec = NULL;
+  incremental->newcolumn = NULL;
+  CMR_CALL( decAcquire(cmr, matrix->numRows, matrix->numColumns, matrix->numNonzeros, &incremental->dec,
+    &incremental->newcolumn) );
+  incremental->numApplied = 0;
+
+  incremental->rowsMasked = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &incremental->rowsMasked, matrix->numRows) );
+  for (size_t row = 0; row < matrix->numRows; ++row)
+    incremental->rowsMasked[row] = false;
+  incremental->columnsMasked = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &incremental->columnsMasked, matrix->numColumns) );
+  incremental->firstRows = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &incremental->firstRows, matrix->numColumns) );
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+  {
+    incremental->columnsMasked[column] = false;
+    incremental->firstRows[column] = SIZE_MAX;
+  }
+  for (size_t row = matrix->numRows; row > 0; --row)
+  {
+    for (size_t entry = matrix->rowSlice[row-1]; entry < matrix->rowSlice[row]; ++entry)
+      incremental->firstRows[matrix->entryColumns[entry]] = row - 1;
+  }
+  incremental->rowEntries = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &incremental->rowEntries, matrix->numColumns) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Frees an \ref IncrementalCographicness structure.
+ */
+
+static
+CMR_ERROR incrementalCographicnessFree(
+  CMR* cmr,                               /**< \ref CMR environment. */
+  IncrementalCographicness** pincremental /**< Pointer to the structure. */
+)
+{
+  assert(cmr);
+  assert(pincremental);
+
+  IncrementalCographicness* incremental = *pincremental;
+  if (!incremental)
+    return CMR_OKAY;
+
+  CMR_CALL( CMRfreeBlockArray(cmr, &incremental->rowEntries) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &incremental->firstRows) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &incremental->columnsMasked) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &incremental->rowsMasked) );
+  CMR_CALL( decRelease(cmr, &incremental->dec, &incremental->newcolumn) );
+  CMR_CALL( CMRfreeBlock(cmr, pincremental) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Rolls the decomposition of \p incremental back to the state before row \p row was added.
+ */
+
+static
+CMR_ERROR incrementalCographicnessRollback(
+  IncrementalCographicness* incremental,  /**< Incremental cographicness test. */
+  size_t row                              /**< First row to be removed. */
+)
+{
+  assert(incremental);
+  assert(row <= incremental->numApplied);
+
+  Dec* dec = incremental->dec;
+  DEC_NEWCOLUMN* newcolumn = incremental->newcolumn;
+
+  /* The path edges of the last check must be removed while the decomposition still contains them. */
+  CMR_CALL( removeAllPathEdges(dec, newcolumn) );
+  newcolumn->numReducedMembers = 0;
+  newcolumn->numReducedComponents = 0;
+
+  if (row < dec->numCheckpoints)
+  {
+    /* The entries of newcolumn for merged members and nodes are never cleaned up since these are not used anymore.
+     * The rollback revives only objects that were modified or created after the checkpoint, so we clean up theirs. */
+    DecCheckpoint* checkpoint = &dec->checkpoints[row];
+    for (size_t u = checkpoint->numUndos; u < dec->numUndos; ++u)
+    {
+      size_t index = dec->undos[u].index;
+      if (dec->undos[u].type == DEC_UNDO_MEMBER && index < newcolumn->memReducedMembers)
+      {
+        newcolumn->memberInfo[index].reducedMember = NULL;
+        newcolumn->memberInfo[index].rootDepthMinimizer = NULL;
+      }
+      else if (dec->undos[u].type == DEC_UNDO_EDGE && index < newcolumn->memEdgesInPath)
+        newcolumn->edgesInPath[index] = false;
+      else if (dec->undos[u].type == DEC_UNDO_NODE && index < newcolumn->memNodesDegree)
+        newcolumn->nodesDegree[index] = 0;
+    }
+    for (size_t m = checkpoint->numMembers; m < dec->numMembers && m < newcolumn->memReducedMembers; ++m)
+    {
+      newcolumn->memberInfo[m].reducedMember = NULL;
+      newcolumn->memberInfo[m].rootDepthMinimizer = NULL;
+    }
+    for (size_t e = checkpoint->memEdges; e < dec->memEdges && e < newcolumn->memEdgesInPath; ++e)
+      newcolumn->edgesInPath[e] = false;
+    for (size_t v = checkpoint->memNodes; v < dec->memNodes && v < newcolumn->memNodesDegree; ++v)
+      newcolumn->nodesDegree[v] = 0;
+
+    CMR_CALL( decRollback(dec, row) );
+  }
+  incremental->numApplied = row;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Tests \p view for cographicness, reusing the decomposition of the common leading rows of the previous
+ *        view.
+ */
+
+static
+CMR_ERROR incrementalCographicnessTest(
+  CMR* cmr,                               /**< \ref CMR environment. */
+  IncrementalCographicness* incremental,  /**< Incremental cographicness test. */
+  CMR_CHRMAT_VIEW* view,                  /**< View of the matrix of \p incremental. */
+  bool* pisCographic                      /**< Pointer for storing whether \p view is cographic. */
+)
+{
+  assert(cmr);
+  assert(incremental);
+  assert(view);
+  assert(view->matrix == incremental->matrix);
+  assert(pisCographic);
+
+  CMR_CHRMAT* matrix = incremental->matrix;
+  Dec* dec = incremental->dec;
+  DEC_NEWCOLUMN* newcolumn = incremental->newcolumn;
+
+  /* Find the first row whose nonzeros differ from those in the previous view and update the masks. */
+  size_t firstChanged = incremental->numApplied;
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    bool masked = CMRchrmatViewRowMasked(view, row);
+    if (masked != incremental->rowsMasked[row])
+    {
+      incremental->rowsMasked[row] = masked;
+      if (row < firstChanged)
+        firstChanged = row;
+    }
+  }
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+  {
+    bool masked = CMRchrmatViewColumnMasked(view, column);
+    if (masked != incremental->columnsMasked[column])
+    {
+      incremental->columnsMasked[column] = masked;
+      if (incremental->firstRows[column] < firstChanged)
+        firstChanged = incremental->firstRows[column];
+    }
+  }
+
+  CMRdbgMsg(0, "Incremental cographicness test reuses %zu of %zu rows.\n", firstChanged, incremental->numApplied);
+  CMR_CALL( incrementalCographicnessRollback(incremental, firstChanged) );
+
+  *pisCographic = true;
+  size_t pollCounter = 0;
+  for (size_t row = incremental->numApplied; row < matrix->numRows; ++row)
+  {
+    if (CMRdeadlinePoll(cmr, &pollCounter))
+      return CMR_ERROR_TIMEOUT;
+
+    CMR_CALL( decCheckpoint(dec, NULL) );
+    size_t numRowEntries = CMRchrmatViewRowColumns(view, row, incremental->rowEntries);
+    CMR_CALL( addColumnCheck(dec, newcolumn, incremental->rowEntries, numRowEntries) );
+    if (!newcolumn->remainsGraphic)
+    {
+      /* We undo the modifications of the check, e.g., the path compressions. */
+      *pisCographic = false;
+      CMR_CALL( incrementalCographicnessRollback(incremental, row) );
+      break;
+    }
+
+    CMR_CALL( addColumnApply(dec, newcolumn, row, incremental->rowEntries, numRowEntries) );
+    incremental->numApplied++;
+  }
+
+  return CMR_OKAY;
+}
+
 static
 CMR_ERROR cographicnessTest(
   CMR* cmr,                 /**< \ref CMR environment. */
-  CMR_CHRMAT* matrix,       /**< Some matrix to be tested for cographicness. */
-  void* data,               /**< Additional data (must be \c NULL). */
-  bool* pisCographic,       /**< Pointer for storing whether \p matrix is cographic. */
-  CMR_SUBMAT** psubmatrix,  /**< Pointer for storing a proper non-cographic submatrix of \p matrix. */
-  double timeLimit          /**< Time limit to impose. */
+  CMR_CHRMAT_VIEW* view,    /**< View of some matrix to be tested for cographicness. */
+  void* data,               /**< An \ref IncrementalCographicness structure (may be \c NULL). */
+  bool* pisCographic,       /**< Pointer for storing whether \p view is cographic. */
+  CMR_SUBMAT** psubmatrix   /**< Pointer for storing a proper non-cographic submatrix of \p view. */
 )
 {
   assert(cmr);
-  assert(matrix);
-  assert(!data);
+  assert(view);
   assert(pisCographic);
   assert(!psubmatrix || !*psubmatrix);
 
+  CMR_CHRMAT* matrix = view->matrix;
+
+  /* The incremental test may only be used by the environment that owns it since tests can run in parallel. */
+  IncrementalCographicness* incremental = (IncrementalCographicness*) data;
+  if (incremental && incremental->cmr == cmr && incremental->matrix == matrix)
+    return incrementalCographicnessTest(cmr, incremental, view, pisCographic);
+
 #if defined(CMR_DEBUG)
-  CMRdbgMsg(0, "cographicnessTest called for a %dx%d matrix\n", matrix->numRows, matrix->numColumns);
+  CMRdbgMsg(0, "cographicnessTest called for a view on a %dx%d matrix\n", matrix->numRows, matrix->numColumns);
   CMRchrmatPrintDense(cmr, matrix, stdout, '0', false);
 #endif /* CMR_DEBUG */
 
   *pisCographic = true;
-  Dec* dec = NULL;
-  clock_t time = clock();
   if (matrix->numNonzeros > 0)
   {
-    CMR_CALL( decCreate(cmr, &dec, 4096, 1024, 256, 256, 256) );
-
-    /* Process each column. */
+    Dec* dec = NULL;
     DEC_NEWCOLUMN* newcolumn = NULL;
-    CMR_CALL( newcolumnCreate(cmr, &newcolumn) );
-    size_t columnTimeFactor = matrix->numRows / 100 + 1;
+    CMR_CALL( decAcquire(cmr, matrix->numRows, matrix->numColumns, matrix->numNonzeros, &dec, &newcolumn) );
+
+    /* Process each column, taking its unmasked entries directly from the view. Masked columns are empty. */
+    size_t* columnEntries = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &columnEntries, matrix->numColumns) );
+    size_t pollCounter = 0;
     for (size_t column = 0; column < matrix->numRows && *pisCographic; ++column)
     {
-      if ((column % columnTimeFactor == 0) && (clock() - time) * 1.0 / CLOCKS_PER_SEC > timeLimit)
+      if (CMRdeadlinePoll(cmr, &pollCounter))
       {
-        CMR_CALL( newcolumnFree(cmr, &newcolumn) );
-        if (dec)
-          CMR_CALL( decFree(&dec) );
+        CMR_CALL( CMRfreeStackArray(cmr, &columnEntries) );
+        CMR_CALL( decRelease(cmr, &dec, &newcolumn) );
         return CMR_ERROR_TIMEOUT;
       }
-      
-      CMR_CALL( addColumnCheck(dec, newcolumn, &matrix->entryColumns[matrix->rowSlice[column]],
-        matrix->rowSlice[column+1] - matrix->rowSlice[column]) );
+
+      size_t numColumnEntries = CMRchrmatViewRowColumns(view, column, columnEntries);
+      CMR_CALL( addColumnCheck(dec, newcolumn, columnEntries, numColumnEntries) );
 
       if (newcolumn->remainsGraphic)
-      {
-        CMR_CALL( addColumnApply(dec, newcolumn, column, &matrix->entryColumns[matrix->rowSlice[column]],
-          matrix->rowSlice[column+1] - matrix->rowSlice[column]) );
-      }
+        CMR_CALL( addColumnApply(dec, newcolumn, column, columnEntries, numColumnEntries) );
       else
         *pisCographic = false;
     }
 
-    CMR_CALL( newcolumnFree(cmr, &newcolumn) );
+    CMR_CALL( CMRfreeStackArray(cmr, &columnEntries) );
+    CMR_CALL( decRelease(cmr, &dec, &newcolumn) );
   }
 
-  if (dec)
-    CMR_CALL( decFree(&dec) );
-
   return CMR_OKAY;
 }
 
-CMR_ERROR CMRtestCographicMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCographic, CMR_GRAPH** pgraph,
-  CMR_GRAPH_EDGE** pforestEdges, CMR_GRAPH_EDGE** pcoforestEdges, CMR_SUBMAT** psubmatrix,
-  CMR_GRAPHIC_STATISTICS* stats, double timeLimit)
+/**
+ * \brief Carries out \ref CMRtestCographicMatrix once its deadline was set.
+ */
+
+static
+CMR_ERROR testCographicMatrix(
+  CMR* cmr,                         /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,               /**< Matrix \f$ M \f$. */
+  bool* pisCographic,               /**< Pointer for storing whether \f$ M \f$ is cographic. */
+  CMR_GRAPH** pgraph,               /**< Pointer for storing the graph (may be \c NULL). */
+  CMR_GRAPH_EDGE** pforestEdges,    /**< Pointer for storing the spanning forest (may be \c NULL). */
+  CMR_GRAPH_EDGE** pcoforestEdges,  /**< Pointer for storing the complementing forest (may be \c NULL). */
+  CMR_SUBMAT** psubmatrix,          /**< Pointer for storing a minimal non-cographic submatrix (may be \c NULL). */
+  CMR_GRAPHIC_STATISTICS* stats     /**< Statistics for the computation (may be \c NULL). */
+)
 {
   assert(cmr);
   assert(matrix);
@@ -5274,22 +6158,19 @@ CMR_ERROR CMRtestCographicMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCographi
   *pisCographic = true;
 
   Dec* dec = NULL;
+  DEC_NEWCOLUMN* newcolumn = NULL;
   if (matrix->numNonzeros > 0)
   {
-    CMR_CALL( decCreate(cmr, &dec, 4096, 1024, 256, 256, 256) );
+    CMR_CALL( decAcquire(cmr, matrix->numRows, matrix->numColumns, matrix->numNonzeros, &dec, &newcolumn) );
 
     /* Process each column. */
-    DEC_NEWCOLUMN* newcolumn = NULL;
-    CMR_CALL( newcolumnCreate(cmr, &newcolumn) );
+    size_t pollCounter = 0;
     for (size_t column = 0; column < matrix->numRows && *pisCographic; ++column)
     {
-      clock_t checkClock = clock();
-      double remainingTime = timeLimit - (checkClock - time) * 1.0 / CLOCKS_PER_SEC;
-      if (remainingTime < 0)
+      clock_t checkClock = (stats ? clock() : 0);
+      if (CMRdeadlinePoll(cmr, &pollCounter))
       {
-        CMR_CALL( newcolumnFree(cmr, &newcolumn) );
-        if (dec)
-          CMR_CALL( decFree(&dec) );
+        CMR_CALL( decRelease(cmr, &dec, &newcolumn) );
         return CMR_ERROR_TIMEOUT;
       }
       CMR_CALL( addColumnCheck(dec, newcolumn, &matrix->entryColumns[matrix->rowSlice[column]],
@@ -5318,8 +6199,6 @@ CMR_ERROR CMRtestCographicMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCographi
       else
         *pisCographic = false;
     }
-
-    CMR_CALL( newcolumnFree(cmr, &newcolumn) );
   }
 
   if (*pisCographic)
@@ -5337,14 +6216,14 @@ CMR_ERROR CMRtestCographicMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCographi
       graph = *pgraph;
     }
 
-    int* forest = NULL;
+    CMR_GRAPH_EDGE* forest = NULL;
     if (pforestEdges)
     {
       if (!*pforestEdges)
         CMR_CALL( CMRallocBlockArray(cmr, pforestEdges, matrix->numColumns) );
       forest = *pforestEdges;
     }
-    int* coforest = NULL;
+    CMR_GRAPH_EDGE* coforest = NULL;
     if (pcoforestEdges)
     {
       if (!*pcoforestEdges)
@@ -5375,10 +6254,10 @@ CMR_ERROR CMRtestCographicMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCographi
             DEC_EDGE edge;
             CMR_CALL( createEdge(dec, member, &edge) );
             CMR_CALL( addEdgeToMembersEdgeList(dec, edge) );
-            dec->edges[edge].element = CMRrowToElement(r);
+            dec->edgeInfo[edge].element = CMRrowToElement(r);
             dec->edges[edge].head = -1;
             dec->edges[edge].tail = -1;
-            dec->edges[edge].childMember = -1;
+            dec->edgeInfo[edge].childMember = -1;
 
             CMRdbgMsg(8, "New empty row %d is edge %d of member %d.\n", r, edge, member);
 
@@ -5421,13 +6300,17 @@ CMR_ERROR CMRtestCographicMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCographi
   }
 
   if (dec)
-    CMR_CALL( decFree(&dec) );
+    CMR_CALL( decRelease(cmr, &dec, &newcolumn) );
 
   if (!*pisCographic && psubmatrix)
   {
-    /* Find submatrix. */
-    double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-    CMR_CALL( CMRtestHereditaryPropertySimple(cmr, matrix, cographicnessTest, NULL, psubmatrix, remainingTime) );
+    /* Find submatrix. Consecutive views mostly differ in late rows, so the tests are carried out incrementally. */
+    IncrementalCographicness* incremental = NULL;
+    CMR_CALL( incrementalCographicnessCreate(cmr, matrix, &incremental) );
+    CMR_ERROR error = CMRtestHereditaryProperty(cmr, matrix, HEREDITARY_PROPERTY_GROUP, cographicnessTest,
+      incremental, psubmatrix);
+    CMR_CALL( incrementalCographicnessFree(cmr, &incremental) );
+    CMR_CALL( error );
   }
 
   if (stats)
@@ -5439,6 +6322,18 @@ CMR_ERROR CMRtestCographicMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCographi
   return CMR_OKAY;
 }
 
+CMR_ERROR CMRtestCographicMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisCographic, CMR_GRAPH** pgraph,
+  CMR_GRAPH_EDGE** pforestEdges, CMR_GRAPH_EDGE** pcoforestEdges, CMR_SUBMAT** psubmatrix,
+  CMR_GRAPHIC_STATISTICS* stats, double timeLimit)
+{
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = testCographicMatrix(cmr, matrix, pisCographic, pgraph, pforestEdges, pcoforestEdges, psubmatrix,
+    stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  return error;
+}
+
 CMR_ERROR CMRtestBinaryGraphicColumnSubmatrixGreedy(CMR* cmr, CMR_CHRMAT* transpose, size_t* orderedColumns,
   CMR_SUBMAT** psubmatrix)
 {
@@ -5465,11 +6360,10 @@ CMR_ERROR CMRtestBinaryGraphicColumnSubmatrixGreedy(CMR* cmr, CMR_CHRMAT* transp
 
   /* Try to add each column. */
   Dec* dec = NULL;
-  CMR_CALL( decCreate(cmr, &dec, 4096, 1024, 256, 256, 256) );
+  DEC_NEWCOLUMN* newcolumn = NULL;
+  CMR_CALL( decAcquire(cmr, transpose->numRows, transpose->numColumns, transpose->numNonzeros, &dec, &newcolumn) );
 
   /* Process each column. */
-  DEC_NEWCOLUMN* newcolumn = NULL;
-  CMR_CALL( newcolumnCreate(cmr, &newcolumn) );
   for (size_t c = 0; c < numColumns; ++c)
   {
     size_t column = orderedColumns ? orderedColumns[c] : c;
@@ -5490,8 +6384,7 @@ CMR_ERROR CMRtestBinaryGraphicColumnSubmatrixGreedy(CMR* cmr, CMR_CHRMAT* transp
     }
   }
 
-  CMR_CALL( newcolumnFree(cmr, &newcolumn) );
-  CMR_CALL( decFree(&dec) );
+  CMR_CALL( decRelease(cmr, &dec, &newcolumn) );
 
   return CMR_OKAY;
 }
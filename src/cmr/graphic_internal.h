@@ -3,6 +3,29 @@
 
 #include <cmr/graphic.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Memory that is reused by consecutive (co)graphicness tests.
+ *
+ * Each environment owns one workspace, which is created by the first test. It holds the decomposition of the last
+ * test, which the next test reuses unless it is much larger than needed. Environments forked from another one hand
+ * their workspaces to their parent together with their stacks.
+ */
+
+typedef struct _CMR_GRAPHIC_WORKSPACE CMR_GRAPHIC_WORKSPACE;
+
+/**
+ * \brief Frees a \ref CMR_GRAPHIC_WORKSPACE.
+ */
+
+CMR_ERROR CMRgraphicWorkspaceFree(
+  CMR* cmr,                           /**< \ref CMR environment. */
+  CMR_GRAPHIC_WORKSPACE** pworkspace  /**< Pointer to the workspace (may point to \c NULL). */
+);
+
 /**
  * \brief Computes the network or graphic matrix of a given (di)graph \f$ D = (V,A) \f$.
  *
@@ -33,4 +56,8 @@ CMR_ERROR CMRcomputeRepresentationMatrix(
                                    **  \f$ D \f$'s underlying undirected graph (may be \c NULL). */
 );
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* CMR_GRAPHIC_INTERNAL_H */
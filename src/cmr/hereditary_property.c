@@ -1,18 +1,19 @@
 #define CMR_DEBUG /* Uncomment to debug. */
 
 #include "hereditary_property.h"
+#include "threadpool.h"
+
 #include <stdint.h>
-#include <time.h>
+#include <string.h>
 
 CMR_ERROR CMRtestHereditaryPropertySimple(CMR* cmr, CMR_CHRMAT* matrix, HereditaryPropertyTest testFunction,
-  void* testData, CMR_SUBMAT** psubmatrix, double timeLimit)
+  void* testData, CMR_SUBMAT** psubmatrix)
 {
   assert(cmr);
   assert(matrix);
   assert(testFunction);
   assert(psubmatrix);
 
-  clock_t time = clock();
   size_t* essentialRows = NULL;
   size_t numEssentialRows = 0;
   CMR_CALL( CMRallocStackArray(cmr, &essentialRows, matrix->numRows) );
@@ -28,91 +29,360 @@ CMR_ERROR CMRtestHereditaryPropertySimple(CMR* cmr, CMR_CHRMAT* matrix, Heredita
   for (size_t column = 0; column < matrix->numColumns; ++column)
     candidates[matrix->numRows + column] = CMRcolumnToElement(column);
 
-  CMR_CHRMAT* current = NULL;
-  CMR_CALL( CMRchrmatCopy(cmr, matrix, &current) );
+  /* The current matrix is the input matrix with the removed rows and columns masked. */
+  bool* rowsRemoved = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowsRemoved, matrix->numRows) );
+  for (size_t row = 0; row < matrix->numRows; ++row)
+    rowsRemoved[row] = false;
+  bool* columnsRemoved = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnsRemoved, matrix->numColumns) );
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+    columnsRemoved[column] = false;
 
-  CMR_CHRMAT* candidateMatrix = NULL;
-  CMR_CALL( CMRchrmatCreate(cmr, &candidateMatrix, matrix->numRows, matrix->numColumns, matrix->numNonzeros) );
-  candidateMatrix->numNonzeros = 0;
+  CMR_CHRMAT_VIEW view = { matrix, rowsRemoved, columnsRemoved, SIZE_MAX, SIZE_MAX };
 
+  CMR_ERROR error = CMR_OKAY;
   while (numCandidates > 0)
   {
-    CMR_ELEMENT candidateElement = candidates[--numCandidates];
-    size_t removedRow = SIZE_MAX;
-    size_t removedColumn = SIZE_MAX;
-    if (CMRelementIsRow(candidateElement))
-      removedRow = CMRelementToRowIndex(candidateElement);
+    if (CMRdeadlineExpired(cmr))
+    {
+      error = CMR_ERROR_TIMEOUT;
+      break;
+    }
+
+    /* Test the current matrix without the candidate. */
+    CMR_ELEMENT element = candidates[--numCandidates];
+    view.extraRow = CMRelementIsRow(element) ? CMRelementToRowIndex(element) : SIZE_MAX;
+    view.extraColumn = CMRelementIsColumn(element) ? CMRelementToColumnIndex(element) : SIZE_MAX;
+    bool hasProperty;
+    CMR_SUBMAT* submatrix = NULL;
+    error = testFunction(cmr, &view, testData, &hasProperty, &submatrix);
+    if (error != CMR_OKAY)
+      break;
+
+    assert(!submatrix); // TODO: we cannot deal with this, yet.
+
+    if (hasProperty)
+    {
+      if (CMRelementIsRow(element))
+        essentialRows[numEssentialRows++] = CMRelementToRowIndex(element);
+      else
+        essentialColumns[numEssentialColumns++] = CMRelementToColumnIndex(element);
+    }
+    else if (CMRelementIsRow(element))
+      rowsRemoved[CMRelementToRowIndex(element)] = true;
     else
-      removedColumn = CMRelementToColumnIndex(candidateElement);
+      columnsRemoved[CMRelementToColumnIndex(element)] = true;
+  }
 
-    /* Copy current matrix to candidate matrix, except for removed row/column. */
-    candidateMatrix->numNonzeros = 0;
-    for (size_t row = 0; row < matrix->numRows; ++row)
+  if (error == CMR_OKAY)
+  {
+    /* Extract the submatrix. */
+    CMR_CALL( CMRsubmatCreate(cmr, numEssentialRows, numEssentialColumns, psubmatrix) );
+    CMR_SUBMAT* submatrix = *psubmatrix;
+    for (size_t row = 0; row < submatrix->numRows; ++row)
+      submatrix->rows[row] = essentialRows[row];
+    for (size_t column = 0; column < submatrix->numColumns; ++column)
+      submatrix->columns[column] = essentialColumns[column];
+  }
+
+  CMR_CALL( CMRfreeStackArray(cmr, &columnsRemoved) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowsRemoved) );
+  CMR_CALL( CMRfreeStackArray(cmr, &candidates) );
+  CMR_CALL( CMRfreeStackArray(cmr, &essentialColumns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &essentialRows) );
+
+  return error;
+}
+
+/**
+ * \brief Marks the rows and columns of \p elements as removed or not removed.
+ */
+
+static
+void markElements(
+  CMR_ELEMENT* elements,  /**< Array of elements. */
+  size_t numElements,     /**< Length of \p elements. */
+  bool* rowsRemoved,      /**< Array indicating the removed rows. */
+  bool* columnsRemoved,   /**< Array indicating the removed columns. */
+  bool removed            /**< Whether to mark the elements as removed. */
+)
+{
+  for (size_t i = 0; i < numElements; ++i)
+  {
+    if (CMRelementIsRow(elements[i]))
+      rowsRemoved[CMRelementToRowIndex(elements[i])] = removed;
+    else
+      columnsRemoved[CMRelementToColumnIndex(elements[i])] = removed;
+  }
+}
+
+/**
+ * \brief Data of a task that tests whether removing one block keeps the violation.
+ */
+
+typedef struct
+{
+  CMR_CHRMAT_VIEW view;                 /**< \brief View of the current matrix without the block. */
+  HereditaryPropertyTest testFunction;  /**< \brief Test function. */
+  void* testData;                       /**< \brief Data to be forwarded to the test function. */
+  bool tested;                          /**< \brief Whether the test was carried out, i.e., not cancelled. */
+  bool hasProperty;                     /**< \brief Whether the matrix without the block has the property. */
+  size_t index;                         /**< \brief Index of the task in its batch. */
+  CMR_TASK_GROUP* groups;               /**< \brief Array with the task groups of the batch (shared). */
+  size_t numTasks;                      /**< \brief Length of \ref groups. */
+} BlockTask;
+
+/**
+ * \brief Task function that tests one block removal.
+ *
+ * If the violation survives the removal, then the block will be removed, which invalidates the results of the later
+ * blocks of the batch. Hence, their tasks are cancelled.
+ */
+
+static
+CMR_ERROR testBlockTask(
+  CMR* cmr,   /**< \ref CMR environment of the executing thread. */
+  void* data  /**< Pointer to \ref BlockTask. */
+)
+{
+  BlockTask* task = (BlockTask*) data;
+
+  CMR_SUBMAT* submatrix = NULL;
+  CMR_CALL( task->testFunction(cmr, &task->view, task->testData, &task->hasProperty, &submatrix) );
+  task->tested = true;
+
+  assert(!submatrix); // TODO: we cannot deal with this, yet.
+
+  if (!task->hasProperty)
+  {
+    for (size_t t = task->index + 1; t < task->numTasks; ++t)
+      CMRtaskGroupCancel(&task->groups[t]);
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRtestHereditaryPropertyGroup(CMR* cmr, CMR_CHRMAT* matrix, HereditaryPropertyTest testFunction,
+  void* testData, CMR_SUBMAT** psubmatrix)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(testFunction);
+  assert(psubmatrix);
+
+  size_t numCandidates = matrix->numRows + matrix->numColumns;
+  CMR_ELEMENT* candidates = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &candidates, numCandidates) );
+  for (size_t row = 0; row < matrix->numRows; ++row)
+    candidates[row] = CMRrowToElement(row);
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+    candidates[matrix->numRows + column] = CMRcolumnToElement(column);
+
+  bool* rowsRemoved = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowsRemoved, matrix->numRows) );
+  for (size_t row = 0; row < matrix->numRows; ++row)
+    rowsRemoved[row] = false;
+  bool* columnsRemoved = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnsRemoved, matrix->numColumns) );
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+    columnsRemoved[column] = false;
+
+  /* Blocks are ranges of candidates; a block's halves are processed before the blocks behind it. The result of a
+   * block's test remains valid until some block is removed. */
+  size_t* blockFirst = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &blockFirst, numCandidates + 1) );
+  size_t* blockBeyond = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &blockBeyond, numCandidates + 1) );
+  bool* blockTested = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &blockTested, numCandidates + 1) );
+  bool* blockHasProperty = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &blockHasProperty, numCandidates + 1) );
+  size_t numBlocks = 0;
+  if (numCandidates > 0)
+  {
+    size_t middle = (numCandidates + 1) / 2;
+    blockFirst[numBlocks] = middle;
+    blockBeyond[numBlocks] = numCandidates;
+    blockTested[numBlocks++] = false;
+    blockFirst[numBlocks] = 0;
+    blockBeyond[numBlocks] = middle;
+    blockTested[numBlocks++] = false;
+  }
+
+  /* With several threads, the topmost untested blocks are tested speculatively, each removed from its own copy of the
+   * masks. With one thread, the block is masked in place. */
+  size_t batchSize = CMRthreadpoolSize(cmr);
+  if (batchSize > numCandidates)
+    batchSize = numCandidates > 0 ? numCandidates : 1;
+  BlockTask* tasks = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &tasks, batchSize) );
+  CMR_TASK_GROUP* groups = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &groups, batchSize) );
+  size_t* taskBlocks = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &taskBlocks, batchSize) );
+  bool* taskMasks = NULL;
+  if (batchSize > 1)
+    CMR_CALL( CMRallocBlockArray(cmr, &taskMasks, batchSize * numCandidates) );
+  for (size_t t = 0; t < batchSize; ++t)
+  {
+    tasks[t].view.matrix = matrix;
+    tasks[t].view.rowsMasked = taskMasks ? &taskMasks[t * numCandidates] : rowsRemoved;
+    tasks[t].view.columnsMasked = taskMasks ? &taskMasks[t * numCandidates + matrix->numRows] : columnsRemoved;
+    tasks[t].view.extraRow = SIZE_MAX;
+    tasks[t].view.extraColumn = SIZE_MAX;
+    tasks[t].testFunction = testFunction;
+    tasks[t].testData = testData;
+    tasks[t].index = t;
+    tasks[t].groups = groups;
+  }
+
+  CMR_ERROR error = CMR_OKAY;
+  size_t numEssentialRows = 0;
+  size_t numEssentialColumns = 0;
+  while (numBlocks > 0)
+  {
+    if (CMRdeadlineExpired(cmr))
     {
-      candidateMatrix->rowSlice[row] = candidateMatrix->numNonzeros;
-      if (row == removedRow)
-        continue;
-      size_t first = current->rowSlice[row];
-      size_t beyond = current->rowSlice[row + 1];
-      for (size_t e = first; e < beyond; ++e)
+      error = CMR_ERROR_TIMEOUT;
+      break;
+    }
+
+    if (!blockTested[numBlocks - 1])
+    {
+      /* Test the current matrix without each of the topmost untested blocks; task 0 tests the top block. */
+      size_t numTasks = 0;
+      for (size_t b = numBlocks; b > 0 && numTasks < batchSize; --b)
       {
-        size_t column = current->entryColumns[e];
-        if (column == removedColumn)
+        if (blockTested[b - 1])
           continue;
-        candidateMatrix->entryColumns[candidateMatrix->numNonzeros] = column;
-        candidateMatrix->entryValues[candidateMatrix->numNonzeros] = current->entryValues[e];
-        candidateMatrix->numNonzeros++;
+
+        BlockTask* task = &tasks[numTasks];
+        CMR_ELEMENT* elements = &candidates[blockFirst[b - 1]];
+        size_t numElements = blockBeyond[b - 1] - blockFirst[b - 1];
+        if (taskMasks)
+        {
+          memcpy(task->view.rowsMasked, rowsRemoved, matrix->numRows * sizeof(bool));
+          memcpy(task->view.columnsMasked, columnsRemoved, matrix->numColumns * sizeof(bool));
+        }
+        markElements(elements, numElements, task->view.rowsMasked, task->view.columnsMasked, true);
+        task->tested = false;
+        taskBlocks[numTasks++] = b - 1;
+      }
+
+      size_t numSpawned = 0;
+      for (; numSpawned < numTasks && error == CMR_OKAY; ++numSpawned)
+      {
+        tasks[numSpawned].numTasks = numTasks;
+        error = CMRtaskGroupInit(cmr, &groups[numSpawned]);
+        if (error == CMR_OKAY)
+          error = CMRtaskSpawn(cmr, &groups[numSpawned], testBlockTask, &tasks[numSpawned]);
+      }
+      for (size_t t = 0; t < numSpawned; ++t)
+      {
+        if (error != CMR_OKAY)
+          CMRtaskGroupCancel(&groups[t]);
+        CMR_ERROR taskError = CMRtaskWait(cmr, &groups[t]);
+        if (error == CMR_OKAY)
+          error = taskError;
+      }
+      if (!taskMasks)
+      {
+        markElements(&candidates[blockFirst[taskBlocks[0]]], blockBeyond[taskBlocks[0]] - blockFirst[taskBlocks[0]],
+          rowsRemoved, columnsRemoved, false);
       }
+      if (error != CMR_OKAY)
+        break;
+
+      for (size_t t = 0; t < numTasks; ++t)
+      {
+        blockTested[taskBlocks[t]] = tasks[t].tested;
+        blockHasProperty[taskBlocks[t]] = tasks[t].hasProperty;
+      }
+      assert(blockTested[numBlocks - 1]);
     }
-    candidateMatrix->rowSlice[matrix->numRows] = candidateMatrix->numNonzeros;
 
-    /* Invoke test. */
-    bool hasProperty;
-    CMR_SUBMAT* submatrix = NULL;
-    double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-    if (remainingTime < 0)
+    --numBlocks;
+    size_t first = blockFirst[numBlocks];
+    size_t beyond = blockBeyond[numBlocks];
+
+    if (!blockHasProperty[numBlocks])
     {
-      CMR_CALL( CMRchrmatFree(cmr, &candidateMatrix) );
-      CMR_CALL( CMRchrmatFree(cmr, &current) );
-      CMR_CALL( CMRfreeStackArray(cmr, &candidates) );
-      CMR_CALL( CMRfreeStackArray(cmr, &essentialColumns) );
-      CMR_CALL( CMRfreeStackArray(cmr, &essentialRows) );
-      return CMR_ERROR_TIMEOUT;
+      /* The whole block can be removed, which invalidates the results of the other blocks. */
+      markElements(&candidates[first], beyond - first, rowsRemoved, columnsRemoved, true);
+      for (size_t b = 0; b < numBlocks; ++b)
+        blockTested[b] = false;
+      continue;
     }
-    CMR_CALL( testFunction(cmr, candidateMatrix, testData, &hasProperty, &submatrix, remainingTime) );
-
-    assert(!submatrix); // TODO: we cannot deal with this, yet.
 
-    if (hasProperty)
+    if (beyond - first == 1)
     {
-      if (removedRow < SIZE_MAX)
-        essentialRows[numEssentialRows++] = removedRow;
+      /* By heredity, the element remains essential for all smaller violators. */
+      if (CMRelementIsRow(candidates[first]))
+        ++numEssentialRows;
       else
-        essentialColumns[numEssentialColumns++] = removedColumn;
+        ++numEssentialColumns;
     }
     else
     {
-      /* Swap candidateMatrix and current. */
-      CMR_CHRMAT* temp = candidateMatrix;
-      candidateMatrix = current;
-      current = temp;
+      size_t middle = first + (beyond - first + 1) / 2;
+      blockFirst[numBlocks] = middle;
+      blockBeyond[numBlocks] = beyond;
+      blockTested[numBlocks++] = false;
+      blockFirst[numBlocks] = first;
+      blockBeyond[numBlocks] = middle;
+      blockTested[numBlocks++] = false;
     }
   }
 
-  CMR_CALL( CMRchrmatFree(cmr, &candidateMatrix) );
-  CMR_CALL( CMRchrmatFree(cmr, &current) );
+  if (taskMasks)
+    CMR_CALL( CMRfreeBlockArray(cmr, &taskMasks) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &taskBlocks) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &groups) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &tasks) );
 
-  /* Extract the submatrix. */
-  CMR_CALL( CMRsubmatCreate(cmr, numEssentialRows, numEssentialColumns, psubmatrix) );
-  CMR_SUBMAT* submatrix = *psubmatrix;
-  for (size_t row = 0; row < submatrix->numRows; ++row)
-    submatrix->rows[row] = essentialRows[row];
-  for (size_t column = 0; column < submatrix->numColumns; ++column)
-    submatrix->columns[column] = essentialColumns[column];
+  if (error == CMR_OKAY)
+  {
+    /* Extract the submatrix, i.e., all rows and columns that were not removed. */
+    CMR_CALL( CMRsubmatCreate(cmr, numEssentialRows, numEssentialColumns, psubmatrix) );
+    CMR_SUBMAT* submatrix = *psubmatrix;
+    size_t numRows = 0;
+    for (size_t row = 0; row < matrix->numRows; ++row)
+    {
+      if (!rowsRemoved[row])
+        submatrix->rows[numRows++] = row;
+    }
+    assert(numRows == numEssentialRows);
+    size_t numColumns = 0;
+    for (size_t column = 0; column < matrix->numColumns; ++column)
+    {
+      if (!columnsRemoved[column])
+        submatrix->columns[numColumns++] = column;
+    }
+    assert(numColumns == numEssentialColumns);
+  }
 
+  CMR_CALL( CMRfreeStackArray(cmr, &blockHasProperty) );
+  CMR_CALL( CMRfreeStackArray(cmr, &blockTested) );
+  CMR_CALL( CMRfreeStackArray(cmr, &blockBeyond) );
+  CMR_CALL( CMRfreeStackArray(cmr, &blockFirst) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnsRemoved) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowsRemoved) );
   CMR_CALL( CMRfreeStackArray(cmr, &candidates) );
-  CMR_CALL( CMRfreeStackArray(cmr, &essentialColumns) );
-  CMR_CALL( CMRfreeStackArray(cmr, &essentialRows) );
 
-  return CMR_OKAY;
+  return error;
+}
+
+CMR_ERROR CMRtestHereditaryProperty(CMR* cmr, CMR_CHRMAT* matrix, HereditaryPropertyStrategy strategy,
+  HereditaryPropertyTest testFunction, void* testData, CMR_SUBMAT** psubmatrix)
+{
+  switch (strategy)
+  {
+  case HEREDITARY_PROPERTY_SIMPLE:
+    return CMRtestHereditaryPropertySimple(cmr, matrix, testFunction, testData, psubmatrix);
+  case HEREDITARY_PROPERTY_GROUP:
+    return CMRtestHereditaryPropertyGroup(cmr, matrix, testFunction, testData, psubmatrix);
+  default:
+    return CMR_ERROR_INPUT;
+  }
 }
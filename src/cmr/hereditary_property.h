@@ -5,6 +5,7 @@
 #include "env_internal.h"
 #include <cmr/matrix.h>
 #include <cmr/element.h>
+#include "matrix_internal.h"
 
 #ifdef __cplus
 extern "C" {
@@ -12,17 +13,17 @@ extern "C" {
 
 typedef CMR_ERROR (*HereditaryPropertyTest)(
   CMR* cmr,                 /**< \ref CMR environment. */
-  CMR_CHRMAT* matrix,       /**< Some matrix to be tested for the property. */
+  CMR_CHRMAT_VIEW* view,    /**< View of some matrix to be tested for the property. */
   void* data,               /**< Potential additional data for the test function. */
-  bool* phasProperty,       /**< Pointer for storing whether \p matrix has the property. */
-  CMR_SUBMAT** psubmatrix,  /**< Pointer for storing a proper submatrix of \p matrix without the property. */
-  double timeLimit          /**< Time limit to impose. */
+  bool* phasProperty,       /**< Pointer for storing whether \p view has the property. */
+  CMR_SUBMAT** psubmatrix   /**< Pointer for storing a proper submatrix of \p view without the property. */
 ); /**< Function pointer for functions that test a hereditary matrix property. */
 
 /**
  * \brief Tests a given \p matrix for the hereditary property defined by a given \p testFunction.
  *
- * The algorithm finds the submatrix by successively removing rows or columns.
+ * The algorithm finds the submatrix by successively removing rows or columns, which are masked in the view that is
+ * passed to \p testFunction.
  */
 
 CMR_ERROR CMRtestHereditaryPropertySimple(
@@ -30,8 +31,51 @@ CMR_ERROR CMRtestHereditaryPropertySimple(
   CMR_CHRMAT* matrix,                   /**< Some matrix not having the hereditary property. */
   HereditaryPropertyTest testFunction,  /**< Test function. */
   void* testData,                       /**< Data to be forwarded to the test function. */
-  CMR_SUBMAT** psubmatrix,              /**< Pointer for storing a minimal submatrix not having the property. */
-  double timeLimit                      /**< Time limit to impose. */
+  CMR_SUBMAT** psubmatrix               /**< Pointer for storing a minimal submatrix not having the property. */
+);
+
+/**
+ * \brief Strategy for finding a minimal submatrix without a hereditary property.
+ */
+
+typedef enum
+{
+  HEREDITARY_PROPERTY_SIMPLE = 0, /**< Test the removal of one row or column at a time. */
+  HEREDITARY_PROPERTY_GROUP = 1   /**< Test the removal of blocks of rows and columns, splitting those that fail. */
+} HereditaryPropertyStrategy;
+
+/**
+ * \brief Tests a given \p matrix for the hereditary property defined by a given \p testFunction.
+ *
+ * The algorithm finds the submatrix by successively removing blocks of rows and columns. Initially, the rows and
+ * columns form two blocks. If the removal of a block destroys the violation, then the block is split into halves,
+ * unless it consists of a single element, which is then essential. For a violator with \f$ k \f$ rows and columns
+ * this requires \f$ O(k \log(m+n)) \f$ calls of \p testFunction instead of \f$ m+n \f$.
+ *
+ * If \p cmr uses several threads, then the removals of the next blocks are tested speculatively in parallel, and the
+ * results are processed in the sequential order until a block is removed. The result is the same as for a sequential
+ * search, but \p testFunction may be called concurrently and must be thread-safe with respect to \p testData.
+ */
+
+CMR_ERROR CMRtestHereditaryPropertyGroup(
+  CMR* cmr,                             /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,                   /**< Some matrix not having the hereditary property. */
+  HereditaryPropertyTest testFunction,  /**< Test function. */
+  void* testData,                       /**< Data to be forwarded to the test function. */
+  CMR_SUBMAT** psubmatrix               /**< Pointer for storing a minimal submatrix not having the property. */
+);
+
+/**
+ * \brief Tests a given \p matrix for the hereditary property defined by a given \p testFunction using \p strategy.
+ */
+
+CMR_ERROR CMRtestHereditaryProperty(
+  CMR* cmr,                             /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,                   /**< Some matrix not having the hereditary property. */
+  HereditaryPropertyStrategy strategy,  /**< Strategy for removing rows and columns. */
+  HereditaryPropertyTest testFunction,  /**< Test function. */
+  void* testData,                       /**< Data to be forwarded to the test function. */
+  CMR_SUBMAT** psubmatrix               /**< Pointer for storing a minimal submatrix not having the property. */
 );
 
 #ifdef __cplusplus
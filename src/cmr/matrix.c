@@ -12,6 +12,12 @@
 #include "sort.h"
 #include "env_internal.h"
 #include "listmatrix.h"
+#include "matrix_internal.h"
+
+#if defined(CMR_WITH_MMAP)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif /* CMR_WITH_MMAP */
 
 CMR_ERROR CMRsubmatCreate(CMR* cmr, size_t numRows, size_t numColumns, CMR_SUBMAT** psubmatrix)
 {
@@ -244,8 +250,8 @@ CMR_ERROR CMRsortSubmatrix(CMR* cmr, CMR_SUBMAT* submatrix)
   return CMR_OKAY;
 }
 
-CMR_ERROR CMRdblmatCreate(CMR* cmr, CMR_DBLMAT** matrix, int numRows, int numColumns,
-  int numNonzeros)
+CMR_ERROR CMRdblmatCreate(CMR* cmr, CMR_DBLMAT** matrix, size_t numRows, size_t numColumns,
+  size_t numNonzeros)
 {
   assert(matrix);
   assert(*matrix == NULL);
@@ -268,7 +274,7 @@ CMR_ERROR CMRdblmatCreate(CMR* cmr, CMR_DBLMAT** matrix, int numRows, int numCol
 }
 
 
-CMR_ERROR CMRintmatCreate(CMR* cmr, CMR_INTMAT** matrix, int numRows, int numColumns, int numNonzeros)
+CMR_ERROR CMRintmatCreate(CMR* cmr, CMR_INTMAT** matrix, size_t numRows, size_t numColumns, size_t numNonzeros)
 {
   assert(matrix);
   assert(*matrix == NULL);
@@ -291,7 +297,7 @@ CMR_ERROR CMRintmatCreate(CMR* cmr, CMR_INTMAT** matrix, int numRows, int numCol
 }
 
 
-CMR_ERROR CMRchrmatCreate(CMR* cmr, CMR_CHRMAT** matrix, int numRows, int numColumns, int numNonzeros)
+CMR_ERROR CMRchrmatCreate(CMR* cmr, CMR_CHRMAT** matrix, size_t numRows, size_t numColumns, size_t numNonzeros)
 {
   assert(matrix);
   assert(*matrix == NULL);
@@ -313,6 +319,97 @@ CMR_ERROR CMRchrmatCreate(CMR* cmr, CMR_CHRMAT** matrix, int numRows, int numCol
   return CMR_OKAY;
 }
 
+/**
+ * \brief Remembers that the arrays of \p matrix point into the memory-mapped file at \p address.
+ */
+
+static
+CMR_ERROR addMapping(CMR* cmr, void* matrix, void* address, size_t length)
+{
+  assert(cmr);
+
+  CMR_MAPPING* mapping = NULL;
+  CMR_CALL( CMRallocBlock(cmr, &mapping) );
+  mapping->matrix = matrix;
+  mapping->address = address;
+  mapping->length = length;
+  mapping->next = cmr->mappings;
+  cmr->mappings = mapping;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Unmaps the file referenced by \p matrix if it was memory-mapped.
+ *
+ * Sets *\p pfound to \c true if and only if \p matrix was memory-mapped.
+ */
+
+static
+CMR_ERROR releaseMapping(CMR* cmr, void* matrix, bool* pfound)
+{
+  assert(cmr);
+  assert(pfound);
+
+  *pfound = false;
+  for (CMR_MAPPING** pmapping = &cmr->mappings; *pmapping; pmapping = &(*pmapping)->next)
+  {
+    CMR_MAPPING* mapping = *pmapping;
+    if (mapping->matrix == matrix)
+    {
+#if defined(CMR_WITH_MMAP)
+      munmap(mapping->address, mapping->length);
+#endif /* CMR_WITH_MMAP */
+      *pmapping = mapping->next;
+      CMR_CALL( CMRfreeBlock(cmr, &mapping) );
+      *pfound = true;
+      break;
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Copies the arrays of \p matrix into block memory if it was memory-mapped and unmaps the file.
+ *
+ * The pointers to the arrays are replaced by the copies, such that they can be reallocated and freed afterwards.
+ */
+
+static
+CMR_ERROR copyMappedArrays(CMR* cmr, void* matrix, size_t numRows, size_t numNonzeros, size_t valueSize,
+  size_t** prowSlice, size_t** pentryColumns, void** pentryValues)
+{
+  assert(cmr);
+  assert(prowSlice);
+  assert(pentryColumns);
+  assert(pentryValues);
+
+  CMR_MAPPING* mapping = cmr->mappings;
+  while (mapping && mapping->matrix != matrix)
+    mapping = mapping->next;
+  if (!mapping)
+    return CMR_OKAY;
+
+  size_t* rowSlice = NULL;
+  size_t* entryColumns = NULL;
+  void* entryValues = NULL;
+  CMR_CALL( CMRduplicateBlockArray(cmr, &rowSlice, numRows + 1, *prowSlice) );
+  if (numNonzeros > 0)
+  {
+    CMR_CALL( CMRduplicateBlockArray(cmr, &entryColumns, numNonzeros, *pentryColumns) );
+    CMR_CALL( _CMRduplicateBlockArray(cmr, &entryValues, valueSize, numNonzeros, *pentryValues) );
+  }
+
+  bool found;
+  CMR_CALL( releaseMapping(cmr, matrix, &found) );
+  *prowSlice = rowSlice;
+  *pentryColumns = entryColumns;
+  *pentryValues = entryValues;
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRdblmatFree(CMR* cmr, CMR_DBLMAT** pmatrix)
 {
   assert(pmatrix);
@@ -320,6 +417,15 @@ CMR_ERROR CMRdblmatFree(CMR* cmr, CMR_DBLMAT** pmatrix)
   if (!matrix)
     return CMR_OKAY;
 
+  bool mapped = false;
+  if (cmr->mappings)
+    CMR_CALL( releaseMapping(cmr, matrix, &mapped) );
+  if (mapped)
+  {
+    CMR_CALL( CMRfreeBlock(cmr, pmatrix) );
+    return CMR_OKAY;
+  }
+
   assert(matrix->rowSlice);
   assert(matrix->numNonzeros == 0 || matrix->entryColumns);
   assert(matrix->numNonzeros == 0 || matrix->entryValues);
@@ -342,6 +448,15 @@ CMR_ERROR CMRintmatFree(CMR* cmr, CMR_INTMAT** pmatrix)
   if (!matrix)
     return CMR_OKAY;
 
+  bool mapped = false;
+  if (cmr->mappings)
+    CMR_CALL( releaseMapping(cmr, matrix, &mapped) );
+  if (mapped)
+  {
+    CMR_CALL( CMRfreeBlock(cmr, pmatrix) );
+    return CMR_OKAY;
+  }
+
   assert(matrix->rowSlice);
   assert(matrix->numNonzeros == 0 || matrix->entryColumns);
   assert(matrix->numNonzeros == 0 || matrix->entryValues);
@@ -364,6 +479,15 @@ CMR_ERROR CMRchrmatFree(CMR* cmr, CMR_CHRMAT** pmatrix)
   if (!matrix)
     return CMR_OKAY;
 
+  bool mapped = false;
+  if (cmr->mappings)
+    CMR_CALL( releaseMapping(cmr, matrix, &mapped) );
+  if (mapped)
+  {
+    CMR_CALL( CMRfreeBlock(cmr, pmatrix) );
+    return CMR_OKAY;
+  }
+
   assert(matrix->rowSlice);
   assert(matrix->numNonzeros == 0 || matrix->entryColumns);
   assert(matrix->numNonzeros == 0 || matrix->entryValues);
@@ -384,6 +508,12 @@ CMR_ERROR CMRdblmatChangeNumNonzeros(CMR* cmr, CMR_DBLMAT* matrix, size_t newNum
   assert(cmr);
   assert(matrix);
 
+  if (cmr->mappings)
+  {
+    CMR_CALL( copyMappedArrays(cmr, matrix, matrix->numRows, matrix->numNonzeros, sizeof(double), &matrix->rowSlice,
+      &matrix->entryColumns, (void**) &matrix->entryValues) );
+  }
+
   CMR_CALL( CMRreallocBlockArray(cmr, &matrix->entryColumns, newNumNonzeros) );
   CMR_CALL( CMRreallocBlockArray(cmr, &matrix->entryValues, newNumNonzeros) );
   matrix->numNonzeros = newNumNonzeros;
@@ -396,6 +526,12 @@ CMR_ERROR CMRintmatChangeNumNonzeros(CMR* cmr, CMR_INTMAT* matrix, size_t newNum
   assert(cmr);
   assert(matrix);
 
+  if (cmr->mappings)
+  {
+    CMR_CALL( copyMappedArrays(cmr, matrix, matrix->numRows, matrix->numNonzeros, sizeof(int), &matrix->rowSlice,
+      &matrix->entryColumns, (void**) &matrix->entryValues) );
+  }
+
   CMR_CALL( CMRreallocBlockArray(cmr, &matrix->entryColumns, newNumNonzeros) );
   CMR_CALL( CMRreallocBlockArray(cmr, &matrix->entryValues, newNumNonzeros) );
   matrix->numNonzeros = newNumNonzeros;
@@ -408,6 +544,12 @@ CMR_ERROR CMRchrmatChangeNumNonzeros(CMR* cmr, CMR_CHRMAT* matrix, size_t newNum
   assert(cmr);
   assert(matrix);
 
+  if (cmr->mappings)
+  {
+    CMR_CALL( copyMappedArrays(cmr, matrix, matrix->numRows, matrix->numNonzeros, sizeof(char), &matrix->rowSlice,
+      &matrix->entryColumns, (void**) &matrix->entryValues) );
+  }
+
   CMR_CALL( CMRreallocBlockArray(cmr, &matrix->entryColumns, newNumNonzeros) );
   CMR_CALL( CMRreallocBlockArray(cmr, &matrix->entryValues, newNumNonzeros) );
   matrix->numNonzeros = newNumNonzeros;
@@ -415,43 +557,22 @@ CMR_ERROR CMRchrmatChangeNumNonzeros(CMR* cmr, CMR_CHRMAT* matrix, size_t newNum
   return CMR_OKAY;
 }
 
-static
-int compareEntries(const void** pa, const void** pb)
-{
-  size_t** a = (size_t**)(pa);
-  size_t** b = (size_t**)(pb);
-  return (**a < **b) ? -1 : (**a > **b ? 1 : 0);
-}
-
 CMR_ERROR CMRdblmatSortNonzeros(CMR* cmr, CMR_DBLMAT* matrix)
 {
   assert(cmr);
   CMRconsistencyAssert( CMRdblmatConsistency(matrix) );
 
-  for (size_t row = 0; row < matrix->numRows; ++row)
-  {
-    size_t first = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row + 1];
-    CMR_CALL( CMRsort2(cmr, beyond - first, &matrix->entryColumns[first], sizeof(size_t), &matrix->entryValues[first],
-      sizeof(double), compareEntries) );
-  }
+  CMR_CALL( CMRsortRowsDbl(cmr, matrix->numRows, matrix->rowSlice, matrix->entryColumns, matrix->entryValues) );
 
   return CMR_OKAY;
 }
 
-
 CMR_ERROR CMRintmatSortNonzeros(CMR* cmr, CMR_INTMAT* matrix)
 {
   assert(cmr);
   CMRconsistencyAssert( CMRintmatConsistency(matrix) );
 
-  for (size_t row = 0; row < matrix->numRows; ++row)
-  {
-    size_t first = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row + 1];
-    CMR_CALL( CMRsort2(cmr, beyond - first, &matrix->entryColumns[first], sizeof(size_t), &matrix->entryValues[first],
-      sizeof(int), compareEntries) );
-  }
+  CMR_CALL( CMRsortRowsInt(cmr, matrix->numRows, matrix->rowSlice, matrix->entryColumns, matrix->entryValues) );
 
   return CMR_OKAY;
 }
@@ -460,14 +581,7 @@ CMR_ERROR CMRchrmatSortNonzeros(CMR* cmr, CMR_CHRMAT* matrix)
 {
   assert(cmr);
 
-  for (size_t row = 0; row < matrix->numRows; ++row)
-  {
-    size_t first = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row + 1];
-    CMRdbgMsg(2, "Sorting nonzero entries in range [%ld,%ld).\n", first, beyond);
-    CMR_CALL( CMRsort2(cmr, beyond - first, &matrix->entryColumns[first], sizeof(size_t), &matrix->entryValues[first],
-      sizeof(char), compareEntries) );
-  }
+  CMR_CALL( CMRsortRowsChr(cmr, matrix->numRows, matrix->rowSlice, matrix->entryColumns, matrix->entryValues) );
 
   CMRconsistencyAssert( CMRchrmatConsistency(matrix) );
 
@@ -858,6 +972,152 @@ CMR_ERROR CMRchrmatPrintSparse(CMR* cmr, CMR_CHRMAT* matrix, FILE* stream)
   return CMR_OKAY;
 }
 
+/**
+ * \brief Type of the values stored in a binary matrix file.
+ */
+
+typedef enum
+{
+  BINARY_VALUES_CHAR = 1,   /**< Values are of type \c char. */
+  BINARY_VALUES_INT = 2,    /**< Values are of type \c int. */
+  BINARY_VALUES_DOUBLE = 3  /**< Values are of type \c double. */
+} BinaryValueType;
+
+#define BINARY_MAGIC "CMR-CSR"      /**< File signature, including the terminating zero byte. */
+#define BINARY_VERSION 1            /**< Version of the binary format. */
+#define BINARY_BYTE_ORDER 0x01020304 /**< Written in native byte order to detect foreign files. */
+
+/**
+ * \brief Header of a binary matrix file.
+ *
+ * The header is followed by the arrays \c rowSlice, \c entryColumns and \c entryValues, where the latter is padded
+ * to a multiple of 8 bytes. All data is stored in native byte order, such that the arrays can be used in place.
+ */
+
+typedef struct
+{
+  char magic[8];          /**< \brief \ref BINARY_MAGIC. */
+  uint32_t version;       /**< \brief \ref BINARY_VERSION. */
+  uint32_t byteOrder;     /**< \brief \ref BINARY_BYTE_ORDER. */
+  uint32_t indexSize;     /**< \brief Size of a row or column index in bytes. */
+  uint32_t valueType;     /**< \brief Type of the values, see \ref BinaryValueType. */
+  uint64_t numRows;       /**< \brief Number of rows. */
+  uint64_t numColumns;    /**< \brief Number of columns. */
+  uint64_t numNonzeros;   /**< \brief Number of nonzeros. */
+  uint64_t reserved[2];   /**< \brief Reserved for future use; zero. */
+} BinaryHeader;
+
+static
+size_t binaryValueSize(BinaryValueType valueType)
+{
+  if (valueType == BINARY_VALUES_CHAR)
+    return sizeof(char);
+  else if (valueType == BINARY_VALUES_INT)
+    return sizeof(int);
+  else
+    return sizeof(double);
+}
+
+/**
+ * \brief Computes the number of bytes of a binary matrix file without its header.
+ *
+ * Returns \c false if this number, increased by the size of the header, cannot be represented as a \c size_t.
+ */
+
+static
+bool binaryDataSize(BinaryHeader* header, size_t* psize)
+{
+  assert(header);
+  assert(psize);
+
+  /* The header is read from a file, so each step must be checked for overflow. */
+  if (header->numRows >= SIZE_MAX / sizeof(size_t)
+    || header->numNonzeros >= SIZE_MAX / sizeof(size_t) - header->numRows)
+  {
+    return false;
+  }
+  size_t indicesSize = (header->numRows + 1 + header->numNonzeros) * sizeof(size_t);
+
+  size_t valueSize = binaryValueSize(header->valueType);
+  if (header->numNonzeros > (SIZE_MAX - 7) / valueSize)
+    return false;
+  size_t valuesSize = (header->numNonzeros * valueSize + 7) / 8 * 8;
+
+  if (valuesSize > SIZE_MAX - sizeof(BinaryHeader) - indicesSize)
+    return false;
+  *psize = indicesSize + valuesSize;
+
+  return true;
+}
+
+static
+CMR_ERROR printBinary(CMR* cmr, size_t numRows, size_t numColumns, size_t* rowSlice, size_t* entryColumns,
+  void* entryValues, BinaryValueType valueType, FILE* stream)
+{
+  assert(cmr);
+  assert(rowSlice);
+  assert(stream);
+
+  BinaryHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+  header.version = BINARY_VERSION;
+  header.byteOrder = BINARY_BYTE_ORDER;
+  header.indexSize = sizeof(size_t);
+  header.valueType = valueType;
+  header.numRows = numRows;
+  header.numColumns = numColumns;
+  header.numNonzeros = rowSlice[numRows];
+
+  size_t numNonzeros = rowSlice[numRows];
+  size_t valuesSize = numNonzeros * binaryValueSize(valueType);
+  static const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  if (fwrite(&header, sizeof(header), 1, stream) != 1
+    || fwrite(rowSlice, sizeof(size_t), numRows + 1, stream) != numRows + 1
+    || fwrite(entryColumns, sizeof(size_t), numNonzeros, stream) != numNonzeros
+    || fwrite(entryValues, 1, valuesSize, stream) != valuesSize
+    || fwrite(padding, 1, (8 - valuesSize % 8) % 8, stream) != (8 - valuesSize % 8) % 8)
+  {
+    CMRraiseErrorMessage(cmr, "Could not write binary matrix.");
+    return CMR_ERROR_OUTPUT;
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRdblmatPrintBinary(CMR* cmr, CMR_DBLMAT* matrix, FILE* stream)
+{
+  assert(cmr);
+  assert(matrix);
+
+  CMR_CALL( printBinary(cmr, matrix->numRows, matrix->numColumns, matrix->rowSlice, matrix->entryColumns,
+    matrix->entryValues, BINARY_VALUES_DOUBLE, stream) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRintmatPrintBinary(CMR* cmr, CMR_INTMAT* matrix, FILE* stream)
+{
+  assert(cmr);
+  assert(matrix);
+
+  CMR_CALL( printBinary(cmr, matrix->numRows, matrix->numColumns, matrix->rowSlice, matrix->entryColumns,
+    matrix->entryValues, BINARY_VALUES_INT, stream) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRchrmatPrintBinary(CMR* cmr, CMR_CHRMAT* matrix, FILE* stream)
+{
+  assert(cmr);
+  assert(matrix);
+
+  CMR_CALL( printBinary(cmr, matrix->numRows, matrix->numColumns, matrix->rowSlice, matrix->entryColumns,
+    matrix->entryValues, BINARY_VALUES_CHAR, stream) );
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRdblmatPrintDense(CMR* cmr, CMR_DBLMAT* matrix, FILE* stream, char zeroChar, bool header)
 {
   assert(cmr);
@@ -980,243 +1240,539 @@ CMR_ERROR CMRchrmatPrintDense(CMR* cmr, CMR_CHRMAT* matrix, FILE* stream, char z
 
 
 
-typedef struct
+#if defined(_WIN32)
+#define flockfile _lock_file
+#define funlockfile _unlock_file
+#define getc_unlocked _getc_nolock
+#endif /* _WIN32 */
+
+#define MAX_TOKEN_LENGTH 128 /**< Maximum length of a number in a text file, including the terminating zero. */
+
+static inline
+bool isSpace(int c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/**
+ * \brief Returns the first non-whitespace character of a locked \p stream.
+ */
+
+static inline
+int skipSpace(
+  FILE* stream  /**< Locked file stream. */
+)
 {
-  size_t row;
-  size_t column;
-  double value;
-} DblNonzero;
+  int c;
+  do
+  {
+    c = getc_unlocked(stream);
+  }
+  while (isSpace(c));
+
+  return c;
+}
+
+/**
+ * \brief Reads the next whitespace-delimited token from \p stream into \p token.
+ *
+ * The characters are taken directly from the buffer of \p stream, which must be locked by the caller via \c flockfile.
+ * Only the whitespace character that delimits the token is consumed in addition.
+ *
+ * \returns the length of the token, which is 0 at the end of the file or if the token is too long.
+ */
 
 static
-int compareDblNonzeros(const void* pa, const void* pb)
+size_t readToken(
+  FILE* stream, /**< Locked file stream. */
+  char* token   /**< Array of length \ref MAX_TOKEN_LENGTH for storing the token. */
+)
 {
-  size_t aRow = ((const DblNonzero*)pa)->row;
-  size_t bRow = ((const DblNonzero*)pb)->row;
-  if (aRow < bRow)
-    return -1;
-  else if (aRow > bRow)
-    return +1;
+  int c = skipSpace(stream);
+  size_t length = 0;
+  while (c != EOF && !isSpace(c))
+  {
+    if (length == MAX_TOKEN_LENGTH - 1)
+      return 0;
+    token[length++] = (char) c;
+    c = getc_unlocked(stream);
+  }
+  token[length] = '\0';
 
-  int aColumn = ((const DblNonzero*)pa)->column;
-  int bColumn = ((const DblNonzero*)pb)->column;
-  return aColumn - bColumn;
+  return length;
 }
 
-CMR_ERROR CMRdblmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_DBLMAT** presult)
+/**
+ * \brief Reads a nonnegative integer from a locked \p stream.
+ */
+
+static
+bool readSize(
+  FILE* stream,   /**< Locked file stream. */
+  size_t* pvalue  /**< Pointer for storing the value. */
+)
 {
-  assert(cmr);
-  assert(presult);
-  assert(!*presult);
-  assert(stream);
+  int c = skipSpace(stream);
+  if (c == '+')
+    c = getc_unlocked(stream);
+  if (c < '0' || c > '9')
+    return false;
 
-  size_t numRows, numColumns, numNonzeros;
-  int numRead = fscanf(stream, "%lu %lu %lu", &numRows, &numColumns, &numNonzeros);
-  if (numRead < 3)
+  size_t value = 0;
+  do
   {
-    CMRraiseErrorMessage(cmr, "Could not read number of rows, columns and nonzeros.");
-    return CMR_ERROR_INPUT;
+    size_t digit = c - '0';
+    if (value > (SIZE_MAX - digit) / 10)
+      return false;
+    value = 10 * value + digit;
+    c = getc_unlocked(stream);
   }
+  while (c >= '0' && c <= '9');
+  if (c != EOF && !isSpace(c))
+    return false;
+  *pvalue = value;
 
-  /* Read all nonzeros. */
+  return true;
+}
 
-  DblNonzero* nonzeros = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &nonzeros, numNonzeros) );
-  size_t entry = 0;
-  for (size_t i = 0; i < numNonzeros; ++i)
+/**
+ * \brief Reads an integer from a locked \p stream.
+ */
+
+static
+bool readInt(
+  FILE* stream, /**< Locked file stream. */
+  int* pvalue   /**< Pointer for storing the value. */
+)
+{
+  int c = skipSpace(stream);
+  bool negative = (c == '-');
+  if (c == '-' || c == '+')
+    c = getc_unlocked(stream);
+  if (c < '0' || c > '9')
+    return false;
+
+  long long value = 0;
+  do
   {
-    size_t row;
-    size_t column;
-    double value;
-    numRead = fscanf(stream, "%lu %lu %lf", &row, &column, &value);
-    if (numRead < 3 || row == 0 || column == 0 || row > numRows || column > numColumns)
-    {
-      CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
-      if (numRead == 2)
-        CMRraiseErrorMessage(cmr, "Could not read a double value of nonzero #%lu.", entry);
-      else
-        CMRraiseErrorMessage(cmr, "Could not read nonzero #%lu.", entry);
-      return CMR_ERROR_INPUT;
-    }
-    if (value != 0.0)
-    {
-      nonzeros[entry].row = row - 1;
-      nonzeros[entry].column = column - 1;
-      nonzeros[entry].value = value;
-      ++entry;
-    }
+    value = 10 * value + (c - '0');
+    if (value > (long long) INT_MAX + 1)
+      return false;
+    c = getc_unlocked(stream);
   }
-  numNonzeros = entry;
+  while (c >= '0' && c <= '9');
+  if (c != EOF && !isSpace(c))
+    return false;
+  if (negative)
+    value = -value;
+  if (value > INT_MAX)
+    return false;
+  *pvalue = (int) value;
 
-  /* We sort all nonzeros by row and then by column. */
-  CMR_CALL( CMRsort(cmr, numNonzeros, nonzeros, sizeof(DblNonzero), compareDblNonzeros) );
+  return true;
+}
 
-  CMR_CALL( CMRdblmatCreate(cmr, presult, numRows, numColumns, numNonzeros) );
-  CMR_DBLMAT* result = *presult;
-  size_t previousRow = SIZE_MAX;
-  size_t previousColumn = SIZE_MAX;
-  size_t* pentryColumn = result->entryColumns;
-  double* pentryValue = result->entryValues;
-  for (size_t entry = 0; entry < numNonzeros; ++entry)
+/**
+ * \brief Reads a floating-point number from a locked \p stream.
+ *
+ * Decimal numbers with at most 15 significant digits and small exponents are converted exactly by a single
+ * multiplication or division. All others are passed to \c strtod.
+ */
+
+static
+bool readDouble(
+  FILE* stream,   /**< Locked file stream. */
+  double* pvalue  /**< Pointer for storing the value. */
+)
+{
+  static const double powersOfTen[] = { 1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9, 1.0e10,
+    1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22 };
+
+  char token[MAX_TOKEN_LENGTH];
+  size_t length = readToken(stream, token);
+  if (length == 0)
+    return false;
+
+  const char* p = token;
+  bool negative = (*p == '-');
+  if (*p == '-' || *p == '+')
+    ++p;
+
+  uint64_t mantissa = 0;
+  int numDigits = 0;
+  int exponent = 0;
+  bool hasDigits = false;
+  for (; *p >= '0' && *p <= '9'; ++p)
+  {
+    hasDigits = true;
+    if (mantissa == 0 && *p == '0')
+      continue;
+    mantissa = 10 * mantissa + (*p - '0');
+    ++numDigits;
+  }
+  if (*p == '.')
   {
-    size_t row = nonzeros[entry].row;
-    size_t column = nonzeros[entry].column;
-    if (row == previousRow && column == previousColumn)
+    for (++p; *p >= '0' && *p <= '9'; ++p)
     {
-      CMRraiseErrorMessage(cmr, "Duplicate nonzero at row %lu and column %lu.", row, column);
-      CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
-      CMR_CALL( CMRdblmatFree(cmr, presult) );
-      return CMR_ERROR_INPUT;
+      hasDigits = true;
+      --exponent;
+      if (mantissa == 0 && *p == '0')
+        continue;
+      mantissa = 10 * mantissa + (*p - '0');
+      ++numDigits;
     }
-    while (previousRow < row || previousRow == SIZE_MAX)
+  }
+  if (hasDigits && (*p == 'e' || *p == 'E'))
+  {
+    const char* q = p + 1;
+    bool negativeExponent = (*q == '-');
+    if (*q == '-' || *q == '+')
+      ++q;
+    int explicitExponent = 0;
+    if (*q >= '0' && *q <= '9')
     {
-      ++previousRow;
-      result->rowSlice[previousRow] = entry;
+      for (; *q >= '0' && *q <= '9' && explicitExponent < 10000; ++q)
+        explicitExponent = 10 * explicitExponent + (*q - '0');
+      exponent += negativeExponent ? -explicitExponent : explicitExponent;
+      p = q;
     }
-    *pentryColumn++ = nonzeros[entry].column;
-    *pentryValue++ = nonzeros[entry].value;
-    previousColumn = column;
   }
-  while (previousRow < numRows || previousRow == SIZE_MAX)
+
+  if (hasDigits && *p == '\0' && numDigits <= 15 && exponent >= -22 && exponent <= 22)
   {
-    ++previousRow;
-    result->rowSlice[previousRow] = numNonzeros;
+    double value = (double) mantissa;
+    value = exponent >= 0 ? value * powersOfTen[exponent] : value / powersOfTen[-exponent];
+    *pvalue = negative ? -value : value;
+    return true;
   }
 
-  CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
+  /* Hexadecimal numbers, infinity, NaN, many digits or large exponents. */
+  char* end = NULL;
+  double value = strtod(token, &end);
+  if (end == token || *end != '\0')
+    return false;
+  *pvalue = value;
 
-  return CMR_OKAY;
+  return true;
 }
 
-typedef struct
-{
-  size_t row;
-  size_t column;
-  int value;
-} IntNonzero;
+/**
+ * \brief Computes the row-wise representation of a matrix given by triples.
+ *
+ * The triples are first distributed by column and then, stably, by row, such that each row is sorted by column. This
+ * takes \f$ O(m + n + k) \f$ time for \f$ k \f$ triples without any comparisons. For each entry, the index of its
+ * triple is stored in \p entryTriples, such that the caller can copy the values.
+ */
 
 static
-int compareIntNonzeros(const void* pa, const void* pb)
+CMR_ERROR buildFromTriples(
+  CMR* cmr,               /**< \ref CMR environment. */
+  size_t numRows,         /**< Number of rows. */
+  size_t numColumns,      /**< Number of columns. */
+  size_t numTriples,      /**< Number of triples. */
+  size_t* rows,           /**< Array with the row of each triple. */
+  size_t* columns,        /**< Array with the column of each triple. */
+  size_t numSelected,     /**< Number of triples to consider. */
+  size_t* selected,       /**< Array with the indices of the triples to consider; \c NULL for all. */
+  size_t* rowSlice,       /**< Array of length \p numRows + 1 for storing the row slices. */
+  size_t* entryColumns,   /**< Array of length \p numSelected for storing the columns of the entries. */
+  size_t* entryTriples    /**< Array of length \p numSelected for storing the triple of each entry. */
+)
 {
-  size_t  aRow = ((const IntNonzero*)pa)->row;
-  size_t  bRow = ((const IntNonzero*)pb)->row;
-  if (aRow < bRow)
-    return -1;
-  else if (aRow > bRow)
-    return +1;
+  assert(cmr);
+  assert(rowSlice);
+  assert(!selected || numSelected <= numTriples);
+  assert(selected || numSelected == numTriples);
 
-  size_t  aColumn = ((const IntNonzero*)pa)->column;
-  size_t  bColumn = ((const IntNonzero*)pb)->column;
-  return aColumn - bColumn;
-}
+  for (size_t s = 0; s < numSelected; ++s)
+  {
+    size_t t = selected ? selected[s] : s;
+    if (rows[t] >= numRows || columns[t] >= numColumns)
+    {
+      CMRraiseErrorMessage(cmr, "Invalid row %lu or column %lu of triple #%lu.", rows[t], columns[t], t);
+      return CMR_ERROR_INPUT;
+    }
+  }
 
-CMR_ERROR CMRintmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_INTMAT** presult)
-{
-  assert(cmr);
-  assert(presult);
-  assert(!*presult);
-  assert(stream);
+  /* The positions are first used for the columns and then for the rows. */
+  size_t* positions = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &positions, (numRows > numColumns ? numRows : numColumns) + 1) );
+  size_t* byColumn = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &byColumn, numSelected) );
 
-  size_t numRows, numColumns, numNonzeros;
-  int numRead = fscanf(stream, "%lu %lu %lu", &numRows, &numColumns, &numNonzeros);
-  if (numRead < 3)
+  /* Distribute the triples by column. */
+
+  for (size_t column = 0; column <= numColumns; ++column)
+    positions[column] = 0;
+  for (size_t s = 0; s < numSelected; ++s)
+    ++positions[columns[selected ? selected[s] : s] + 1];
+  for (size_t column = 0; column < numColumns; ++column)
+    positions[column + 1] += positions[column];
+  for (size_t s = 0; s < numSelected; ++s)
   {
-    CMRraiseErrorMessage(cmr, "Could not read number of rows, columns and nonzeros.");
-    return CMR_ERROR_INPUT;
+    size_t t = selected ? selected[s] : s;
+    byColumn[positions[columns[t]]++] = t;
   }
 
-  /* Read all nonzeros. */
+  /* Distribute them stably by row. */
 
-  IntNonzero* nonzeros = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &nonzeros, numNonzeros) );
-  size_t entry = 0;
-  for (size_t i = 0; i < numNonzeros; ++i)
+  for (size_t row = 0; row <= numRows; ++row)
+    rowSlice[row] = 0;
+  for (size_t s = 0; s < numSelected; ++s)
+    ++rowSlice[rows[byColumn[s]] + 1];
+  for (size_t row = 0; row < numRows; ++row)
   {
-    size_t row;
-    size_t column;
-    int value;
-    numRead = fscanf(stream, "%lu %lu %d", &row, &column, &value);
-    if (numRead < 3 || row == 0 || column == 0 || row > numRows || column > numColumns)
-    {
-      CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
-      if (numRead == 2)
-        CMRraiseErrorMessage(cmr, "Could not read an integer value of nonzero #%lu.", entry);
-      else
-        CMRraiseErrorMessage(cmr, "Could not read nonzero #%lu.", entry);
-      return CMR_ERROR_INPUT;
-    }
-    if (value != 0)
+    rowSlice[row + 1] += rowSlice[row];
+    positions[row] = rowSlice[row];
+  }
+  for (size_t s = 0; s < numSelected; ++s)
+  {
+    size_t t = byColumn[s];
+    size_t entry = positions[rows[t]]++;
+    entryColumns[entry] = columns[t];
+    entryTriples[entry] = t;
+  }
+
+  CMR_CALL( CMRfreeStackArray(cmr, &byColumn) );
+  CMR_CALL( CMRfreeStackArray(cmr, &positions) );
+
+  /* Detect duplicates, which are now adjacent. */
+
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (size_t entry = rowSlice[row] + 1; entry < rowSlice[row + 1]; ++entry)
     {
-      nonzeros[entry].row = row - 1;
-      nonzeros[entry].column = column - 1;
-      nonzeros[entry].value = value;
-      ++entry;
+      if (entryColumns[entry] == entryColumns[entry - 1])
+      {
+        CMRraiseErrorMessage(cmr, "Duplicate nonzero at row %lu and column %lu.", row, entryColumns[entry]);
+        return CMR_ERROR_INPUT;
+      }
     }
   }
-  numNonzeros = entry;
 
-  /* We sort all nonzeros by row and then by column. */
-  CMR_CALL( CMRsort(cmr, numNonzeros, nonzeros, sizeof(DblNonzero), compareIntNonzeros) );
+  return CMR_OKAY;
+}
 
-  CMR_CALL( CMRintmatCreate(cmr, presult, numRows, numColumns, numNonzeros) );
-  CMR_INTMAT* result = *presult;
-  size_t previousRow = SIZE_MAX;
-  size_t previousColumn = SIZE_MAX;
-  size_t* pentryColumn = result->entryColumns;
-  int* pentryValue = result->entryValues;
-  for (size_t entry = 0; entry < numNonzeros; ++entry)
+CMR_ERROR CMRdblmatCreateFromTriples(CMR* cmr, size_t numRows, size_t numColumns, size_t numTriples, size_t* rows,
+  size_t* columns, double* values, CMR_DBLMAT** presult)
+{
+  assert(cmr);
+  assert(presult);
+  assert(!*presult);
+  assert(!numTriples || (rows && columns && values));
+
+  /* Zero values are ignored. */
+  size_t numNonzeros = 0;
+  for (size_t t = 0; t < numTriples; ++t)
+  {
+    if (values[t] != 0.0)
+      ++numNonzeros;
+  }
+  size_t* selected = NULL;
+  if (numNonzeros < numTriples)
   {
-    size_t row = nonzeros[entry].row;
-    size_t column = nonzeros[entry].column;
-    if (row == previousRow && column == previousColumn)
+    CMR_CALL( CMRallocStackArray(cmr, &selected, numNonzeros) );
+    size_t s = 0;
+    for (size_t t = 0; t < numTriples; ++t)
     {
-      CMRraiseErrorMessage(cmr, "Duplicate nonzero at row %lu and column %lu.", row, column);
-      CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
-      CMR_CALL( CMRintmatFree(cmr, presult) );
-      return CMR_ERROR_INPUT;
+      if (values[t] != 0.0)
+        selected[s++] = t;
     }
-    while (previousRow < row || previousRow == SIZE_MAX)
+  }
+
+  size_t* entryTriples = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &entryTriples, numNonzeros) );
+  CMR_CALL( CMRdblmatCreate(cmr, presult, numRows, numColumns, numNonzeros) );
+  CMR_DBLMAT* result = *presult;
+  CMR_ERROR error = buildFromTriples(cmr, numRows, numColumns, numTriples, rows, columns, numNonzeros, selected,
+    result->rowSlice, result->entryColumns, entryTriples);
+  if (error == CMR_OKAY)
+  {
+    for (size_t entry = 0; entry < numNonzeros; ++entry)
+      result->entryValues[entry] = values[entryTriples[entry]];
+  }
+  else
+    CMR_CALL( CMRdblmatFree(cmr, presult) );
+
+  CMR_CALL( CMRfreeStackArray(cmr, &entryTriples) );
+  if (selected)
+    CMR_CALL( CMRfreeStackArray(cmr, &selected) );
+
+  return error;
+}
+
+CMR_ERROR CMRintmatCreateFromTriples(CMR* cmr, size_t numRows, size_t numColumns, size_t numTriples, size_t* rows,
+  size_t* columns, int* values, CMR_INTMAT** presult)
+{
+  assert(cmr);
+  assert(presult);
+  assert(!*presult);
+  assert(!numTriples || (rows && columns && values));
+
+  /* Zero values are ignored. */
+  size_t numNonzeros = 0;
+  for (size_t t = 0; t < numTriples; ++t)
+  {
+    if (values[t] != 0)
+      ++numNonzeros;
+  }
+  size_t* selected = NULL;
+  if (numNonzeros < numTriples)
+  {
+    CMR_CALL( CMRallocStackArray(cmr, &selected, numNonzeros) );
+    size_t s = 0;
+    for (size_t t = 0; t < numTriples; ++t)
     {
-      ++previousRow;
-      result->rowSlice[previousRow] = entry;
+      if (values[t] != 0)
+        selected[s++] = t;
     }
-    *pentryColumn++ = nonzeros[entry].column;
-    *pentryValue++ = nonzeros[entry].value;
-    previousColumn = column;
   }
-  while (previousRow < numRows || previousRow == SIZE_MAX)
+
+  size_t* entryTriples = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &entryTriples, numNonzeros) );
+  CMR_CALL( CMRintmatCreate(cmr, presult, numRows, numColumns, numNonzeros) );
+  CMR_INTMAT* result = *presult;
+  CMR_ERROR error = buildFromTriples(cmr, numRows, numColumns, numTriples, rows, columns, numNonzeros, selected,
+    result->rowSlice, result->entryColumns, entryTriples);
+  if (error == CMR_OKAY)
   {
-    ++previousRow;
-    result->rowSlice[previousRow] = numNonzeros;
+    for (size_t entry = 0; entry < numNonzeros; ++entry)
+      result->entryValues[entry] = values[entryTriples[entry]];
   }
+  else
+    CMR_CALL( CMRintmatFree(cmr, presult) );
 
-  CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
+  CMR_CALL( CMRfreeStackArray(cmr, &entryTriples) );
+  if (selected)
+    CMR_CALL( CMRfreeStackArray(cmr, &selected) );
 
-  return CMR_OKAY;
+  return error;
 }
 
-typedef struct
+CMR_ERROR CMRchrmatCreateFromTriples(CMR* cmr, size_t numRows, size_t numColumns, size_t numTriples, size_t* rows,
+  size_t* columns, char* values, CMR_CHRMAT** presult)
 {
-  size_t row;
-  size_t column;
-  char value;
-} ChrNonzero;
+  assert(cmr);
+  assert(presult);
+  assert(!*presult);
+  assert(!numTriples || (rows && columns && values));
+
+  /* Zero values are ignored. */
+  size_t numNonzeros = 0;
+  for (size_t t = 0; t < numTriples; ++t)
+  {
+    if (values[t] != 0)
+      ++numNonzeros;
+  }
+  size_t* selected = NULL;
+  if (numNonzeros < numTriples)
+  {
+    CMR_CALL( CMRallocStackArray(cmr, &selected, numNonzeros) );
+    size_t s = 0;
+    for (size_t t = 0; t < numTriples; ++t)
+    {
+      if (values[t] != 0)
+        selected[s++] = t;
+    }
+  }
+
+  size_t* entryTriples = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &entryTriples, numNonzeros) );
+  CMR_CALL( CMRchrmatCreate(cmr, presult, numRows, numColumns, numNonzeros) );
+  CMR_CHRMAT* result = *presult;
+  CMR_ERROR error = buildFromTriples(cmr, numRows, numColumns, numTriples, rows, columns, numNonzeros, selected,
+    result->rowSlice, result->entryColumns, entryTriples);
+  if (error == CMR_OKAY)
+  {
+    for (size_t entry = 0; entry < numNonzeros; ++entry)
+      result->entryValues[entry] = values[entryTriples[entry]];
+  }
+  else
+    CMR_CALL( CMRchrmatFree(cmr, presult) );
+
+  CMR_CALL( CMRfreeStackArray(cmr, &entryTriples) );
+  if (selected)
+    CMR_CALL( CMRfreeStackArray(cmr, &selected) );
+
+  return error;
+}
 
 static
-int compareChrNonzeros(const void* pa, const void* pb)
+CMR_ERROR dblmatCreateFromSparseStreamLocked(CMR* cmr, FILE* stream, CMR_DBLMAT** presult)
 {
-  size_t  aRow = ((const ChrNonzero*)pa)->row;
-  size_t  bRow = ((const ChrNonzero*)pb)->row;
-  if (aRow < bRow)
-    return -1;
-  else if (aRow > bRow)
-    return +1;
+  assert(cmr);
+  assert(presult);
+  assert(!*presult);
+  assert(stream);
 
-  size_t  aColumn = ((const ChrNonzero*)pa)->column;
-  size_t  bColumn = ((const ChrNonzero*)pb)->column;
-  return aColumn - bColumn;
+  size_t numRows, numColumns, numNonzeros;
+  if (!readSize(stream, &numRows) || !readSize(stream, &numColumns) || !readSize(stream, &numNonzeros))
+  {
+    CMRraiseErrorMessage(cmr, "Could not read number of rows, columns and nonzeros.");
+    return CMR_ERROR_INPUT;
+  }
+
+  /* Read all nonzeros. */
+
+  size_t* rows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows, numNonzeros) );
+  size_t* columns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns, numNonzeros) );
+  double* values = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &values, numNonzeros) );
+  size_t entry = 0;
+  for (size_t i = 0; i < numNonzeros; ++i)
+  {
+    size_t row;
+    size_t column;
+    double value;
+    int numRead = readSize(stream, &row) ? 1 : 0;
+    if (numRead == 1 && readSize(stream, &column))
+      numRead = 2;
+    if (numRead == 2 && readDouble(stream, &value))
+      numRead = 3;
+    if (numRead < 3 || row == 0 || column == 0 || row > numRows || column > numColumns)
+    {
+      CMR_CALL( CMRfreeStackArray(cmr, &values) );
+      CMR_CALL( CMRfreeStackArray(cmr, &columns) );
+      CMR_CALL( CMRfreeStackArray(cmr, &rows) );
+      if (numRead == 2)
+        CMRraiseErrorMessage(cmr, "Could not read a double value of nonzero #%lu.", entry);
+      else
+        CMRraiseErrorMessage(cmr, "Could not read nonzero #%lu.", entry);
+      return CMR_ERROR_INPUT;
+    }
+    if (value != 0.0)
+    {
+      rows[entry] = row - 1;
+      columns[entry] = column - 1;
+      values[entry] = value;
+      ++entry;
+    }
+  }
+
+  CMR_ERROR error = CMRdblmatCreateFromTriples(cmr, numRows, numColumns, entry, rows, columns, values, presult);
+
+  CMR_CALL( CMRfreeStackArray(cmr, &values) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rows) );
+
+  return error;
 }
 
-CMR_ERROR CMRchrmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** presult)
+CMR_ERROR CMRdblmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_DBLMAT** presult)
+{
+  assert(stream);
+
+  flockfile(stream);
+  CMR_ERROR error = dblmatCreateFromSparseStreamLocked(cmr, stream, presult);
+  funlockfile(stream);
+
+  return error;
+}
+
+static
+CMR_ERROR intmatCreateFromSparseStreamLocked(CMR* cmr, FILE* stream, CMR_INTMAT** presult)
 {
   assert(cmr);
   assert(presult);
@@ -1224,8 +1780,7 @@ CMR_ERROR CMRchrmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** p
   assert(stream);
 
   size_t numRows, numColumns, numNonzeros;
-  int numRead = fscanf(stream, "%lu %lu %lu", &numRows, &numColumns, &numNonzeros);
-  if (numRead < 3)
+  if (!readSize(stream, &numRows) || !readSize(stream, &numColumns) || !readSize(stream, &numNonzeros))
   {
     CMRraiseErrorMessage(cmr, "Could not read number of rows, columns and nonzeros.");
     return CMR_ERROR_INPUT;
@@ -1233,18 +1788,28 @@ CMR_ERROR CMRchrmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** p
 
   /* Read all nonzeros. */
 
-  ChrNonzero* nonzeros = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &nonzeros, numNonzeros) );
+  size_t* rows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows, numNonzeros) );
+  size_t* columns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns, numNonzeros) );
+  int* values = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &values, numNonzeros) );
   size_t entry = 0;
   for (size_t i = 0; i < numNonzeros; ++i)
   {
     size_t row;
     size_t column;
     int value;
-    numRead = fscanf(stream, "%lu %lu %d", &row, &column, &value);
+    int numRead = readSize(stream, &row) ? 1 : 0;
+    if (numRead == 1 && readSize(stream, &column))
+      numRead = 2;
+    if (numRead == 2 && readInt(stream, &value))
+      numRead = 3;
     if (numRead < 3 || row == 0 || column == 0 || row > numRows || column > numColumns)
     {
-      CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
+      CMR_CALL( CMRfreeStackArray(cmr, &values) );
+      CMR_CALL( CMRfreeStackArray(cmr, &columns) );
+      CMR_CALL( CMRfreeStackArray(cmr, &rows) );
       if (numRead == 2)
         CMRraiseErrorMessage(cmr, "Could not read an integer value of nonzero #%lu.", entry);
       else
@@ -1253,55 +1818,109 @@ CMR_ERROR CMRchrmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** p
     }
     if (value != 0)
     {
-      nonzeros[entry].row = row - 1;
-      nonzeros[entry].column = column - 1;
-      nonzeros[entry].value = value;
+      rows[entry] = row - 1;
+      columns[entry] = column - 1;
+      values[entry] = value;
       ++entry;
     }
   }
-  numNonzeros = entry;
 
-  /* We sort all nonzeros by row and then by column. */
-  CMR_CALL( CMRsort(cmr, numNonzeros, nonzeros, sizeof(ChrNonzero), compareChrNonzeros) );
+  CMR_ERROR error = CMRintmatCreateFromTriples(cmr, numRows, numColumns, entry, rows, columns, values, presult);
 
-  CMR_CALL( CMRchrmatCreate(cmr, presult, numRows, numColumns, numNonzeros) );
-  CMR_CHRMAT* result = *presult;
-  size_t previousRow = SIZE_MAX;
-  size_t previousColumn = SIZE_MAX;
-  size_t* pentryColumn = result->entryColumns;
-  char* pentryValue = result->entryValues;
-  for (size_t entry = 0; entry < numNonzeros; ++entry)
+  CMR_CALL( CMRfreeStackArray(cmr, &values) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rows) );
+
+  return error;
+}
+
+CMR_ERROR CMRintmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_INTMAT** presult)
+{
+  assert(stream);
+
+  flockfile(stream);
+  CMR_ERROR error = intmatCreateFromSparseStreamLocked(cmr, stream, presult);
+  funlockfile(stream);
+
+  return error;
+}
+
+static
+CMR_ERROR chrmatCreateFromSparseStreamLocked(CMR* cmr, FILE* stream, CMR_CHRMAT** presult)
+{
+  assert(cmr);
+  assert(presult);
+  assert(!*presult);
+  assert(stream);
+
+  size_t numRows, numColumns, numNonzeros;
+  if (!readSize(stream, &numRows) || !readSize(stream, &numColumns) || !readSize(stream, &numNonzeros))
+  {
+    CMRraiseErrorMessage(cmr, "Could not read number of rows, columns and nonzeros.");
+    return CMR_ERROR_INPUT;
+  }
+
+  /* Read all nonzeros. */
+
+  size_t* rows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows, numNonzeros) );
+  size_t* columns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns, numNonzeros) );
+  char* values = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &values, numNonzeros) );
+  size_t entry = 0;
+  for (size_t i = 0; i < numNonzeros; ++i)
   {
-    size_t row = nonzeros[entry].row;
-    size_t column = nonzeros[entry].column;
-    if (row == previousRow && column == previousColumn)
+    size_t row;
+    size_t column;
+    int value;
+    int numRead = readSize(stream, &row) ? 1 : 0;
+    if (numRead == 1 && readSize(stream, &column))
+      numRead = 2;
+    if (numRead == 2 && readInt(stream, &value))
+      numRead = 3;
+    if (numRead < 3 || row == 0 || column == 0 || row > numRows || column > numColumns)
     {
-      CMRraiseErrorMessage(cmr, "Duplicate nonzero at row %lu and column %lu.", row, column);
-      CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
-      CMR_CALL( CMRchrmatFree(cmr, presult) );
+      CMR_CALL( CMRfreeStackArray(cmr, &values) );
+      CMR_CALL( CMRfreeStackArray(cmr, &columns) );
+      CMR_CALL( CMRfreeStackArray(cmr, &rows) );
+      if (numRead == 2)
+        CMRraiseErrorMessage(cmr, "Could not read an integer value of nonzero #%lu.", entry);
+      else
+        CMRraiseErrorMessage(cmr, "Could not read nonzero #%lu.", entry);
       return CMR_ERROR_INPUT;
     }
-    while (previousRow < row || previousRow == SIZE_MAX)
+    if (value != 0)
     {
-      ++previousRow;
-      result->rowSlice[previousRow] = entry;
+      rows[entry] = row - 1;
+      columns[entry] = column - 1;
+      values[entry] = value;
+      ++entry;
     }
-    *pentryColumn++ = nonzeros[entry].column;
-    *pentryValue++ = nonzeros[entry].value;
-    previousColumn = column;
-  }
-  while (previousRow < numRows || previousRow == SIZE_MAX)
-  {
-    ++previousRow;
-    result->rowSlice[previousRow] = numNonzeros;
   }
 
-  CMR_CALL( CMRfreeStackArray(cmr, &nonzeros) );
+  CMR_ERROR error = CMRchrmatCreateFromTriples(cmr, numRows, numColumns, entry, rows, columns, values, presult);
 
-  return CMR_OKAY;
+  CMR_CALL( CMRfreeStackArray(cmr, &values) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rows) );
+
+  return error;
 }
 
-CMR_ERROR CMRdblmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_DBLMAT** presult)
+CMR_ERROR CMRchrmatCreateFromSparseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** presult)
+{
+  assert(stream);
+
+  flockfile(stream);
+  CMR_ERROR error = chrmatCreateFromSparseStreamLocked(cmr, stream, presult);
+  funlockfile(stream);
+
+  return error;
+}
+
+static
+CMR_ERROR dblmatCreateFromDenseStreamLocked(CMR* cmr, FILE* stream, CMR_DBLMAT** presult)
 {
   assert(cmr);
   assert(presult);
@@ -1309,8 +1928,7 @@ CMR_ERROR CMRdblmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_DBLMAT** pr
   assert(stream);
 
   size_t numRows, numColumns;
-  int numRead = fscanf(stream, "%lu %lu", &numRows, &numColumns);
-  if (numRead < 2)
+  if (!readSize(stream, &numRows) || !readSize(stream, &numColumns))
   {
     CMRraiseErrorMessage(cmr, "Could not read number of rows and columns.");
     return CMR_ERROR_INPUT;
@@ -1335,8 +1953,7 @@ CMR_ERROR CMRdblmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_DBLMAT** pr
     for (size_t column = 0; column < numColumns; ++column)
     {
       double x;
-      numRead = fscanf(stream, "%lf", &x);
-      if (numRead < 1)
+      if (!readDouble(stream, &x))
       {
         CMRraiseErrorMessage(cmr, "Could not read matrix entry in row %lu and column %lu.", row, column);
         return CMR_ERROR_INPUT;
@@ -1373,7 +1990,19 @@ CMR_ERROR CMRdblmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_DBLMAT** pr
   return CMR_OKAY;
 }
 
-CMR_ERROR CMRintmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_INTMAT** presult)
+CMR_ERROR CMRdblmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_DBLMAT** presult)
+{
+  assert(stream);
+
+  flockfile(stream);
+  CMR_ERROR error = dblmatCreateFromDenseStreamLocked(cmr, stream, presult);
+  funlockfile(stream);
+
+  return error;
+}
+
+static
+CMR_ERROR intmatCreateFromDenseStreamLocked(CMR* cmr, FILE* stream, CMR_INTMAT** presult)
 {
   assert(cmr);
   assert(presult);
@@ -1381,8 +2010,7 @@ CMR_ERROR CMRintmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_INTMAT** pr
   assert(stream);
 
   size_t numRows, numColumns;
-  int numRead = fscanf(stream, "%lu %lu", &numRows, &numColumns);
-  if (numRead < 2)
+  if (!readSize(stream, &numRows) || !readSize(stream, &numColumns))
   {
     CMRraiseErrorMessage(cmr, "Could not read number of rows and columns.");
     return CMR_ERROR_INPUT;
@@ -1407,8 +2035,7 @@ CMR_ERROR CMRintmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_INTMAT** pr
     for (size_t column = 0; column < numColumns; ++column)
     {
       int x;
-      numRead = fscanf(stream, "%d", &x);
-      if (numRead < 1)
+      if (!readInt(stream, &x))
       {
         CMRraiseErrorMessage(cmr, "Could not read matrix entry in row %lu and column %lu.", row, column);
         return CMR_ERROR_INPUT;
@@ -1431,8 +2058,13 @@ CMR_ERROR CMRintmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_INTMAT** pr
   }
   result->rowSlice[numRows] = entry;
 
-  /* Make arrays smaller again. */
-  if (entry < memEntries)
+  /* Make arrays smaller again; a zero matrix has none. */
+  if (entry == 0)
+  {
+    CMR_CALL( CMRfreeBlockArray(cmr, &entryColumns) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &entryValues) );
+  }
+  else if (entry < memEntries)
   {
     CMR_CALL( CMRreallocBlockArray(cmr, &entryColumns, entry) );
     CMR_CALL( CMRreallocBlockArray(cmr, &entryValues, entry) );
@@ -1445,7 +2077,19 @@ CMR_ERROR CMRintmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_INTMAT** pr
   return CMR_OKAY;
 }
 
-CMR_ERROR CMRchrmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** presult)
+CMR_ERROR CMRintmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_INTMAT** presult)
+{
+  assert(stream);
+
+  flockfile(stream);
+  CMR_ERROR error = intmatCreateFromDenseStreamLocked(cmr, stream, presult);
+  funlockfile(stream);
+
+  return error;
+}
+
+static
+CMR_ERROR chrmatCreateFromDenseStreamLocked(CMR* cmr, FILE* stream, CMR_CHRMAT** presult)
 {
   assert(cmr);
   assert(presult);
@@ -1453,8 +2097,7 @@ CMR_ERROR CMRchrmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** pr
   assert(stream);
 
   size_t numRows, numColumns;
-  int numRead = fscanf(stream, "%lu %lu", &numRows, &numColumns);
-  if (numRead < 2)
+  if (!readSize(stream, &numRows) || !readSize(stream, &numColumns))
   {
     CMRraiseErrorMessage(cmr, "Could not read number of rows and columns.");
     return CMR_ERROR_INPUT;
@@ -1479,10 +2122,11 @@ CMR_ERROR CMRchrmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** pr
     for (size_t column = 0; column < numColumns; ++column)
     {
       double x;
-      numRead = fscanf(stream, "%lf", &x);
-      if (numRead < 1)
+      if (!readDouble(stream, &x))
       {
         CMRraiseErrorMessage(cmr, "Could not read matrix entry in row %lu and column %lu.", row, column);
+        CMR_CALL( CMRfreeBlockArray(cmr, &entryValues) );
+        CMR_CALL( CMRfreeBlockArray(cmr, &entryColumns) );
         return CMR_ERROR_INPUT;
       }
 
@@ -1503,8 +2147,13 @@ CMR_ERROR CMRchrmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** pr
   }
   result->rowSlice[numRows] = entry;
 
-  /* Make arrays smaller again. */
-  if (entry < memEntries)
+  /* Make arrays smaller again; a zero matrix has none. */
+  if (entry == 0)
+  {
+    CMR_CALL( CMRfreeBlockArray(cmr, &entryColumns) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &entryValues) );
+  }
+  else if (entry < memEntries)
   {
     CMR_CALL( CMRreallocBlockArray(cmr, &entryColumns, entry) );
     CMR_CALL( CMRreallocBlockArray(cmr, &entryValues, entry) );
@@ -1517,6 +2166,394 @@ CMR_ERROR CMRchrmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** pr
   return CMR_OKAY;
 }
 
+CMR_ERROR CMRchrmatCreateFromDenseStream(CMR* cmr, FILE* stream, CMR_CHRMAT** presult)
+{
+  assert(stream);
+
+  flockfile(stream);
+  CMR_ERROR error = chrmatCreateFromDenseStreamLocked(cmr, stream, presult);
+  funlockfile(stream);
+
+  return error;
+}
+
+/**
+ * \brief Reads the header of a binary matrix file and checks whether it can be used on this machine.
+ */
+
+static
+CMR_ERROR readBinaryHeader(CMR* cmr, FILE* stream, BinaryHeader* header)
+{
+  assert(cmr);
+  assert(stream);
+  assert(header);
+
+  if (fread(header, sizeof(BinaryHeader), 1, stream) != 1
+    || memcmp(header->magic, BINARY_MAGIC, sizeof(header->magic)))
+  {
+    CMRraiseErrorMessage(cmr, "Could not read header of binary matrix.");
+    return CMR_ERROR_INPUT;
+  }
+  if (header->version != BINARY_VERSION)
+  {
+    CMRraiseErrorMessage(cmr, "Unsupported version %u of binary matrix.", header->version);
+    return CMR_ERROR_INPUT;
+  }
+  if (header->byteOrder != BINARY_BYTE_ORDER || header->indexSize != sizeof(size_t))
+  {
+    CMRraiseErrorMessage(cmr, "Binary matrix was written on an incompatible machine.");
+    return CMR_ERROR_INPUT;
+  }
+  if (header->valueType < BINARY_VALUES_CHAR || header->valueType > BINARY_VALUES_DOUBLE)
+  {
+    CMRraiseErrorMessage(cmr, "Unknown value type %u of binary matrix.", header->valueType);
+    return CMR_ERROR_INPUT;
+  }
+  size_t dataSize;
+  if (!binaryDataSize(header, &dataSize))
+  {
+    CMRraiseErrorMessage(cmr, "Dimensions of binary matrix are too large.");
+    return CMR_ERROR_INPUT;
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Checks the row slices and entry columns of a binary matrix.
+ *
+ * The row slices must be monotone and the column indices of each row must be strictly increasing and less than the
+ * number of columns. Like the other readers, which drop zeros, no stored value may be zero. This takes one pass over
+ * the nonzeros.
+ */
+
+static
+CMR_ERROR checkBinaryIndices(CMR* cmr, BinaryHeader* header, size_t* rowSlice, size_t* entryColumns,
+  void* entryValues, BinaryValueType valueType)
+{
+  assert(cmr);
+  assert(header);
+  assert(rowSlice);
+
+  size_t numRows = header->numRows;
+  size_t numColumns = header->numColumns;
+  size_t numNonzeros = header->numNonzeros;
+  if (rowSlice[0] != 0 || rowSlice[numRows] != numNonzeros)
+  {
+    CMRraiseErrorMessage(cmr, "Inconsistent row slices of binary matrix.");
+    return CMR_ERROR_INPUT;
+  }
+
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    size_t first = rowSlice[row];
+    size_t beyond = rowSlice[row + 1];
+    if (beyond < first || beyond > numNonzeros)
+    {
+      CMRraiseErrorMessage(cmr, "Inconsistent row slice of row %lu of binary matrix.", row);
+      return CMR_ERROR_INPUT;
+    }
+    for (size_t entry = first; entry < beyond; ++entry)
+    {
+      size_t column = entryColumns[entry];
+      if (column >= numColumns)
+      {
+        CMRraiseErrorMessage(cmr, "Column %lu of nonzero #%lu of binary matrix is out of range.", column, entry);
+        return CMR_ERROR_INPUT;
+      }
+      if (entry > first && column <= entryColumns[entry - 1])
+      {
+        CMRraiseErrorMessage(cmr, "Nonzeros of row %lu of binary matrix are not sorted by column.", row);
+        return CMR_ERROR_INPUT;
+      }
+      bool isZero;
+      if (valueType == BINARY_VALUES_CHAR)
+        isZero = ((char*) entryValues)[entry] == 0;
+      else if (valueType == BINARY_VALUES_INT)
+        isZero = ((int*) entryValues)[entry] == 0;
+      else
+        isZero = ((double*) entryValues)[entry] == 0.0;
+      if (isZero)
+      {
+        CMRraiseErrorMessage(cmr, "Nonzero #%lu of binary matrix has value zero.", entry);
+        return CMR_ERROR_INPUT;
+      }
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Memory-maps the arrays of a binary matrix file that starts at position \p start of \p stream.
+ *
+ * Sets *\p paddress to \c NULL if this is not possible, e.g., because \p stream is not a regular file or because the
+ * values have to be converted. Otherwise, \p stream is positioned behind the matrix.
+ */
+
+static
+CMR_ERROR mapBinary(CMR* cmr, FILE* stream, long start, BinaryHeader* header, BinaryValueType valueType,
+  void** paddress, size_t* plength)
+{
+  assert(cmr);
+  assert(stream);
+  assert(header);
+  assert(paddress);
+  assert(plength);
+
+  *paddress = NULL;
+
+#if defined(CMR_WITH_MMAP)
+
+  struct stat status;
+  if (start < 0 || start % 8 != 0 || header->valueType != valueType || fstat(fileno(stream), &status) != 0
+    || !S_ISREG(status.st_mode))
+  {
+    return CMR_OKAY;
+  }
+
+  size_t dataSize;
+  if (!binaryDataSize(header, &dataSize) || (size_t) start > SIZE_MAX - sizeof(BinaryHeader) - dataSize)
+    return CMR_OKAY;
+  size_t end = start + sizeof(BinaryHeader) + dataSize;
+  if (end > (size_t) status.st_size)
+  {
+    CMRraiseErrorMessage(cmr, "Binary matrix file is truncated.");
+    return CMR_ERROR_INPUT;
+  }
+
+  /* A private writable mapping allows in-place modifications without touching the file. */
+  void* address = mmap(NULL, end, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(stream), 0);
+  if (address == MAP_FAILED)
+    return CMR_OKAY;
+
+  if (fseek(stream, end, SEEK_SET) != 0)
+  {
+    munmap(address, end);
+    return CMR_OKAY;
+  }
+
+  *paddress = address;
+  *plength = end;
+
+#else /* !CMR_WITH_MMAP */
+
+  CMR_UNUSED(start);
+  CMR_UNUSED(valueType);
+
+#endif /* CMR_WITH_MMAP */
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads the arrays of a binary matrix from \p stream, converting the values to \p valueType.
+ */
+
+static
+CMR_ERROR readBinary(CMR* cmr, FILE* stream, BinaryHeader* header, size_t* rowSlice, size_t* entryColumns,
+  void* entryValues, BinaryValueType valueType)
+{
+  assert(cmr);
+  assert(stream);
+  assert(header);
+
+  size_t numNonzeros = header->numNonzeros;
+  if (fread(rowSlice, sizeof(size_t), header->numRows + 1, stream) != header->numRows + 1
+    || fread(entryColumns, sizeof(size_t), numNonzeros, stream) != numNonzeros)
+  {
+    CMRraiseErrorMessage(cmr, "Binary matrix file is truncated.");
+    return CMR_ERROR_INPUT;
+  }
+
+  size_t sourceSize = binaryValueSize(header->valueType);
+  size_t valuesSize = numNonzeros * sourceSize;
+  char padding[8];
+  if (header->valueType == valueType)
+  {
+    if (fread(entryValues, 1, valuesSize, stream) != valuesSize
+      || fread(padding, 1, (8 - valuesSize % 8) % 8, stream) != (8 - valuesSize % 8) % 8)
+    {
+      CMRraiseErrorMessage(cmr, "Binary matrix file is truncated.");
+      return CMR_ERROR_INPUT;
+    }
+    CMR_CALL( checkBinaryIndices(cmr, header, rowSlice, entryColumns, entryValues, valueType) );
+
+    return CMR_OKAY;
+  }
+
+  /* The values have a different type, so we convert them. */
+
+  char* source = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &source, valuesSize + 8) );
+  if (fread(source, 1, valuesSize, stream) != valuesSize
+    || fread(padding, 1, (8 - valuesSize % 8) % 8, stream) != (8 - valuesSize % 8) % 8)
+  {
+    CMR_CALL( CMRfreeStackArray(cmr, &source) );
+    CMRraiseErrorMessage(cmr, "Binary matrix file is truncated.");
+    return CMR_ERROR_INPUT;
+  }
+
+  for (size_t entry = 0; entry < numNonzeros; ++entry)
+  {
+    double value;
+    if (header->valueType == BINARY_VALUES_CHAR)
+      value = source[entry];
+    else if (header->valueType == BINARY_VALUES_INT)
+      value = ((int*) source)[entry];
+    else
+      value = ((double*) source)[entry];
+
+    if (valueType == BINARY_VALUES_DOUBLE)
+      ((double*) entryValues)[entry] = value;
+    else if (value != floor(value) || value < (valueType == BINARY_VALUES_INT ? INT_MIN : CHAR_MIN)
+      || value > (valueType == BINARY_VALUES_INT ? INT_MAX : CHAR_MAX))
+    {
+      CMR_CALL( CMRfreeStackArray(cmr, &source) );
+      CMRraiseErrorMessage(cmr, "Value %g of nonzero #%lu cannot be represented.", value, entry);
+      return CMR_ERROR_INPUT;
+    }
+    else if (valueType == BINARY_VALUES_INT)
+      ((int*) entryValues)[entry] = (int) value;
+    else
+      ((char*) entryValues)[entry] = (char) value;
+  }
+
+  CMR_CALL( CMRfreeStackArray(cmr, &source) );
+  CMR_CALL( checkBinaryIndices(cmr, header, rowSlice, entryColumns, entryValues, valueType) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRdblmatCreateFromBinaryStream(CMR* cmr, FILE* stream, CMR_DBLMAT** presult)
+{
+  assert(cmr);
+  assert(presult);
+  assert(!*presult);
+  assert(stream);
+
+  long start = ftell(stream);
+  BinaryHeader header;
+  CMR_CALL( readBinaryHeader(cmr, stream, &header) );
+
+  void* address = NULL;
+  size_t length = 0;
+  CMR_CALL( mapBinary(cmr, stream, start, &header, BINARY_VALUES_DOUBLE, &address, &length) );
+  if (address)
+  {
+    char* data = (char*) address + start + sizeof(BinaryHeader);
+    CMR_CALL( CMRallocBlock(cmr, presult) );
+    CMR_DBLMAT* result = *presult;
+    result->numRows = header.numRows;
+    result->numColumns = header.numColumns;
+    result->numNonzeros = header.numNonzeros;
+    result->rowSlice = (size_t*) data;
+    result->entryColumns = header.numNonzeros ? (size_t*) data + header.numRows + 1 : NULL;
+    result->entryValues = header.numNonzeros ? (double*) (result->entryColumns + header.numNonzeros) : NULL;
+    CMR_CALL( addMapping(cmr, result, address, length) );
+    CMR_ERROR error = checkBinaryIndices(cmr, &header, result->rowSlice, result->entryColumns,
+      result->entryValues, BINARY_VALUES_DOUBLE);
+    if (error != CMR_OKAY)
+      CMR_CALL( CMRdblmatFree(cmr, presult) );
+    return error;
+  }
+
+  CMR_CALL( CMRdblmatCreate(cmr, presult, header.numRows, header.numColumns, header.numNonzeros) );
+  CMR_DBLMAT* result = *presult;
+  CMR_ERROR error = readBinary(cmr, stream, &header, result->rowSlice, result->entryColumns, result->entryValues,
+    BINARY_VALUES_DOUBLE);
+  if (error != CMR_OKAY)
+    CMR_CALL( CMRdblmatFree(cmr, presult) );
+
+  return error;
+}
+
+CMR_ERROR CMRintmatCreateFromBinaryStream(CMR* cmr, FILE* stream, CMR_INTMAT** presult)
+{
+  assert(cmr);
+  assert(presult);
+  assert(!*presult);
+  assert(stream);
+
+  long start = ftell(stream);
+  BinaryHeader header;
+  CMR_CALL( readBinaryHeader(cmr, stream, &header) );
+
+  void* address = NULL;
+  size_t length = 0;
+  CMR_CALL( mapBinary(cmr, stream, start, &header, BINARY_VALUES_INT, &address, &length) );
+  if (address)
+  {
+    char* data = (char*) address + start + sizeof(BinaryHeader);
+    CMR_CALL( CMRallocBlock(cmr, presult) );
+    CMR_INTMAT* result = *presult;
+    result->numRows = header.numRows;
+    result->numColumns = header.numColumns;
+    result->numNonzeros = header.numNonzeros;
+    result->rowSlice = (size_t*) data;
+    result->entryColumns = header.numNonzeros ? (size_t*) data + header.numRows + 1 : NULL;
+    result->entryValues = header.numNonzeros ? (int*) (result->entryColumns + header.numNonzeros) : NULL;
+    CMR_CALL( addMapping(cmr, result, address, length) );
+    CMR_ERROR error = checkBinaryIndices(cmr, &header, result->rowSlice, result->entryColumns,
+      result->entryValues, BINARY_VALUES_INT);
+    if (error != CMR_OKAY)
+      CMR_CALL( CMRintmatFree(cmr, presult) );
+    return error;
+  }
+
+  CMR_CALL( CMRintmatCreate(cmr, presult, header.numRows, header.numColumns, header.numNonzeros) );
+  CMR_INTMAT* result = *presult;
+  CMR_ERROR error = readBinary(cmr, stream, &header, result->rowSlice, result->entryColumns, result->entryValues,
+    BINARY_VALUES_INT);
+  if (error != CMR_OKAY)
+    CMR_CALL( CMRintmatFree(cmr, presult) );
+
+  return error;
+}
+
+CMR_ERROR CMRchrmatCreateFromBinaryStream(CMR* cmr, FILE* stream, CMR_CHRMAT** presult)
+{
+  assert(cmr);
+  assert(presult);
+  assert(!*presult);
+  assert(stream);
+
+  long start = ftell(stream);
+  BinaryHeader header;
+  CMR_CALL( readBinaryHeader(cmr, stream, &header) );
+
+  void* address = NULL;
+  size_t length = 0;
+  CMR_CALL( mapBinary(cmr, stream, start, &header, BINARY_VALUES_CHAR, &address, &length) );
+  if (address)
+  {
+    char* data = (char*) address + start + sizeof(BinaryHeader);
+    CMR_CALL( CMRallocBlock(cmr, presult) );
+    CMR_CHRMAT* result = *presult;
+    result->numRows = header.numRows;
+    result->numColumns = header.numColumns;
+    result->numNonzeros = header.numNonzeros;
+    result->rowSlice = (size_t*) data;
+    result->entryColumns = header.numNonzeros ? (size_t*) data + header.numRows + 1 : NULL;
+    result->entryValues = header.numNonzeros ? (char*) (result->entryColumns + header.numNonzeros) : NULL;
+    CMR_CALL( addMapping(cmr, result, address, length) );
+    CMR_ERROR error = checkBinaryIndices(cmr, &header, result->rowSlice, result->entryColumns,
+      result->entryValues, BINARY_VALUES_CHAR);
+    if (error != CMR_OKAY)
+      CMR_CALL( CMRchrmatFree(cmr, presult) );
+    return error;
+  }
+
+  CMR_CALL( CMRchrmatCreate(cmr, presult, header.numRows, header.numColumns, header.numNonzeros) );
+  CMR_CHRMAT* result = *presult;
+  CMR_ERROR error = readBinary(cmr, stream, &header, result->rowSlice, result->entryColumns, result->entryValues,
+    BINARY_VALUES_CHAR);
+  if (error != CMR_OKAY)
+    CMR_CALL( CMRchrmatFree(cmr, presult) );
+
+  return error;
+}
+
 bool CMRdblmatCheckEqual(CMR_DBLMAT* matrix1, CMR_DBLMAT* matrix2)
 {
   CMRconsistencyAssert( CMRdblmatConsistency(matrix1) );
@@ -2216,6 +3253,124 @@ CMR_ERROR CMRchrmatFilter(CMR* cmr, CMR_CHRMAT* matrix, size_t numRows, size_t*
   return CMR_OKAY;
 }
 
+size_t CMRchrmatViewRowColumns(CMR_CHRMAT_VIEW* view, size_t row, size_t* columns)
+{
+  assert(view);
+  assert(columns);
+
+  if (CMRchrmatViewRowMasked(view, row))
+    return 0;
+
+  CMR_CHRMAT* matrix = view->matrix;
+  size_t numColumns = 0;
+  size_t beyond = matrix->rowSlice[row + 1];
+  for (size_t entry = matrix->rowSlice[row]; entry < beyond; ++entry)
+  {
+    size_t column = matrix->entryColumns[entry];
+    if (!CMRchrmatViewColumnMasked(view, column))
+      columns[numColumns++] = column;
+  }
+
+  return numColumns;
+}
+
+CMR_ERROR CMRchrmatViewMaterialize(CMR* cmr, CMR_CHRMAT_VIEW* view, CMR_CHRMAT** presult)
+{
+  assert(cmr);
+  assert(view);
+  assert(presult);
+
+  CMR_CHRMAT* matrix = view->matrix;
+  size_t* rows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows, matrix->numRows) );
+  size_t numRows = 0;
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    if (!CMRchrmatViewRowMasked(view, row))
+      rows[numRows++] = row;
+  }
+  size_t* columns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns, matrix->numColumns) );
+  size_t numColumns = 0;
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+  {
+    if (!CMRchrmatViewColumnMasked(view, column))
+      columns[numColumns++] = column;
+  }
+
+  CMR_CALL( CMRchrmatFilter(cmr, matrix, numRows, rows, numColumns, columns, presult) );
+
+  CMR_CALL( CMRfreeStackArray(cmr, &columns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rows) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRcompactIndicesInitStack(CMR* cmr, CMR_COMPACT_INDICES* indices, CMR_MATRIX* matrix)
+{
+  assert(cmr);
+  assert(indices);
+  assert(matrix);
+  assert(CMRcompactIndicesFit(matrix));
+
+  indices->rowSlice = NULL;
+  indices->entryColumns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &indices->rowSlice, matrix->numRows + 1) );
+  CMR_CALL( CMRallocStackArray(cmr, &indices->entryColumns, matrix->numNonzeros) );
+  for (size_t row = 0; row <= matrix->numRows; ++row)
+    indices->rowSlice[row] = matrix->rowSlice[row];
+  for (size_t entry = 0; entry < matrix->numNonzeros; ++entry)
+    indices->entryColumns[entry] = matrix->entryColumns[entry];
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRcompactIndicesClearStack(CMR* cmr, CMR_COMPACT_INDICES* indices)
+{
+  assert(cmr);
+  assert(indices);
+
+  CMR_CALL( CMRfreeStackArray(cmr, &indices->entryColumns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &indices->rowSlice) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRpackedSignsInitStack(CMR* cmr, CMR_PACKED_SIGNS* signs, CMR_CHRMAT* matrix)
+{
+  assert(cmr);
+  assert(signs);
+  assert(matrix);
+
+  size_t numWords = (matrix->numNonzeros + 63) / 64;
+  signs->negative = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &signs->negative, numWords) );
+  for (size_t word = 0; word < numWords; ++word)
+  {
+    size_t first = 64 * word;
+    size_t beyond = first + 64 < matrix->numNonzeros ? first + 64 : matrix->numNonzeros;
+    uint64_t bits = 0;
+    for (size_t entry = first; entry < beyond; ++entry)
+    {
+      assert(matrix->entryValues[entry] == 1 || matrix->entryValues[entry] == -1);
+      bits |= (uint64_t) (matrix->entryValues[entry] < 0) << (entry - first);
+    }
+    signs->negative[word] = bits;
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRpackedSignsClearStack(CMR* cmr, CMR_PACKED_SIGNS* signs)
+{
+  assert(cmr);
+  assert(signs);
+
+  CMR_CALL( CMRfreeStackArray(cmr, &signs->negative) );
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRchrmatZoomSubmat(CMR* cmr, CMR_CHRMAT* matrix, CMR_SUBMAT* submatrix, CMR_CHRMAT** presult)
 {
   assert(cmr);
@@ -3,6 +3,10 @@
 
 #include <cmr/matrix.h>
 
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,6 +49,181 @@ CMR_ERROR CMRchrmatFilter(
   CMR_CHRMAT** presult  /**< Pointer for storing the created submatrix. */
 );
 
+/**
+ * \brief View of a char matrix in which some rows and columns are masked out.
+ *
+ * The view refers to the memory of \ref matrix and of the masks, i.e., creating or modifying it requires only
+ * \f$ O(1) \f$ time and memory. A masked row (resp. column) behaves like a zero row (resp. column). Algorithms that
+ * require a matrix in compressed sparse row format can obtain one via \ref CMRchrmatViewMaterialize.
+ */
+
+typedef struct
+{
+  CMR_CHRMAT* matrix;   /**< \brief Underlying matrix. */
+  bool* rowsMasked;     /**< \brief Array indicating the masked rows (may be \c NULL). */
+  bool* columnsMasked;  /**< \brief Array indicating the masked columns (may be \c NULL). */
+  size_t extraRow;      /**< \brief Additionally masked row, or \c SIZE_MAX. */
+  size_t extraColumn;   /**< \brief Additionally masked column, or \c SIZE_MAX. */
+} CMR_CHRMAT_VIEW;
+
+/**
+ * \brief Returns \c true if \p row is masked in \p view.
+ */
+
+static inline
+bool CMRchrmatViewRowMasked(
+  CMR_CHRMAT_VIEW* view,  /**< Matrix view. */
+  size_t row              /**< Row of the underlying matrix. */
+)
+{
+  return row == view->extraRow || (view->rowsMasked && view->rowsMasked[row]);
+}
+
+/**
+ * \brief Returns \c true if \p column is masked in \p view.
+ */
+
+static inline
+bool CMRchrmatViewColumnMasked(
+  CMR_CHRMAT_VIEW* view,  /**< Matrix view. */
+  size_t column           /**< Column of the underlying matrix. */
+)
+{
+  return column == view->extraColumn || (view->columnsMasked && view->columnsMasked[column]);
+}
+
+/**
+ * \brief Stores the columns of the nonzeros of \p row of \p view in \p columns and returns their number.
+ *
+ * \p columns must have space for the number of nonzeros of \p row in the underlying matrix.
+ */
+
+size_t CMRchrmatViewRowColumns(
+  CMR_CHRMAT_VIEW* view,  /**< Matrix view. */
+  size_t row,             /**< Row of the underlying matrix. */
+  size_t* columns         /**< Array for storing the columns. */
+);
+
+/**
+ * \brief Creates the submatrix of the underlying matrix consisting of the rows and columns of \p view that are not
+ *        masked.
+ */
+
+CMR_ERROR CMRchrmatViewMaterialize(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_CHRMAT_VIEW* view,  /**< Matrix view. */
+  CMR_CHRMAT** presult    /**< Pointer for storing the submatrix. */
+);
+
+/**
+ * \brief Row slices and entry columns of a sparse matrix as 32-bit indices.
+ *
+ * Algorithms that scan the rows of a matrix many times read half as many index bytes from it. The entry values are
+ * not copied since the entries are in the same order as in the matrix.
+ */
+
+typedef struct
+{
+  uint32_t* rowSlice;     /**< \brief Array mapping each row to the index of its first entry. */
+  uint32_t* entryColumns; /**< \brief Array mapping each entry to its column. */
+} CMR_COMPACT_INDICES;
+
+/**
+ * \brief Returns \c true if the row slices and entry columns of \p matrix fit into 32-bit indices.
+ */
+
+static inline
+bool CMRcompactIndicesFit(
+  CMR_MATRIX* matrix  /**< Matrix. */
+)
+{
+  return matrix->numNonzeros <= UINT32_MAX && matrix->numColumns <= UINT32_MAX;
+}
+
+/**
+ * \brief Copies the row slices and entry columns of \p matrix into \p indices using stack memory.
+ *
+ * Requires \ref CMRcompactIndicesFit to hold for \p matrix.
+ */
+
+CMR_ERROR CMRcompactIndicesInitStack(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  CMR_COMPACT_INDICES* indices, /**< Compact indices. */
+  CMR_MATRIX* matrix            /**< Matrix. */
+);
+
+/**
+ * \brief Frees the stack memory of \p indices.
+ */
+
+CMR_ERROR CMRcompactIndicesClearStack(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  CMR_COMPACT_INDICES* indices  /**< Compact indices. */
+);
+
+/**
+ * \brief Signs of the nonzeros of a ternary matrix, packed into one bit per nonzero.
+ *
+ * Together with \ref CMR_COMPACT_INDICES it replaces the index and value arrays of a matrix in repeated row scans.
+ */
+
+typedef struct
+{
+  uint64_t* negative; /**< \brief Bit array indicating the nonzeros that are -1. */
+} CMR_PACKED_SIGNS;
+
+/**
+ * \brief Returns the value of \p entry, which is either 1 or -1.
+ */
+
+static inline
+char CMRpackedSignsGet(
+  const CMR_PACKED_SIGNS* signs,  /**< Packed signs. */
+  size_t entry                    /**< Entry. */
+)
+{
+  return (char) (1 - 2 * (int) ((signs->negative[entry / 64] >> (entry % 64)) & 1));
+}
+
+/**
+ * \brief Sets the value of \p entry to \p value, which must be 1 or -1.
+ */
+
+static inline
+void CMRpackedSignsSet(
+  CMR_PACKED_SIGNS* signs,  /**< Packed signs. */
+  size_t entry,             /**< Entry. */
+  char value                /**< New value. */
+)
+{
+  assert(value == 1 || value == -1);
+
+  uint64_t bit = (uint64_t) 1 << (entry % 64);
+  if (value < 0)
+    signs->negative[entry / 64] |= bit;
+  else
+    signs->negative[entry / 64] &= ~bit;
+}
+
+/**
+ * \brief Packs the signs of the nonzeros of the ternary \p matrix into \p signs using stack memory.
+ */
+
+CMR_ERROR CMRpackedSignsInitStack(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_PACKED_SIGNS* signs,  /**< Packed signs. */
+  CMR_CHRMAT* matrix        /**< Ternary matrix. */
+);
+
+/**
+ * \brief Frees the stack memory of \p signs.
+ */
+
+CMR_ERROR CMRpackedSignsClearStack(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_PACKED_SIGNS* signs   /**< Packed signs. */
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,7 @@
 #include "sort.h"
 
 #include <assert.h>
+#include <float.h>
 #include <limits.h>
 #include <stdlib.h>
 #include <time.h>
@@ -95,17 +96,30 @@ typedef struct
 
 typedef struct
 {
-  DIJKSTRA_STAGE stage; /* Stage in BFS. */
-  int predecessor;      /* Predecessor node. */
-  CMR_GRAPH_EDGE edge;   /* Edge connecting to predecessor node. */
-  int distance;         /* Combinatorial distance to the BFS root. */
-  char sign;            /* Sign of this tree edge with respect to current column. */
-  bool fixed;           /* Whether the orientation of this edge is already fixed. */
+  DIJKSTRA_STAGE stage;       /* Stage in BFS. */
+  CMR_GRAPH_NODE predecessor; /* Predecessor node. */
+  CMR_GRAPH_EDGE edge;        /* Edge connecting to predecessor node. */
+  int distance;               /* Combinatorial distance to the BFS root. */
+  char sign;                  /* Sign of this tree edge with respect to current column. */
+  bool fixed;                 /* Whether the orientation of this edge is already fixed. */
 } NetworkNodeData;
 
-CMR_ERROR CMRtestConetworkMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisConetwork, CMR_GRAPH** pdigraph,
-  CMR_GRAPH_EDGE** pforestArcs, CMR_GRAPH_EDGE** pcoforestArcs, bool** parcsReversed, CMR_SUBMAT** psubmatrix,
-  CMR_NETWORK_STATISTICS* stats, double timeLimit)
+/**
+ * \brief Carries out \ref CMRtestConetworkMatrix once its deadline was set.
+ */
+
+static
+CMR_ERROR testConetwork(
+  CMR* cmr,                       /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,             /**< Matrix \f$ M \f$. */
+  bool* pisConetwork,             /**< Pointer for storing whether \f$ M \f$ is conetwork. */
+  CMR_GRAPH** pdigraph,           /**< Pointer for storing the digraph (may be \c NULL). */
+  CMR_GRAPH_EDGE** pforestArcs,   /**< Pointer for storing the arcs of the spanning forest (may be \c NULL). */
+  CMR_GRAPH_EDGE** pcoforestArcs, /**< Pointer for storing the arcs of the complementing forest (may be \c NULL). */
+  bool** parcsReversed,           /**< Pointer for storing which arcs are reversed (may be \c NULL). */
+  CMR_SUBMAT** psubmatrix,        /**< Pointer for storing a violating submatrix (may be \c NULL). */
+  CMR_NETWORK_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
+)
 {
   assert(cmr);
   assert(matrix);
@@ -124,7 +138,7 @@ CMR_ERROR CMRtestConetworkMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisConetwor
   clock_t totalClock = clock();
 
   bool isCamionSigned;
-  CMR_CALL( CMRtestCamionSigned(cmr, matrix, &isCamionSigned, psubmatrix, stats ? &stats->camion : NULL, timeLimit) );
+  CMR_CALL( CMRtestCamionSigned(cmr, matrix, &isCamionSigned, psubmatrix, stats ? &stats->camion : NULL, DBL_MAX) );
 #if defined(CMR_DEBUG)
   CMRdbgMsg(2, "CMRtestCamionSigned() returned %s.\n", isCamionSigned ? "TRUE": "FALSE");
 #endif /* CMR_DEBUG */
@@ -135,11 +149,10 @@ CMR_ERROR CMRtestConetworkMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisConetwor
     return CMR_OKAY;
   }
 
-  double remainingTime = timeLimit - (clock() - totalClock) * 1.0 / CLOCKS_PER_SEC;
   CMR_GRAPH_EDGE* forestEdges = NULL;
   CMR_GRAPH_EDGE* coforestEdges = NULL;
   CMR_CALL( CMRtestCographicMatrix(cmr, matrix, pisConetwork, pdigraph, pforestArcs ? &forestEdges : NULL,
-    pcoforestArcs ? &coforestEdges : NULL, psubmatrix, stats ? &stats->graphic : NULL, remainingTime) );
+    pcoforestArcs ? &coforestEdges : NULL, psubmatrix, stats ? &stats->graphic : NULL, DBL_MAX) );
 #if defined(CMR_DEBUG)
   CMRdbgMsg(2, "CMRtestCographicMatrix() returned %s.\n", (*pisConetwork) ? "TRUE": "FALSE");
 #endif /* CMR_DEBUG */
@@ -174,8 +187,8 @@ CMR_ERROR CMRtestConetworkMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisConetwor
   /* Decompose into 1-connected components. */
   size_t numComponents;
   CMR_ONESUM_COMPONENT* components = NULL;
-  CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(char), sizeof(char), &numComponents, &components, NULL,
-    NULL, NULL, NULL) );
+  CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(char), sizeof(char), true, &numComponents,
+    &components, NULL, NULL, NULL, NULL) );
 
   /* Allocate and initialize auxiliary data for nodes. */
   NetworkNodeData* nodeData = NULL;
@@ -204,7 +217,7 @@ CMR_ERROR CMRtestConetworkMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisConetwor
     edgeData[forestEdges[b]].forestIndex = b;
 
   /* Allocate and initialize a queue for BFS. */
-  int* queue = NULL;
+  CMR_GRAPH_NODE* queue = NULL;
   int queueFirst;
   int queueBeyond;
   CMR_CALL(CMRallocStackArray(cmr, &queue, matrix->numColumns + matrix->numRows));
@@ -437,6 +450,18 @@ CMR_ERROR CMRtestConetworkMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisConetwor
   return CMR_OKAY;
 }
 
+CMR_ERROR CMRtestConetworkMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisConetwork, CMR_GRAPH** pdigraph,
+  CMR_GRAPH_EDGE** pforestArcs, CMR_GRAPH_EDGE** pcoforestArcs, bool** parcsReversed, CMR_SUBMAT** psubmatrix,
+  CMR_NETWORK_STATISTICS* stats, double timeLimit)
+{
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = testConetwork(cmr, matrix, pisConetwork, pdigraph, pforestArcs, pcoforestArcs, parcsReversed,
+    psubmatrix, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  return error;
+}
+
 CMR_ERROR CMRtestNetworkMatrix(CMR* cmr, CMR_CHRMAT* matrix, bool* pisNetwork, CMR_GRAPH** pdigraph,
   CMR_GRAPH_EDGE** pforestArcs, CMR_GRAPH_EDGE** pcoforestArcs, bool** parcsReversed, CMR_SUBMAT** psubmatrix,
   CMR_NETWORK_STATISTICS* stats, double timeLimit)
@@ -2,40 +2,339 @@
 
 #include "one_sum.h"
 
+#include <cmr/graph.h>
+
 #include <assert.h>
 #include <stdlib.h>
 #include <math.h>
 #include <limits.h>
+#include <stdint.h>
 
 #include "env_internal.h"
 
+CMR_ERROR oneSumUnionFindInit(CMR* cmr, CMR_ONESUM_UNIONFIND* unionFind, size_t numRows, size_t numColumns)
+{
+  assert(cmr);
+  assert(unionFind);
+
+  unionFind->numRows = numRows;
+  unionFind->numColumns = numColumns;
+  unionFind->parents = NULL;
+  unionFind->ranks = NULL;
+  size_t numNodes = numRows + numColumns;
+  CMR_CALL( CMRallocBlockArray(cmr, &unionFind->parents, numNodes) );
+  CMR_CALL( CMRallocBlockArray(cmr, &unionFind->ranks, numNodes) );
+  for (size_t node = 0; node < numNodes; ++node)
+  {
+    unionFind->parents[node] = node;
+    unionFind->ranks[node] = 0;
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR oneSumUnionFindClear(CMR* cmr, CMR_ONESUM_UNIONFIND* unionFind)
+{
+  assert(cmr);
+  assert(unionFind);
+
+  CMR_CALL( CMRfreeBlockArray(cmr, &unionFind->ranks) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &unionFind->parents) );
+
+  return CMR_OKAY;
+}
+
+size_t oneSumUnionFindLabel(CMR_ONESUM_UNIONFIND* unionFind, size_t* nodeLabels)
+{
+  assert(unionFind);
+  assert(nodeLabels);
+
+  /* Nodes are labeled in increasing order, so each root's label is known before any node of a larger index needs
+   * it. A root that has no label yet stores SIZE_MAX. */
+  size_t numNodes = unionFind->numRows + unionFind->numColumns;
+  for (size_t node = 0; node < numNodes; ++node)
+    nodeLabels[node] = SIZE_MAX;
+
+  size_t numLabels = 0;
+  for (size_t node = 0; node < numNodes; ++node)
+  {
+    size_t root = oneSumUnionFindFind(unionFind, node);
+    if (nodeLabels[root] == SIZE_MAX)
+      nodeLabels[root] = numLabels++;
+    nodeLabels[node] = nodeLabels[root];
+  }
+
+  return numLabels;
+}
+
+/**
+ * \brief Signed index of row and column nodes, of nonzeros and of components in the 1-sum decomposition.
+ *
+ * It has the width of the indices of \ref CMR_GRAPH, i.e., 64 bits if the library is built with \c INDEX64.
+ */
+
+typedef CMR_GRAPH_INDEX ONESUM_INDEX;
+
 struct GraphNode
 {
-  int adjacencyStart; /**< \brief Index of first outgoing arc. */
-  int component;      /**< \brief Index of component of matrix. */
-  int degree;         /**< \brief Used to count the degree. */
-  int order;          /**< \brief Corresponding row/column in component. */
+  ONESUM_INDEX component;       /**< \brief Index of component of matrix. */
+  ONESUM_INDEX degree;          /**< \brief Number of nonzeros in the row or column. */
+  ONESUM_INDEX order;           /**< \brief Corresponding row/column in component. */
+  ONESUM_INDEX adjacencyStart;  /**< \brief First entry of a row node, or index of the first row of a column node in
+                                 **  the array of the rows of all columns; only used for a depth-first search. */
 };
 typedef struct GraphNode GRAPH_NODE;
 
+#define ONESUM_NONZERO_DBL(value) ((value) != 0.0)      /**< Whether a stored double entry is nonzero. */
+#define ONESUM_NONZERO_INT(value) ((value) != 0)        /**< Whether a stored int entry is nonzero. */
+#define ONESUM_NONZERO_CHR(value) ((void) (value), assert((value) != 0), true) /**< Stored char entries are nonzero. */
+#define ONESUM_ROW_BEYOND_SLICE(node) ((ONESUM_INDEX) rowSlice[(node) + 1]) /**< Row end if zeros may be stored. */
+#define ONESUM_ROW_BEYOND_DEGREE(node) \
+  (graphNodes[(node)].adjacencyStart + graphNodes[(node)].degree) /**< Row end if all stored entries are nonzero. */
+
+/**
+ * \brief Defines the functions that scan the nonzeros of a matrix whose entries have values of type \p TYPE.
+ *
+ * The defined function scanNonzeros##NAME counts the nonzeros of each row and column node and adds them to the
+ * union-find structure, while countDegrees##NAME only counts them. The function fillColumnRows##NAME stores the rows
+ * of the nonzeros of each column, and labelNodes##NAME labels the components and orders their rows and columns by a
+ * depth-first search. The macro \p IS_NONZERO decides whether a stored entry is a nonzero, and \p ROW_BEYOND yields
+ * the entry beyond the last one of a row node, whose first entry is stored in the node.
+ */
+
+#define ONESUM_SCAN_FUNCTIONS(NAME, TYPE, IS_NONZERO, ROW_BEYOND) \
+  static \
+  void scanNonzeros##NAME(CMR_MATRIX* matrix, GRAPH_NODE* graphNodes, CMR_ONESUM_UNIONFIND* unionFind) \
+  { \
+    const TYPE* values = (const TYPE*) matrix->entryValues; \
+    const size_t firstColumnNode = matrix->numRows; \
+    for (size_t row = 0; row < matrix->numRows; ++row) \
+    { \
+      size_t first = matrix->rowSlice[row]; \
+      size_t beyond = matrix->rowSlice[row + 1]; \
+      for (size_t e = first; e < beyond; ++e) \
+      { \
+        if (IS_NONZERO(values[e])) \
+        { \
+          size_t column = matrix->entryColumns[e]; \
+          graphNodes[row].degree++; \
+          graphNodes[firstColumnNode + column].degree++; \
+          oneSumUnionFindAddNonzero(unionFind, row, column); \
+        } \
+      } \
+    } \
+  } \
+  \
+  static \
+  void countDegrees##NAME(CMR_MATRIX* matrix, GRAPH_NODE* graphNodes) \
+  { \
+    const TYPE* values = (const TYPE*) matrix->entryValues; \
+    const size_t firstColumnNode = matrix->numRows; \
+    for (size_t row = 0; row < matrix->numRows; ++row) \
+    { \
+      size_t first = matrix->rowSlice[row]; \
+      size_t beyond = matrix->rowSlice[row + 1]; \
+      for (size_t e = first; e < beyond; ++e) \
+      { \
+        if (IS_NONZERO(values[e])) \
+        { \
+          graphNodes[row].degree++; \
+          graphNodes[firstColumnNode + matrix->entryColumns[e]].degree++; \
+        } \
+      } \
+    } \
+  } \
+  \
+  static \
+  void fillColumnRows##NAME(CMR_MATRIX* matrix, GRAPH_NODE* graphNodes, ONESUM_INDEX* columnRows) \
+  { \
+    const TYPE* values = (const TYPE*) matrix->entryValues; \
+    const size_t firstColumnNode = matrix->numRows; \
+    for (size_t row = 0; row < matrix->numRows; ++row) \
+    { \
+      size_t first = matrix->rowSlice[row]; \
+      size_t beyond = matrix->rowSlice[row + 1]; \
+      for (size_t e = first; e < beyond; ++e) \
+      { \
+        if (IS_NONZERO(values[e])) \
+          columnRows[graphNodes[firstColumnNode + matrix->entryColumns[e]].adjacencyStart++] = row; \
+      } \
+    } \
+  } \
+  \
+  static \
+  ONESUM_INDEX labelNodes##NAME(CMR_MATRIX* matrix, GRAPH_NODE* graphNodes, ONESUM_INDEX* columnRows, \
+    ONESUM_INDEX* stack) \
+  { \
+    const TYPE* values = (const TYPE*) matrix->entryValues; \
+    const size_t* rowSlice = matrix->rowSlice; \
+    const size_t* entryColumns = matrix->entryColumns; \
+    (void) rowSlice; \
+    const ONESUM_INDEX firstColumnNode = matrix->numRows; \
+    const ONESUM_INDEX numNodes = matrix->numRows + matrix->numColumns; \
+    ONESUM_INDEX countComponents = 0; \
+    for (ONESUM_INDEX startNode = 0; startNode < numNodes; ++startNode) \
+    { \
+      if (graphNodes[startNode].component >= 0) \
+        continue; \
+      ONESUM_INDEX currentOrderRow = 0; \
+      ONESUM_INDEX currentOrderColumn = 0; \
+      graphNodes[startNode].component = countComponents; \
+      if (startNode < firstColumnNode) \
+        graphNodes[startNode].order = currentOrderRow++; \
+      else \
+        graphNodes[startNode].order = currentOrderColumn++; \
+      ONESUM_INDEX stackLength = 1; \
+      stack[0] = startNode; \
+      while (stackLength > 0) \
+      { \
+        ONESUM_INDEX node = stack[--stackLength]; \
+        if (node < firstColumnNode) \
+        { \
+          ONESUM_INDEX beyond = ROW_BEYOND(node); \
+          for (ONESUM_INDEX e = graphNodes[node].adjacencyStart; e < beyond; ++e) \
+          { \
+            ONESUM_INDEX columnNode = firstColumnNode + entryColumns[e]; \
+            if (IS_NONZERO(values[e]) && graphNodes[columnNode].component < 0) \
+            { \
+              graphNodes[columnNode].component = countComponents; \
+              graphNodes[columnNode].order = currentOrderColumn++; \
+              stack[stackLength++] = columnNode; \
+            } \
+          } \
+        } \
+        else \
+        { \
+          ONESUM_INDEX beyond = graphNodes[node].adjacencyStart; \
+          for (ONESUM_INDEX i = beyond - graphNodes[node].degree; i < beyond; ++i) \
+          { \
+            ONESUM_INDEX rowNode = columnRows[i]; \
+            if (graphNodes[rowNode].component < 0) \
+            { \
+              graphNodes[rowNode].component = countComponents; \
+              graphNodes[rowNode].order = currentOrderRow++; \
+              stack[stackLength++] = rowNode; \
+            } \
+          } \
+        } \
+      } \
+      ++countComponents; \
+    } \
+    return countComponents; \
+  }
+
+ONESUM_SCAN_FUNCTIONS(Dbl, double, ONESUM_NONZERO_DBL, ONESUM_ROW_BEYOND_SLICE)
+ONESUM_SCAN_FUNCTIONS(Int, int, ONESUM_NONZERO_INT, ONESUM_ROW_BEYOND_SLICE)
+ONESUM_SCAN_FUNCTIONS(Chr, char, ONESUM_NONZERO_CHR, ONESUM_ROW_BEYOND_DEGREE)
+
+/**
+ * \brief Defines the function that fills the transpose of a component with the entries of a matrix.
+ *
+ * The defined function fillTranspose##NAME copies the nonzeros of the component's rows from \p matrix, whose values
+ * have type \p SOURCE, to the component's transpose, whose values have type \p TARGET. Its row slices must contain
+ * the first entry of each row, and afterwards contain the first entry of the next row.
+ */
+
+#define ONESUM_FILL_TRANSPOSE_FUNCTION(NAME, SOURCE, TARGET, IS_NONZERO, CONVERT) \
+  static \
+  void fillTranspose##NAME(CMR_MATRIX* matrix, CMR_ONESUM_COMPONENT* component, GRAPH_NODE* graphNodes, \
+    ONESUM_INDEX firstColumnNode) \
+  { \
+    const SOURCE* values = (const SOURCE*) matrix->entryValues; \
+    CMR_MATRIX* compTranspose = component->transpose; \
+    TARGET* compValues = (TARGET*) compTranspose->entryValues; \
+    for (size_t compRow = 0; compRow < compTranspose->numColumns; ++compRow) \
+    { \
+      size_t row = component->rowsToOriginal[compRow]; \
+      size_t start = matrix->rowSlice[row]; \
+      size_t end = matrix->rowSlice[row + 1]; \
+      for (size_t matrixEntry = start; matrixEntry < end; ++matrixEntry) \
+      { \
+        if (IS_NONZERO(values[matrixEntry])) \
+        { \
+          ONESUM_INDEX compColumn = graphNodes[firstColumnNode + matrix->entryColumns[matrixEntry]].order; \
+          size_t compEntry = compTranspose->rowSlice[compColumn]++; \
+          compTranspose->entryColumns[compEntry] = compRow; \
+          compValues[compEntry] = CONVERT(values[matrixEntry]); \
+        } \
+      } \
+    } \
+  }
+
+#define ONESUM_CONVERT_COPY(value) (value)                /**< Converts an entry without rounding. */
+#define ONESUM_CONVERT_ROUND(value) ((int) round(value))  /**< Rounds a double entry to an integer. */
+
+ONESUM_FILL_TRANSPOSE_FUNCTION(DblToDbl, double, double, ONESUM_NONZERO_DBL, ONESUM_CONVERT_COPY)
+ONESUM_FILL_TRANSPOSE_FUNCTION(DblToInt, double, int, ONESUM_NONZERO_DBL, ONESUM_CONVERT_ROUND)
+ONESUM_FILL_TRANSPOSE_FUNCTION(DblToChr, double, char, ONESUM_NONZERO_DBL, ONESUM_CONVERT_ROUND)
+ONESUM_FILL_TRANSPOSE_FUNCTION(IntToDbl, int, double, ONESUM_NONZERO_INT, ONESUM_CONVERT_COPY)
+ONESUM_FILL_TRANSPOSE_FUNCTION(IntToInt, int, int, ONESUM_NONZERO_INT, ONESUM_CONVERT_COPY)
+ONESUM_FILL_TRANSPOSE_FUNCTION(IntToChr, int, char, ONESUM_NONZERO_INT, ONESUM_CONVERT_COPY)
+ONESUM_FILL_TRANSPOSE_FUNCTION(ChrToDbl, char, double, ONESUM_NONZERO_CHR, ONESUM_CONVERT_COPY)
+ONESUM_FILL_TRANSPOSE_FUNCTION(ChrToInt, char, int, ONESUM_NONZERO_CHR, ONESUM_CONVERT_COPY)
+ONESUM_FILL_TRANSPOSE_FUNCTION(ChrToChr, char, char, ONESUM_NONZERO_CHR, ONESUM_CONVERT_COPY)
+
+/**
+ * \brief Defines the function that fills the matrix of a component from its transpose.
+ *
+ * The defined function fillMatrix##NAME copies the entries, whose values have type \p TYPE. The row slices of the
+ * matrix must contain the first entry of each row, and afterwards contain the first entry of the next row.
+ */
+
+#define ONESUM_FILL_MATRIX_FUNCTION(NAME, TYPE) \
+  static \
+  void fillMatrix##NAME(CMR_ONESUM_COMPONENT* component) \
+  { \
+    CMR_MATRIX* compMatrix = component->matrix; \
+    CMR_MATRIX* compTranspose = component->transpose; \
+    TYPE* compValues = (TYPE*) compMatrix->entryValues; \
+    const TYPE* compTransposeValues = (const TYPE*) compTranspose->entryValues; \
+    for (size_t compColumn = 0; compColumn < compMatrix->numColumns; ++compColumn) \
+    { \
+      size_t start = compTranspose->rowSlice[compColumn]; \
+      size_t end = compTranspose->rowSlice[compColumn + 1]; \
+      for (size_t compTransposeEntry = start; compTransposeEntry < end; ++compTransposeEntry) \
+      { \
+        size_t compMatrixEntry = compMatrix->rowSlice[compTranspose->entryColumns[compTransposeEntry]]++; \
+        compMatrix->entryColumns[compMatrixEntry] = compColumn; \
+        compValues[compMatrixEntry] = compTransposeValues[compTransposeEntry]; \
+      } \
+    } \
+  }
+
+ONESUM_FILL_MATRIX_FUNCTION(Dbl, double)
+ONESUM_FILL_MATRIX_FUNCTION(Int, int)
+ONESUM_FILL_MATRIX_FUNCTION(Chr, char)
+
+typedef void (*ScanNonzerosFunction)(CMR_MATRIX* matrix, GRAPH_NODE* graphNodes, CMR_ONESUM_UNIONFIND* unionFind);
+typedef void (*CountDegreesFunction)(CMR_MATRIX* matrix, GRAPH_NODE* graphNodes);
+typedef void (*FillColumnRowsFunction)(CMR_MATRIX* matrix, GRAPH_NODE* graphNodes, ONESUM_INDEX* columnRows);
+typedef ONESUM_INDEX (*LabelNodesFunction)(CMR_MATRIX* matrix, GRAPH_NODE* graphNodes, ONESUM_INDEX* columnRows,
+  ONESUM_INDEX* stack);
+typedef void (*FillTransposeFunction)(CMR_MATRIX* matrix, CMR_ONESUM_COMPONENT* component, GRAPH_NODE* graphNodes,
+  ONESUM_INDEX firstColumnNode);
+typedef void (*FillMatrixFunction)(CMR_ONESUM_COMPONENT* component);
+
 CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_t targetType,
-  size_t* pnumComponents, CMR_ONESUM_COMPONENT** pcomponents, size_t* rowsToComponents,
+  bool sequentiallyConnected, size_t* pnumComponents, CMR_ONESUM_COMPONENT** pcomponents, size_t* rowsToComponents,
   size_t* columnsToComponents, size_t* rowsToComponentRows, size_t* columnsToComponentColumns)
 {
-  GRAPH_NODE* graphNodes = NULL;
-  int* graphAdjacencies = NULL;
-  int* queue = NULL;
-  int queueLength = 0;
-  int numNodes = matrix->numRows + matrix->numColumns;
-  int countComponents = 0;
-  const int firstColumnNode = matrix->numRows;
-  int i;
-
   assert(cmr);
   assert(matrix);
   assert(pnumComponents);
   assert(pcomponents);
 
+  /* Nodes and nonzeros must be representable as indices. */
+  if (matrix->numRows > CMR_GRAPH_INDEX_MAX || matrix->numColumns > CMR_GRAPH_INDEX_MAX - matrix->numRows
+    || matrix->numNonzeros > CMR_GRAPH_INDEX_MAX)
+  {
+    return CMR_ERROR_OVERFLOW;
+  }
+
+  GRAPH_NODE* graphNodes = NULL;
+  ONESUM_INDEX numNodes = matrix->numRows + matrix->numColumns;
+  const ONESUM_INDEX firstColumnNode = matrix->numRows;
+
 #if defined(CMR_DEBUG)
   CMRdbgMsg(0, "decomposeOneSum:\n");
   if (matrixType == sizeof(double))
@@ -46,142 +345,105 @@ CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_
     CMRchrmatPrintDense(stdout, (CMR_CHRMAT*) matrix, '0', true);
 #endif
 
-  CMR_CALL( CMRallocStackArray(cmr, &graphNodes, numNodes + 1) );
-  CMR_CALL( CMRallocStackArray(cmr, &graphAdjacencies, 2 * matrix->numNonzeros) );
-  CMR_CALL( CMRallocStackArray(cmr, &queue, numNodes) );
+  CMR_CALL( CMRallocStackArray(cmr, &graphNodes, numNodes) );
+  for (ONESUM_INDEX node = 0; node < numNodes; ++node)
+    graphNodes[node].degree = 0;
 
-  for (int node = 0; node < numNodes; ++node)
+  /* Select the type-specific functions. */
+  ScanNonzerosFunction scanNonzeros;
+  CountDegreesFunction countDegrees;
+  FillColumnRowsFunction fillColumnRows;
+  LabelNodesFunction labelNodes;
+  FillTransposeFunction fillTranspose;
+  FillMatrixFunction fillMatrix;
+  if (matrixType == sizeof(double))
   {
-    graphNodes[node].component = -1;
-    graphNodes[node].degree = 0;
+    scanNonzeros = scanNonzerosDbl;
+    countDegrees = countDegreesDbl;
+    fillColumnRows = fillColumnRowsDbl;
+    labelNodes = labelNodesDbl;
+    fillTranspose = targetType == sizeof(double) ? fillTransposeDblToDbl
+      : (targetType == sizeof(int) ? fillTransposeDblToInt : fillTransposeDblToChr);
   }
-
-  /* Count degrees */
-  for (size_t row = 0; row < matrix->numRows; ++row)
+  else if (matrixType == sizeof(int))
   {
-    size_t first = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row + 1];
-    for (size_t e = first; e < beyond; ++e)
-    {
-      bool isNonzero;
-      if (matrixType == sizeof(double))
-        isNonzero = ((double*)matrix->entryValues)[e] != 0.0;
-      else if (matrixType == sizeof(int))
-        isNonzero = ((int*)matrix->entryValues)[e] != 0;
-      else
-      {
-        assert(matrixType == sizeof(char));
-        isNonzero = ((char*)matrix->entryValues)[e] != 0;
-      }
-      if (isNonzero)
-      {
-        int column = matrix->entryColumns[e];
-        graphNodes[row].degree++;
-        graphNodes[firstColumnNode + column].degree++;
-      }
-    }
+    scanNonzeros = scanNonzerosInt;
+    countDegrees = countDegreesInt;
+    fillColumnRows = fillColumnRowsInt;
+    labelNodes = labelNodesInt;
+    fillTranspose = targetType == sizeof(double) ? fillTransposeIntToDbl
+      : (targetType == sizeof(int) ? fillTransposeIntToInt : fillTransposeIntToChr);
   }
-
-  /* Compute ranges for adjacencies */
-  i = 0;
-  for (int node = 0; node < numNodes; ++node)
+  else
+  {
+    assert(matrixType == sizeof(char));
+    scanNonzeros = scanNonzerosChr;
+    countDegrees = countDegreesChr;
+    fillColumnRows = fillColumnRowsChr;
+    labelNodes = labelNodesChr;
+    fillTranspose = targetType == sizeof(double) ? fillTransposeChrToDbl
+      : (targetType == sizeof(int) ? fillTransposeChrToInt : fillTransposeChrToChr);
+  }
+  if (targetType == sizeof(double))
+    fillMatrix = fillMatrixDbl;
+  else if (targetType == sizeof(int))
+    fillMatrix = fillMatrixInt;
+  else
   {
-    graphNodes[node].adjacencyStart = i;
-    i += graphNodes[node].degree;
+    assert(targetType == sizeof(char));
+    fillMatrix = fillMatrixChr;
   }
-  graphNodes[numNodes].adjacencyStart = i;
 
-  /* Scan entries and create adjacencies. */
-  for (size_t row = 0; row < matrix->numRows; ++row)
+  ONESUM_INDEX countComponents;
+  if (sequentiallyConnected)
   {
-    size_t first = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row+1];
-    for (size_t e = first; e < beyond; ++e)
+    /* Store the rows of each column, which together with the row slices yield the adjacencies of the search. */
+    countDegrees(matrix, graphNodes);
+    ONESUM_INDEX* columnRows = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &columnRows, matrix->numNonzeros) );
+    ONESUM_INDEX* stack = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &stack, numNodes) );
+
+    for (ONESUM_INDEX row = 0; row < firstColumnNode; ++row)
+      graphNodes[row].adjacencyStart = matrix->rowSlice[row];
+    ONESUM_INDEX start = 0;
+    for (ONESUM_INDEX node = firstColumnNode; node < numNodes; ++node)
     {
-      bool isNonzero = false;
-      if (matrixType == sizeof(double))
-        isNonzero = ((double*)matrix->entryValues)[e] != 0.0;
-      else if (matrixType == sizeof(int))
-        isNonzero = ((int*)matrix->entryValues)[e] != 0;
-      else if (matrixType == sizeof(char))
-        isNonzero = ((char*)matrix->entryValues)[e] != 0;
-      else
-        assert("Invalid matrixType parameter." == 0);
-
-      if (isNonzero)
-      {
-        int column = matrix->entryColumns[e];
-        int columnNode = firstColumnNode + column;
-        CMRdbgMsg(2, "Nonzero (%d,%d) with row node %d (%d neighbors missing) and column node %d (%d neighbors missing).\n",
-          row, column, row, graphNodes[row].degree, columnNode, graphNodes[columnNode].degree);
-        graphAdjacencies[graphNodes[row + 1].adjacencyStart - graphNodes[row].degree] = columnNode;
-        graphNodes[row].degree--;
-        graphAdjacencies[graphNodes[columnNode + 1].adjacencyStart - graphNodes[columnNode].degree] = row;
-        graphNodes[columnNode].degree--;
-      }
+      graphNodes[node].adjacencyStart = start;
+      start += graphNodes[node].degree;
     }
-  }
-
-  /*
-   * We decremented the degree entries, so they should be 0. From now on we can query
-   * graphNodes[node+1].adjacencyStart - graphNodes[node].adjacencyStart if necessary.
-   *
-   * TODO: make degree a union with something else to save memory and improve cache behavior.
-   */
+    fillColumnRows(matrix, graphNodes, columnRows);
 
-  for (int node = 0; node < numNodes; ++node)
-    assert(graphNodes[node].degree == 0);
+    for (ONESUM_INDEX node = 0; node < numNodes; ++node)
+      graphNodes[node].component = -1;
+    countComponents = labelNodes(matrix, graphNodes, columnRows, stack);
 
-  /* Run DFS. */
-  for (int startNode = 0; startNode < numNodes; ++startNode)
+    CMR_CALL( CMRfreeStackArray(cmr, &stack) );
+    CMR_CALL( CMRfreeStackArray(cmr, &columnRows) );
+  }
+  else
   {
-    if (graphNodes[startNode].component < 0)
-    {
-      /* Start a new component. */
-      int currentOrderRow = 0;
-      int currentOrderColumn = 0;
-
-      graphNodes[startNode].component = countComponents;
-      graphNodes[startNode].order = 0;
-      if (startNode < firstColumnNode)
-        currentOrderRow++;
-      else
-        currentOrderColumn++;
-      queueLength = 1;
-      queue[0] = startNode;
-      while (queueLength > 0)
-      {
-        int currentNode = queue[--queueLength];
-        int start = graphNodes[currentNode].adjacencyStart;
-        int end = graphNodes[currentNode + 1].adjacencyStart;
-
-        for (int i = start; i < end; ++i)
-        {
-          int endNode = graphAdjacencies[i];
-          if (graphNodes[endNode].component < 0)
-          {
-            graphNodes[endNode].component = countComponents;
-            if (endNode < firstColumnNode)
-              graphNodes[endNode].order = currentOrderRow++;
-            else
-              graphNodes[endNode].order = currentOrderColumn++;
-            queue[queueLength] = endNode;
-            ++queueLength;
-          }
-        }
-      }
-
-      ++countComponents;
-    }
+    /* Count degrees and merge the components of the row and column of each nonzero. */
+    CMR_ONESUM_UNIONFIND unionFind;
+    CMR_CALL( oneSumUnionFindInit(cmr, &unionFind, matrix->numRows, matrix->numColumns) );
+    scanNonzeros(matrix, graphNodes, &unionFind);
+
+    size_t* nodeLabels = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &nodeLabels, numNodes) );
+    countComponents = oneSumUnionFindLabel(&unionFind, nodeLabels);
+    for (ONESUM_INDEX node = 0; node < numNodes; ++node)
+      graphNodes[node].component = nodeLabels[node];
+    CMR_CALL( CMRfreeStackArray(cmr, &nodeLabels) );
+    CMR_CALL( oneSumUnionFindClear(cmr, &unionFind) );
   }
 
   *pnumComponents = countComponents;
 
 #if defined(CMR_DEBUG)
-  printf("DFS found %d components.\n", countComponents);
-  for (int node = 0; node < numNodes; ++node)
+  printf("Found %ld components.\n", (long) countComponents);
+  for (ONESUM_INDEX node = 0; node < numNodes; ++node)
   {
-    printf("Node %d has component %d.\n", node, graphNodes[node].component);
+    printf("Node %ld has component %ld.\n", (long) node, (long) graphNodes[node].component);
   }
 #endif
 
@@ -190,7 +452,7 @@ CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_
   CMR_ONESUM_COMPONENT* components = *pcomponents;
 
   /* Compute sizes. */
-  for (int comp = 0; comp < countComponents; ++comp)
+  for (ONESUM_INDEX comp = 0; comp < countComponents; ++comp)
   {
     components[comp].matrix = NULL;
     components[comp].transpose = NULL;
@@ -199,28 +461,32 @@ CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_
     CMR_CALL( CMRchrmatCreate(cmr, (CMR_CHRMAT**) &components[comp].matrix, 0, 0, 0) );
   }
 
-  for (int node = 0; node < numNodes; ++node)
+  /* Unless they were ordered by the search, the rows and columns keep their order within each component. */
+  for (ONESUM_INDEX node = 0; node < numNodes; ++node)
   {
-    int comp = graphNodes[node].component;
-    int start = graphNodes[node].adjacencyStart;
-    int end = graphNodes[node + 1].adjacencyStart;
-    assert(comp >= 0);
+    CMR_MATRIX* compMatrix = components[graphNodes[node].component].matrix;
     if (node < firstColumnNode)
     {
-      components[comp].matrix->numRows++;
-      components[comp].matrix->numNonzeros += end - start;
+      if (!sequentiallyConnected)
+        graphNodes[node].order = compMatrix->numRows;
+      compMatrix->numRows++;
+      compMatrix->numNonzeros += graphNodes[node].degree;
     }
     else
-      components[comp].matrix->numColumns++;
+    {
+      if (!sequentiallyConnected)
+        graphNodes[node].order = compMatrix->numColumns;
+      compMatrix->numColumns++;
+    }
   }
 
   /* Allocate memory */
-  for (int comp = 0; comp < countComponents; ++comp)
+  for (ONESUM_INDEX comp = 0; comp < countComponents; ++comp)
   {
     CMR_MATRIX* compMatrix = components[comp].matrix;
 
 #if defined(CMR_DEBUG)
-    printf("Component %d has %dx%d matrix with %d nonzeros.\n", comp, compMatrix->numRows,
+    printf("Component %ld has %zux%zu matrix with %zu nonzeros.\n", (long) comp, compMatrix->numRows,
       compMatrix->numColumns, compMatrix->numNonzeros);
 #endif
 
@@ -255,10 +521,10 @@ CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_
   }
 
   /* Fill mapping arrays. */
-  for (int node = 0; node < numNodes; ++node)
+  for (ONESUM_INDEX node = 0; node < numNodes; ++node)
   {
-    int comp = graphNodes[node].component;
-    int order = graphNodes[node].order;
+    ONESUM_INDEX comp = graphNodes[node].component;
+    ONESUM_INDEX order = graphNodes[node].order;
     if (node < firstColumnNode)
       components[comp].rowsToOriginal[order] = node;
     else
@@ -266,129 +532,49 @@ CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_
   }
 
 #if defined(CMR_DEBUG)
-  for (int comp = 0; comp < countComponents; ++comp)
+  for (ONESUM_INDEX comp = 0; comp < countComponents; ++comp)
   {
-    printf("Component %d's rows map to original rows:", comp);
-    for (int row = 0; row < components[comp].matrix->numRows; ++row)
-      printf(" %d", components[comp].rowsToOriginal[row]);
+    printf("Component %ld's rows map to original rows:", (long) comp);
+    for (ONESUM_INDEX row = 0; row < components[comp].matrix->numRows; ++row)
+      printf(" %zu", components[comp].rowsToOriginal[row]);
     printf("\n");
-    printf("Component %d's columns map to original columns:", comp);
-    for (int column = 0; column < components[comp].matrix->numColumns; ++column)
-      printf(" %d", components[comp].columnsToOriginal[column]);
+    printf("Component %ld's columns map to original columns:", (long) comp);
+    for (ONESUM_INDEX column = 0; column < components[comp].matrix->numColumns; ++column)
+      printf(" %zu", components[comp].columnsToOriginal[column]);
     printf("\n");
   }
 #endif
 
   /* We can now fill the matrices of each component. */
-  for (int comp = 0; comp < countComponents; ++comp)
+  for (ONESUM_INDEX comp = 0; comp < countComponents; ++comp)
   {
     CMR_MATRIX* compTranspose = components[comp].transpose;
 
-    /* Compute the slices in the transposed component matrix from the graph. */
-    int countNonzeros = 0;
+    /* Compute the slices in the transposed component matrix from the degrees. */
+    ONESUM_INDEX countNonzeros = 0;
     for (size_t compColumn = 0; compColumn < compTranspose->numRows; ++compColumn)
     {
-      int column = components[comp].columnsToOriginal[compColumn];
-      int node = firstColumnNode + column;
+      ONESUM_INDEX column = components[comp].columnsToOriginal[compColumn];
+      ONESUM_INDEX node = firstColumnNode + column;
       compTranspose->rowSlice[compColumn] = countNonzeros;
 #if defined(CMR_DEBUG)
-      printf("Component %d's column %d (row of transposed) starts at component entry %d.\n", comp, compColumn,
-        countNonzeros);
+      printf("Component %ld's column %zu (row of transposed) starts at component entry %ld.\n", (long) comp,
+        compColumn, (long) countNonzeros);
 #endif
-      countNonzeros += graphNodes[node+1].adjacencyStart - graphNodes[node].adjacencyStart;
+      countNonzeros += graphNodes[node].degree;
     }
 
     /* Fill the slices. To ensure that it is sorted, we iterate row-wise. */
-    for (size_t compRow = 0; compRow < compTranspose->numColumns; ++compRow)
-    {
-      size_t row = components[comp].rowsToOriginal[compRow];
-      size_t start = matrix->rowSlice[row];
-      size_t end = matrix->rowSlice[row + 1];
-
-      /* Iterate over all entries of that row. */
-      for (size_t matrixEntry = start; matrixEntry < end; ++matrixEntry)
-      {
-        bool isNonzero = false;
-        if (matrixType == sizeof(double))
-          isNonzero = round(((double*)matrix->entryValues)[matrixEntry]) != 0;
-        else if (matrixType == sizeof(int))
-          isNonzero = ((int*)matrix->entryValues)[matrixEntry] != 0;
-        else if (matrixType == sizeof(char))
-          isNonzero = ((char*)matrix->entryValues)[matrixEntry] != 0;
-        else
-          assert("Invalid matrixType parameter." == 0);
-
-        if (isNonzero)
-        {
-          size_t column = matrix->entryColumns[matrixEntry];
-          int compColumn = graphNodes[firstColumnNode + column].order;
-          int compEntry = compTranspose->rowSlice[compColumn];
-#if defined(CMR_DEBUG)
-          printf("Component %d contains matrix entry %d in at %d,%d.",
-            comp, matrixEntry, row, column);
-          printf(" It will be component entry %d at %d,%d\n", compEntry, compRow, compColumn);
-#endif
-          compTranspose->entryColumns[compEntry] = compRow;
-          compTranspose->rowSlice[compColumn]++;
-          if (targetType == sizeof(double) && matrixType == sizeof(double))
-          {
-            ((double*)compTranspose->entryValues)[compEntry] =
-              ((double*)matrix->entryValues)[matrixEntry];
-          }
-          else if (targetType == sizeof(int) && matrixType == sizeof(double))
-          {
-            ((int*)compTranspose->entryValues)[compEntry] =
-              (int)(round(((double*)matrix->entryValues)[matrixEntry]) + 0.5);
-          }
-          else if (targetType == sizeof(char) && matrixType == sizeof(double))
-          {
-            ((char*)compTranspose->entryValues)[compEntry] =
-              (char)(round(((double*)matrix->entryValues)[matrixEntry]) + 0.5);
-          }
-          else if (targetType == sizeof(double) && matrixType == sizeof(int))
-          {
-            ((double*)compTranspose->entryValues)[compEntry] =
-              ((int*)matrix->entryValues)[matrixEntry];
-          }
-          else if (targetType == sizeof(int) && matrixType == sizeof(int))
-          {
-            ((int*)compTranspose->entryValues)[compEntry] =
-              ((int*)matrix->entryValues)[matrixEntry];
-          }
-          else if (targetType == sizeof(char) && matrixType == sizeof(int))
-          {
-            ((char*)compTranspose->entryValues)[compEntry] =
-              ((int*)matrix->entryValues)[matrixEntry];
-          }
-          else if (targetType == sizeof(double) && matrixType == sizeof(char))
-          {
-            ((double*)compTranspose->entryValues)[compEntry] =
-              ((char*)matrix->entryValues)[matrixEntry];
-          }
-          else if (targetType == sizeof(int) && matrixType == sizeof(char))
-          {
-            ((int*)compTranspose->entryValues)[compEntry] =
-              ((char*)matrix->entryValues)[matrixEntry];
-          }
-          else if (targetType == sizeof(char) && matrixType == sizeof(char))
-          {
-            ((char*)compTranspose->entryValues)[compEntry] =
-              ((char*)matrix->entryValues)[matrixEntry];
-          }
-          else
-            assert("Invalid targetType / matrixType parameter combination." == 0);
-        }
-      }
-    }
+    fillTranspose(matrix, &components[comp], graphNodes, firstColumnNode);
 
     /* Since we incremented the rowSlice for each nonzero, the array is shifted by one entry.
      * We restore this now. */
-    for (int compColumn = compTranspose->numRows; compColumn > 0; --compColumn)
+    for (ONESUM_INDEX compColumn = compTranspose->numRows; compColumn > 0; --compColumn)
       compTranspose->rowSlice[compColumn] = compTranspose->rowSlice[compColumn-1];
     compTranspose->rowSlice[0] = 0;
 
 #if defined(CMR_DEBUG)
-    printf("Component %d's transpose:\n", comp);
+    printf("Component %ld's transpose:\n", (long) comp);
     if (targetType == sizeof(double))
       CMRdblmatPrintDense(stdout, (CMR_DBLMAT*) compTranspose, '0', true);
     else if (targetType == sizeof(int))
@@ -399,54 +585,30 @@ CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_
   }
 
   /* We now create the row-wise representation from the column-wise one. */
-  for (int comp = 0; comp < countComponents; ++comp)
+  for (ONESUM_INDEX comp = 0; comp < countComponents; ++comp)
   {
     CMR_MATRIX* compMatrix = components[comp].matrix;
-    CMR_MATRIX* compTranspose = components[comp].transpose;
 
-    /* Compute the slices in the component matrix from the graph. */
-    int countNonzeros = 0;
+    /* Compute the slices in the component matrix from the degrees. */
+    ONESUM_INDEX countNonzeros = 0;
     for (size_t compRow = 0; compRow < compMatrix->numRows; ++compRow)
     {
-      int row = components[comp].rowsToOriginal[compRow];
-      int node = row;
+      ONESUM_INDEX row = components[comp].rowsToOriginal[compRow];
+      ONESUM_INDEX node = row;
       compMatrix->rowSlice[compRow] = countNonzeros;
-      countNonzeros += graphNodes[node+1].adjacencyStart - graphNodes[node].adjacencyStart;
+      countNonzeros += graphNodes[node].degree;
     }
 
     /* Fill the slices. To ensure that it is sorted, we iterate column-wise. */
-    for (size_t compColumn = 0; compColumn < compMatrix->numColumns; ++compColumn)
-    {
-      int start = compTranspose->rowSlice[compColumn];
-      int end = compTranspose->rowSlice[compColumn + 1];
-
-      /* Iterate over all entries of that column. */
-      for (int compTransposeEntry = start; compTransposeEntry < end; ++compTransposeEntry)
-      {
-        int compRow = compTranspose->entryColumns[compTransposeEntry];
-        int compMatrixEntry = compMatrix->rowSlice[compRow];
-        compMatrix->entryColumns[compMatrixEntry] = compColumn;
-        compMatrix->rowSlice[compRow]++;
-#if defined(CMR_DEBUG)
-        printf("Component matrix entry %d (%d,%d in component) copied from component transpose entry %d.\n",
-          compMatrixEntry, compRow, compColumn, compTransposeEntry);
-#endif
-        if (targetType == sizeof(double))
-          ((double*)compMatrix->entryValues)[compMatrixEntry] = ((double*)compTranspose->entryValues)[compTransposeEntry];
-        else if (targetType == sizeof(int))
-          ((int*)compMatrix->entryValues)[compMatrixEntry] = ((int*)compTranspose->entryValues)[compTransposeEntry];
-        else if (targetType == sizeof(char))
-          ((char*)compMatrix->entryValues)[compMatrixEntry] = ((char*)compTranspose->entryValues)[compTransposeEntry];
-        else
-          assert("Invalid targetType parameter." == 0);
-      }
-    }
+    fillMatrix(&components[comp]);
 
     /* Since we incremented the rowSlice for each nonzero, the array is shifted by one entry.
      * We restore this now. */
-    for (int compRow = compMatrix->numRows; compRow > 0; --compRow)
+    for (ONESUM_INDEX compRow = compMatrix->numRows; compRow > 0; --compRow)
       compMatrix->rowSlice[compRow] = compMatrix->rowSlice[compRow-1];
     compMatrix->rowSlice[0] = 0;
+
+#if !defined(NDEBUG)
     bool isTranspose;
     if (targetType == sizeof(double))
     {
@@ -468,6 +630,7 @@ CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_
       isTranspose = false;
     }
     assert(isTranspose);
+#endif /* !NDEBUG */
   }
 
   /* Fill arrays for original matrix viewpoint. */
@@ -492,8 +655,6 @@ CMR_ERROR decomposeOneSum(CMR* cmr, CMR_MATRIX* matrix, size_t matrixType, size_
       columnsToComponentColumns[column] = graphNodes[firstColumnNode + column].order;
   }
 
-  CMR_CALL( CMRfreeStackArray(cmr, &queue) );
-  CMR_CALL( CMRfreeStackArray(cmr, &graphAdjacencies) );
   CMR_CALL( CMRfreeStackArray(cmr, &graphNodes) );
 
   return CMR_OKAY;
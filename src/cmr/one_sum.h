@@ -4,6 +4,8 @@
 #include <cmr/env.h>
 #include "matrix_internal.h"
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -20,11 +22,111 @@ typedef struct
   size_t* columnsToOriginal;  /**< \brief Maps component columns to original matrix columns. */
 } CMR_ONESUM_COMPONENT;
 
+/**
+ * \brief Union-find structure on the rows and columns of a matrix whose classes are the 1-connected components.
+ *
+ * Nonzeros can be added in any order, e.g., while the matrix is being read, and take near-constant amortized time
+ * each. Two classes may be merged by any later nonzero, so a component is only known to be complete when all
+ * nonzeros were added.
+ */
+
+typedef struct
+{
+  size_t numRows;         /**< \brief Number of rows. */
+  size_t numColumns;      /**< \brief Number of columns. */
+  size_t* parents;        /**< \brief Parent of each row node \f$ 0, \dotsc, m-1 \f$ and each column node
+                           **  \f$ m, \dotsc, m+n-1 \f$; roots are their own parents. */
+  unsigned char* ranks;   /**< \brief Rank of each root node. */
+} CMR_ONESUM_UNIONFIND;
+
+/**
+ * \brief Initializes a \ref CMR_ONESUM_UNIONFIND for a matrix without nonzeros.
+ */
+
+CMR_ERROR oneSumUnionFindInit(
+  CMR* cmr,                         /**< \ref CMR environment. */
+  CMR_ONESUM_UNIONFIND* unionFind,  /**< Union-find structure. */
+  size_t numRows,                   /**< Number of rows. */
+  size_t numColumns                 /**< Number of columns. */
+);
+
+/**
+ * \brief Frees the memory of a \ref CMR_ONESUM_UNIONFIND.
+ */
+
+CMR_ERROR oneSumUnionFindClear(
+  CMR* cmr,                         /**< \ref CMR environment. */
+  CMR_ONESUM_UNIONFIND* unionFind   /**< Union-find structure. */
+);
+
+/**
+ * \brief Returns the root of the class of \p node, compressing the path to it.
+ */
+
+static inline
+size_t oneSumUnionFindFind(
+  CMR_ONESUM_UNIONFIND* unionFind,  /**< Union-find structure. */
+  size_t node                       /**< Row node or column node. */
+)
+{
+  size_t* parents = unionFind->parents;
+  while (parents[node] != node)
+  {
+    parents[node] = parents[parents[node]];
+    node = parents[node];
+  }
+  return node;
+}
+
+/**
+ * \brief Adds the nonzero at (\p row, \p column), which merges the classes of its row and column.
+ */
+
+static inline
+void oneSumUnionFindAddNonzero(
+  CMR_ONESUM_UNIONFIND* unionFind,  /**< Union-find structure. */
+  size_t row,                       /**< Row of the nonzero. */
+  size_t column                     /**< Column of the nonzero. */
+)
+{
+  size_t rowRoot = oneSumUnionFindFind(unionFind, row);
+  size_t columnRoot = oneSumUnionFindFind(unionFind, unionFind->numRows + column);
+  if (rowRoot == columnRoot)
+    return;
+
+  if (unionFind->ranks[rowRoot] < unionFind->ranks[columnRoot])
+    unionFind->parents[rowRoot] = columnRoot;
+  else
+  {
+    unionFind->parents[columnRoot] = rowRoot;
+    if (unionFind->ranks[rowRoot] == unionFind->ranks[columnRoot])
+      unionFind->ranks[rowRoot]++;
+  }
+}
+
+/**
+ * \brief Labels the classes of a \ref CMR_ONESUM_UNIONFIND by \f$ 0, 1, \dotsc \f$ in the order of their first row
+ *        or, if they have no row, first column.
+ *
+ * Returns the number of classes.
+ */
+
+size_t oneSumUnionFindLabel(
+  CMR_ONESUM_UNIONFIND* unionFind,  /**< Union-find structure. */
+  size_t* nodeLabels                /**< Array for storing the label of each row node and each column node; row nodes
+                                     **  come first. */
+);
+
 /**
  * \brief Decomposes int matrix into 1-connected submatrices.
  *
  * Allocates an array \p components with an entry per 1-connected submatrix. The caller has to free this array and
- * its members.
+ * its members. The components are ordered by their first row (or column if they have no rows).
+ *
+ * If \p sequentiallyConnected is \c true, then the rows and columns of each component are ordered as they are
+ * discovered by a depth-first search, i.e., each of them except the first one has a nonzero in common with an
+ * earlier one. Otherwise, they are ordered as in \p matrix, and only \f$ O(m + n) \f$ additional memory is needed
+ * for an \f$ m \times n \f$ matrix.
  */
 
 CMR_ERROR decomposeOneSum(
@@ -32,6 +134,7 @@ CMR_ERROR decomposeOneSum(
   CMR_MATRIX* matrix,                 /**< Matrix */
   size_t matrixType,                  /**< Size of base type of matrix. */
   size_t targetType,                  /**< Size of base type of component matrices. */
+  bool sequentiallyConnected,         /**< Whether to order each component by a depth-first search. */
   size_t* pnumComponents,             /**< Pointer for storing the number of components. */
   CMR_ONESUM_COMPONENT** components,  /**< Pointer for storing the array with component information. */
   size_t* rowsToComponents,           /**< Mapping of rows of \p matrix to components (may be \c NULL). */
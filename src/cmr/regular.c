@@ -3,12 +3,15 @@
 #include <cmr/regular.h>
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <time.h>
 
 #include "env_internal.h"
 #include "dec_internal.h"
 #include "regular_internal.h"
+#include "result_cache.h"
+#include "threadpool.h"
 
 CMR_ERROR CMRparamsRegularInit(CMR_REGULAR_PARAMETERS* params)
 {
@@ -41,6 +44,8 @@ CMR_ERROR CMRstatsRegularInit(CMR_REGULAR_STATISTICS* stats)
   stats->enumerationCount = 0;
   stats->enumerationTime = 0.0;
   stats->enumerationCandidatesCount = 0;
+  stats->cacheHitCount = 0;
+  stats->cacheMissCount = 0;
 
   return CMR_OKAY;
 }
@@ -72,11 +77,70 @@ CMR_ERROR CMRstatsRegularPrint(FILE* stream, CMR_REGULAR_STATISTICS* stats, cons
     stats->enumerationTime);
   fprintf(stream, "%s3-separation candidates: %ld in %f seconds\n", prefix, stats->enumerationCandidatesCount,
     stats->enumerationTime);
+  if (stats->cacheHitCount || stats->cacheMissCount)
+  {
+    fprintf(stream, "%sresult cache: %ld hits, %ld misses\n", prefix, stats->cacheHitCount,
+      stats->cacheMissCount);
+  }
   fprintf(stream, "%stotal: %ld in %f seconds\n", prefix, stats->totalCount, stats->totalTime);
 
   return CMR_OKAY;
 }
 
+/**
+ * \brief Adds the (co)graphicness statistics \p other to \p stats.
+ */
+
+static
+void addStatsGraphic(
+  CMR_GRAPHIC_STATISTICS* stats,  /**< Statistics to add to. */
+  CMR_GRAPHIC_STATISTICS* other   /**< Statistics to be added. */
+)
+{
+  stats->totalCount += other->totalCount;
+  stats->totalTime += other->totalTime;
+  stats->checkCount += other->checkCount;
+  stats->checkTime += other->checkTime;
+  stats->applyCount += other->applyCount;
+  stats->applyTime += other->applyTime;
+  stats->transposeCount += other->transposeCount;
+  stats->transposeTime += other->transposeTime;
+}
+
+CMR_ERROR CMRstatsRegularAdd(CMR_REGULAR_STATISTICS* stats, CMR_REGULAR_STATISTICS* other)
+{
+  assert(stats);
+  assert(other);
+
+  stats->totalCount += other->totalCount;
+  stats->totalTime += other->totalTime;
+  stats->seriesParallel.totalCount += other->seriesParallel.totalCount;
+  stats->seriesParallel.totalTime += other->seriesParallel.totalTime;
+  stats->seriesParallel.reduceCount += other->seriesParallel.reduceCount;
+  stats->seriesParallel.reduceTime += other->seriesParallel.reduceTime;
+  stats->seriesParallel.wheelCount += other->seriesParallel.wheelCount;
+  stats->seriesParallel.wheelTime += other->seriesParallel.wheelTime;
+  stats->seriesParallel.nonbinaryCount += other->seriesParallel.nonbinaryCount;
+  stats->seriesParallel.nonbinaryTime += other->seriesParallel.nonbinaryTime;
+  addStatsGraphic(&stats->graphic, &other->graphic);
+  addStatsGraphic(&stats->network.graphic, &other->network.graphic);
+  stats->network.totalCount += other->network.totalCount;
+  stats->network.totalTime += other->network.totalTime;
+  stats->network.camion.totalCount += other->network.camion.totalCount;
+  stats->network.camion.totalTime += other->network.camion.totalTime;
+  stats->sequenceExtensionCount += other->sequenceExtensionCount;
+  stats->sequenceExtensionTime += other->sequenceExtensionTime;
+  stats->sequenceGraphicCount += other->sequenceGraphicCount;
+  stats->sequenceGraphicTime += other->sequenceGraphicTime;
+  stats->enumerationCount += other->enumerationCount;
+  stats->enumerationTime += other->enumerationTime;
+  stats->enumerationCandidatesCount += other->enumerationCandidatesCount;
+  stats->cacheHitCount += other->cacheHitCount;
+  stats->cacheMissCount += other->cacheMissCount;
+
+  return CMR_OKAY;
+}
+
 /**
  * \brief Tests a 2-connected binary or ternary matrix for regularity.
  */
@@ -89,10 +153,178 @@ CMR_ERROR testRegularTwoConnected(
   bool *pisRegular,               /**< Pointer for storing whether \p matrix is regular. */
   CMR_MINOR** pminor,             /**< Pointer for storing an \f$ F_7 \f$ or \f$ F_7^\star \f$ minor. */
   CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 );
 
+/**
+ * \brief Data of a task that tests one child of a 1-, 2- or 3-sum node for regularity.
+ */
+
+typedef struct
+{
+  CMR_DEC* dec;                   /**< \brief Decomposition node of the child. */
+  size_t index;                   /**< \brief Index of the child. */
+  bool ternary;                   /**< \brief Whether signs matter. */
+  bool tested;                    /**< \brief Whether the child was actually tested. */
+  bool isRegular;                 /**< \brief Whether the child is regular. */
+  CMR_MINOR* minor;               /**< \brief Minor found for the child. */
+  bool searchMinor;               /**< \brief Whether to search for a minor. */
+  CMR_REGULAR_PARAMETERS* params; /**< \brief Parameters for the computation. */
+  CMR_REGULAR_STATISTICS stats;   /**< \brief Statistics of this task; merged into the caller's afterwards. */
+  bool collectStats;              /**< \brief Whether \ref stats shall be collected. */
+  size_t* pfirstIrregular;        /**< \brief Smallest index of a child known to be irregular (shared). */
+  CMR_TASK_GROUP* groups;         /**< \brief Array with the task group of each child (shared). */
+  size_t numChildren;             /**< \brief Length of \ref groups. */
+} ChildTask;
+
+/**
+ * \brief Task function that tests one child of a 1-, 2- or 3-sum node for regularity.
+ *
+ * Unless a complete decomposition tree is requested, an irregular child cancels the tasks of all children behind it,
+ * including the tasks they spawned themselves.
+ */
+
+static
+CMR_ERROR testRegularChildTask(
+  CMR* cmr,   /**< \ref CMR environment of the executing thread. */
+  void* data  /**< Pointer to \ref ChildTask. */
+)
+{
+  ChildTask* task = (ChildTask*) data;
+
+  task->tested = true;
+  CMR_CALL( testRegularTwoConnected(cmr, task->dec, task->ternary, &task->isRegular,
+    task->searchMinor ? &task->minor : NULL, task->params, task->collectStats ? &task->stats : NULL) );
+
+  if (!task->isRegular && !CMRtaskIsCancelled(cmr))
+  {
+    size_t firstIrregular = __atomic_load_n(task->pfirstIrregular, __ATOMIC_ACQUIRE);
+    while (task->index < firstIrregular && !__atomic_compare_exchange_n(task->pfirstIrregular, &firstIrregular,
+      task->index, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    if (!task->params->completeTree)
+    {
+      for (size_t c = task->index + 1; c < task->numChildren; ++c)
+        CMRtaskGroupCancel(&task->groups[c]);
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Tests the children of a 1-, 2- or 3-sum node for regularity.
+ *
+ * Each child is tested as a task, i.e., in parallel if \p cmr has more than one thread. The resulting decomposition
+ * tree, minor and regularity are the same as for a sequential test that processes the children in order and, unless a
+ * complete tree is requested, stops at the first irregular one. Children behind the first irregular one are cancelled
+ * as soon as it is found; those that were (partially) tested anyway are replaced by untested copies.
+ */
+
+static
+CMR_ERROR testRegularChildren(
+  CMR* cmr,                       /**< \ref CMR environment. */
+  CMR_DEC* dec,                   /**< 1-, 2- or 3-sum decomposition node. */
+  bool ternary,                   /**< Whether signs matter. */
+  bool *pisRegular,               /**< Pointer for storing whether the matrix is regular. */
+  CMR_MINOR** pminor,             /**< Pointer for storing an \f$ F_7 \f$ or \f$ F_7^\star \f$ minor (may be \c NULL). */
+  CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
+)
+{
+  assert(cmr);
+  assert(dec);
+  assert(dec->type == CMR_DEC_ONE_SUM || dec->type == CMR_DEC_TWO_SUM || dec->type == CMR_DEC_THREE_SUM);
+
+  size_t numChildren = dec->numChildren;
+  size_t firstIrregular = SIZE_MAX;
+  ChildTask* tasks = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &tasks, numChildren) );
+  CMR_TASK_GROUP* groups = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &groups, numChildren) );
+
+  /* Each child has its own group such that a child can cancel the ones behind it. */
+  for (size_t c = 0; c < numChildren; ++c)
+  {
+    CMR_CALL( CMRtaskGroupInit(cmr, &groups[c]) );
+    ChildTask* task = &tasks[c];
+    task->dec = dec->children[c];
+    task->index = c;
+    task->ternary = ternary;
+    task->tested = false;
+    task->isRegular = true;
+    task->minor = NULL;
+    task->searchMinor = pminor;
+    task->params = params;
+    task->collectStats = stats;
+    if (stats)
+      CMR_CALL( CMRstatsRegularInit(&task->stats) );
+    task->pfirstIrregular = &firstIrregular;
+    task->groups = groups;
+    task->numChildren = numChildren;
+  }
+
+  CMR_ERROR error = CMR_OKAY;
+  size_t numSpawned = 0;
+  for (; numSpawned < numChildren && error == CMR_OKAY; ++numSpawned)
+    error = CMRtaskSpawn(cmr, &groups[numSpawned], testRegularChildTask, &tasks[numSpawned]);
+
+  /* The tasks refer to this stack frame, so we must wait for all of them, even after an error. */
+  for (size_t c = 0; c < numSpawned; ++c)
+  {
+    if (error != CMR_OKAY)
+      CMRtaskGroupCancel(&groups[c]);
+    CMR_ERROR childError = CMRtaskWait(cmr, &groups[c]);
+    if (error == CMR_OKAY)
+      error = childError;
+  }
+
+  for (size_t c = 0; c < numChildren && error == CMR_OKAY; ++c)
+  {
+    ChildTask* task = &tasks[c];
+    if (!task->tested)
+      continue;
+
+    if (params->completeTree || c <= firstIrregular)
+    {
+      /* Only the children a sequential test would have tested contribute to the statistics. */
+      if (stats)
+        CMR_CALL( CMRstatsRegularAdd(stats, &task->stats) );
+
+      *pisRegular = *pisRegular && task->isRegular;
+      if (task->minor && pminor && !*pminor)
+      {
+        /* Only components of 1-sums have their own row and column indexing. */
+        if (dec->type == CMR_DEC_ONE_SUM)
+          CMR_CALL( CMRdecTranslateMinorToParent(task->dec, task->minor) );
+        *pminor = task->minor;
+        task->minor = NULL;
+      }
+    }
+    else
+    {
+      /* A sequential test would not have tested this child, so we replace it by an untested copy. */
+      CMR_DEC* child = dec->children[c];
+      CMR_DEC* untested = NULL;
+      CMR_CALL( CMRdecCreate(cmr, dec, child->numRows, child->rowsParent, child->numColumns, child->columnsParent,
+        &untested) );
+      untested->matrix = child->matrix;
+      untested->transpose = child->transpose;
+      child->matrix = NULL;
+      child->transpose = NULL;
+      CMR_CALL( CMRdecFree(cmr, &dec->children[c]) );
+      dec->children[c] = untested;
+    }
+  }
+
+  for (size_t c = 0; c < numChildren; ++c)
+    CMR_CALL( CMRminorFree(cmr, &tasks[c].minor) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &groups) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &tasks) );
+
+  return error;
+}
+
 static
 CMR_ERROR testRegularThreeConnectedWithSequence(
   CMR* cmr,                       /**< \ref CMR environment. */
@@ -101,8 +333,7 @@ CMR_ERROR testRegularThreeConnectedWithSequence(
   bool *pisRegular,               /**< Pointer for storing whether \p matrix is regular. */
   CMR_MINOR** pminor,             /**< Pointer for storing an \f$ F_7 \f$ or \f$ F_7^\star \f$ minor. */
   CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 )
 {
   assert(cmr);
@@ -115,8 +346,6 @@ CMR_ERROR testRegularThreeConnectedWithSequence(
   assert(dec->nestedMinorsSequenceNumColumns);
   assert(dec->nestedMinorsLength > 0);
 
-  clock_t time = clock();
-
   CMRdbgMsg(6, "Testing binary %dx%d 3-connected matrix with given nested sequence of 3-connected minors for regularity.\n",
     dec->matrix->numRows, dec->matrix->numColumns);
 
@@ -130,14 +359,13 @@ CMR_ERROR testRegularThreeConnectedWithSequence(
   CMR_CALL( CMRchrmatTranspose(cmr, dec->nestedMinorsMatrix, &nestedMinorsTranspose) );
 
   /* Test sequence for graphicness. */
-  double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
   size_t lastGraphicMinor = 0;
   CMR_GRAPH* graph = NULL;
   CMR_ELEMENT* graphEdgeLabels = NULL;
   CMR_CALL( CMRregularSequenceGraphic(cmr, dec->nestedMinorsMatrix, nestedMinorsTranspose,
     dec->nestedMinorsRowsOriginal, dec->nestedMinorsColumnsOriginal, dec->nestedMinorsLength,
     dec->nestedMinorsSequenceNumRows, dec->nestedMinorsSequenceNumColumns, &lastGraphicMinor, &graph,
-    &graphEdgeLabels, stats, remainingTime) );
+    &graphEdgeLabels, stats) );
 
   if (graph)
   {
@@ -180,11 +408,10 @@ CMR_ERROR testRegularThreeConnectedWithSequence(
     /* Test sequence for cographicness. */
     CMR_GRAPH* cograph = NULL;
     CMR_ELEMENT* cographEdgeLabels = NULL;
-    remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
     CMR_CALL( CMRregularSequenceGraphic(cmr, nestedMinorsTranspose, dec->nestedMinorsMatrix,
       dec->nestedMinorsColumnsOriginal, dec->nestedMinorsRowsOriginal, dec->nestedMinorsLength,
       dec->nestedMinorsSequenceNumColumns, dec->nestedMinorsSequenceNumRows, &lastCographicMinor, &cograph,
-      &cographEdgeLabels, stats, remainingTime) );
+      &cographEdgeLabels, stats) );
 
     if (cograph)
     {
@@ -234,10 +461,8 @@ CMR_ERROR testRegularThreeConnectedWithSequence(
         lastGraphicMinor, lastCographicMinor,
         lastGraphicMinor > lastCographicMinor ? (lastGraphicMinor+1) : (lastCographicMinor + 1) );
 
-      remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
       CMR_CALL( CMRregularSearchThreeSeparation(cmr, dec, nestedMinorsTranspose, ternary,
-        lastGraphicMinor > lastCographicMinor ? (lastGraphicMinor+1) : (lastCographicMinor + 1), NULL, params, stats,
-        remainingTime) );
+        lastGraphicMinor > lastCographicMinor ? (lastGraphicMinor+1) : (lastCographicMinor + 1), NULL, params, stats) );
 
       if (dec->type == CMR_DEC_IRREGULAR)
       {
@@ -254,16 +479,7 @@ CMR_ERROR testRegularThreeConnectedWithSequence(
         CMR_CALL( CMRchrmatPrintDense(cmr, dec->children[1]->matrix, stdout, '0', true) );
 #endif /* CMR_DEBUG */
 
-        remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-        CMR_CALL( testRegularTwoConnected(cmr, dec->children[0], ternary, pisRegular, pminor, params, stats,
-          remainingTime) );
-        
-        if (params->completeTree || *pisRegular)
-        {
-          remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-          CMR_CALL( testRegularTwoConnected(cmr, dec->children[1], ternary, pisRegular, pminor, params, stats,
-            remainingTime) );
-        }
+        CMR_CALL( testRegularChildren(cmr, dec, ternary, pisRegular, pminor, params, stats) );
       }
     }
   }
@@ -275,7 +491,7 @@ CMR_ERROR testRegularThreeConnectedWithSequence(
 
 static
 CMR_ERROR testRegularTwoConnected(CMR* cmr, CMR_DEC* dec, bool ternary, bool *pisRegular, CMR_MINOR** pminor,
-  CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats, double timeLimit)
+  CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats)
 {
   assert(cmr);
   assert(dec);
@@ -284,7 +500,10 @@ CMR_ERROR testRegularTwoConnected(CMR* cmr, CMR_DEC* dec, bool ternary, bool *pi
   CMRdbgMsg(2, "Testing binary %dx%d 2-connected matrix for regularity.\n", dec->matrix->numRows,
     dec->matrix->numColumns);
 
-  clock_t time = clock();
+  /* The caller discards the result of a cancelled task anyway. */
+  if (CMRtaskIsCancelled(cmr))
+    return CMR_OKAY;
+
   CMR_SUBMAT* submatrix = NULL;
 
   if (params->directGraphicness || dec->matrix->numRows <= 3 || dec->matrix->numColumns <= 3)
@@ -296,7 +515,7 @@ CMR_ERROR testRegularTwoConnected(CMR* cmr, CMR_DEC* dec, bool ternary, bool *pi
       CMRdbgMsg(4, "Checking for graphicness...");
       bool isGraphic;
       CMR_CALL( CMRregularTestGraphic(cmr, &dec->matrix, &dec->transpose, ternary, &isGraphic, &dec->graph,
-        &dec->graphForest, &dec->graphCoforest, &dec->graphArcsReversed, &submatrix, stats, timeLimit) );
+        &dec->graphForest, &dec->graphCoforest, &dec->graphArcsReversed, &submatrix, stats) );
       if (isGraphic)
       {
         CMRdbgMsg(0, " graphic.\n");
@@ -309,9 +528,8 @@ CMR_ERROR testRegularTwoConnected(CMR* cmr, CMR_DEC* dec, bool ternary, bool *pi
 
     CMRdbgMsg(4, "Checking for cographicness...");
     bool isCographic;
-    double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
     CMR_CALL( CMRregularTestGraphic(cmr, &dec->transpose, &dec->matrix, ternary, &isCographic, &dec->cograph,
-      &dec->cographForest, &dec->cographCoforest, &dec->cographArcsReversed, &submatrix, stats, remainingTime) );
+      &dec->cographForest, &dec->cographCoforest, &dec->cographArcsReversed, &submatrix, stats) );
     if (isCographic)
     {
       CMRdbgMsg(0, " cographic.\n");
@@ -332,16 +550,14 @@ CMR_ERROR testRegularTwoConnected(CMR* cmr, CMR_DEC* dec, bool ternary, bool *pi
     CMR_CALL( CMRdecPrintSequenceNested3ConnectedMinors(cmr, dec, stdout) );
 #endif /* CMR_DEBUG */
 
-    double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-    CMR_CALL( CMRregularExtendNestedMinorSequence(cmr, dec, ternary, &submatrix, params, stats, remainingTime) );
+    CMR_CALL( CMRregularExtendNestedMinorSequence(cmr, dec, ternary, &submatrix, params, stats) );
     
     /* Handling of the resulting sequence or 2-separation is done at the end. */
   }
   else
   {
     CMRdbgMsg(4, "Splitting off series-parallel elements...");
-    double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-    CMR_CALL( CMRregularDecomposeSeriesParallel(cmr, &dec, ternary, &submatrix, params, stats, remainingTime) );
+    CMR_CALL( CMRregularDecomposeSeriesParallel(cmr, &dec, ternary, &submatrix, params, stats) );
 
     if (dec->type == CMR_DEC_IRREGULAR)
     {
@@ -358,16 +574,7 @@ CMR_ERROR testRegularTwoConnected(CMR* cmr, CMR_DEC* dec, bool ternary, bool *pi
     {
       CMRdbgMsg(0, " Encountered a 2-separation.\n");
       assert(dec->numChildren == 2);
-      remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-      CMR_CALL( testRegularTwoConnected(cmr, dec->children[0], ternary, pisRegular, pminor, params, stats,
-        remainingTime) );
-
-      if (params->completeTree || *pisRegular)
-      {
-        remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-        CMR_CALL( testRegularTwoConnected(cmr, dec->children[1], ternary, pisRegular, pminor, params, stats,
-          remainingTime) );
-      }
+      CMR_CALL( testRegularChildren(cmr, dec, ternary, pisRegular, pminor, params, stats) );
 
       return CMR_OKAY;
     }
@@ -378,9 +585,7 @@ CMR_ERROR testRegularTwoConnected(CMR* cmr, CMR_DEC* dec, bool ternary, bool *pi
 
     /* No 2-sum found, so we have a wheel submatrix. */
 
-    remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-    CMR_CALL( CMRregularConstructNestedMinorSequence(cmr, dec, ternary, wheelSubmatrix, &submatrix, params, stats,
-      remainingTime) );
+    CMR_CALL( CMRregularConstructNestedMinorSequence(cmr, dec, ternary, wheelSubmatrix, &submatrix, params, stats) );
     CMR_CALL( CMRsubmatFree(cmr, &wheelSubmatrix) );
   }
 
@@ -395,29 +600,18 @@ CMR_ERROR testRegularTwoConnected(CMR* cmr, CMR_DEC* dec, bool ternary, bool *pi
     CMRdbgMsg(0, " Encountered a 2-separation.\n");
     assert(dec->numChildren == 2);
 
-    double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-    CMR_CALL( testRegularTwoConnected(cmr, dec->children[0], ternary, pisRegular, pminor, params, stats,
-      remainingTime) );
-
-    if (params->completeTree || *pisRegular)
-    {
-      remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-      CMR_CALL( testRegularTwoConnected(cmr, dec->children[1], ternary, pisRegular, pminor, params, stats,
-        remainingTime) );
-    }
+    CMR_CALL( testRegularChildren(cmr, dec, ternary, pisRegular, pminor, params, stats) );
 
     return CMR_OKAY;
   }
 
-  double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-  CMR_CALL( testRegularThreeConnectedWithSequence(cmr, dec, ternary, pisRegular, pminor, params, stats,
-    remainingTime) );
+  CMR_CALL( testRegularThreeConnectedWithSequence(cmr, dec, ternary, pisRegular, pminor, params, stats) );
 
   return CMR_OKAY;
 }
 
 CMR_ERROR CMRtestRegular(CMR* cmr, CMR_CHRMAT* matrix, bool ternary, bool *pisRegular, CMR_DEC** pdec,
-  CMR_MINOR** pminor, CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats, double timeLimit)
+  CMR_MINOR** pminor, CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats)
 {
   assert(cmr);
   assert(matrix);
@@ -446,28 +640,11 @@ CMR_ERROR CMRtestRegular(CMR* cmr, CMR_CHRMAT* matrix, bool ternary, bool *pisRe
 #endif /* CMR_DEBUG */
 
   bool isRegular = true;
-  double remainingTime;
   if (dec->numChildren)
-  {
-    for (size_t c = 0; c < dec->numChildren; ++c)
-    {
-      if (isRegular || params->completeTree)
-      {
-        bool childIsRegular = true;
-        remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-        CMR_CALL( testRegularTwoConnected(cmr, dec->children[c], ternary, &childIsRegular, pminor, params, stats,
-          remainingTime) );
-        if (pminor && *pminor)
-          CMR_CALL( CMRdecTranslateMinorToParent(dec->children[c], *pminor) );
-
-        isRegular = isRegular && childIsRegular;
-      }
-    }
-  }
+    CMR_CALL( testRegularChildren(cmr, dec, ternary, &isRegular, pminor, params, stats) );
   else
   {
-    remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-    CMR_CALL( testRegularTwoConnected(cmr, dec, ternary, &isRegular, pminor, params, stats, remainingTime) );
+    CMR_CALL( testRegularTwoConnected(cmr, dec, ternary, &isRegular, pminor, params, stats) );
   }
 
   if (pisRegular)
@@ -522,8 +699,38 @@ CMR_ERROR CMRtestBinaryRegular(CMR* cmr, CMR_CHRMAT* matrix, bool *pisRegular, C
     return CMR_OKAY;
   }
 
-  CMR_CALL( CMRtestRegular(cmr, matrix, false, pisRegular, pdec, pminor, params, stats, timeLimit) );
+  /* The cache only knows the answer. */
+  CMR_RESULT_KEY key;
+  bool useCache = !pdec && !pminor && CMRresultCacheEnabled(cmr);
+  if (useCache)
+  {
+    bool found;
+    CMR_CALL( CMRresultCacheLookup(cmr, matrix, CMR_RESULT_BINARY_REGULAR, &key, &found, pisRegular) );
+    if (found)
+    {
+      if (stats)
+        stats->cacheHitCount++;
+      return CMR_OKAY;
+    }
+    if (stats)
+      stats->cacheMissCount++;
+  }
 
-  return CMR_OKAY;
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = CMRtestRegular(cmr, matrix, false, pisRegular, pdec, pminor, params, stats);
+
+  /* A cancelled or timed-out test may return early with a meaningless answer. */
+  bool isReliable = error == CMR_OKAY && !CMRtaskIsCancelled(cmr) && !CMRdeadlineExpired(cmr);
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  if (useCache)
+  {
+    if (isReliable)
+      CMR_CALL( CMRresultCacheStore(cmr, &key, *pisRegular) );
+    else
+      CMR_CALL( CMRresultCacheDiscard(cmr, &key) );
+  }
+
+  return error;
 }
 
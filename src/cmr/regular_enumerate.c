@@ -777,8 +777,7 @@ CMR_ERROR transformSeparationNested(
 }
 
 CMR_ERROR CMRregularSearchThreeSeparation(CMR* cmr, CMR_DEC* dec, CMR_CHRMAT* transpose, bool ternary,
-  size_t firstNonCoGraphicMinor, CMR_SUBMAT** psubmatrix, CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats,
-  double timeLimit)
+  size_t firstNonCoGraphicMinor, CMR_SUBMAT** psubmatrix, CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats)
 {
   CMR_UNUSED(psubmatrix);
   CMR_UNUSED(ternary);
@@ -875,8 +874,7 @@ CMR_ERROR CMRregularSearchThreeSeparation(CMR* cmr, CMR_DEC* dec, CMR_CHRMAT* tr
 
     for (size_t minor = firstMinor+1; minor <= firstNonCoGraphicMinor && !separation; ++minor)
     {
-      double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-      if (remainingTime < 0)
+      if (CMRdeadlineExpired(cmr))
       {
         CMR_CALL( CMRfreeStackArray(cmr, &queueMemory) );
         CMR_CALL( CMRfreeStackArray(cmr, &partColumns[1]) );
@@ -9,6 +9,7 @@
 #include "hashtable.h"
 
 #include <stdint.h>
+#include <float.h>
 #include <time.h>
 
 /**
@@ -16,15 +17,15 @@
  */
 
 static
-int dfsArticulationPoint(
-  CMR_GRAPH* graph,             /**< Graph. */
-  bool* edgesEnabled,           /**< Edge array indicating whether an edge is enabled. */
-  CMR_GRAPH_NODE node,          /**< Current node. */
-  bool* nodesVisited,           /**< Node array indicating whether a node was already visited. */
-  int* nodesDiscoveryTime,      /**< Node array indicating at which time a node was visited. */
-  int* ptime,                   /**< Pointer to current time. */
-  CMR_GRAPH_NODE parentNode,    /**< Parent node in DFS arborescence. */
-  size_t* nodesArticulationPoint  /**< Node array indicating whether a node is an articulation point. */
+CMR_GRAPH_INDEX dfsArticulationPoint(
+  CMR_GRAPH* graph,                     /**< Graph. */
+  bool* edgesEnabled,                   /**< Edge array indicating whether an edge is enabled. */
+  CMR_GRAPH_NODE node,                  /**< Current node. */
+  bool* nodesVisited,                   /**< Node array indicating whether a node was already visited. */
+  CMR_GRAPH_INDEX* nodesDiscoveryTime,  /**< Node array indicating at which time a node was visited. */
+  CMR_GRAPH_INDEX* ptime,               /**< Pointer to current time. */
+  CMR_GRAPH_NODE parentNode,            /**< Parent node in DFS arborescence. */
+  size_t* nodesArticulationPoint        /**< Node array indicating whether a node is an articulation point. */
 )
 {
   assert(graph);
@@ -37,7 +38,7 @@ int dfsArticulationPoint(
   nodesVisited[node] = true;
   ++(*ptime);
   nodesDiscoveryTime[node] = *ptime;
-  int earliestReachableTime = *ptime;
+  CMR_GRAPH_INDEX earliestReachableTime = *ptime;
 
   for (CMR_GRAPH_ITER iter = CMRgraphIncFirst(graph, node); CMRgraphIncValid(graph, iter);
     iter = CMRgraphIncNext(graph, iter))
@@ -50,8 +51,8 @@ int dfsArticulationPoint(
     if (!nodesVisited[v])
     {
       ++numChildren;
-      int childEarliestReachableTime = dfsArticulationPoint(graph, edgesEnabled, v, nodesVisited, nodesDiscoveryTime,
-        ptime, node, nodesArticulationPoint);
+      CMR_GRAPH_INDEX childEarliestReachableTime = dfsArticulationPoint(graph, edgesEnabled, v, nodesVisited,
+        nodesDiscoveryTime, ptime, node, nodesArticulationPoint);
       if (childEarliestReachableTime < earliestReachableTime)
         earliestReachableTime = childEarliestReachableTime;
       if (parentNode >= 0 && childEarliestReachableTime >= nodesDiscoveryTime[node])
@@ -87,7 +88,7 @@ CMR_ERROR findArticulationPoints(
 
   bool* nodesVisited = NULL;
   CMR_CALL( CMRallocStackArray(cmr, &nodesVisited, CMRgraphMemNodes(graph)) );
-  int* nodesDiscoveryTime = NULL;
+  CMR_GRAPH_INDEX* nodesDiscoveryTime = NULL;
   CMR_CALL( CMRallocStackArray(cmr, &nodesDiscoveryTime, CMRgraphMemNodes(graph)) );
   bool* edgesEnabled = NULL;
   CMR_CALL( CMRallocStackArray(cmr, &edgesEnabled, CMRgraphMemEdges(graph)) );
@@ -107,7 +108,7 @@ CMR_ERROR findArticulationPoints(
   for (size_t i = 0; i < numNonzeroColumns; ++i)
     edgesEnabled[columnEdges[nonzeroColumns[i]]] = false;  
 
-  int time = 0;
+  CMR_GRAPH_INDEX time = 0;
   dfsArticulationPoint(graph, edgesEnabled, CMRgraphNodesFirst(graph), nodesVisited, nodesDiscoveryTime, &time, -1,
     nodesArticulationPoint);
 
@@ -1245,8 +1246,7 @@ CMR_ERROR createWheel(
 
 CMR_ERROR CMRregularSequenceGraphic(CMR* cmr, CMR_CHRMAT* matrix, CMR_CHRMAT* transpose, CMR_ELEMENT* rowElements,
   CMR_ELEMENT* columnElements, size_t lengthSequence, size_t* sequenceNumRows, size_t* sequenceNumColumns,
-  size_t* plastGraphicMinor, CMR_GRAPH** pgraph, CMR_ELEMENT** pedgeElements, CMR_REGULAR_STATISTICS* stats,
-  double timeLimit)
+  size_t* plastGraphicMinor, CMR_GRAPH** pgraph, CMR_ELEMENT** pedgeElements, CMR_REGULAR_STATISTICS* stats)
 {
   assert(cmr);
   assert(matrix);
@@ -1293,10 +1293,10 @@ CMR_ERROR CMRregularSequenceGraphic(CMR* cmr, CMR_CHRMAT* matrix, CMR_CHRMAT* tr
   CMR_CALL( updateHashValues(matrix, rowHashValues, columnHashValues, hashVector, 0, sequenceNumRows[0],
     sequenceNumColumns[0]) );
 
-  size_t extensionTimeFactor = lengthSequence / 100 + 1;
+  size_t pollCounter = 0;
   for (size_t extension = 1; extension < lengthSequence; ++extension)
   { 
-    if ((extension % extensionTimeFactor == 0) && (clock() - time) * 1.0 / CLOCKS_PER_SEC > timeLimit)
+    if (CMRdeadlinePoll(cmr, &pollCounter))
     {
       CMR_CALL( CMRfreeStackArray(cmr, &columnHashValues) );
       CMR_CALL( CMRfreeStackArray(cmr, &rowHashValues) );
@@ -1429,7 +1429,7 @@ CMR_ERROR CMRregularSequenceGraphic(CMR* cmr, CMR_CHRMAT* matrix, CMR_CHRMAT* tr
 
 CMR_ERROR CMRregularTestGraphic(CMR* cmr, CMR_CHRMAT** pmatrix, CMR_CHRMAT** ptranspose, bool ternary, bool* pisGraphic,
   CMR_GRAPH** pgraph, CMR_GRAPH_EDGE** pforest, CMR_GRAPH_EDGE** pcoforest, bool** parcsReversed,
-  CMR_SUBMAT** psubmatrix, CMR_REGULAR_STATISTICS* stats, double timeLimit)
+  CMR_SUBMAT** psubmatrix, CMR_REGULAR_STATISTICS* stats)
 {
   assert(cmr);
   assert(pmatrix);
@@ -1454,12 +1454,12 @@ CMR_ERROR CMRregularTestGraphic(CMR* cmr, CMR_CHRMAT** pmatrix, CMR_CHRMAT** ptr
   if (ternary)
   {
     CMR_CALL( CMRtestConetworkMatrix(cmr, transpose, pisGraphic, pgraph, pforest, pcoforest, parcsReversed,
-      NULL, stats ? &stats->network : NULL, timeLimit) );
+      NULL, stats ? &stats->network : NULL, DBL_MAX) );
   }
   else
   {
     CMR_CALL( CMRtestCographicMatrix(cmr, transpose, pisGraphic, pgraph, pforest, pcoforest, NULL,
-      stats ? &stats->graphic : NULL, timeLimit) );
+      stats ? &stats->graphic : NULL, DBL_MAX) );
   }
 
   return CMR_OKAY;
@@ -3,6 +3,17 @@
 
 #include <cmr/regular.h>
 
+/**
+ * \brief Adds the statistics \p other to \p stats.
+ *
+ * Used to merge statistics of computations that ran in parallel.
+ */
+
+CMR_ERROR CMRstatsRegularAdd(
+  CMR_REGULAR_STATISTICS* stats,  /**< Statistics to add to. */
+  CMR_REGULAR_STATISTICS* other   /**< Statistics to be added. */
+);
+
 /**
  * \brief Enumerates 3-separations for a 3-connected matrix.
  */
@@ -15,8 +26,7 @@ CMR_ERROR CMRregularSearchThreeSeparation(
   size_t firstNonCoGraphicMinor,  /**< Index of first nested minor that is neither graphic nor cographic. */
   CMR_SUBMAT** psubmatrix,        /**< Pointer for storing a violator matrix. */
   CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 );
 
 /**
@@ -45,8 +55,7 @@ CMR_ERROR CMRregularSequenceGraphic(
   size_t* plastGraphicMinor,      /**< Pointer for storing the last graphic minor. */
   CMR_GRAPH** pgraph,             /**< Pointer for storing the graph. */
   CMR_ELEMENT** pedgeElements,    /**< Pointer for storing the mapping of edges to elements. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 );
 
 /**
@@ -62,8 +71,7 @@ CMR_ERROR CMRregularExtendNestedMinorSequence(
   bool ternary,                   /**< Whether to consider the signs of the matrix. */
   CMR_SUBMAT** psubmatrix,        /**< Pointer for storing a violator matrix. */
   CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 );
 
 /**
@@ -80,8 +88,7 @@ CMR_ERROR CMRregularConstructNestedMinorSequence(
   CMR_SUBMAT* wheelSubmatrix,     /**< Wheel submatrix to start with. */
   CMR_SUBMAT** psubmatrix,        /**< Pointer for storing a violator matrix. */
   CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 );
 
 /**
@@ -99,8 +106,7 @@ CMR_ERROR CMRregularTestGraphic(
   CMR_GRAPH_EDGE** pcoforest,     /**< Pointer for storing the mapping of rows to forest edges. */
   bool** parcsReversed,           /**< Pointer for storing the array indicating which arcs are reversed. */ 
   CMR_SUBMAT** psubmatrix,        /**< Pointer for storing a minimal non-graphic submatrix (may be \c NULL). */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 );
 
 /**
@@ -119,8 +125,7 @@ CMR_ERROR CMRregularDecomposeSeriesParallel(
   bool ternary,                   /**< Whether to consider the signs of the matrix. */
   CMR_SUBMAT** psubmatrix,        /**< Pointer for storing a violator matrix. */
   CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 );
 
 /**
@@ -153,8 +158,7 @@ CMR_ERROR CMRtestRegular(
   CMR_DEC** pdec,                 /**< Pointer for storing the decomposition tree (may be \c NULL). */
   CMR_MINOR** pminor,             /**< Pointer for storing an \f$ F_7 \f$ or \f$ F_7^\star \f$ minor. */
   CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 );
 
 #endif /* CMR_REGULAR_INTERNAL_H */
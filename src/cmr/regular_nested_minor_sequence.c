@@ -614,8 +614,7 @@ CMR_ERROR extendNestedMinorSequence(
   size_t* nestedMinorsColumns,    /**< Mapping of columns of the nested minor sequence to columns of \p dense. */
   CMR_SUBMAT** psubmatrix,        /**< Pointer for storing a violator matrix. */
   CMR_REGULAR_PARAMETERS* params, /**< Parameters for the computation. */
-  CMR_REGULAR_STATISTICS* stats,  /**< Statistics for the computation (may be \c NULL). */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_REGULAR_STATISTICS* stats   /**< Statistics for the computation (may be \c NULL). */
 )
 {
   CMR_UNUSED(ternary);
@@ -700,11 +699,10 @@ CMR_ERROR extendNestedMinorSequence(
   CMR_CALL( initializeHashing(cmr, dense, columnData, columnHashtable, numColumns, processedRows, numProcessedRows, 
     hashVector, false) );
 
-  size_t elementTimeFactor = (numRows + numColumns) / 100 + 1;
+  size_t pollCounter = 0;
   while (numProcessedRows < numRows || numProcessedColumns < numColumns)
   {
-    if (((numProcessedRows + numProcessedColumns) % elementTimeFactor == 0)
-      && (clock() - time) * 1.0 / CLOCKS_PER_SEC > timeLimit)
+    if (CMRdeadlinePoll(cmr, &pollCounter))
     {
       return CMR_ERROR_TIMEOUT;
     }
@@ -1135,14 +1133,13 @@ CMR_ERROR extendNestedMinorSequence(
 }
 
 CMR_ERROR CMRregularConstructNestedMinorSequence(CMR* cmr, CMR_DEC* dec, bool ternary, CMR_SUBMAT* wheelSubmatrix,
-  CMR_SUBMAT** psubmatrix, CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats, double timeLimit)
+  CMR_SUBMAT** psubmatrix, CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats)
 {
   assert(cmr);
   assert(dec);
   assert(wheelSubmatrix);
   assert(params);
 
-  clock_t time = clock();
   size_t numRows = dec->matrix->numRows;
   size_t numColumns = dec->matrix->numColumns;
 
@@ -1177,9 +1174,8 @@ CMR_ERROR CMRregularConstructNestedMinorSequence(CMR* cmr, CMR_DEC* dec, bool te
       CMRdensebinmatrixSet1(dense, row, dec->matrix->entryColumns[e]);
   }
 
-  double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
   CMR_CALL( extendNestedMinorSequence(cmr, dec, ternary, dense, nestedMinorsRows, nestedMinorsColumns, psubmatrix,
-    params, stats, remainingTime) );
+    params, stats) );
 
   CMR_CALL( CMRdensebinmatrixFreeStack(cmr, &dense) );
 
@@ -1196,7 +1192,7 @@ CMR_ERROR CMRregularConstructNestedMinorSequence(CMR* cmr, CMR_DEC* dec, bool te
 }
 
 CMR_ERROR CMRregularExtendNestedMinorSequence(CMR* cmr, CMR_DEC* dec, bool ternary, CMR_SUBMAT** psubmatrix,
-  CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats, double timeLimit)
+  CMR_REGULAR_PARAMETERS* params, CMR_REGULAR_STATISTICS* stats)
 {
   assert(cmr);
   assert(dec);
@@ -1233,7 +1229,7 @@ CMR_ERROR CMRregularExtendNestedMinorSequence(CMR* cmr, CMR_DEC* dec, bool terna
     }
 
     CMR_CALL( extendNestedMinorSequence(cmr, dec, ternary, dense, nestedMinorsRows, nestedMinorsColumns, psubmatrix,
-      params, stats, timeLimit) );
+      params, stats) );
 
     CMR_CALL( CMRdensebinmatrixFreeStack(cmr, &dense) );
 
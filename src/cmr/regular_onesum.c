@@ -9,10 +9,20 @@
 #include "sort.h"
 #include "one_sum.h"
 
+/**
+ * \brief Compares two pointers to 1-sum components by their number of nonzeros.
+ *
+ * Ties are broken by the order of the components, which makes the resulting order deterministic.
+ */
+
+static
 int compareOneSumComponents(const void* a, const void* b)
 {
-  return ((CMR_ONESUM_COMPONENT*)a)->matrix->numNonzeros -
-    ((CMR_ONESUM_COMPONENT*)b)->matrix->numNonzeros;
+  const CMR_ONESUM_COMPONENT* first = *((const CMR_ONESUM_COMPONENT**) a);
+  const CMR_ONESUM_COMPONENT* second = *((const CMR_ONESUM_COMPONENT**) b);
+  if (first->matrix->numNonzeros != second->matrix->numNonzeros)
+    return first->matrix->numNonzeros < second->matrix->numNonzeros ? -1 : 1;
+  return (first > second) - (first < second);
 }
 
 CMR_ERROR CMRregularDecomposeOneSum(CMR* cmr, CMR_DEC* dec)
@@ -25,8 +35,8 @@ CMR_ERROR CMRregularDecomposeOneSum(CMR* cmr, CMR_DEC* dec)
 
   size_t numComponents;
   CMR_ONESUM_COMPONENT* components = NULL;
-  CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) dec->matrix, sizeof(char), sizeof(char), &numComponents, &components, NULL, NULL,
-    NULL, NULL) );
+  CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) dec->matrix, sizeof(char), sizeof(char), false, &numComponents,
+    &components, NULL, NULL, NULL, NULL) );
 
   if (numComponents == 1)
   {
@@ -0,0 +1,493 @@
+// #define CMR_DEBUG /* Uncomment to debug this file. */
+
+#include "result_cache.h"
+
+#include "hashtable.h"
+#include "sort.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Number of refinement rounds for the fingerprints of the rows and columns.
+ *
+ * In each round, every column is hashed with the multiset of the (row fingerprint, value) pairs of its nonzeros, and
+ * then every row with those of the new column fingerprints.
+ */
+
+#define NUM_REFINEMENT_ROUNDS 2
+
+typedef struct _CMR_RESULT_ENTRY
+{
+  CMR_RESULT_PROPERTY property;           /**< \brief Property that was tested. */
+  uint64_t fingerprint;                   /**< \brief Fingerprint of the matrix. */
+  CMR_CHRMAT* canonical;                  /**< \brief Canonical copy of the matrix. */
+  bool result;                            /**< \brief Whether the matrix has the property. */
+  struct _CMR_RESULT_ENTRY* bucketNext;   /**< \brief Next entry in the same bucket. */
+  struct _CMR_RESULT_ENTRY* newer;        /**< \brief Next more recently used entry. */
+  struct _CMR_RESULT_ENTRY* older;        /**< \brief Next less recently used entry. */
+} CMR_RESULT_ENTRY;
+
+struct _CMR_RESULT_CACHE
+{
+  size_t capacity;              /**< \brief Maximum number of entries. */
+  size_t numEntries;            /**< \brief Current number of entries. */
+  size_t numBuckets;            /**< \brief Number of buckets; a power of 2. */
+  CMR_RESULT_ENTRY** buckets;   /**< \brief Array with the first entry of each bucket. */
+  CMR_RESULT_ENTRY* newest;     /**< \brief Most recently used entry. */
+  CMR_RESULT_ENTRY* oldest;     /**< \brief Least recently used entry. */
+  bool lock;                    /**< \brief Spin lock protecting all entries. */
+};
+
+/**
+ * \brief Returns the cache of \p cmr, which belongs to the environment it was (indirectly) forked from.
+ */
+
+static
+CMR_RESULT_CACHE* getCache(
+  CMR* cmr  /**< \ref CMR environment. */
+)
+{
+  while (cmr->parent)
+    cmr = cmr->parent;
+  return cmr->resultCache;
+}
+
+/**
+ * \brief Scrambles the bits of \p x (finalizer of SplitMix64).
+ */
+
+static inline
+uint64_t mix(
+  uint64_t x  /**< Value to scramble. */
+)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/**
+ * \brief Returns the hash of a nonzero \p value.
+ */
+
+static inline
+uint64_t valueHash(
+  char value  /**< Value. */
+)
+{
+  return mix((uint64_t) (int64_t) value);
+}
+
+/**
+ * \brief Computes fingerprints of the rows and columns that do not depend on their order.
+ *
+ * Multisets are hashed by adding the scrambled hashes of their elements. This takes
+ * \f$ O(m + n + k) \f$ time for an \f$ m \times n \f$ matrix with \f$ k \f$ nonzeros.
+ */
+
+static
+void computeFingerprints(
+  CMR_CHRMAT* matrix,     /**< Matrix. */
+  uint64_t* rowHashes,    /**< Array for storing the fingerprints of the rows. */
+  uint64_t* columnHashes  /**< Array for storing the fingerprints of the columns. */
+)
+{
+  assert(matrix);
+
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    uint64_t hash = 0;
+    for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+      hash += valueHash(matrix->entryValues[e]);
+    rowHashes[row] = mix(hash);
+  }
+
+  for (size_t round = 0; round < NUM_REFINEMENT_ROUNDS; ++round)
+  {
+    for (size_t column = 0; column < matrix->numColumns; ++column)
+      columnHashes[column] = 0;
+    for (size_t row = 0; row < matrix->numRows; ++row)
+    {
+      for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+        columnHashes[matrix->entryColumns[e]] += mix(rowHashes[row] ^ valueHash(matrix->entryValues[e]));
+    }
+    for (size_t column = 0; column < matrix->numColumns; ++column)
+      columnHashes[column] = mix(columnHashes[column] + round);
+
+    for (size_t row = 0; row < matrix->numRows; ++row)
+    {
+      uint64_t hash = 0;
+      for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+        hash += mix(columnHashes[matrix->entryColumns[e]] ^ valueHash(matrix->entryValues[e]));
+      rowHashes[row] = mix(hash + rowHashes[row]);
+    }
+  }
+}
+
+/**
+ * \brief Fingerprint of a row or column together with its index.
+ */
+
+typedef struct
+{
+  uint64_t hash;  /**< \brief Fingerprint. */
+  size_t index;   /**< \brief Row or column. */
+} HashIndex;
+
+static
+int compareHashIndex(const void* pa, const void* pb)
+{
+  const HashIndex* a = (const HashIndex*) pa;
+  const HashIndex* b = (const HashIndex*) pb;
+  if (a->hash != b->hash)
+    return a->hash < b->hash ? -1 : +1;
+  if (a->index != b->index)
+    return a->index < b->index ? -1 : +1;
+  return 0;
+}
+
+/**
+ * \brief Computes the fingerprint of \p matrix and its canonical copy, whose rows and columns are sorted by their
+ *        fingerprints.
+ */
+
+static
+CMR_ERROR computeKey(
+  CMR* cmr,           /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix, /**< Matrix. */
+  CMR_RESULT_KEY* key /**< Key whose fingerprint and canonical copy shall be computed. */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(key);
+
+  size_t numRows = matrix->numRows;
+  size_t numColumns = matrix->numColumns;
+  size_t numNonzeros = matrix->numNonzeros;
+
+  uint64_t* rowHashes = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowHashes, numRows + 1) );
+  uint64_t* columnHashes = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnHashes, numColumns + 1) );
+  computeFingerprints(matrix, rowHashes, columnHashes);
+
+  uint64_t fingerprint = mix(key->property);
+  fingerprint = mix(fingerprint + numRows);
+  fingerprint = mix(fingerprint + numColumns);
+  fingerprint = mix(fingerprint + numNonzeros);
+  uint64_t sum = 0;
+  for (size_t row = 0; row < numRows; ++row)
+    sum += mix(rowHashes[row]);
+  fingerprint = mix(fingerprint + sum);
+  sum = 0;
+  for (size_t column = 0; column < numColumns; ++column)
+    sum += mix(columnHashes[column]);
+  key->fingerprint = mix(fingerprint + sum);
+
+  /* Sort the rows and columns by their fingerprints; ties are broken by index. */
+  HashIndex* rowOrder = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowOrder, numRows + 1) );
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    rowOrder[row].hash = rowHashes[row];
+    rowOrder[row].index = row;
+  }
+  CMR_CALL( CMRsort(cmr, numRows, rowOrder, sizeof(HashIndex), compareHashIndex) );
+  HashIndex* columnOrder = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnOrder, numColumns + 1) );
+  for (size_t column = 0; column < numColumns; ++column)
+  {
+    columnOrder[column].hash = columnHashes[column];
+    columnOrder[column].index = column;
+  }
+  CMR_CALL( CMRsort(cmr, numColumns, columnOrder, sizeof(HashIndex), compareHashIndex) );
+
+  /* We reuse the column fingerprints for the canonical position of each column. */
+  for (size_t c = 0; c < numColumns; ++c)
+    columnHashes[columnOrder[c].index] = c;
+
+  size_t* tripleRows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &tripleRows, numNonzeros + 1) );
+  size_t* tripleColumns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &tripleColumns, numNonzeros + 1) );
+  char* tripleValues = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &tripleValues, numNonzeros + 1) );
+  size_t numTriples = 0;
+  for (size_t r = 0; r < numRows; ++r)
+  {
+    size_t row = rowOrder[r].index;
+    for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+    {
+      tripleRows[numTriples] = r;
+      tripleColumns[numTriples] = columnHashes[matrix->entryColumns[e]];
+      tripleValues[numTriples] = matrix->entryValues[e];
+      ++numTriples;
+    }
+  }
+
+  key->canonical = NULL;
+  CMR_CALL( CMRchrmatCreateFromTriples(cmr, numRows, numColumns, numTriples, tripleRows, tripleColumns, tripleValues,
+    &key->canonical) );
+
+  CMR_CALL( CMRfreeStackArray(cmr, &tripleValues) );
+  CMR_CALL( CMRfreeStackArray(cmr, &tripleColumns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &tripleRows) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnOrder) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowOrder) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnHashes) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowHashes) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Returns \c true if the canonical copies \p a and \p b are equal.
+ */
+
+static
+bool equalCanonical(
+  CMR_CHRMAT* a,  /**< First matrix. */
+  CMR_CHRMAT* b   /**< Second matrix. */
+)
+{
+  if (a->numRows != b->numRows || a->numColumns != b->numColumns || a->numNonzeros != b->numNonzeros)
+    return false;
+
+  return memcmp(a->rowSlice, b->rowSlice, (a->numRows + 1) * sizeof(size_t)) == 0
+    && memcmp(a->entryColumns, b->entryColumns, a->numNonzeros * sizeof(size_t)) == 0
+    && memcmp(a->entryValues, b->entryValues, a->numNonzeros * sizeof(char)) == 0;
+}
+
+/**
+ * \brief Removes \p entry from the recency list of \p cache.
+ */
+
+static
+void unlinkRecency(
+  CMR_RESULT_CACHE* cache,  /**< Cache. */
+  CMR_RESULT_ENTRY* entry   /**< Entry. */
+)
+{
+  if (entry->newer)
+    entry->newer->older = entry->older;
+  else
+    cache->newest = entry->older;
+  if (entry->older)
+    entry->older->newer = entry->newer;
+  else
+    cache->oldest = entry->newer;
+}
+
+/**
+ * \brief Inserts \p entry at the front of the recency list of \p cache.
+ */
+
+static
+void linkRecency(
+  CMR_RESULT_CACHE* cache,  /**< Cache. */
+  CMR_RESULT_ENTRY* entry   /**< Entry. */
+)
+{
+  entry->newer = NULL;
+  entry->older = cache->newest;
+  if (cache->newest)
+    cache->newest->newer = entry;
+  else
+    cache->oldest = entry;
+  cache->newest = entry;
+}
+
+/**
+ * \brief Frees \p entry and its canonical matrix.
+ */
+
+static
+CMR_ERROR freeEntry(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_RESULT_ENTRY** pentry /**< Pointer to entry. */
+)
+{
+  CMR_CALL( CMRchrmatFree(cmr, &(*pentry)->canonical) );
+  CMR_CALL( CMRfreeBlock(cmr, pentry) );
+
+  return CMR_OKAY;
+}
+
+bool CMRresultCacheEnabled(CMR* cmr)
+{
+  assert(cmr);
+
+  return getCache(cmr) != NULL;
+}
+
+CMR_ERROR CMRresultCacheLookup(CMR* cmr, CMR_CHRMAT* matrix, CMR_RESULT_PROPERTY property, CMR_RESULT_KEY* key,
+  bool* pfound, bool* presult)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(key);
+  assert(pfound);
+  assert(presult);
+
+  key->property = property;
+  key->fingerprint = 0;
+  key->canonical = NULL;
+  *pfound = false;
+
+  CMR_RESULT_CACHE* cache = getCache(cmr);
+  if (!cache)
+    return CMR_OKAY;
+
+  CMR_CALL( computeKey(cmr, matrix, key) );
+
+  while (__atomic_test_and_set(&cache->lock, __ATOMIC_ACQUIRE));
+  for (CMR_RESULT_ENTRY* entry = cache->buckets[key->fingerprint & (cache->numBuckets - 1)]; entry;
+    entry = entry->bucketNext)
+  {
+    if (entry->fingerprint == key->fingerprint && entry->property == property
+      && equalCanonical(entry->canonical, key->canonical))
+    {
+      *pfound = true;
+      *presult = entry->result;
+      unlinkRecency(cache, entry);
+      linkRecency(cache, entry);
+      break;
+    }
+  }
+  __atomic_clear(&cache->lock, __ATOMIC_RELEASE);
+
+  CMRdbgMsg(0, "Result cache lookup for fingerprint %lx: %s.\n", key->fingerprint, *pfound ? "hit" : "miss");
+
+  if (*pfound)
+    CMR_CALL( CMRchrmatFree(cmr, &key->canonical) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRresultCacheStore(CMR* cmr, CMR_RESULT_KEY* key, bool result)
+{
+  assert(cmr);
+  assert(key);
+
+  CMR_RESULT_CACHE* cache = getCache(cmr);
+  if (!cache || !key->canonical)
+    return CMRresultCacheDiscard(cmr, key);
+
+  CMR_RESULT_ENTRY* entry = NULL;
+  CMR_CALL( CMRallocBlock(cmr, &entry) );
+  entry->property = key->property;
+  entry->fingerprint = key->fingerprint;
+  entry->canonical = key->canonical;
+  entry->result = result;
+  key->canonical = NULL;
+
+  CMR_RESULT_ENTRY* evicted = NULL;
+  CMR_RESULT_ENTRY** pbucket = &cache->buckets[entry->fingerprint & (cache->numBuckets - 1)];
+
+  while (__atomic_test_and_set(&cache->lock, __ATOMIC_ACQUIRE));
+
+  /* Another thread may have stored the same result in the meantime. */
+  bool duplicate = false;
+  for (CMR_RESULT_ENTRY* other = *pbucket; other; other = other->bucketNext)
+  {
+    if (other->fingerprint == entry->fingerprint && other->property == entry->property
+      && equalCanonical(other->canonical, entry->canonical))
+    {
+      duplicate = true;
+      break;
+    }
+  }
+
+  if (!duplicate)
+  {
+    if (cache->numEntries == cache->capacity)
+    {
+      evicted = cache->oldest;
+      unlinkRecency(cache, evicted);
+      CMR_RESULT_ENTRY** pprevious = &cache->buckets[evicted->fingerprint & (cache->numBuckets - 1)];
+      while (*pprevious != evicted)
+        pprevious = &(*pprevious)->bucketNext;
+      *pprevious = evicted->bucketNext;
+      --cache->numEntries;
+    }
+
+    entry->bucketNext = *pbucket;
+    *pbucket = entry;
+    linkRecency(cache, entry);
+    ++cache->numEntries;
+  }
+
+  __atomic_clear(&cache->lock, __ATOMIC_RELEASE);
+
+  if (duplicate)
+    CMR_CALL( freeEntry(cmr, &entry) );
+  if (evicted)
+    CMR_CALL( freeEntry(cmr, &evicted) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRresultCacheDiscard(CMR* cmr, CMR_RESULT_KEY* key)
+{
+  assert(cmr);
+  assert(key);
+
+  if (key->canonical)
+    CMR_CALL( CMRchrmatFree(cmr, &key->canonical) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRresultCacheFree(CMR* cmr, CMR_RESULT_CACHE** pcache)
+{
+  assert(cmr);
+  assert(pcache);
+
+  CMR_RESULT_CACHE* cache = *pcache;
+  if (!cache)
+    return CMR_OKAY;
+
+  while (cache->newest)
+  {
+    CMR_RESULT_ENTRY* entry = cache->newest;
+    cache->newest = entry->older;
+    CMR_CALL( freeEntry(cmr, &entry) );
+  }
+  CMR_CALL( CMRfreeBlockArray(cmr, &cache->buckets) );
+  CMR_CALL( CMRfreeBlock(cmr, pcache) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRsetResultCacheCapacity(CMR* cmr, size_t capacity)
+{
+  assert(cmr);
+
+  /* Only the environment that owns the cache may change it. */
+  if (cmr->parent)
+    return CMR_ERROR_INVALID;
+
+  CMR_CALL( CMRresultCacheFree(cmr, &cmr->resultCache) );
+  if (capacity == 0)
+    return CMR_OKAY;
+
+  CMR_RESULT_CACHE* cache = NULL;
+  CMR_CALL( CMRallocBlock(cmr, &cache) );
+  cache->capacity = capacity;
+  cache->numEntries = 0;
+  cache->numBuckets = capacity < 16 ? 16 : nextPower2(capacity);
+  cache->buckets = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &cache->buckets, cache->numBuckets) );
+  for (size_t b = 0; b < cache->numBuckets; ++b)
+    cache->buckets[b] = NULL;
+  cache->newest = NULL;
+  cache->oldest = NULL;
+  cache->lock = false;
+  cmr->resultCache = cache;
+
+  return CMR_OKAY;
+}
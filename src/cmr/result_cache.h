@@ -0,0 +1,110 @@
+#ifndef CMR_RESULT_CACHE_INTERNAL_H
+#define CMR_RESULT_CACHE_INTERNAL_H
+
+#include "env_internal.h"
+
+#include <cmr/matrix.h>
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Property of a matrix whose test results are remembered by a \ref CMR_RESULT_CACHE.
+ */
+
+typedef enum
+{
+  CMR_RESULT_TOTALLY_UNIMODULAR = 0,  /**< Total unimodularity of a ternary matrix. */
+  CMR_RESULT_BINARY_REGULAR = 1       /**< Regularity of a binary matrix. */
+} CMR_RESULT_PROPERTY;
+
+/**
+ * \brief Cache of test results, keyed by a fingerprint of the matrix that does not depend on the order of its rows
+ *        and columns.
+ *
+ * Each entry stores a canonical copy of its matrix, whose rows and columns are sorted by their fingerprints. A
+ * query matches an entry only if its own canonical copy is equal to the stored one, which makes false positives
+ * impossible. Permuted matrices whose rows (resp. columns) with equal fingerprints are arranged differently in the
+ * canonical copies are not recognized.
+ *
+ * The cache belongs to an environment that was not forked and is shared by all environments forked from it. The
+ * entries are protected by a spin lock and evicted in least-recently-used order.
+ */
+
+typedef struct _CMR_RESULT_CACHE CMR_RESULT_CACHE;
+
+/**
+ * \brief Key of a query to a \ref CMR_RESULT_CACHE.
+ *
+ * It is computed by \ref CMRresultCacheLookup and must be passed to \ref CMRresultCacheStore or
+ * \ref CMRresultCacheDiscard afterwards.
+ */
+
+typedef struct
+{
+  CMR_RESULT_PROPERTY property; /**< \brief Queried property. */
+  uint64_t fingerprint;         /**< \brief Fingerprint of the matrix. */
+  CMR_CHRMAT* canonical;        /**< \brief Canonical copy of the matrix, or \c NULL if caching is disabled. */
+} CMR_RESULT_KEY;
+
+/**
+ * \brief Returns \c true if results of \p cmr are cached.
+ */
+
+bool CMRresultCacheEnabled(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
+/**
+ * \brief Looks up whether \p matrix has the queried \p property.
+ *
+ * Takes \f$ O(k + m \log m + n \log n) \f$ time for an \f$ m \times n \f$ matrix with \f$ k \f$ nonzeros. If the
+ * result is not cached, then \p key must be passed to \ref CMRresultCacheStore or \ref CMRresultCacheDiscard.
+ */
+
+CMR_ERROR CMRresultCacheLookup(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,           /**< Queried matrix. */
+  CMR_RESULT_PROPERTY property, /**< Queried property. */
+  CMR_RESULT_KEY* key,          /**< Pointer for storing the key of the query. */
+  bool* pfound,                 /**< Pointer for storing whether the result is cached. */
+  bool* presult                 /**< Pointer for storing the cached result. */
+);
+
+/**
+ * \brief Stores the \p result of the query with the given \p key, evicting the least recently used entry if the
+ *        cache is full.
+ */
+
+CMR_ERROR CMRresultCacheStore(
+  CMR* cmr,             /**< \ref CMR environment. */
+  CMR_RESULT_KEY* key,  /**< Key of the query; its canonical matrix is taken over. */
+  bool result           /**< Whether the matrix has the queried property. */
+);
+
+/**
+ * \brief Frees the \p key of a query whose result shall not be stored, e.g., because the computation failed.
+ */
+
+CMR_ERROR CMRresultCacheDiscard(
+  CMR* cmr,           /**< \ref CMR environment. */
+  CMR_RESULT_KEY* key /**< Key of the query. */
+);
+
+/**
+ * \brief Frees a \ref CMR_RESULT_CACHE.
+ */
+
+CMR_ERROR CMRresultCacheFree(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_RESULT_CACHE** pcache   /**< Pointer to the cache. */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMR_RESULT_CACHE_INTERNAL_H */
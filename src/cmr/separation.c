@@ -506,7 +506,7 @@ CMR_ERROR CMRtwoSum(CMR* cmr, CMR_CHRMAT* first, CMR_CHRMAT* second, CMR_ELEMENT
     markerRowNumNonzeros = first->rowSlice[firstRowMarker+1] - first->rowSlice[firstRowMarker];
 
     secondColumnMarker = CMRelementToColumnIndex(secondMarker);
-    CMR_CALL( CMRallocStackArray(cmr, &markerColumn, second->numColumns) );
+    CMR_CALL( CMRallocStackArray(cmr, &markerColumn, second->numRows) );
     for (size_t row = 0; row < second->numRows; ++row)
     {
       size_t entry;
@@ -528,7 +528,7 @@ CMR_ERROR CMRtwoSum(CMR* cmr, CMR_CHRMAT* first, CMR_CHRMAT* second, CMR_ELEMENT
   else
   {
     firstColumnMarker = CMRelementToColumnIndex(firstMarker); 
-    CMR_CALL( CMRallocStackArray(cmr, &markerColumn, first->numColumns) );
+    CMR_CALL( CMRallocStackArray(cmr, &markerColumn, first->numRows) );
     for (size_t row = 0; row < first->numRows; ++row)
     {
       size_t entry;
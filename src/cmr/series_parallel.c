@@ -68,7 +68,7 @@ CMR_ERROR CMRstatsSeriesParallelPrint(FILE* stream, CMR_SP_STATISTICS* stats, co
   return CMR_OKAY;
 }
 
-static char seriesParallelStringBuffer[32]; /**< Static buffer for \ref CMRspString. */
+static _Thread_local char seriesParallelStringBuffer[32]; /**< Static buffer for \ref CMRspString. */
 
 char* CMRspReductionString(CMR_SP_REDUCTION reduction, char* buffer)
 {
@@ -1494,8 +1494,7 @@ CMR_ERROR decomposeBinarySeriesParallel(
   CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
   CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a wheel-submatrix (may be \c NULL). */
   CMR_SEPA** pseparation,           /**< Pointer for storing a 2-separation (may be \c NULL). */
-  CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
-  double timeLimit                  /**< Time limit to impose. */
+  CMR_SP_STATISTICS* stats          /**< Pointer to statistics (may be \c NULL). */
 )
 {
   assert(cmr);
@@ -1568,8 +1567,7 @@ CMR_ERROR decomposeBinarySeriesParallel(
       &numColumnReductions) );
 
     clock_t now = clock();
-    double remainingTime = timeLimit - (now - time) * 1.0 / CLOCKS_PER_SEC;
-    if (remainingTime < 0)
+    if (CMRdeadlineExpired(cmr))
     {
       CMR_CALL( CMRlisthashtableFree(cmr, &columnHashtable) );
       CMR_CALL( CMRlisthashtableFree(cmr, &rowHashtable) );
@@ -1653,11 +1651,14 @@ CMR_ERROR CMRtestBinarySeriesParallel(CMR* cmr, CMR_CHRMAT* matrix, bool* pisSer
   if (!reductions)
     CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
 
-  CMR_CALL( decomposeBinarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions, SIZE_MAX,
-    &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, NULL, stats, timeLimit) );
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = decomposeBinarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions, SIZE_MAX,
+    &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, NULL, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+  CMR_CALL( error );
 
   if (pisSeriesParallel)
-    *pisSeriesParallel = (*pnumReductions == matrix->numRows + matrix->numColumns);
+    *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
   if (reductions)
     *pnumReductions = localNumReductions;
   else
@@ -1681,8 +1682,11 @@ CMR_ERROR CMRdecomposeBinarySeriesParallel(CMR* cmr, CMR_CHRMAT* matrix, bool* p
   if (!reductions)
     CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
 
-  CMR_CALL( decomposeBinarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions, maxNumReductions,
-    &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, pseparation, stats, timeLimit) );
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = decomposeBinarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions,
+    maxNumReductions, &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, pseparation, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+  CMR_CALL( error );
 
   if (pisSeriesParallel)
     *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
@@ -1705,8 +1709,7 @@ CMR_ERROR decomposeTernarySeriesParallel(
   CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
   CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a wheel-submatrix (may be \c NULL). */
   CMR_SEPA** pseparation,           /**< Pointer for storing a 2-separation (may be \c NULL). */
-  CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
-  double timeLimit                  /**< Time limit to impose. */
+  CMR_SP_STATISTICS* stats          /**< Pointer to statistics (may be \c NULL). */
 )
 {
   assert(cmr);
@@ -1777,8 +1780,7 @@ CMR_ERROR decomposeTernarySeriesParallel(
       &numColumnReductions) );
 
     clock_t now = clock();
-    double remainingTime = timeLimit - (now - time) * 1.0 / CLOCKS_PER_SEC;
-    if (remainingTime < 0)
+    if (CMRdeadlineExpired(cmr))
     {
       CMR_CALL( CMRlisthashtableFree(cmr, &columnHashtable) );
       CMR_CALL( CMRlisthashtableFree(cmr, &rowHashtable) );
@@ -1851,7 +1853,7 @@ CMR_ERROR decomposeTernarySeriesParallel(
           numRows - numRowReductions, numColumns - numColumnReductions, pviolatorSubmatrix, pseparation) );
 
         /* Check whether the rank-1 part also has ternary rank 1. */
-        if (pseparation)
+        if (pseparation && *pseparation)
         {
           CMRdbgMsg(2, "Checking block of -1/+1s for ternary rank 1.\n");
 
@@ -1933,11 +1935,14 @@ CMR_ERROR CMRtestTernarySeriesParallel(CMR* cmr, CMR_CHRMAT* matrix, bool* pisSe
   if (!reductions)
     CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
 
-  CMR_CALL( decomposeTernarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions, SIZE_MAX,
-    &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, NULL, stats, timeLimit) );
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = decomposeTernarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions, SIZE_MAX,
+    &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, NULL, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+  CMR_CALL( error );
 
   if (pisSeriesParallel)
-    *pisSeriesParallel = (*pnumReductions == matrix->numRows + matrix->numColumns);
+    *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
   if (reductions)
     *pnumReductions = localNumReductions;
   else
@@ -1960,11 +1965,14 @@ CMR_ERROR CMRdecomposeTernarySeriesParallel(CMR* cmr, CMR_CHRMAT* matrix, bool*
   if (!reductions)
     CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
 
-  CMR_CALL( decomposeTernarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions,
-    maxNumReductions, &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, pseparation, stats, timeLimit) );
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = decomposeTernarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions,
+    maxNumReductions, &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, pseparation, stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+  CMR_CALL( error );
 
   if (pisSeriesParallel)
-    *pisSeriesParallel = (*pnumReductions == matrix->numRows + matrix->numColumns);
+    *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
   if (reductions)
     *pnumReductions = localNumReductions;
   else
@@ -1,88 +1,256 @@
 // #define CMR_DEBUG /* Uncomment to debug the sorting. */
 
 #include "sort.h"
+#include "threadpool.h"
 
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
-#define MOVE_ELEMENT(source, target, size) \
-  do \
+CMR_ERROR CMRsort(CMR* cmr, size_t length, void* array, size_t elementSize, int (*compare)(const void*, const void*))
+{
+  assert(cmr);
+
+  qsort(array, length, elementSize, compare);
+
+  return CMR_OKAY;
+}
+
+#define SORT_INSERTION_MAX_LENGTH 48     /**< Rows up to this length are sorted by insertion sort. */
+#define SORT_RADIX_BITS 8                /**< Number of key bits considered in each pass of the radix sort. */
+#define SORT_PARALLEL_MIN_NONZEROS 65536 /**< Minimum number of nonzeros for sorting row ranges in parallel. */
+
+/**
+ * \brief Defines the functions that sort the rows of a matrix whose entries have values of type \p TYPE.
+ *
+ * The defined function sortRange##NAME sorts rows \p firstRow, ..., \p beyondRow - 1. Rows that are already sorted
+ * are only scanned. The others are sorted by insertion sort if they are short and by a least-significant-digit radix
+ * sort on the column indices otherwise, where passes in which all keys have the same digit are skipped.
+ */
+
+#define SORT_ROWS_FUNCTIONS(NAME, TYPE) \
+  static \
+  void insertionSort##NAME(size_t length, size_t* keys, TYPE* values) \
+  { \
+    for (size_t i = 1; i < length; ++i) \
+    { \
+      size_t key = keys[i]; \
+      TYPE value = values[i]; \
+      size_t j = i; \
+      for (; j > 0 && keys[j - 1] > key; --j) \
+      { \
+        keys[j] = keys[j - 1]; \
+        values[j] = values[j - 1]; \
+      } \
+      keys[j] = key; \
+      values[j] = value; \
+    } \
+  } \
+  \
+  static \
+  void radixSort##NAME(size_t length, size_t* keys, TYPE* values, size_t maxKey, size_t* tempKeys, TYPE* tempValues) \
   { \
-    size_t __size = (size); \
-    char* __s = (source); \
-    char* __t = (target); \
-    do \
+    size_t counts[1 << SORT_RADIX_BITS]; \
+    size_t* sourceKeys = keys; \
+    TYPE* sourceValues = values; \
+    size_t* targetKeys = tempKeys; \
+    TYPE* targetValues = tempValues; \
+    for (size_t shift = 0; shift < 8 * sizeof(size_t) && (maxKey >> shift) > 0; shift += SORT_RADIX_BITS) \
     { \
-      *__t++ = *__s++; \
+      for (size_t digit = 0; digit < (1 << SORT_RADIX_BITS); ++digit) \
+        counts[digit] = 0; \
+      for (size_t i = 0; i < length; ++i) \
+        ++counts[(sourceKeys[i] >> shift) & ((1 << SORT_RADIX_BITS) - 1)]; \
+      if (counts[(sourceKeys[0] >> shift) & ((1 << SORT_RADIX_BITS) - 1)] == length) \
+        continue; \
+      size_t position = 0; \
+      for (size_t digit = 0; digit < (1 << SORT_RADIX_BITS); ++digit) \
+      { \
+        size_t count = counts[digit]; \
+        counts[digit] = position; \
+        position += count; \
+      } \
+      for (size_t i = 0; i < length; ++i) \
+      { \
+        size_t target = counts[(sourceKeys[i] >> shift) & ((1 << SORT_RADIX_BITS) - 1)]++; \
+        targetKeys[target] = sourceKeys[i]; \
+        targetValues[target] = sourceValues[i]; \
+      } \
+      size_t* swapKeys = sourceKeys; \
+      sourceKeys = targetKeys; \
+      targetKeys = swapKeys; \
+      TYPE* swapValues = sourceValues; \
+      sourceValues = targetValues; \
+      targetValues = swapValues; \
+    } \
+    if (sourceKeys != keys) \
+    { \
+      memcpy(keys, sourceKeys, length * sizeof(size_t)); \
+      memcpy(values, sourceValues, length * sizeof(TYPE)); \
     } \
-    while (--__size > 0); \
   } \
-  while (false)
+  \
+  static \
+  CMR_ERROR sortRange##NAME(CMR* cmr, size_t firstRow, size_t beyondRow, size_t* rowSlice, size_t* entryColumns, \
+    void* entryValues) \
+  { \
+    assert(cmr); \
+    \
+    size_t maxLength = 0; \
+    for (size_t row = firstRow; row < beyondRow; ++row) \
+    { \
+      if (rowSlice[row + 1] - rowSlice[row] > maxLength) \
+        maxLength = rowSlice[row + 1] - rowSlice[row]; \
+    } \
+    size_t* tempKeys = NULL; \
+    TYPE* tempValues = NULL; \
+    if (maxLength > SORT_INSERTION_MAX_LENGTH) \
+    { \
+      CMR_CALL( CMRallocStackArray(cmr, &tempKeys, maxLength) ); \
+      CMR_CALL( CMRallocStackArray(cmr, &tempValues, maxLength) ); \
+    } \
+    \
+    for (size_t row = firstRow; row < beyondRow; ++row) \
+    { \
+      size_t first = rowSlice[row]; \
+      size_t length = rowSlice[row + 1] - first; \
+      size_t* keys = &entryColumns[first]; \
+      TYPE* values = &((TYPE*) entryValues)[first]; \
+      bool sorted = true; \
+      size_t maxKey = length > 0 ? keys[0] : 0; \
+      for (size_t i = 1; i < length; ++i) \
+      { \
+        if (keys[i] < keys[i - 1]) \
+          sorted = false; \
+        if (keys[i] > maxKey) \
+          maxKey = keys[i]; \
+      } \
+      if (sorted) \
+        continue; \
+      CMRdbgMsg(2, "Sorting nonzero entries in range [%ld,%ld).\n", first, first + length); \
+      if (length <= SORT_INSERTION_MAX_LENGTH) \
+        insertionSort##NAME(length, keys, values); \
+      else \
+        radixSort##NAME(length, keys, values, maxKey, tempKeys, tempValues); \
+    } \
+    \
+    if (tempKeys) \
+    { \
+      CMR_CALL( CMRfreeStackArray(cmr, &tempValues) ); \
+      CMR_CALL( CMRfreeStackArray(cmr, &tempKeys) ); \
+    } \
+    \
+    return CMR_OKAY; \
+  }
 
-CMR_ERROR CMRsort(CMR* cmr, size_t length, void* array, size_t elementSize, int (*compare)(const void*, const void*))
+SORT_ROWS_FUNCTIONS(Dbl, double)
+SORT_ROWS_FUNCTIONS(Int, int)
+SORT_ROWS_FUNCTIONS(Chr, char)
+
+typedef CMR_ERROR (*SortRangeFunction)(CMR* cmr, size_t firstRow, size_t beyondRow, size_t* rowSlice,
+  size_t* entryColumns, void* entryValues);
+
+/**
+ * \brief Data of a task that sorts a range of rows.
+ */
+
+typedef struct
 {
-  assert(cmr);
+  SortRangeFunction function; /**< \brief Type-specific function that sorts the rows. */
+  size_t firstRow;            /**< \brief First row of the range. */
+  size_t beyondRow;           /**< \brief Row beyond the range. */
+  size_t* rowSlice;           /**< \brief Row slices of the matrix. */
+  size_t* entryColumns;       /**< \brief Columns of the entries of the matrix. */
+  void* entryValues;          /**< \brief Values of the entries of the matrix. */
+} SortRangeTask;
 
-  qsort(array, length, elementSize, compare);
+static
+CMR_ERROR sortRangeTask(
+  CMR* cmr,   /**< \ref CMR environment of the executing thread. */
+  void* data  /**< Pointer to \ref SortRangeTask. */
+)
+{
+  SortRangeTask* task = (SortRangeTask*) data;
+
+  CMR_CALL( task->function(cmr, task->firstRow, task->beyondRow, task->rowSlice, task->entryColumns,
+    task->entryValues) );
 
   return CMR_OKAY;
 }
 
-CMR_ERROR CMRsort2(CMR* cmr, size_t length, void* array1, size_t elementSize1, void* array2, size_t elementSize2,
-  int (*compare)(const void**, const void**))
+/**
+ * \brief Sorts the rows of a matrix using \p function, in parallel for large matrices.
+ *
+ * The rows are split into several ranges per thread with roughly the same number of nonzeros each.
+ */
+
+static
+CMR_ERROR sortRows(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  size_t numRows,             /**< Number of rows. */
+  size_t* rowSlice,           /**< Row slices of the matrix. */
+  size_t* entryColumns,       /**< Columns of the entries of the matrix. */
+  void* entryValues,          /**< Values of the entries of the matrix. */
+  SortRangeFunction function  /**< Type-specific function that sorts a range of rows. */
+)
 {
   assert(cmr);
+  assert(rowSlice);
 
-  CMRassertStackConsistency(cmr);
-
-  /* Allocate space for temporary elements of both arrays. */
-  char* temp1 = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &temp1, elementSize1) );
-  char* temp2 = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &temp2, elementSize2) );
-
-  /* Create an array with pointers into array1. */
-  void** pointerArray = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &pointerArray, length) );
-  void* pointer = array1;
-  for (size_t i = 0; i < length; ++i)
+  size_t numNonzeros = rowSlice[numRows];
+  size_t numThreads = CMRthreadpoolSize(cmr);
+  if (numThreads == 1 || numRows < 2 || numNonzeros < SORT_PARALLEL_MIN_NONZEROS)
   {
-    pointerArray[i] = pointer;
-    pointer += elementSize1;
+    CMR_CALL( function(cmr, 0, numRows, rowSlice, entryColumns, entryValues) );
+    return CMR_OKAY;
   }
 
-  qsort(pointerArray, length, sizeof(size_t*), (int (*)(const void*, const void*)) compare);
+  size_t numRanges = 4 * numThreads < numRows ? 4 * numThreads : numRows;
+  SortRangeTask* tasks = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &tasks, numRanges) );
+  CMR_TASK_GROUP group;
+  CMR_CALL( CMRtaskGroupInit(cmr, &group) );
 
-  /* Reorder array1 and array2 according to the array of pointers. */
-  for (size_t i = 0; i < length; ++i)
+  CMR_ERROR error = CMR_OKAY;
+  size_t row = 0;
+  for (size_t r = 0; r < numRanges && error == CMR_OKAY; ++r)
   {
-    CMRdbgMsg(0, "i = %d, pointerArray[i] = %p array1 = %p, difference = %ld, scaled = %d\n", i, pointerArray[i], array1,
-      pointerArray[i] - array1, (pointerArray[i] - array1) / elementSize1);
-    if (i != (pointerArray[i] - array1) / elementSize1)
-    {
-      MOVE_ELEMENT(array1 + elementSize1 * i, temp1, elementSize1); /* temp1 = array1[i] */
-      MOVE_ELEMENT(array2 + elementSize2 * i, temp2, elementSize2); /* temp2 = array2[i] */
-      size_t j;
-      size_t k = i;
-      while (i != (j = (pointerArray[k] - array1) / elementSize1))
-      {
-        MOVE_ELEMENT(array1 + elementSize1 * j, array1 + elementSize1 * k, elementSize1); /* array1[k] = array1[j] */
-        MOVE_ELEMENT(array2 + elementSize2 * j, array2 + elementSize2 * k, elementSize2); /* array2[k] = array2[j] */
-        pointerArray[k] = array1 + elementSize1 * k;
-        k = j;
-      }
-      MOVE_ELEMENT(temp1, array1 + elementSize1 * k, elementSize1); /* array1[k] = temp1 */
-      MOVE_ELEMENT(temp2, array2 + elementSize2 * k, elementSize2); /* array2[k] = temp2 */
-      pointerArray[k] = array1 + elementSize1 * k;
-    }
+    SortRangeTask* task = &tasks[r];
+    task->function = function;
+    task->rowSlice = rowSlice;
+    task->entryColumns = entryColumns;
+    task->entryValues = entryValues;
+    task->firstRow = row;
+    size_t beyondEntry = (numNonzeros / numRanges) * (r + 1);
+    if (r + 1 == numRanges)
+      row = numRows;
+    while (row < numRows && rowSlice[row] < beyondEntry)
+      ++row;
+    task->beyondRow = row;
+    error = CMRtaskSpawn(cmr, &group, sortRangeTask, task);
   }
+  if (error != CMR_OKAY)
+    CMRtaskGroupCancel(&group);
+  CMR_ERROR taskError = CMRtaskWait(cmr, &group);
+  if (error == CMR_OKAY)
+    error = taskError;
 
-  /* Free the temporary space. */
-  CMR_CALL( CMRfreeStackArray(cmr, &pointerArray) );
-  CMR_CALL( CMRfreeStackArray(cmr, &temp2) );
-  CMR_CALL( CMRfreeStackArray(cmr, &temp1) );
-  CMRassertStackConsistency(cmr);
+  CMR_CALL( CMRfreeBlockArray(cmr, &tasks) );
 
-  return CMR_OKAY;
+  return error;
+}
+
+CMR_ERROR CMRsortRowsDbl(CMR* cmr, size_t numRows, size_t* rowSlice, size_t* entryColumns, double* entryValues)
+{
+  return sortRows(cmr, numRows, rowSlice, entryColumns, entryValues, sortRangeDbl);
 }
 
+CMR_ERROR CMRsortRowsInt(CMR* cmr, size_t numRows, size_t* rowSlice, size_t* entryColumns, int* entryValues)
+{
+  return sortRows(cmr, numRows, rowSlice, entryColumns, entryValues, sortRangeInt);
+}
+
+CMR_ERROR CMRsortRowsChr(CMR* cmr, size_t numRows, size_t* rowSlice, size_t* entryColumns, char* entryValues)
+{
+  return sortRows(cmr, numRows, rowSlice, entryColumns, entryValues, sortRangeChr);
+}
@@ -23,21 +23,46 @@ CMR_ERROR CMRsort(
 );
 
 /**
- * \brief Sorts two arrays simultaneously.
+ * \brief Sorts the entries of each row of a double matrix by column.
  *
- * Sorts two arrays using the qsort function from the C library. The user must provide a \p compare function that is
- * called several times with pointers to pointers into the first array. Hence, the arguments must be dereferenced twice
- * in order to access the actual element.
+ * Short rows are sorted by insertion sort and long rows by a radix sort on the columns. If \p cmr uses several
+ * threads and the matrix is large, then ranges of rows are sorted in parallel.
  */
 
-CMR_ERROR CMRsort2(
-  CMR* cmr,                                     /**< \ref CMR environment. */
-  size_t length,                              /**< Number of elements in both arrays. */
-  void *array1,                               /**< Pointer to the first element of the first array.  */
-  size_t elementSize1,                        /**< Size (in bytes) of each element of the first array. */
-  void* array2,                               /**< Pointer to the first element of the second array.  */
-  size_t elementSize2,                        /**< Size (in bytes) of each element of the second array. */
-  int (*compare)(const void**, const void**)  /**< Comparison function for comparing two elements. */
+CMR_ERROR CMRsortRowsDbl(
+  CMR* cmr,             /**< \ref CMR environment. */
+  size_t numRows,       /**< Number of rows. */
+  size_t* rowSlice,     /**< Array of length \p numRows + 1 with the first entry of each row. */
+  size_t* entryColumns, /**< Array with the column of each entry. */
+  double* entryValues   /**< Array with the value of each entry. */
+);
+
+/**
+ * \brief Sorts the entries of each row of an int matrix by column.
+ *
+ * See \ref CMRsortRowsDbl.
+ */
+
+CMR_ERROR CMRsortRowsInt(
+  CMR* cmr,             /**< \ref CMR environment. */
+  size_t numRows,       /**< Number of rows. */
+  size_t* rowSlice,     /**< Array of length \p numRows + 1 with the first entry of each row. */
+  size_t* entryColumns, /**< Array with the column of each entry. */
+  int* entryValues      /**< Array with the value of each entry. */
+);
+
+/**
+ * \brief Sorts the entries of each row of a char matrix by column.
+ *
+ * See \ref CMRsortRowsDbl.
+ */
+
+CMR_ERROR CMRsortRowsChr(
+  CMR* cmr,             /**< \ref CMR environment. */
+  size_t numRows,       /**< Number of rows. */
+  size_t* rowSlice,     /**< Array of length \p numRows + 1 with the first entry of each row. */
+  size_t* entryColumns, /**< Array with the column of each entry. */
+  char* entryValues     /**< Array with the value of each entry. */
 );
 
 #ifdef __cplusplus
@@ -0,0 +1,481 @@
+// #define CMR_DEBUG /* Uncomment to debug the thread pool. */
+
+#include "threadpool.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#if defined(CMR_WITH_THREADS)
+#include <pthread.h>
+#include <sched.h>
+#endif /* CMR_WITH_THREADS */
+
+/**
+ * \brief A task that was spawned but did not start yet.
+ */
+
+typedef struct
+{
+  CMR_TASK_FUNCTION function; /**< \brief Function to execute. */
+  void* data;                 /**< \brief Data passed to \ref function. */
+  CMR_TASK_GROUP* group;      /**< \brief Group the task belongs to. */
+} CMR_TASK;
+
+/**
+ * \brief Executes \p task unless its group was cancelled, and records its error.
+ */
+
+static
+void runTask(
+  CMR* cmr,       /**< \ref CMR environment of the executing thread. */
+  CMR_TASK* task  /**< Task to execute. */
+)
+{
+  assert(cmr);
+  assert(task);
+
+  CMR_TASK_GROUP* group = task->group;
+  if (!CMRtaskGroupIsCancelled(group))
+  {
+    /* Groups initialized by the task are nested in its group, and it runs with the deadline of its spawner. */
+    CMR_TASK_GROUP* outerGroup = cmr->taskGroup;
+    double outerDeadline = cmr->deadline.time;
+    cmr->taskGroup = group;
+    cmr->deadline.time = group->deadline;
+    CMR_ERROR error = task->function(cmr, task->data);
+    cmr->taskGroup = outerGroup;
+    cmr->deadline.time = outerDeadline;
+    if (error != CMR_OKAY)
+    {
+      /* Only the first error of a group is reported, together with its message. */
+      CMR_ERROR expected = CMR_OKAY;
+      if (__atomic_compare_exchange_n(&group->error, &expected, error, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      {
+        group->errorMessage = cmr->errorMessage;
+        cmr->errorMessage = NULL;
+      }
+      CMRtaskGroupCancel(group);
+    }
+  }
+
+  /* Release all writes of the task to the thread that waits for the group. */
+  __atomic_sub_fetch(&group->numPending, 1, __ATOMIC_ACQ_REL);
+}
+
+CMR_ERROR CMRtaskGroupInit(CMR* cmr, CMR_TASK_GROUP* group)
+{
+  assert(cmr);
+  assert(group);
+
+  group->parent = cmr->taskGroup;
+  group->numPending = 0;
+  group->cancelled = 0;
+  group->error = CMR_OKAY;
+  group->errorMessage = NULL;
+  group->deadline = cmr->deadline.time;
+
+  return CMR_OKAY;
+}
+
+void CMRtaskGroupCancel(CMR_TASK_GROUP* group)
+{
+  assert(group);
+
+  __atomic_store_n(&group->cancelled, 1, __ATOMIC_RELEASE);
+}
+
+bool CMRtaskGroupIsCancelled(CMR_TASK_GROUP* group)
+{
+  assert(group);
+
+  for (; group; group = group->parent)
+  {
+    if (__atomic_load_n(&group->cancelled, __ATOMIC_ACQUIRE))
+      return true;
+  }
+
+  return false;
+}
+
+bool CMRtaskIsCancelled(CMR* cmr)
+{
+  assert(cmr);
+
+  return cmr->taskGroup && CMRtaskGroupIsCancelled(cmr->taskGroup);
+}
+
+#if defined(CMR_WITH_THREADS)
+
+/**
+ * \brief Double-ended queue of tasks of one worker, implemented as a ring buffer.
+ *
+ * The owning worker pushes and pops at the back, other workers steal from the front.
+ */
+
+typedef struct
+{
+  pthread_mutex_t mutex;  /**< \brief Mutex protecting the deque. */
+  CMR_TASK* tasks;        /**< \brief Ring buffer of tasks. */
+  size_t memTasks;        /**< \brief Memory of \ref tasks. */
+  size_t first;           /**< \brief Index of front task in \ref tasks. */
+  size_t numTasks;        /**< \brief Number of tasks in the deque. */
+} CMR_TASK_DEQUE;
+
+struct _CMR_THREADPOOL
+{
+  size_t numWorkers;        /**< \brief Number of workers, including the owning thread. */
+  CMR_TASK_DEQUE* deques;   /**< \brief Array with one deque per worker. */
+  CMR** environments;       /**< \brief Array with the environment of each worker. */
+  pthread_t* threads;       /**< \brief Array with the threads of workers 1, 2, ... */
+  pthread_mutex_t mutex;    /**< \brief Mutex for \ref condition and \ref shutdown. */
+  pthread_cond_t condition; /**< \brief Condition variable idle workers wait for. */
+  size_t numQueued;         /**< \brief Total number of tasks in all deques. */
+  bool shutdown;            /**< \brief Whether the workers shall terminate. */
+};
+
+/**
+ * \brief Pushes \p task to the back of the deque of worker \p index and wakes up an idle worker.
+ */
+
+static
+CMR_ERROR pushTask(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_THREADPOOL* pool,   /**< Thread pool. */
+  size_t index,           /**< Index of worker. */
+  CMR_TASK* task          /**< Task to push. */
+)
+{
+  CMR_TASK_DEQUE* deque = &pool->deques[index];
+
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->numTasks == deque->memTasks)
+  {
+    size_t newMemTasks = 2 * deque->memTasks;
+    CMR_TASK* newTasks = NULL;
+    CMR_ERROR error = CMRallocBlockArray(cmr, &newTasks, newMemTasks);
+    if (error != CMR_OKAY)
+    {
+      pthread_mutex_unlock(&deque->mutex);
+      return error;
+    }
+    for (size_t i = 0; i < deque->numTasks; ++i)
+      newTasks[i] = deque->tasks[(deque->first + i) % deque->memTasks];
+    CMRfreeBlockArray(cmr, &deque->tasks);
+    deque->tasks = newTasks;
+    deque->memTasks = newMemTasks;
+    deque->first = 0;
+  }
+  deque->tasks[(deque->first + deque->numTasks) % deque->memTasks] = *task;
+  ++deque->numTasks;
+  __atomic_add_fetch(&pool->numQueued, 1, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&deque->mutex);
+
+  pthread_mutex_lock(&pool->mutex);
+  pthread_cond_signal(&pool->condition);
+  pthread_mutex_unlock(&pool->mutex);
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Takes a task from the deque of worker \p index, from its back if \p back is \c true and from its front
+ *        otherwise.
+ */
+
+static
+bool takeTask(
+  CMR_THREADPOOL* pool, /**< Thread pool. */
+  size_t index,         /**< Index of worker whose deque is accessed. */
+  bool back,            /**< Whether to take the most recently pushed task. */
+  CMR_TASK* ptask       /**< Pointer for storing the task. */
+)
+{
+  CMR_TASK_DEQUE* deque = &pool->deques[index];
+  bool found = false;
+
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->numTasks > 0)
+  {
+    if (back)
+      *ptask = deque->tasks[(deque->first + deque->numTasks - 1) % deque->memTasks];
+    else
+    {
+      *ptask = deque->tasks[deque->first];
+      deque->first = (deque->first + 1) % deque->memTasks;
+    }
+    --deque->numTasks;
+    __atomic_sub_fetch(&pool->numQueued, 1, __ATOMIC_RELAXED);
+    found = true;
+  }
+  pthread_mutex_unlock(&deque->mutex);
+
+  return found;
+}
+
+/**
+ * \brief Finds a task for worker \p index, first in its own deque and then in those of the other workers.
+ */
+
+static
+bool findTask(
+  CMR_THREADPOOL* pool, /**< Thread pool. */
+  size_t index,         /**< Index of worker. */
+  CMR_TASK* ptask       /**< Pointer for storing the task. */
+)
+{
+  if (__atomic_load_n(&pool->numQueued, __ATOMIC_ACQUIRE) == 0)
+    return false;
+
+  if (takeTask(pool, index, true, ptask))
+    return true;
+
+  for (size_t w = 1; w < pool->numWorkers; ++w)
+  {
+    if (takeTask(pool, (index + w) % pool->numWorkers, false, ptask))
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * \brief Main loop of a worker thread.
+ */
+
+static
+void* workerMain(
+  void* arg /**< \ref CMR environment of the worker. */
+)
+{
+  CMR* cmr = (CMR*) arg;
+  CMR_THREADPOOL* pool = cmr->threadPool;
+
+  while (true)
+  {
+    CMR_TASK task;
+    if (findTask(pool, cmr->threadIndex, &task))
+    {
+      runTask(cmr, &task);
+      continue;
+    }
+
+    pthread_mutex_lock(&pool->mutex);
+    while (!pool->shutdown && __atomic_load_n(&pool->numQueued, __ATOMIC_ACQUIRE) == 0)
+      pthread_cond_wait(&pool->condition, &pool->mutex);
+    bool shutdown = pool->shutdown;
+    pthread_mutex_unlock(&pool->mutex);
+
+    if (shutdown)
+      break;
+  }
+
+  return NULL;
+}
+
+CMR_ERROR CMRthreadpoolCreate(CMR* cmr, size_t numThreads, CMR_THREADPOOL** ppool)
+{
+  assert(cmr);
+  assert(numThreads >= 1);
+  assert(ppool);
+
+  CMRdbgMsg(0, "Creating thread pool with %zu workers.\n", numThreads);
+
+  CMR_CALL( CMRallocBlock(cmr, ppool) );
+  CMR_THREADPOOL* pool = *ppool;
+  pool->numWorkers = numThreads;
+  pool->numQueued = 0;
+  pool->shutdown = false;
+  pool->deques = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &pool->deques, numThreads) );
+  pool->environments = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &pool->environments, numThreads) );
+  pool->threads = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &pool->threads, numThreads) );
+  pthread_mutex_init(&pool->mutex, NULL);
+  pthread_cond_init(&pool->condition, NULL);
+
+  for (size_t w = 0; w < numThreads; ++w)
+  {
+    CMR_TASK_DEQUE* deque = &pool->deques[w];
+    pthread_mutex_init(&deque->mutex, NULL);
+    deque->memTasks = 16;
+    deque->tasks = NULL;
+    CMR_CALL( CMRallocBlockArray(cmr, &deque->tasks, deque->memTasks) );
+    deque->first = 0;
+    deque->numTasks = 0;
+  }
+
+  /* Worker 0 is the owning thread; all others get a forked environment with their own stack. */
+  pool->environments[0] = cmr;
+  for (size_t w = 1; w < numThreads; ++w)
+  {
+    CMR* worker = NULL;
+    CMR_CALL( CMRforkEnvironment(cmr, &worker) );
+    worker->numThreads = (int) numThreads;
+    worker->threadPool = pool;
+    worker->threadIndex = w;
+    pool->environments[w] = worker;
+  }
+
+  for (size_t w = 1; w < numThreads; ++w)
+  {
+    if (pthread_create(&pool->threads[w], NULL, workerMain, pool->environments[w]))
+    {
+      /* Run with the threads started so far. */
+      CMRdbgMsg(2, "Could not start thread %zu.\n", w);
+      for (size_t v = w; v < numThreads; ++v)
+      {
+        CMR_CALL( CMRfreeEnvironment(&pool->environments[v]) );
+        pthread_mutex_destroy(&pool->deques[v].mutex);
+        CMR_CALL( CMRfreeBlockArray(cmr, &pool->deques[v].tasks) );
+      }
+      pool->numWorkers = w;
+      break;
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRthreadpoolFree(CMR* cmr, CMR_THREADPOOL** ppool)
+{
+  assert(cmr);
+  assert(ppool);
+
+  CMR_THREADPOOL* pool = *ppool;
+  if (!pool)
+    return CMR_OKAY;
+
+  assert(pool->numQueued == 0);
+
+  pthread_mutex_lock(&pool->mutex);
+  pool->shutdown = true;
+  pthread_cond_broadcast(&pool->condition);
+  pthread_mutex_unlock(&pool->mutex);
+
+  for (size_t w = 1; w < pool->numWorkers; ++w)
+  {
+    pthread_join(pool->threads[w], NULL);
+    CMR_CALL( CMRfreeEnvironment(&pool->environments[w]) );
+  }
+
+  for (size_t w = 0; w < pool->numWorkers; ++w)
+  {
+    pthread_mutex_destroy(&pool->deques[w].mutex);
+    CMR_CALL( CMRfreeBlockArray(cmr, &pool->deques[w].tasks) );
+  }
+  pthread_cond_destroy(&pool->condition);
+  pthread_mutex_destroy(&pool->mutex);
+
+  CMR_CALL( CMRfreeBlockArray(cmr, &pool->threads) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &pool->environments) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &pool->deques) );
+  CMR_CALL( CMRfreeBlock(cmr, ppool) );
+
+  return CMR_OKAY;
+}
+
+size_t CMRthreadpoolSize(CMR* cmr)
+{
+  assert(cmr);
+
+  if (cmr->threadPool)
+    return cmr->threadPool->numWorkers;
+
+  return cmr->numThreads > 1 ? (size_t) cmr->numThreads : 1;
+}
+
+#else /* !CMR_WITH_THREADS */
+
+CMR_ERROR CMRthreadpoolCreate(CMR* cmr, size_t numThreads, CMR_THREADPOOL** ppool)
+{
+  assert(cmr);
+  assert(ppool);
+  CMR_UNUSED(numThreads);
+
+  *ppool = NULL;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRthreadpoolFree(CMR* cmr, CMR_THREADPOOL** ppool)
+{
+  assert(cmr);
+  assert(ppool);
+  assert(!*ppool);
+
+  return CMR_OKAY;
+}
+
+size_t CMRthreadpoolSize(CMR* cmr)
+{
+  assert(cmr);
+
+  return 1;
+}
+
+#endif /* CMR_WITH_THREADS */
+
+CMR_ERROR CMRtaskSpawn(CMR* cmr, CMR_TASK_GROUP* group, CMR_TASK_FUNCTION function, void* data)
+{
+  assert(cmr);
+  assert(group);
+  assert(function);
+
+  CMR_TASK task = { function, data, group };
+
+#if defined(CMR_WITH_THREADS)
+  if (!cmr->threadPool && cmr->numThreads > 1)
+  {
+    CMR_CALL( CMRthreadpoolCreate(cmr, cmr->numThreads, &cmr->threadPool) );
+    cmr->threadIndex = 0;
+    cmr->ownsThreadPool = true;
+  }
+
+  if (cmr->threadPool && cmr->threadPool->numWorkers > 1)
+  {
+    __atomic_add_fetch(&group->numPending, 1, __ATOMIC_RELAXED);
+    CMR_ERROR error = pushTask(cmr, cmr->threadPool, cmr->threadIndex, &task);
+    if (error != CMR_OKAY)
+      __atomic_sub_fetch(&group->numPending, 1, __ATOMIC_RELAXED);
+    return error;
+  }
+#endif /* CMR_WITH_THREADS */
+
+  /* Without other workers, the task is executed immediately. */
+  __atomic_add_fetch(&group->numPending, 1, __ATOMIC_RELAXED);
+  runTask(cmr, &task);
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRtaskWait(CMR* cmr, CMR_TASK_GROUP* group)
+{
+  assert(cmr);
+  assert(group);
+
+#if defined(CMR_WITH_THREADS)
+  CMR_THREADPOOL* pool = cmr->threadPool;
+  while (__atomic_load_n(&group->numPending, __ATOMIC_ACQUIRE) > 0)
+  {
+    /* Help with pending tasks instead of blocking, which also allows tasks to wait for other tasks. */
+    assert(pool);
+    CMR_TASK task;
+    if (findTask(pool, cmr->threadIndex, &task))
+      runTask(cmr, &task);
+    else
+      sched_yield();
+  }
+#endif /* CMR_WITH_THREADS */
+
+  assert(group->numPending == 0);
+
+  if (group->error != CMR_OKAY && group->errorMessage)
+  {
+    free(cmr->errorMessage);
+    cmr->errorMessage = group->errorMessage;
+    group->errorMessage = NULL;
+  }
+
+  return group->error;
+}
@@ -0,0 +1,147 @@
+#ifndef CMR_THREADPOOL_INTERNAL_H
+#define CMR_THREADPOOL_INTERNAL_H
+
+#include "env_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Function executed by a task.
+ *
+ * The \p cmr environment is the one of the executing thread and may differ from the one that spawned the task.
+ */
+
+typedef CMR_ERROR (*CMR_TASK_FUNCTION)(
+  CMR* cmr,   /**< \ref CMR environment of the executing thread. */
+  void* data  /**< Data passed to \ref CMRtaskSpawn. */
+);
+
+/**
+ * \brief Group of tasks that can be waited for jointly.
+ *
+ * A group that is initialized within a task is nested in the group of that task, i.e., it is cancelled whenever the
+ * latter is. The members must only be accessed via the functions below.
+ */
+
+typedef struct _CMR_TASK_GROUP
+{
+  struct _CMR_TASK_GROUP* parent; /**< \brief Group of the task that initialized this group, or \c NULL. */
+  size_t numPending;              /**< \brief Number of spawned tasks that did not finish yet. */
+  int cancelled;                  /**< \brief Whether tasks that did not start yet shall be skipped. */
+  CMR_ERROR error;                /**< \brief First error reported by a task of this group. */
+  char* errorMessage;             /**< \brief Error message of the environment that reported \ref error. */
+  double deadline;                /**< \brief Deadline of the environment that initialized the group. */
+} CMR_TASK_GROUP;
+
+/**
+ * \brief Thread pool with one deque of tasks per worker.
+ *
+ * Worker 0 is the thread that owns the \ref CMR environment. The other workers run in their own threads and have
+ * their own environments, in particular their own stack memory. Idle workers steal tasks from the other deques.
+ */
+
+typedef struct _CMR_THREADPOOL CMR_THREADPOOL;
+
+/**
+ * \brief Creates a thread pool with \p numThreads workers for \p cmr.
+ */
+
+CMR_ERROR CMRthreadpoolCreate(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  size_t numThreads,        /**< Number of workers, including the calling thread. */
+  CMR_THREADPOOL** ppool    /**< Pointer for storing the thread pool. */
+);
+
+/**
+ * \brief Terminates all threads of a thread pool and frees it.
+ *
+ * Must not be called while tasks are pending.
+ */
+
+CMR_ERROR CMRthreadpoolFree(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_THREADPOOL** ppool  /**< Pointer to thread pool. */
+);
+
+/**
+ * \brief Returns the number of workers that execute tasks spawned from \p cmr.
+ *
+ * This is 1 if the library was built without thread support.
+ */
+
+size_t CMRthreadpoolSize(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
+/**
+ * \brief Initializes an empty task group.
+ *
+ * If called from within a task, the new group is nested in the group of that task.
+ */
+
+CMR_ERROR CMRtaskGroupInit(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_TASK_GROUP* group   /**< Task group. */
+);
+
+/**
+ * \brief Spawns a task of \p group.
+ *
+ * If \p cmr uses only one thread, then the task is executed immediately. Otherwise, it is pushed onto the deque of
+ * the calling worker and may be executed by any worker. Tasks of a cancelled group are not started anymore.
+ */
+
+CMR_ERROR CMRtaskSpawn(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_TASK_GROUP* group,      /**< Task group. */
+  CMR_TASK_FUNCTION function, /**< Function to execute. */
+  void* data                  /**< Data passed to \p function. */
+);
+
+/**
+ * \brief Waits until all tasks of \p group have finished.
+ *
+ * While waiting, the calling thread executes pending tasks of any group. Returns the first error reported by a task of
+ * \p group, whose error message is moved to \p cmr.
+ */
+
+CMR_ERROR CMRtaskWait(
+  CMR* cmr,             /**< \ref CMR environment. */
+  CMR_TASK_GROUP* group /**< Task group. */
+);
+
+/**
+ * \brief Requests that no further tasks of \p group are started.
+ *
+ * Running tasks are not interrupted, but may poll \ref CMRtaskGroupIsCancelled.
+ */
+
+void CMRtaskGroupCancel(
+  CMR_TASK_GROUP* group /**< Task group. */
+);
+
+/**
+ * \brief Returns \c true if \p group or a group it is nested in was cancelled.
+ */
+
+bool CMRtaskGroupIsCancelled(
+  CMR_TASK_GROUP* group /**< Task group. */
+);
+
+/**
+ * \brief Returns \c true if the task that is currently executed by \p cmr was cancelled.
+ *
+ * Long-running tasks may poll this in order to terminate early. Returns \c false outside of tasks.
+ */
+
+bool CMRtaskIsCancelled(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMR_THREADPOOL_INTERNAL_H */
@@ -1,15 +1,20 @@
 #include <cmr/tu.h>
+#include "tu_internal.h"
 
 #include <cmr/camion.h>
 
+#include "dec_internal.h"
 #include "matrix_internal.h"
 #include "one_sum.h"
 #include "camion_internal.h"
 #include "regular_internal.h"
 #include "hereditary_property.h"
+#include "result_cache.h"
+#include "threadpool.h"
 
 #include <stdlib.h>
 #include <assert.h>
+#include <float.h>
 #include <time.h>
 
 CMR_ERROR CMRparamsTotalUnimodularityInit(CMR_TU_PARAMETERS* params)
@@ -29,6 +34,24 @@ CMR_ERROR CMRstatsTotalUnimodularityInit(CMR_TU_STATISTICS* stats)
   stats->totalTime = 0.0;
   CMR_CALL( CMRstatsCamionInit(&stats->camion) );
   CMR_CALL( CMRstatsRegularInit(&stats->regular) );
+  stats->cacheHitCount = 0;
+  stats->cacheMissCount = 0;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRstatsTotalUnimodularityAdd(CMR_TU_STATISTICS* stats, CMR_TU_STATISTICS* other)
+{
+  assert(stats);
+  assert(other);
+
+  stats->totalCount += other->totalCount;
+  stats->totalTime += other->totalTime;
+  stats->camion.totalCount += other->camion.totalCount;
+  stats->camion.totalTime += other->camion.totalTime;
+  CMR_CALL( CMRstatsRegularAdd(&stats->regular, &other->regular) );
+  stats->cacheHitCount += other->cacheHitCount;
+  stats->cacheMissCount += other->cacheMissCount;
 
   return CMR_OKAY;
 }
@@ -50,28 +73,47 @@ CMR_ERROR CMRstatsTotalUnimodularityPrint(FILE* stream, CMR_TU_STATISTICS* stats
   snprintf(subPrefix, 256, "%sregularity ", prefix);
   CMR_CALL( CMRstatsRegularPrint(stream, &stats->regular, subPrefix) );
 
+  if (stats->cacheHitCount || stats->cacheMissCount)
+  {
+    fprintf(stream, "%sresult cache: %ld hits, %ld misses\n", prefix, stats->cacheHitCount,
+      stats->cacheMissCount);
+  }
   fprintf(stream, "%stotal: %ld in %f seconds\n", prefix, stats->totalCount,
     stats->totalTime);
 
   return CMR_OKAY;
 }
 
+/**
+ * \brief Data passed to \ref tuTest.
+ */
+
+typedef struct
+{
+  CMR_TU_STATISTICS* stats; /**< \brief Statistics to add to (may be \c NULL). */
+  bool statsLock;           /**< \brief Spin lock protecting \ref stats, since tests may run concurrently. */
+} TuTestData;
+
 static
 CMR_ERROR tuTest(
   CMR* cmr,                   /**< \ref CMR environment. */
-  CMR_CHRMAT* matrix,         /**< Some matrix to be tested for total unimodularity. */
-  void* data,                 /**< Additional data (must be \c NULL). */
-  bool* pisTotallyUnimodular, /**< Pointer for storing whether \p matrix is totally unimodular. */
-  CMR_SUBMAT** psubmatrix,    /**< Pointer for storing a proper non-totally unimodular submatrix of \p matrix. */
-  double timeLimit                /**< Time limit to impose. */
+  CMR_CHRMAT_VIEW* view,     /**< View of some matrix to be tested for total unimodularity. */
+  void* data,                 /**< Pointer to \ref TuTestData. */
+  bool* pisTotallyUnimodular, /**< Pointer for storing whether \p view is totally unimodular. */
+  CMR_SUBMAT** psubmatrix     /**< Pointer for storing a proper non-totally unimodular submatrix of \p view. */
 )
 {
   assert(cmr);
-  assert(matrix);
+  assert(view);
+  assert(data);
   assert(pisTotallyUnimodular);
   assert(!psubmatrix || !*psubmatrix);
 
-  CMR_TU_STATISTICS* stats = (CMR_TU_STATISTICS*) data;
+  TuTestData* testData = (TuTestData*) data;
+
+  /* Camion's algorithm and the regularity test require a compressed matrix. */
+  CMR_CHRMAT* matrix = NULL;
+  CMR_CALL( CMRchrmatViewMaterialize(cmr, view, &matrix) );
 
 #if defined(CMR_DEBUG)
   CMRdbgMsg(0, "tuTest called for a %dx%d matrix\n", matrix->numRows, matrix->numColumns);
@@ -79,24 +121,137 @@ CMR_ERROR tuTest(
 #endif /* CMR_DEBUG */
 
   *pisTotallyUnimodular = true;
-  clock_t time = clock();
 
-  CMR_CALL( CMRtestCamionSigned(cmr, matrix, pisTotallyUnimodular, NULL, stats ? &stats->camion : NULL, timeLimit) );
+  /* Statistics are collected locally and added at the end. */
+  CMR_TU_STATISTICS stats;
+  CMR_CALL( CMRstatsTotalUnimodularityInit(&stats) );
+
+  CMR_CALL( CMRtestCamionSigned(cmr, matrix, pisTotallyUnimodular, NULL, &stats.camion, DBL_MAX) );
 
   if (*pisTotallyUnimodular)
   {
     CMR_REGULAR_PARAMETERS params;
     CMR_CALL( CMRparamsRegularInit(&params) );
-    double remainingTime = ((clock() - time) * 1.0 / CLOCKS_PER_SEC) - timeLimit;
-    CMR_CALL( CMRtestRegular(cmr, matrix, false, pisTotallyUnimodular, NULL, NULL, &params,
-      stats ? &stats->regular : NULL, remainingTime) );
+    CMR_CALL( CMRtestRegular(cmr, matrix, false, pisTotallyUnimodular, NULL, NULL, &params, &stats.regular) );
   }
 
+  if (testData->stats)
+  {
+    while (__atomic_test_and_set(&testData->statsLock, __ATOMIC_ACQUIRE));
+    testData->stats->camion.totalCount += stats.camion.totalCount;
+    testData->stats->camion.totalTime += stats.camion.totalTime;
+    CMRstatsRegularAdd(&testData->stats->regular, &stats.regular);
+    __atomic_clear(&testData->statsLock, __ATOMIC_RELEASE);
+  }
+
+  CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+
   return CMR_OKAY;
 }
 
-CMR_ERROR CMRtestTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotallyUnimodular, CMR_DEC** pdec,
-  CMR_SUBMAT** psubmatrix, CMR_TU_PARAMETERS* params, CMR_TU_STATISTICS* stats, double timeLimit)
+/**
+ * \brief Returns \c true if the decomposition \p node or one of its descendants is irregular.
+ */
+
+static
+bool containsIrregular(
+  CMR_DEC* node /**< Decomposition node. */
+)
+{
+  if (node->type == CMR_DEC_IRREGULAR)
+    return true;
+  for (size_t c = 0; c < node->numChildren; ++c)
+  {
+    if (containsIrregular(node->children[c]))
+      return true;
+  }
+  return false;
+}
+
+/**
+ * \brief Finds a small irregular submatrix of the matrix decomposed by \p dec.
+ *
+ * The children of 1-sums, 2-sums and series-parallel reductions are submatrices of their parent, and an irregular
+ * child is a minor of its parent. Hence, we descend into such children as long as they contain an irregular node.
+ * If this leads to a proper submatrix, it is stored in \p *psubmatrix; otherwise, \p *psubmatrix is set to \c NULL.
+ */
+
+static
+CMR_ERROR findIrregularSubmatrix(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_DEC* dec,           /**< Decomposition of an irregular matrix. */
+  CMR_SUBMAT** psubmatrix /**< Pointer for storing the submatrix. */
+)
+{
+  assert(cmr);
+  assert(dec);
+  assert(psubmatrix);
+
+  *psubmatrix = NULL;
+  CMR_DEC* node = dec;
+  bool descended = true;
+  while (descended)
+  {
+    descended = false;
+    if (node->type != CMR_DEC_ONE_SUM && node->type != CMR_DEC_TWO_SUM && node->type != CMR_DEC_SERIES_PARALLEL)
+      break;
+
+    for (size_t c = 0; c < node->numChildren && !descended; ++c)
+    {
+      CMR_DEC* child = node->children[c];
+      bool isSubmatrix = child->rowsParent && child->columnsParent;
+      for (size_t row = 0; row < child->numRows && isSubmatrix; ++row)
+        isSubmatrix = child->rowsParent[row] < node->numRows;
+      for (size_t column = 0; column < child->numColumns && isSubmatrix; ++column)
+        isSubmatrix = child->columnsParent[column] < node->numColumns;
+      if (isSubmatrix && containsIrregular(child))
+      {
+        node = child;
+        descended = true;
+      }
+    }
+  }
+
+  if (node == dec)
+    return CMR_OKAY;
+
+  CMRdbgMsg(2, "Irregularity is displayed by a %zux%zu submatrix.\n", node->numRows, node->numColumns);
+
+  CMR_CALL( CMRsubmatCreate(cmr, node->numRows, node->numColumns, psubmatrix) );
+  CMR_SUBMAT* submatrix = *psubmatrix;
+  for (size_t row = 0; row < node->numRows; ++row)
+  {
+    size_t index = row;
+    for (CMR_DEC* current = node; current != dec; current = current->parent)
+      index = current->rowsParent[index];
+    submatrix->rows[row] = index;
+  }
+  for (size_t column = 0; column < node->numColumns; ++column)
+  {
+    size_t index = column;
+    for (CMR_DEC* current = node; current != dec; current = current->parent)
+      index = current->columnsParent[index];
+    submatrix->columns[column] = index;
+  }
+  CMR_CALL( CMRsortSubmatrix(cmr, submatrix) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Carries out \ref CMRtestTotalUnimodularity once its deadline was set.
+ */
+
+static
+CMR_ERROR testTotalUnimodularity(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,         /**< Matrix \f$ M \f$. */
+  bool* pisTotallyUnimodular, /**< Pointer for storing whether \f$ M \f$ is totally unimodular. */
+  CMR_DEC** pdec,             /**< Pointer for storing the decomposition tree (may be \c NULL). */
+  CMR_SUBMAT** psubmatrix,    /**< Pointer for storing a minimal non-totally unimodular submatrix (may be \c NULL). */
+  CMR_TU_PARAMETERS* params,  /**< Parameters for the computation (may be \c NULL for defaults). */
+  CMR_TU_STATISTICS* stats    /**< Statistics for the computation (may be \c NULL). */
+)
 {
   assert(cmr);
   assert(matrix);
@@ -110,10 +265,18 @@ CMR_ERROR CMRtestTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotal
 
   clock_t totalClock = clock();
   if (!CMRchrmatIsTernary(cmr, matrix, psubmatrix))
+  {
+    *pisTotallyUnimodular = false;
+    if (stats)
+    {
+      stats->totalCount++;
+      stats->totalTime += (clock() - totalClock) * 1.0 / CLOCKS_PER_SEC;
+    }
     return CMR_OKAY;
+  }
 
   CMR_CALL( CMRtestCamionSigned(cmr, matrix, pisTotallyUnimodular, psubmatrix, stats ? &stats->camion : NULL,
-    timeLimit) );
+    DBL_MAX) );
 
   if (!*pisTotallyUnimodular)
   {
@@ -125,19 +288,46 @@ CMR_ERROR CMRtestTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotal
     return CMR_OKAY;
   }
 
-  // TODO: run regularity check with ternary = true.
+  /* Since the matrix is Camion-signed, it is totally unimodular if and only if its support is regular. Hence, the
+   * signs need not be considered anymore. */
 
-  double remainingTime = timeLimit - ((clock() - totalClock) * 1.0 / CLOCKS_PER_SEC);
-  CMR_CALL( CMRtestRegular(cmr, matrix, false, pisTotallyUnimodular, pdec, NULL, &params->regular,
-    stats ? &stats->regular : NULL, remainingTime) );
+  CMR_DEC* dec = NULL;
+  CMR_CALL( CMRtestRegular(cmr, matrix, false, pisTotallyUnimodular, (pdec || psubmatrix) ? &dec : NULL, NULL,
+    &params->regular, stats ? &stats->regular : NULL) );
 
   if (!*pisTotallyUnimodular && psubmatrix)
   {
     assert(!*psubmatrix);
-    remainingTime = timeLimit - (clock() - totalClock) * 1.0 / CLOCKS_PER_SEC;
-    CMR_CALL( CMRtestHereditaryPropertySimple(cmr, matrix, tuTest, stats, psubmatrix, remainingTime) );
+
+    /* The search is restricted to the smallest irregular submatrix displayed by the decomposition. */
+    CMR_SUBMAT* irregularSubmatrix = NULL;
+    CMR_CALL( findIrregularSubmatrix(cmr, dec, &irregularSubmatrix) );
+    CMR_CHRMAT* irregularMatrix = NULL;
+    if (irregularSubmatrix)
+      CMR_CALL( CMRchrmatZoomSubmat(cmr, matrix, irregularSubmatrix, &irregularMatrix) );
+
+    TuTestData testData = { stats, false };
+    CMR_CALL( CMRtestHereditaryProperty(cmr, irregularMatrix ? irregularMatrix : matrix, HEREDITARY_PROPERTY_GROUP,
+      tuTest, &testData, psubmatrix) );
+
+    if (irregularSubmatrix)
+    {
+      CMR_SUBMAT* submatrix = *psubmatrix;
+      for (size_t r = 0; r < submatrix->numRows; ++r)
+        submatrix->rows[r] = irregularSubmatrix->rows[submatrix->rows[r]];
+      for (size_t c = 0; c < submatrix->numColumns; ++c)
+        submatrix->columns[c] = irregularSubmatrix->columns[submatrix->columns[c]];
+      CMR_CALL( CMRsortSubmatrix(cmr, submatrix) );
+      CMR_CALL( CMRchrmatFree(cmr, &irregularMatrix) );
+      CMR_CALL( CMRsubmatFree(cmr, &irregularSubmatrix) );
+    }
   }
 
+  if (pdec)
+    *pdec = dec;
+  else if (dec)
+    CMR_CALL( CMRdecFree(cmr, &dec) );
+
   if (stats)
   {
     stats->totalCount++;
@@ -146,3 +336,156 @@ CMR_ERROR CMRtestTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotal
 
   return CMR_OKAY;
 }
+
+/**
+ * \brief Carries out \ref testTotalUnimodularity unless the result cache of \p cmr knows the answer.
+ *
+ * The cache is only used if neither a decomposition nor a submatrix is requested.
+ */
+
+static
+CMR_ERROR testTotalUnimodularityCached(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,         /**< Matrix \f$ M \f$. */
+  bool* pisTotallyUnimodular, /**< Pointer for storing whether \f$ M \f$ is totally unimodular. */
+  CMR_DEC** pdec,             /**< Pointer for storing the decomposition tree (may be \c NULL). */
+  CMR_SUBMAT** psubmatrix,    /**< Pointer for storing a minimal non-totally unimodular submatrix (may be \c NULL). */
+  CMR_TU_PARAMETERS* params,  /**< Parameters for the computation (may be \c NULL for defaults). */
+  CMR_TU_STATISTICS* stats    /**< Statistics for the computation (may be \c NULL). */
+)
+{
+  if (pdec || psubmatrix || !CMRresultCacheEnabled(cmr))
+    return testTotalUnimodularity(cmr, matrix, pisTotallyUnimodular, pdec, psubmatrix, params, stats);
+
+  CMR_RESULT_KEY key;
+  bool found;
+  CMR_CALL( CMRresultCacheLookup(cmr, matrix, CMR_RESULT_TOTALLY_UNIMODULAR, &key, &found, pisTotallyUnimodular) );
+  if (found)
+  {
+    if (stats)
+      stats->cacheHitCount++;
+    return CMR_OKAY;
+  }
+  if (stats)
+    stats->cacheMissCount++;
+
+  CMR_ERROR error = testTotalUnimodularity(cmr, matrix, pisTotallyUnimodular, NULL, NULL, params, stats);
+
+  /* A cancelled or timed-out test may return early with a meaningless answer. */
+  if (error == CMR_OKAY && !CMRtaskIsCancelled(cmr) && !CMRdeadlineExpired(cmr))
+    CMR_CALL( CMRresultCacheStore(cmr, &key, *pisTotallyUnimodular) );
+  else
+    CMR_CALL( CMRresultCacheDiscard(cmr, &key) );
+
+  return error;
+}
+
+CMR_ERROR CMRtestTotalUnimodularity(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotallyUnimodular, CMR_DEC** pdec,
+  CMR_SUBMAT** psubmatrix, CMR_TU_PARAMETERS* params, CMR_TU_STATISTICS* stats, double timeLimit)
+{
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_ERROR error = testTotalUnimodularityCached(cmr, matrix, pisTotallyUnimodular, pdec, psubmatrix, params,
+    stats);
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  return error;
+}
+
+/**
+ * \brief Data of a task that tests matrices of a batch for total unimodularity until none is left.
+ */
+
+typedef struct
+{
+  CMR_CHRMAT** matrices;      /**< \brief Array with the matrices of the batch (shared). */
+  CMR_TU_RESULT* results;     /**< \brief Array for storing the results (shared). */
+  size_t numMatrices;         /**< \brief Number of matrices of the batch. */
+  size_t* pnext;              /**< \brief Index of the next matrix to be tested (shared). */
+  CMR_TU_PARAMETERS* params;  /**< \brief Parameters for the computation. */
+  CMR_TU_STATISTICS stats;    /**< \brief Statistics of this task; merged into the caller's afterwards. */
+  bool collectStats;          /**< \brief Whether \ref stats shall be collected. */
+} BatchTask;
+
+/**
+ * \brief Task function that tests the next matrix of a batch until all matrices were taken.
+ *
+ * Taking the matrices one by one balances the load also if their sizes differ a lot.
+ */
+
+static
+CMR_ERROR testBatchTask(
+  CMR* cmr,   /**< \ref CMR environment of the executing thread. */
+  void* data  /**< Pointer to \ref BatchTask. */
+)
+{
+  BatchTask* task = (BatchTask*) data;
+
+  size_t index;
+  while ((index = __atomic_fetch_add(task->pnext, 1, __ATOMIC_RELAXED)) < task->numMatrices)
+  {
+    if (CMRtaskIsCancelled(cmr))
+      break;
+    if (CMRdeadlineExpired(cmr))
+      return CMR_ERROR_TIMEOUT;
+
+    CMR_TU_RESULT* result = &task->results[index];
+    double startTime = CMRwallClock();
+    CMR_CALL( testTotalUnimodularityCached(cmr, task->matrices[index], &result->isTotallyUnimodular, NULL, NULL,
+      task->params, task->collectStats ? &task->stats : NULL) );
+    result->time = CMRwallClock() - startTime;
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRtestTotalUnimodularityBatch(CMR* cmr, size_t numMatrices, CMR_CHRMAT** matrices, CMR_TU_RESULT* results,
+  CMR_TU_PARAMETERS* params, CMR_TU_STATISTICS* stats, double timeLimit)
+{
+  assert(cmr);
+  assert(matrices || !numMatrices);
+  assert(results || !numMatrices);
+
+  if (numMatrices == 0)
+    return CMR_OKAY;
+
+  /* One task per worker; each of them tests matrices until none is left. */
+  size_t numTasks = CMRthreadpoolSize(cmr);
+  if (numTasks > numMatrices)
+    numTasks = numMatrices;
+  BatchTask* tasks = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &tasks, numTasks) );
+  size_t next = 0;
+  for (size_t t = 0; t < numTasks; ++t)
+  {
+    BatchTask* task = &tasks[t];
+    task->matrices = matrices;
+    task->results = results;
+    task->numMatrices = numMatrices;
+    task->pnext = &next;
+    task->params = params;
+    task->collectStats = stats;
+    if (stats)
+      CMR_CALL( CMRstatsTotalUnimodularityInit(&task->stats) );
+  }
+
+  double previousDeadline = CMRdeadlineEnter(cmr, timeLimit);
+  CMR_TASK_GROUP group;
+  CMR_ERROR error = CMRtaskGroupInit(cmr, &group);
+  for (size_t t = 0; t < numTasks && error == CMR_OKAY; ++t)
+    error = CMRtaskSpawn(cmr, &group, testBatchTask, &tasks[t]);
+
+  /* The tasks refer to this stack frame, so we must wait for them, even after an error. */
+  if (error != CMR_OKAY)
+    CMRtaskGroupCancel(&group);
+  CMR_ERROR taskError = CMRtaskWait(cmr, &group);
+  if (error == CMR_OKAY)
+    error = taskError;
+  CMRdeadlineLeave(cmr, previousDeadline);
+
+  for (size_t t = 0; t < numTasks && stats; ++t)
+    CMR_CALL( CMRstatsTotalUnimodularityAdd(stats, &tasks[t].stats) );
+
+  CMR_CALL( CMRfreeBlockArray(cmr, &tasks) );
+
+  return error;
+}
@@ -0,0 +1,17 @@
+#ifndef CMR_TU_INTERNAL_H
+#define CMR_TU_INTERNAL_H
+
+#include <cmr/tu.h>
+
+/**
+ * \brief Adds the statistics \p other to \p stats.
+ *
+ * Used to merge statistics of computations that ran in parallel.
+ */
+
+CMR_ERROR CMRstatsTotalUnimodularityAdd(
+  CMR_TU_STATISTICS* stats, /**< Statistics to add to. */
+  CMR_TU_STATISTICS* other  /**< Statistics to be added. */
+);
+
+#endif /* CMR_TU_INTERNAL_H */
@@ -19,6 +19,7 @@ typedef enum
   FILEFORMAT_UNDEFINED = 0,       /**< Whether the file format of input/output was defined by the user. */
   FILEFORMAT_MATRIX_DENSE = 1,    /**< Dense matrix format. */
   FILEFORMAT_MATRIX_SPARSE = 2,   /**< Sparse matrix format. */
+  FILEFORMAT_MATRIX_BINARY = 3,   /**< Binary matrix format. */
 } FileFormat;
 
 /**
@@ -49,6 +50,8 @@ CMR_ERROR checkCamionSigned(
     CMR_CALL( CMRchrmatCreateFromDenseStream(cmr, inputMatrixFile, &matrix) );
   else if (inputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatCreateFromSparseStream(cmr, inputMatrixFile, &matrix) );
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatCreateFromBinaryStream(cmr, inputMatrixFile, &matrix) );
   if (inputMatrixFile != stdin)
     fclose(inputMatrixFile);
   fprintf(stderr, "Read %lux%lu matrix with %lu nonzeros in %f seconds.\n", matrix->numRows, matrix->numColumns,
@@ -119,6 +122,8 @@ CMR_ERROR computeCamionSigned(
     CMR_CALL( CMRchrmatCreateFromDenseStream(cmr, inputMatrixFile, &matrix) );
   else if (inputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatCreateFromSparseStream(cmr, inputMatrixFile, &matrix) );
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatCreateFromBinaryStream(cmr, inputMatrixFile, &matrix) );
   if (inputMatrixFile != stdin)
     fclose(inputMatrixFile);
   fprintf(stderr, "Read %lux%lu matrix with %lu nonzeros in %f seconds.\n", matrix->numRows, matrix->numColumns,
@@ -138,11 +143,14 @@ CMR_ERROR computeCamionSigned(
   FILE* outputMatrixFile = outputMatrixToFile ? fopen(outputMatrixFileName, "w") : stdout;
   fprintf(stderr, "Writing Camion-signed matrix to %s%s%s in %s format.\n", outputMatrixToFile ? "file <" : "",
     outputMatrixToFile ? outputMatrixFileName : "stdout", outputMatrixToFile ? ">" : "",
-    outputFormat == FILEFORMAT_MATRIX_DENSE ? "dense" : "sparse");
+    outputFormat == FILEFORMAT_MATRIX_DENSE ? "dense" :
+    (outputFormat == FILEFORMAT_MATRIX_SPARSE ? "sparse" : "binary"));
   if (outputFormat == FILEFORMAT_MATRIX_DENSE)
     CMR_CALL( CMRchrmatPrintDense(cmr, matrix, outputMatrixFile, '0', false) );
   else if (outputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatPrintSparse(cmr, matrix, outputMatrixFile) );
+  else if (outputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatPrintBinary(cmr, matrix, outputMatrixFile) );
   else
     assert(false);
   if (outputMatrixToFile)
@@ -173,10 +181,10 @@ int printUsage(const char* program)
   fputs("Options specific to (1):\n", stderr);
   fputs("  -N NON-SUB   Write a minimal non-Camion submatrix to file NON-SUB; default: skip computation.\n\n", stderr);
   fputs("Options specific to (2):\n", stderr);
-  fputs("  -o FORMAT    Format of file OUT-MAT, among `dense' and `sparse'; default: same as format of IN-MAT.\n\n",
+  fputs("  -o FORMAT    Format of file OUT-MAT, among `dense', `sparse' and `binary'; default: same as format of IN-MAT.\n\n",
     stderr);
   fputs("Common options:\n", stderr);
-  fputs("  -i FORMAT    Format of file IN-MAT, among `dense' and `sparse'; default: dense.\n", stderr);
+  fputs("  -i FORMAT    Format of file IN-MAT, among `dense', `sparse' and `binary'; default: dense.\n", stderr);
   fputs("  -s           Print statistics about the computation to stderr.\n\n", stderr);
   fputs("Advanced options:\n", stderr);
   fputs("  --time-limit LIMIT   Allow at most LIMIT seconds for the computation.\n\n", stderr);
@@ -219,6 +227,8 @@ int main(int argc, char** argv)
         inputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         inputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        inputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: Unknown input file format <%s>.\n\n", argv[a+1]);
@@ -232,6 +242,8 @@ int main(int argc, char** argv)
         outputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         outputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        outputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: Unknown output format <%s>.\n\n", argv[a+1]);
@@ -19,6 +19,7 @@ typedef enum
   FILEFORMAT_UNDEFINED = 0,
   FILEFORMAT_MATRIX_DENSE = 1,    /**< Dense matrix format. */
   FILEFORMAT_MATRIX_SPARSE = 2,   /**< Sparse matrix format. */
+  FILEFORMAT_MATRIX_BINARY = 3,   /**< Binary matrix format. */
 } FileFormat;
 
 /**
@@ -33,6 +34,7 @@ CMR_ERROR testComplementTotalUnimodularity(
   char* outputOperationsFileName,   /**< File name for the operations; may be `-' for stdout. */
   char* outputMatrixFileName,       /**< File name for the matrix; may be `-' for stdout. */
   bool printStats,                  /**< Whether to print statistics to stderr. */
+  int numThreads,                   /**< Number of threads to use. */
   double timeLimit                  /**< Time limit to impose. */
 )
 {
@@ -43,6 +45,7 @@ CMR_ERROR testComplementTotalUnimodularity(
 
   CMR* cmr = NULL;
   CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
 
   /* Read matrix. */
 
@@ -51,6 +54,8 @@ CMR_ERROR testComplementTotalUnimodularity(
     CMR_CALL( CMRchrmatCreateFromDenseStream(cmr, inputMatrixFile, &matrix) );
   else if (inputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatCreateFromSparseStream(cmr, inputMatrixFile, &matrix) );
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatCreateFromBinaryStream(cmr, inputMatrixFile, &matrix) );
   if (inputMatrixFile != stdin)
     fclose(inputMatrixFile);
   fprintf(stderr, "Read %lux%lu matrix with %lu nonzeros in %f seconds.\n", matrix->numRows, matrix->numColumns,
@@ -63,7 +68,8 @@ CMR_ERROR testComplementTotalUnimodularity(
   size_t complementColumn = SIZE_MAX;
   CMR_CTU_STATISTICS stats;
   CMR_CALL( CMRstatsComplementTotalUnimodularityInit(&stats) );
-  CMR_CALL( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, &complementRow, &complementColumn, &stats) );
+  CMR_CALL( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, &complementRow, &complementColumn, &stats,
+    timeLimit) );
 
   fprintf(stderr, "Matrix %scomplement totally unimodular.\n", isCTU ? "IS " : "IS NOT ");
   if (printStats)
@@ -93,7 +99,9 @@ CMR_ERROR testComplementTotalUnimodularity(
       FILE* outputMatrixFile = outputMatrixToFile ? fopen(outputMatrixFileName, "w") : stdout;
       fprintf(stderr, "Writing complemented non-totally unimodular matrix to %s%s%s in %s format.\n",
         outputMatrixToFile ? "file <" : "", outputMatrixToFile ? outputMatrixFileName : "stdout",
-        outputMatrixToFile ? ">" : "", outputFormat == FILEFORMAT_MATRIX_DENSE ? "dense" : "sparse");
+        outputMatrixToFile ? ">" : "",
+        outputFormat == FILEFORMAT_MATRIX_DENSE ? "dense" :
+        (outputFormat == FILEFORMAT_MATRIX_SPARSE ? "sparse" : "binary"));
 
       CMR_CHRMAT* complemented = NULL;
       CMR_CALL( CMRcomplementRowColumn(cmr, matrix, complementRow, complementColumn, &complemented) );
@@ -102,6 +110,8 @@ CMR_ERROR testComplementTotalUnimodularity(
         CMR_CALL( CMRchrmatPrintDense(cmr, complemented, stdout, '0', false) );
       else if (outputFormat == FILEFORMAT_MATRIX_SPARSE)
         CMR_CALL( CMRchrmatPrintSparse(cmr, complemented, stdout) );
+      else if (outputFormat == FILEFORMAT_MATRIX_BINARY)
+        CMR_CALL( CMRchrmatPrintBinary(cmr, complemented, stdout) );
       else
         assert(false);
   
@@ -148,6 +158,8 @@ CMR_ERROR complementMatrix(
     CMR_CALL( CMRchrmatCreateFromDenseStream(cmr, inputMatrixFile, &matrix) );
   else if (inputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatCreateFromSparseStream(cmr, inputMatrixFile, &matrix) );
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatCreateFromBinaryStream(cmr, inputMatrixFile, &matrix) );
   if (inputMatrixFile != stdin)
     fclose(inputMatrixFile);
   fprintf(stderr, "Read %lux%lu matrix with %lu nonzeros.\n", matrix->numRows, matrix->numColumns,
@@ -161,12 +173,16 @@ CMR_ERROR complementMatrix(
   FILE* outputMatrixFile = outputMatrixToFile ? fopen(outputMatrixFileName, "w") : stdout;
   fprintf(stderr, "Writing complemented matrix to %s%s%s in %s format.\n",
     outputMatrixToFile ? "file <" : "", outputMatrixToFile ? outputMatrixFileName : "stdout",
-    outputMatrixToFile ? ">" : "", outputFormat == FILEFORMAT_MATRIX_DENSE ? "dense" : "sparse");
+    outputMatrixToFile ? ">" : "",
+    outputFormat == FILEFORMAT_MATRIX_DENSE ? "dense" :
+    (outputFormat == FILEFORMAT_MATRIX_SPARSE ? "sparse" : "binary"));
 
   if (outputFormat == FILEFORMAT_MATRIX_DENSE)
     CMR_CALL( CMRchrmatPrintDense(cmr, complemented, outputMatrixFile, '0', false) );
   else if (outputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatPrintSparse(cmr, complemented, outputMatrixFile) );
+  else if (outputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatPrintBinary(cmr, complemented, outputMatrixFile) );
 
   if (outputMatrixToFile)
     fclose(outputMatrixFile);
@@ -202,11 +218,12 @@ int printUsage(const char* program)
   fputs("  -r ROW    Apply row complement operation to row ROW.\n", stderr);
   fputs("  -c COLUMN Apply column complement operation to column COLUMN.\n", stderr);
   fputs("Common options:\n", stderr);
-  fputs("  -i FORMAT   Format of file IN-MAT, among `dense' and `sparse'; default: dense.\n", stderr);
-  fputs("  -o FORMAT   Format of file OUT-MAT, among `dense' and `sparse'; default: same as for IN-MAT.\n", stderr);
+  fputs("  -i FORMAT   Format of file IN-MAT, among `dense', `sparse' and `binary'; default: dense.\n", stderr);
+  fputs("  -o FORMAT   Format of file OUT-MAT, among `dense', `sparse' and `binary'; default: same as for IN-MAT.\n", stderr);
   fputs("  -s          Print statistics about the computation to stderr.\n\n", stderr);
   fputs("Advanced options:\n", stderr);
-  fputs("  --time-limit LIMIT   Allow at most LIMIT seconds for the computation.\n\n", stderr);
+  fputs("  --time-limit LIMIT   Allow at most LIMIT seconds for the computation.\n", stderr);
+  fputs("  --threads NUM        Use NUM threads for the computation; default: 1.\n\n", stderr);
   fputs("If IN-MAT is `-' then the matrix is read from stdin.\n", stderr);
   fputs("If OUT-OPS or OUT-MAT is `-` then the list of operations (resp. the matrix) is written to stdout.\n", stderr);
 
@@ -225,6 +242,7 @@ int main(int argc, char** argv)
   char* outputOperationsFileName = NULL;
   bool printStats = false;
   double timeLimit = DBL_MAX;
+  int numThreads = 1;
   for (int a = 1; a < argc; ++a)
   {
     if (!strcmp(argv[a], "-h"))
@@ -275,6 +293,8 @@ int main(int argc, char** argv)
         inputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         inputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        inputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: Unknown input file format <%s>.\n\n", argv[a+1]);
@@ -288,6 +308,8 @@ int main(int argc, char** argv)
         outputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         outputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        outputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: Unknown output format <%s>.\n\n", argv[a+1]);
@@ -304,6 +326,15 @@ int main(int argc, char** argv)
       }
       ++a;
     }
+    else if (!strcmp(argv[a], "--threads") && (a+1 < argc))
+    {
+      if (sscanf(argv[a+1], "%d", &numThreads) == 0 || numThreads <= 0)
+      {
+        fprintf(stderr, "Error: Invalid number of threads <%s> specified.\n\n", argv[a+1]);
+        return printUsage(argv[0]);
+      }
+      ++a;
+    }
     else if (!inputMatrixFileName)
       inputMatrixFileName = argv[a];
     else if (!outputMatrixFileName)
@@ -334,7 +365,7 @@ int main(int argc, char** argv)
   if (task == TASK_RECOGNIZE)
   {
     error = testComplementTotalUnimodularity(inputMatrixFileName, inputFormat, outputFormat, outputOperationsFileName,
-      outputMatrixFileName, printStats, timeLimit);
+      outputMatrixFileName, printStats, numThreads, timeLimit);
   }
   else
   {
@@ -351,6 +382,9 @@ int main(int argc, char** argv)
   case CMR_ERROR_MEMORY:
     puts("Memory error.");
     return EXIT_FAILURE;
+  case CMR_ERROR_TIMEOUT:
+    puts("Time limit exceeded.");
+    return EXIT_FAILURE;
   default:
     return EXIT_SUCCESS;
   }
@@ -12,6 +12,7 @@ typedef enum
   FILEFORMAT_UNDEFINED = 0,       /**< Whether the file format of input/output was defined by the user. */
   FILEFORMAT_MATRIX_DENSE = 1,    /**< Dense matrix format. */
   FILEFORMAT_MATRIX_SPARSE = 2,   /**< Sparse matrix format. */
+  FILEFORMAT_MATRIX_BINARY = 3,   /**< Binary matrix format. */
 } FileFormat;
 
 /**
@@ -29,7 +30,7 @@ int printUsage(const char* program)
   puts("  -t         Test the transpose matrix instead.");
   puts("  -s         Test for strong k-modularity.");
   puts("  -u         Test only for unimodularity, i.e., 1-modularity.");
-  puts("Formats for matrices: dense, sparse");
+  puts("Formats for matrices: dense, sparse, binary");
   puts("If FILE is `-', then the input will be read from stdin.");
 
   return EXIT_FAILURE;
@@ -66,6 +67,8 @@ CMR_ERROR testKmodularity(
     CMR_CALL( CMRchrmatCreateFromDenseStream(cmr, instanceFile, &matrix) );
   else if (inputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatCreateFromSparseStream(cmr, instanceFile, &matrix) );
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatCreateFromBinaryStream(cmr, instanceFile, &matrix) );
   if (instanceFile != stdin)
     fclose(instanceFile);
   fprintf(stderr, "Read %lux%lu matrix with %lu nonzeros.\n", matrix->numRows, matrix->numColumns,
@@ -163,6 +166,8 @@ int main(int argc, char** argv)
         inputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         inputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        inputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         printf("Error: unknown input file format <%s>.\n\n", argv[a+1]);
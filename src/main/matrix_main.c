@@ -16,7 +16,8 @@ typedef enum
 {
   FILEFORMAT_UNDEFINED = 0,     /**< Whether the file format of input/output was defined by the user. */
   FILEFORMAT_MATRIX_DENSE = 1,  /**< Dense matrix format. */
-  FILEFORMAT_MATRIX_SPARSE = 2  /**< Sparse matrix format. */
+  FILEFORMAT_MATRIX_SPARSE = 2, /**< Sparse matrix format. */
+  FILEFORMAT_MATRIX_BINARY = 3  /**< Binary matrix format. */
 } FileFormat;
 
 static
@@ -39,6 +40,8 @@ CMR_ERROR writeToFileDbl(CMR* cmr, CMR_DBLMAT* matrix, FileFormat outputFormat,
     CMR_CALL( CMRdblmatPrintSparse(cmr, output, outputMatrixFile) );
   else if (outputFormat == FILEFORMAT_MATRIX_DENSE)
     CMR_CALL( CMRdblmatPrintDense(cmr, output, outputMatrixFile, '0', false) );
+  else if (outputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRdblmatPrintBinary(cmr, output, outputMatrixFile) );
   else
     error = CMR_ERROR_INPUT;
 
@@ -71,6 +74,8 @@ CMR_ERROR writeToFileInt(CMR* cmr, CMR_INTMAT* matrix, FileFormat outputFormat,
     CMR_CALL( CMRintmatPrintSparse(cmr, output, outputMatrixFile) );
   else if (outputFormat == FILEFORMAT_MATRIX_DENSE)
     CMR_CALL( CMRintmatPrintDense(cmr, output, outputMatrixFile, '0', false) );
+  else if (outputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRintmatPrintBinary(cmr, output, outputMatrixFile) );
   else
     error = CMR_ERROR_INPUT;
 
@@ -103,6 +108,8 @@ CMR_ERROR writeToFileChr(CMR* cmr, CMR_CHRMAT* matrix, FileFormat outputFormat,
     CMR_CALL( CMRchrmatPrintSparse(cmr, output, outputMatrixFile) );
   else if (outputFormat == FILEFORMAT_MATRIX_DENSE)
     CMR_CALL( CMRchrmatPrintDense(cmr, output, outputMatrixFile, '0', false) );
+  else if (outputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatPrintBinary(cmr, output, outputMatrixFile) );
   else
     error = CMR_ERROR_INPUT;
 
@@ -137,6 +144,8 @@ CMR_ERROR runDbl(
     CMR_CALL( CMRdblmatCreateFromSparseStream(cmr, inputMatrixFile, &matrix) );
   else if (inputFormat == FILEFORMAT_MATRIX_DENSE)
     CMR_CALL( CMRdblmatCreateFromDenseStream(cmr, inputMatrixFile, &matrix) );
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRdblmatCreateFromBinaryStream(cmr, inputMatrixFile, &matrix) );
   else
     return CMR_ERROR_INPUT;
   if (inputMatrixFile != stdin)
@@ -240,6 +249,12 @@ CMR_ERROR runInt(
     if (error == CMR_ERROR_INPUT)
       fprintf(stderr, "Error when reading sparse matrix from <%s>: %s\n", inputMatrixFileName, CMRgetErrorMessage(cmr));
   }
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+  {
+    error = CMRintmatCreateFromBinaryStream(cmr, inputMatrixFile, &matrix);
+    if (error == CMR_ERROR_INPUT)
+      fprintf(stderr, "Error when reading binary matrix from <%s>: %s\n", inputMatrixFileName, CMRgetErrorMessage(cmr));
+  }
   else
     assert(false);
   if (inputMatrixFile != stdin)
@@ -320,8 +335,8 @@ int printUsage(const char* program)
   fprintf(stderr, "%s IN-MAT OUT-MAT [OPTION]...\n\n", program);
   fputs("  copies the matrix from file IN-MAT to file OUT-MAT, potentially applying certain operations.\n\n", stderr);
   fputs("Options:\n", stderr);
-  fputs("  -i FORMAT Format of file IN-MAT, among `dense' and `sparse'; default: dense.\n", stderr);
-  fputs("  -o FORMAT Format of file OUT-MAT, among `dense' and `sparse'; default: same format as of IN-MAT.\n", stderr);
+  fputs("  -i FORMAT Format of file IN-MAT, among `dense', `sparse' and `binary'; default: dense.\n", stderr);
+  fputs("  -o FORMAT Format of file OUT-MAT, among `dense', `sparse' and `binary'; default: same format as of IN-MAT.\n", stderr);
   fputs("  -S IN-SUB Consider the submatrix of IN-MAT specified in file IN-SUB instead of IN-MAT itself; can be combined with other operations.\n",
     stderr);
   fputs("  -t        Transpose the matrix; can be combined with other operations.\n", stderr);
@@ -357,6 +372,8 @@ int main(int argc, char** argv)
         inputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         inputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        inputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: Unknown input format <%s>.\n\n", argv[a+1]);
@@ -370,6 +387,8 @@ int main(int argc, char** argv)
         outputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         outputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        outputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: Unknown output format <%s>.\n\n", argv[a+1]);
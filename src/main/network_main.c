@@ -20,6 +20,7 @@ typedef enum
   FILEFORMAT_UNDEFINED = 0,     /**< Whether the file format of input/output was defined by the user. */
   FILEFORMAT_MATRIX_DENSE = 1,  /**< Dense matrix format. */
   FILEFORMAT_MATRIX_SPARSE = 2, /**< Sparse matrix format. */
+  FILEFORMAT_MATRIX_BINARY = 3, /**< Binary matrix format. */
 } FileFormat;
 
 /**
@@ -53,6 +54,8 @@ CMR_ERROR recognizeNetwork(
     CMR_CALL( CMRchrmatCreateFromDenseStream(cmr, inputFile, &matrix) );
   else if (inputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatCreateFromSparseStream(cmr, inputFile, &matrix) );
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatCreateFromBinaryStream(cmr, inputFile, &matrix) );
   if (inputFile != stdin)
     fclose(inputFile);
   fprintf(stderr, "Read %lux%lu matrix with %lu nonzeros in %f seconds.\n", matrix->numRows, matrix->numColumns,
@@ -105,7 +108,7 @@ CMR_ERROR recognizeNetwork(
             u = v;
             v = temp;
           }
-          fprintf(outputGraphFile, "%d %d c%ld\n", u, v, column+1);
+          fprintf(outputGraphFile, "%ld %ld c%ld\n", (long) u, (long) v, column+1);
         }
         for (size_t row = 0; row < matrix->numRows; ++row)
         {
@@ -118,7 +121,7 @@ CMR_ERROR recognizeNetwork(
             u = v;
             v = temp;
           }
-          fprintf(outputGraphFile, "%d %d r%ld\n", u, v, row+1);
+          fprintf(outputGraphFile, "%ld %ld r%ld\n", (long) u, (long) v, row+1);
         }
       }
       else
@@ -134,7 +137,7 @@ CMR_ERROR recognizeNetwork(
             u = v;
             v = temp;
           }
-          fprintf(outputGraphFile, "%d %d r%ld\n", u, v, row+1);
+          fprintf(outputGraphFile, "%ld %ld r%ld\n", (long) u, (long) v, row+1);
         }
         for (size_t column = 0; column < matrix->numColumns; ++column)
         {
@@ -147,7 +150,7 @@ CMR_ERROR recognizeNetwork(
             u = v;
             v = temp;
           }
-          fprintf(outputGraphFile, "%d %d c%ld\n", u, v, column+1);
+          fprintf(outputGraphFile, "%ld %ld c%ld\n", (long) u, (long) v, column+1);
         }
       }
       
@@ -182,7 +185,7 @@ CMR_ERROR recognizeNetwork(
           u = v;
           v = temp;
         }
-        fprintf(outputDotFile, " v_%d -> v_%d [label=\"%s\",style=bold,color=red];\n", u, v,
+        fprintf(outputDotFile, " v_%ld -> v_%ld [label=\"%s\",style=bold,color=red];\n", (long) u, (long) v,
           CMRelementString(CMRrowToElement(row), buffer));
       }
       for (size_t column = 0; column < matrix->numColumns; ++column)
@@ -196,7 +199,8 @@ CMR_ERROR recognizeNetwork(
           u = v;
           v = temp;
         }
-        fprintf(outputDotFile, " v_%d -> v_%d [label=\"%s\"];\n", u, v, CMRelementString(CMRcolumnToElement(column), buffer));
+        fprintf(outputDotFile, " v_%ld -> v_%ld [label=\"%s\"];\n", (long) u, (long) v,
+          CMRelementString(CMRcolumnToElement(column), buffer));
       }
       fputs("}\n", outputDotFile);
 
@@ -333,12 +337,16 @@ CMR_ERROR computeNetwork(
   FILE* outputMatrixFile = outputMatrixToFile ? fopen(outputMatrixFileName, "w") : stdout;
   fprintf(stderr, "Writing %snetwork matrix to %s%s%s in %s format.\n", conetwork ? "co" : "",
     outputMatrixToFile ? "file <" : "", outputMatrixToFile ? outputMatrixFileName : "stdout",
-    outputMatrixToFile ? ">" : "", outputFormat == FILEFORMAT_MATRIX_DENSE ? "dense" : "sparse");
+    outputMatrixToFile ? ">" : "",
+    outputFormat == FILEFORMAT_MATRIX_DENSE ? "dense" :
+    (outputFormat == FILEFORMAT_MATRIX_SPARSE ? "sparse" : "binary"));
 
   if (outputFormat == FILEFORMAT_MATRIX_DENSE)
     CMR_CALL( CMRchrmatPrintDense(cmr, matrix, outputMatrixFile, '0', false) );
   else if (outputFormat == FILEFORMAT_MATRIX_SPARSE)
     CMR_CALL( CMRchrmatPrintSparse(cmr, matrix, outputMatrixFile) );
+  else if (outputFormat == FILEFORMAT_MATRIX_BINARY)
+    CMR_CALL( CMRchrmatPrintBinary(cmr, matrix, outputMatrixFile) );
   else
     assert(false);
 
@@ -372,14 +380,14 @@ int printUsage(const char* program)
   fputs("  (2) computes a (co)network matrix corresponding to the digraph from file IN-GRAPH and writes it to OUT-MAT.\n\n\n",
     stderr);
   fputs("Options specific to (1):\n", stderr);
-  fputs("  -i FORMAT    Format of file IN-MAT, among `dense' and `sparse'; default: dense.\n", stderr);
+  fputs("  -i FORMAT    Format of file IN-MAT, among `dense', `sparse' and `binary'; default: dense.\n", stderr);
   fputs("  -t           Test for being conetwork; default: test for being network.\n", stderr);
   fputs("  -G OUT-GRAPH Write a digraph to file OUT-GRAPH; default: skip computation.\n", stderr);
   fputs("  -T OUT-TREE  Write a directed spanning tree to file OUT-TREE; default: skip computation.\n", stderr);
   fputs("  -D OUT-DOT   Write a dot file OUT-DOT with the digraph and the directed spanning tree; default: skip computation.\n", stderr);
   fputs("  -N NON-SUB   Write a minimal non-(co)network submatrix to file NON-SUB; default: skip computation.\n\n", stderr);
   fputs("Options specific to (2):\n", stderr);
-  fputs("  -o FORMAT    Format of file OUT-MAT, among `dense' and `sparse'; default: dense.\n", stderr);
+  fputs("  -o FORMAT    Format of file OUT-MAT, among `dense', `sparse' and `binary'; default: dense.\n", stderr);
   fputs("  -t           Return the transpose of the network matrix.\n", stderr);
   fputs("  -T IN-TREE   Read a directed tree from file IN-TREE; default: use first specified arcs as tree edges.\n\n", stderr);
   fputs("Common options:\n", stderr);
@@ -426,6 +434,8 @@ int main(int argc, char** argv)
         inputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         inputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        inputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: Unknown input file format <%s>.\n\n", argv[a+1]);
@@ -439,6 +449,8 @@ int main(int argc, char** argv)
         outputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         outputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        outputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: Unknown output format <%s>.\n\n", argv[a+1]);
@@ -11,6 +11,7 @@ typedef enum
 {
   FILEFORMAT_MATRIX_DENSE = 1,    /**< Dense matrix format. */
   FILEFORMAT_MATRIX_SPARSE = 2,   /**< Sparse matrix format. */
+  FILEFORMAT_MATRIX_BINARY = 3,   /**< Binary matrix format. */
 } FileFormat;
 
 /**
@@ -26,6 +27,7 @@ CMR_ERROR testRegularity(
   bool printStats,                  /**< Whether to print statistics to stderr. */
   bool directGraphicness,           /**< Whether to use fast graphicness routines. */
   bool seriesParallel,              /**< Whether to allow series-parallel operations in the decomposition tree. */
+  int numThreads,                   /**< Number of threads to use. */
   double timeLimit                  /**< Time limit to impose. */
 )
 {
@@ -39,6 +41,7 @@ CMR_ERROR testRegularity(
 
   CMR* cmr = NULL;
   CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
 
   /* Read matrix. */
 
@@ -56,6 +59,12 @@ CMR_ERROR testRegularity(
     if (error == CMR_ERROR_INPUT)
       fprintf(stderr, "Error when reading dense matrix from <%s>: %s\n", inputMatrixFileName, CMRgetErrorMessage(cmr));
   }
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+  {
+    error = CMRchrmatCreateFromBinaryStream(cmr, inputMatrixFile, &matrix);
+    if (error == CMR_ERROR_INPUT)
+      fprintf(stderr, "Error when reading binary matrix from <%s>: %s\n", inputMatrixFileName, CMRgetErrorMessage(cmr));
+  }
   else
     assert(false);
 
@@ -125,12 +134,13 @@ int printUsage(const char* program)
   fprintf(stderr, "%s IN-MAT [OPTION]...\n\n", program);
   fputs("  determines whether the matrix given in file IN-MAT is regular.\n\n", stderr);
   fputs("Options:\n", stderr);
-  fputs("  -i FORMAT    Format of file IN-MAT, among `dense' and `sparse'; default: dense.\n", stderr);
+  fputs("  -i FORMAT    Format of file IN-MAT, among `dense', `sparse' and `binary'; default: dense.\n", stderr);
   fputs("  -D OUT-DEC   Write a decomposition tree of the regular matroid to file OUT-DEC; default: skip computation.\n", stderr);
   fputs("  -N NON-MINOR Write a minimal non-regular minor to file NON-MINOR; default: skip computation.\n", stderr);
   fputs("  -s           Print statistics about the computation to stderr.\n\n", stderr);
   fputs("Advanced options:\n", stderr);
   fputs("  --time-limit LIMIT   Allow at most LIMIT seconds for the computation.\n", stderr);
+  fputs("  --threads NUM        Use NUM threads for the computation; default: 1.\n", stderr);
   fputs("  --no-direct-graphic  Check only 3-connected matrices for regularity.\n", stderr);
   fputs("  --no-series-parallel Do not allow series-parallel operations in decomposition tree.\n\n", stderr);
   fputs("If IN-MAT is `-' then the matrix is read from stdin.\n", stderr);
@@ -148,6 +158,7 @@ int main(int argc, char** argv)
   bool printStats = false;
   bool directGraphicness = true;
   bool seriesParallel = true;
+  int numThreads = 1;
   double timeLimit = DBL_MAX;
   for (int a = 1; a < argc; ++a)
   {
@@ -162,6 +173,8 @@ int main(int argc, char** argv)
         inputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         inputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        inputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         printf("Error: unknown input file format <%s>.\n\n", argv[a+1]);
@@ -188,6 +201,15 @@ int main(int argc, char** argv)
       }
       ++a;
     }
+    else if (!strcmp(argv[a], "--threads") && (a+1 < argc))
+    {
+      if (sscanf(argv[a+1], "%d", &numThreads) == 0 || numThreads <= 0)
+      {
+        fprintf(stderr, "Error: Invalid number of threads <%s> specified.\n\n", argv[a+1]);
+        return printUsage(argv[0]);
+      }
+      ++a;
+    }
     else if (!inputMatrixFileName)
       inputMatrixFileName = argv[a];
     else
@@ -205,7 +227,7 @@ int main(int argc, char** argv)
 
   CMR_ERROR error;
   error = testRegularity(inputMatrixFileName, inputFormat, outputTree, outputMinor, printStats, directGraphicness,
-    seriesParallel, timeLimit);
+    seriesParallel, numThreads, timeLimit);
 
   switch (error)
   {
@@ -11,6 +11,7 @@ typedef enum
 {
   FILEFORMAT_MATRIX_DENSE = 1,    /**< Dense matrix format. */
   FILEFORMAT_MATRIX_SPARSE = 2,   /**< Sparse matrix format. */
+  FILEFORMAT_MATRIX_BINARY = 3,   /**< Binary matrix format. */
 } FileFormat;
 
 /**
@@ -26,6 +27,7 @@ CMR_ERROR testTotalUnimodularity(
   bool printStats,                      /**< Whether to print statistics to stderr. */
   bool directGraphicness,               /**< Whether to use fast graphicness routines. */
   bool seriesParallel,                  /**< Whether to allow series-parallel operations in the decomposition tree. */
+  int numThreads,                       /**< Number of threads to use. */
   double timeLimit                      /**< Time limit to impose. */
 )
 {
@@ -39,6 +41,7 @@ CMR_ERROR testTotalUnimodularity(
 
   CMR* cmr = NULL;
   CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
 
   /* Read matrix. */
 
@@ -56,6 +59,12 @@ CMR_ERROR testTotalUnimodularity(
     if (error == CMR_ERROR_INPUT)
       fprintf(stderr, "Error when reading sparse matrix from <%s>: %s\n", inputMatrixFileName, CMRgetErrorMessage(cmr));
   }
+  else if (inputFormat == FILEFORMAT_MATRIX_BINARY)
+  {
+    error = CMRchrmatCreateFromBinaryStream(cmr, inputMatrixFile, &matrix);
+    if (error == CMR_ERROR_INPUT)
+      fprintf(stderr, "Error when reading binary matrix from <%s>: %s\n", inputMatrixFileName, CMRgetErrorMessage(cmr));
+  }
   else
     assert(false);
 
@@ -113,6 +122,147 @@ CMR_ERROR testTotalUnimodularity(
   return CMR_OKAY;
 }
 
+#define STREAM_BATCH_SIZE 1024 /**< Number of matrices of a stream that are tested jointly. */
+
+/**
+ * \brief Returns the current wall-clock time in seconds.
+ */
+
+static
+double wallClock(void)
+{
+  struct timespec now;
+  timespec_get(&now, TIME_UTC);
+  return now.tv_sec + now.tv_nsec * 1.0e-9;
+}
+
+/**
+ * \brief Returns \c true if \p stream has no further matrix.
+ */
+
+static
+bool streamEnded(
+  FILE* stream,     /**< File stream. */
+  bool skipSpace    /**< Whether whitespace between matrices shall be skipped. */
+)
+{
+  int c = getc(stream);
+  while (skipSpace && (c == ' ' || (c >= '\t' && c <= '\r')))
+    c = getc(stream);
+  if (c == EOF)
+    return true;
+
+  ungetc(c, stream);
+  return false;
+}
+
+/**
+ * \brief Tests a stream of concatenated matrices from a file for total unimodularity.
+ *
+ * The matrices are read and tested in batches of \ref STREAM_BATCH_SIZE, and one line is printed per matrix.
+ */
+
+static
+CMR_ERROR testTotalUnimodularityStream(
+  const char* inputMatrixFileName,  /**< File name containing the input matrices (may be `-' for stdin). */
+  FileFormat inputFormat,           /**< Format of the input matrices. */
+  bool printStats,                  /**< Whether to print statistics to stderr. */
+  bool directGraphicness,           /**< Whether to use fast graphicness routines. */
+  bool seriesParallel,              /**< Whether to allow series-parallel operations in the decomposition tree. */
+  int numThreads,                   /**< Number of threads to use. */
+  double timeLimit                  /**< Time limit to impose on all tests. */
+)
+{
+  FILE* inputMatrixFile = strcmp(inputMatrixFileName, "-") ? fopen(inputMatrixFileName, "r") : stdin;
+  if (!inputMatrixFile)
+  {
+    fprintf(stderr, "Unable to open file <%s>\n", inputMatrixFileName);
+    return CMR_ERROR_INPUT;
+  }
+
+  CMR* cmr = NULL;
+  CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+
+  CMR_TU_PARAMETERS params;
+  CMR_CALL( CMRparamsTotalUnimodularityInit(&params) );
+  params.regular.directGraphicness = directGraphicness;
+  params.regular.seriesParallel = seriesParallel;
+  CMR_TU_STATISTICS stats;
+  CMR_CALL( CMRstatsTotalUnimodularityInit(&stats));
+
+  CMR_CHRMAT** matrices = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &matrices, STREAM_BATCH_SIZE) );
+  CMR_TU_RESULT* results = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &results, STREAM_BATCH_SIZE) );
+
+  double deadline = timeLimit < DBL_MAX ? wallClock() + timeLimit : DBL_MAX;
+  size_t numTested = 0;
+  CMR_ERROR error = CMR_OKAY;
+  bool ended = false;
+  while (!ended && error == CMR_OKAY)
+  {
+    /* Read the next batch. */
+    size_t numMatrices = 0;
+    while (numMatrices < STREAM_BATCH_SIZE)
+    {
+      ended = streamEnded(inputMatrixFile, inputFormat != FILEFORMAT_MATRIX_BINARY);
+      if (ended)
+        break;
+
+      CMR_CHRMAT** pmatrix = &matrices[numMatrices];
+      *pmatrix = NULL;
+      if (inputFormat == FILEFORMAT_MATRIX_DENSE)
+        error = CMRchrmatCreateFromDenseStream(cmr, inputMatrixFile, pmatrix);
+      else if (inputFormat == FILEFORMAT_MATRIX_SPARSE)
+        error = CMRchrmatCreateFromSparseStream(cmr, inputMatrixFile, pmatrix);
+      else
+        error = CMRchrmatCreateFromBinaryStream(cmr, inputMatrixFile, pmatrix);
+      if (error != CMR_OKAY)
+      {
+        if (error == CMR_ERROR_INPUT)
+        {
+          fprintf(stderr, "Error when reading matrix #%lu from <%s>: %s\n", numTested + numMatrices + 1,
+            inputMatrixFileName, CMRgetErrorMessage(cmr));
+        }
+        /* The reader may have created the matrix before it failed. */
+        CMR_CALL( CMRchrmatFree(cmr, pmatrix) );
+        break;
+      }
+      ++numMatrices;
+    }
+
+    /* Test and report it. */
+    if (error == CMR_OKAY && numMatrices > 0)
+    {
+      double remainingTime = deadline < DBL_MAX ? deadline - wallClock() : DBL_MAX;
+      error = CMRtestTotalUnimodularityBatch(cmr, numMatrices, matrices, results, &params, &stats, remainingTime);
+      for (size_t i = 0; i < numMatrices && error == CMR_OKAY; ++i)
+      {
+        printf("Matrix #%lu %stotally unimodular; tested in %f seconds.\n", numTested + i + 1,
+          results[i].isTotallyUnimodular ? "IS " : "IS NOT ", results[i].time);
+      }
+      fflush(stdout);
+      numTested += numMatrices;
+    }
+
+    for (size_t i = 0; i < numMatrices; ++i)
+      CMR_CALL( CMRchrmatFree(cmr, &matrices[i]) );
+  }
+
+  if (inputMatrixFile != stdin)
+    fclose(inputMatrixFile);
+
+  if (printStats)
+    CMR_CALL( CMRstatsTotalUnimodularityPrint(stderr, &stats, NULL) );
+
+  CMR_CALL( CMRfreeBlockArray(cmr, &results) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &matrices) );
+  CMR_CALL( CMRfreeEnvironment(&cmr) );
+
+  return error;
+}
+
 /**
  * \brief Prints the usage of the \p program to stdout.
  * 
@@ -125,12 +275,15 @@ int printUsage(const char* program)
   fprintf(stderr, "%s IN-MAT [OPTION]...\n\n", program);
   fputs("  determines whether the matrix given in file IN-MAT is totally unimodular.\n\n", stderr);
   fputs("Options:\n", stderr);
-  fputs("  -i FORMAT  Format of file IN-MAT, among `dense' and `sparse'; default: dense.\n", stderr);
+  fputs("  -i FORMAT  Format of file IN-MAT, among `dense', `sparse' and `binary'; default: dense.\n", stderr);
   fputs("  -D OUT-DEC Write a decomposition tree of the underlying regular matroid to file OUT-DEC; default: skip computation.\n", stderr);
   fputs("  -N NON-SUB Write a minimal non-totally-unimodular submatrix to file NON-SUB; default: skip computation.\n", stderr);
   fputs("  -s         Print statistics about the computation to stderr.\n\n", stderr);
   fputs("Advanced options:\n", stderr);
   fputs("  --time-limit LIMIT   Allow at most LIMIT seconds for the computation.\n", stderr);
+  fputs("  --threads NUM        Use NUM threads for the computation; default: 1.\n", stderr);
+  fputs("  --stream             Test each matrix of a sequence of concatenated matrices in IN-MAT and print one line per\n", stderr);
+  fputs("                       matrix; cannot be combined with -D or -N.\n", stderr);
   fputs("  --no-direct-graphic  Check only 3-connected matrices for regularity.\n", stderr);
   fputs("  --no-series-parallel Do not allow series-parallel operations in decomposition tree.\n\n", stderr);
   fputs("If IN-MAT is `-' then the matrix is read from stdin.\n", stderr);
@@ -148,6 +301,8 @@ int main(int argc, char** argv)
   bool printStats = false;
   bool directGraphicness = true;
   bool seriesParallel = true;
+  int numThreads = 1;
+  bool stream = false;
   double timeLimit = DBL_MAX;
   for (int a = 1; a < argc; ++a)
   {
@@ -162,6 +317,8 @@ int main(int argc, char** argv)
         inputFormat = FILEFORMAT_MATRIX_DENSE;
       else if (!strcmp(argv[a+1], "sparse"))
         inputFormat = FILEFORMAT_MATRIX_SPARSE;
+      else if (!strcmp(argv[a+1], "binary"))
+        inputFormat = FILEFORMAT_MATRIX_BINARY;
       else
       {
         fprintf(stderr, "Error: unknown input file format <%s>.\n\n", argv[a+1]);
@@ -179,6 +336,8 @@ int main(int argc, char** argv)
       directGraphicness = false;
     else if (!strcmp(argv[a], "--no-series-parallel"))
       seriesParallel = false;
+    else if (!strcmp(argv[a], "--stream"))
+      stream = true;
     else if (!strcmp(argv[a], "--time-limit") && (a+1 < argc))
     {
       if (sscanf(argv[a+1], "%lf", &timeLimit) == 0 || timeLimit <= 0)
@@ -188,6 +347,15 @@ int main(int argc, char** argv)
       }
       ++a;
     }
+    else if (!strcmp(argv[a], "--threads") && (a+1 < argc))
+    {
+      if (sscanf(argv[a+1], "%d", &numThreads) == 0 || numThreads <= 0)
+      {
+        fprintf(stderr, "Error: Invalid number of threads <%s> specified.\n\n", argv[a+1]);
+        return printUsage(argv[0]);
+      }
+      ++a;
+    }
     else if (!inputMatrixFileName)
       inputMatrixFileName = argv[a];
     else
@@ -203,9 +371,23 @@ int main(int argc, char** argv)
     return printUsage(argv[0]);
   }
 
+  if (stream && (outputTree || outputSubmatrix))
+  {
+    fputs("Error: Options -D and -N cannot be combined with --stream.\n\n", stderr);
+    return printUsage(argv[0]);
+  }
+
   CMR_ERROR error;
-  error = testTotalUnimodularity(inputMatrixFileName, inputFormat, outputTree, outputSubmatrix, printStats,
-    directGraphicness, seriesParallel, timeLimit);
+  if (stream)
+  {
+    error = testTotalUnimodularityStream(inputMatrixFileName, inputFormat, printStats, directGraphicness,
+      seriesParallel, numThreads, timeLimit);
+  }
+  else
+  {
+    error = testTotalUnimodularity(inputMatrixFileName, inputFormat, outputTree, outputSubmatrix, printStats,
+      directGraphicness, seriesParallel, numThreads, timeLimit);
+  }
 
   switch (error)
   {
@@ -214,6 +396,9 @@ int main(int argc, char** argv)
   case CMR_ERROR_MEMORY:
     puts("Memory error.");
     return EXIT_FAILURE;
+  case CMR_ERROR_TIMEOUT:
+    puts("Time limit exceeded.");
+    return EXIT_FAILURE;
   default:
     return EXIT_SUCCESS;
   }
@@ -3,6 +3,8 @@
 #include "common.h"
 #include <cmr/camion.h>
 
+#include "../src/cmr/camion_internal.h"
+
 TEST(Camion, Change)
 {
   CMR* cmr = NULL;
@@ -96,3 +98,104 @@ TEST(Camion, Issue10)
 
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+TEST(Camion, ManySignChanges)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* A connected binary matrix with more nonzeros than fit into one word of packed signs. */
+  const size_t n = 20;
+  std::string dense = std::to_string(n) + " " + std::to_string(n) + " ";
+  size_t numNonzeros = 0;
+  for (size_t row = 0; row < n; ++row)
+  {
+    for (size_t column = 0; column < n; ++column)
+    {
+      bool nonzero = row == column || (row + 1) % n == column || (3 * row + 5 * column) % 7 < 2;
+      dense += nonzero ? "1 " : "0 ";
+      numNonzeros += nonzero ? 1 : 0;
+    }
+  }
+  ASSERT_GT(numNonzeros, 128UL);
+
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, dense.c_str()) );
+  CMR_CHRMAT* original = NULL;
+  ASSERT_CMR_CALL( CMRchrmatCopy(cmr, matrix, &original) );
+
+  bool alreadySigned;
+  ASSERT_CMR_CALL( CMRcomputeCamionSigned(cmr, matrix, &alreadySigned, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE(alreadySigned);
+
+  /* Only signs were changed, and the result is Camion-signed. */
+  ASSERT_EQ(matrix->numNonzeros, original->numNonzeros);
+  for (size_t entry = 0; entry < matrix->numNonzeros; ++entry)
+  {
+    ASSERT_EQ(matrix->entryColumns[entry], original->entryColumns[entry]);
+    ASSERT_EQ(abs(matrix->entryValues[entry]), 1);
+  }
+  ASSERT_CMR_CALL( CMRtestCamionSigned(cmr, matrix, &alreadySigned, NULL, NULL, DBL_MAX) );
+  ASSERT_TRUE(alreadySigned);
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &original) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Camion, WideIndices)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* Connected binary matrices with more columns than rows and vice versa. */
+  const size_t sizes[][2] = { { 14, 20 }, { 20, 14 } };
+  for (size_t s = 0; s < 2; ++s)
+  {
+    const size_t numRows = sizes[s][0];
+    const size_t numColumns = sizes[s][1];
+    std::string dense = std::to_string(numRows) + " " + std::to_string(numColumns) + " ";
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      for (size_t column = 0; column < numColumns; ++column)
+      {
+        bool nonzero = row == column || row == column + 1 || (3 * row + 5 * column) % 7 < 2;
+        dense += nonzero ? "1 " : "0 ";
+      }
+    }
+
+    CMR_CHRMAT* compact = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &compact, dense.c_str()) );
+    CMR_CHRMAT* wide = NULL;
+    ASSERT_CMR_CALL( CMRchrmatCopy(cmr, compact, &wide) );
+
+    bool compactSigned;
+    CMR_SUBMAT* compactViolator = NULL;
+    ASSERT_CMR_CALL( CMRcomputeCamionSigned(cmr, compact, &compactSigned, &compactViolator, NULL, DBL_MAX) );
+
+    /* The same signing with size_t indices. */
+    bool wideSigned;
+    CMR_SUBMAT* wideViolator = NULL;
+    ASSERT_CMR_CALL( CMRcomputeCamionSignedWideIndices(cmr, wide, &wideSigned, &wideViolator, NULL, DBL_MAX) );
+
+    ASSERT_FALSE( compactSigned );
+    ASSERT_EQ( wideSigned, compactSigned );
+    ASSERT_TRUE( CMRchrmatCheckEqual(wide, compact) );
+    ASSERT_TRUE( compactViolator != NULL );
+    ASSERT_TRUE( wideViolator != NULL );
+    ASSERT_EQ( wideViolator->numRows, compactViolator->numRows );
+    ASSERT_EQ( wideViolator->numColumns, compactViolator->numColumns );
+    for (size_t row = 0; row < compactViolator->numRows; ++row)
+      ASSERT_EQ( wideViolator->rows[row], compactViolator->rows[row] );
+    for (size_t column = 0; column < compactViolator->numColumns; ++column)
+      ASSERT_EQ( wideViolator->columns[column], compactViolator->columns[column] );
+
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &wideViolator) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &compactViolator) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &wide) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &compact) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -18,7 +18,7 @@ TEST(ComplementTotalUnimodularity, Examples)
     ) );
 
     bool isCTU;
-    ASSERT_CMR_CALL( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, NULL, NULL, NULL) );
+    ASSERT_CMR_CALL( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, NULL, NULL, NULL, DBL_MAX) );
     
     ASSERT_TRUE(isCTU);
     ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
@@ -36,7 +36,8 @@ TEST(ComplementTotalUnimodularity, Examples)
     bool isCTU;
     size_t complementRow;
     size_t complementColumn;
-    ASSERT_CMR_CALL( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, &complementRow, &complementColumn, NULL) );
+    ASSERT_CMR_CALL( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, &complementRow, &complementColumn, NULL,
+      DBL_MAX) );
     ASSERT_FALSE(isCTU);
     ASSERT_EQ(complementRow, 0);
     ASSERT_EQ(complementColumn, 0);
@@ -45,3 +46,149 @@ TEST(ComplementTotalUnimodularity, Examples)
 
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+TEST(ComplementTotalUnimodularity, Threads)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, " 6 6 "
+    "0 0 0 0 1 0 "
+    "0 1 0 1 0 0 "
+    "0 1 0 1 0 0 "
+    "0 0 1 0 0 1 "
+    "0 0 0 0 1 1 "
+    "0 0 0 1 0 1 "
+  ) );
+
+  /* The parallel sweep must return the first complement that a sequential one finds. */
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+  {
+    ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+
+    CMR_CTU_STATISTICS stats;
+    ASSERT_CMR_CALL( CMRstatsComplementTotalUnimodularityInit(&stats) );
+    bool isCTU;
+    size_t complementRow;
+    size_t complementColumn;
+    ASSERT_CMR_CALL( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, &complementRow, &complementColumn,
+      &stats, DBL_MAX) );
+    ASSERT_FALSE(isCTU);
+    ASSERT_EQ(complementRow, 3UL);
+    ASSERT_EQ(complementColumn, 2UL);
+    ASSERT_GE(stats.tu.totalCount, 3UL * 7 + 3);
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(ComplementTotalUnimodularity, Complement)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, " 3 4 "
+    "1 1 0 1 "
+    "1 1 1 0 "
+    "0 1 0 1 "
+  ) );
+
+  CMR_CHRMAT* rowComplement = NULL;
+  ASSERT_CMR_CALL( CMRcomplementRowColumn(cmr, matrix, 0, SIZE_MAX, &rowComplement) );
+  CMR_CHRMAT* check = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &check, " 3 4 "
+    "1 1 0 1 "
+    "0 0 1 1 "
+    "1 0 0 0 "
+  ) );
+  ASSERT_TRUE( CMRchrmatCheckEqual(rowComplement, check) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &check) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &rowComplement) );
+
+  CMR_CHRMAT* complement = NULL;
+  ASSERT_CMR_CALL( CMRcomplementRowColumn(cmr, matrix, 0, 1, &complement) );
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &check, " 3 4 "
+    "0 1 1 0 "
+    "0 0 1 1 "
+    "1 0 0 0 "
+  ) );
+  ASSERT_TRUE( CMRchrmatCheckEqual(complement, check) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &check) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &complement) );
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(ComplementTotalUnimodularity, TimeLimit)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, " 4 5 "
+    "1 0 0 1 1 "
+    "1 1 0 0 1 "
+    "0 1 1 0 1 "
+    "0 0 1 1 1 "
+  ) );
+
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+  {
+    ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+    bool isCTU;
+    ASSERT_EQ( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, NULL, NULL, NULL, 0.0), CMR_ERROR_TIMEOUT );
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(ComplementTotalUnimodularity, ResultCacheThreads)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR* reference = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&reference) );
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, " 6 6 "
+    "0 0 0 0 1 0 "
+    "0 1 0 1 0 0 "
+    "0 1 0 1 0 0 "
+    "0 0 1 0 0 1 "
+    "0 0 0 0 1 1 "
+    "0 0 0 1 0 1 "
+  ) );
+
+  /* Tests of complements that are cancelled by the parallel sweep must not leave answers in the cache. */
+  ASSERT_CMR_CALL( CMRsetResultCacheCapacity(cmr, 1024) );
+  ASSERT_CMR_CALL( CMRsetNumThreads(cmr, 4) );
+  for (int round = 0; round < 10; ++round)
+  {
+    bool isCTU;
+    ASSERT_CMR_CALL( CMRtestComplementTotalUnimodularity(cmr, matrix, &isCTU, NULL, NULL, NULL, DBL_MAX) );
+    ASSERT_FALSE(isCTU);
+  }
+  ASSERT_CMR_CALL( CMRsetNumThreads(cmr, 1) );
+
+  for (size_t row = 0; row <= matrix->numRows; ++row)
+  {
+    for (size_t column = 0; column <= matrix->numColumns; ++column)
+    {
+      CMR_CHRMAT* complement = NULL;
+      ASSERT_CMR_CALL( CMRcomplementRowColumn(cmr, matrix, row < matrix->numRows ? row : SIZE_MAX,
+        column < matrix->numColumns ? column : SIZE_MAX, &complement) );
+      bool isTU;
+      ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, complement, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+      bool isReferenceTU;
+      ASSERT_CMR_CALL( CMRtestTotalUnimodularity(reference, complement, &isReferenceTU, NULL, NULL, NULL, NULL,
+        DBL_MAX) );
+      ASSERT_EQ(isTU, isReferenceTU);
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &complement) );
+    }
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&reference) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
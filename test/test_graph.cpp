@@ -58,3 +58,24 @@ TEST(Graph, Modifications)
   
   CMRfreeEnvironment(&cmr);
 }
+
+TEST(Graph, IndexRange)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+#if defined(CMR_WITH_INDEX64)
+  ASSERT_EQ(sizeof(CMR_GRAPH_INDEX), 8UL);
+#else
+  ASSERT_EQ(sizeof(CMR_GRAPH_INDEX), sizeof(int));
+#endif /* CMR_WITH_INDEX64 */
+
+  /* Requests whose arcs cannot be indexed fail before anything is allocated. */
+  CMR_GRAPH* graph = NULL;
+  ASSERT_EQ(CMRgraphCreateEmpty(cmr, &graph, 1, (size_t) CMR_GRAPH_INDEX_MAX / 2 + 1), CMR_ERROR_OVERFLOW);
+  ASSERT_EQ(graph, (CMR_GRAPH*) NULL);
+  ASSERT_EQ(CMRgraphCreateEmpty(cmr, &graph, (size_t) CMR_GRAPH_INDEX_MAX + 1, 1), CMR_ERROR_OVERFLOW);
+  ASSERT_EQ(graph, (CMR_GRAPH*) NULL);
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
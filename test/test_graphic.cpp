@@ -47,12 +47,12 @@ void testBinaryGraphicMatrix(
 
     printf("Basis:");
     for (int r = 0; r < matrix->numRows; ++r)
-      printf(" %d", basis[r]);
+      printf(" %ld", (long) basis[r]);
     printf("\n");
 
     printf("Cobasis:");
     for (int c = 0; c < matrix->numColumns; ++c)
-      printf(" %d", cobasis[c]);
+      printf(" %ld", (long) cobasis[c]);
     printf("\n");
   }
 
@@ -1025,3 +1025,188 @@ TEST(Graphic, RepresentationMatrix)
   ASSERT_CMR_CALL( CMRgraphFree(cmr, &graph) );
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+static
+void testNonCographicSubmatrix(
+  CMR* cmr,           /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix  /**< Non-cographic matrix. */
+)
+{
+  bool isCographic;
+  CMR_SUBMAT* submatrix = NULL;
+  ASSERT_CMR_CALL( CMRtestCographicMatrix(cmr, matrix, &isCographic, NULL, NULL, NULL, &submatrix, NULL,
+    DBL_MAX) );
+  ASSERT_FALSE( isCographic );
+  ASSERT_TRUE( submatrix );
+
+  CMR_CHRMAT* violator = NULL;
+  ASSERT_CMR_CALL( CMRchrmatZoomSubmat(cmr, matrix, submatrix, &violator) );
+  ASSERT_CMR_CALL( CMRtestCographicMatrix(cmr, violator, &isCographic, NULL, NULL, NULL, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isCographic );
+
+  /* Removing any row or column must yield a cographic matrix. */
+  for (size_t removed = 0; removed < violator->numRows + violator->numColumns; ++removed)
+  {
+    bool removeRow = removed < violator->numRows;
+    CMR_SUBMAT* reducedSubmatrix = NULL;
+    ASSERT_CMR_CALL( CMRsubmatCreate(cmr, violator->numRows - (removeRow ? 1 : 0),
+      violator->numColumns - (removeRow ? 0 : 1), &reducedSubmatrix) );
+    size_t numRows = 0;
+    for (size_t row = 0; row < violator->numRows; ++row)
+    {
+      if (row != removed)
+        reducedSubmatrix->rows[numRows++] = row;
+    }
+    size_t numColumns = 0;
+    for (size_t column = 0; column < violator->numColumns; ++column)
+    {
+      if (violator->numRows + column != removed)
+        reducedSubmatrix->columns[numColumns++] = column;
+    }
+
+    CMR_CHRMAT* reduced = NULL;
+    ASSERT_CMR_CALL( CMRchrmatZoomSubmat(cmr, violator, reducedSubmatrix, &reduced) );
+    ASSERT_CMR_CALL( CMRtestCographicMatrix(cmr, reduced, &isCographic, NULL, NULL, NULL, NULL, NULL, DBL_MAX) );
+    ASSERT_TRUE( isCographic );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &reduced) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &reducedSubmatrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violator) );
+  ASSERT_CMR_CALL( CMRsubmatFree(cmr, &submatrix) );
+}
+
+TEST(Graphic, NonCographicSubmatrix)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* The upper left 5x4 submatrix represents K_{3,3}, which is not cographic. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "7 6 "
+    " 1 1 0 0 1 0 "
+    " 1 1 1 0 0 1 "
+    " 1 0 0 1 0 0 "
+    " 0 1 1 1 1 0 "
+    " 0 0 1 1 0 0 "
+    " 1 0 1 0 1 1 "
+    " 0 0 0 0 1 1 "
+  ) );
+
+  testNonCographicSubmatrix(cmr, matrix);
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Graphic, NonCographicSubmatrixLate)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* An interval matrix, which is cographic, followed by the rows of a K_{3,3} in disjoint columns. */
+  const size_t numIntervalRows = 40;
+  const size_t numColumns = 60;
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( CMRchrmatCreate(cmr, &matrix, numIntervalRows + 5, numColumns, 8 * numIntervalRows + 20) );
+  const char* k33[5] = { "110010", "111001", "100100", "011110", "001100" };
+  matrix->numNonzeros = 0;
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    matrix->rowSlice[row] = matrix->numNonzeros;
+    for (size_t column = 0; column < numColumns; ++column)
+    {
+      bool nonzero;
+      if (row < numIntervalRows)
+        nonzero = column >= row && column < row + 1 + row % 7;
+      else
+        nonzero = column >= numColumns - 6 && k33[row - numIntervalRows][column - numColumns + 6] == '1';
+      if (nonzero)
+      {
+        matrix->entryColumns[matrix->numNonzeros] = column;
+        matrix->entryValues[matrix->numNonzeros] = 1;
+        matrix->numNonzeros++;
+      }
+    }
+  }
+  matrix->rowSlice[matrix->numRows] = matrix->numNonzeros;
+
+  testNonCographicSubmatrix(cmr, matrix);
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+static void createIntervalMatrix(CMR* cmr, CMR_CHRMAT** pmatrix, size_t numRows, size_t numColumns)
+{
+  ASSERT_CMR_CALL( CMRchrmatCreate(cmr, pmatrix, numRows, numColumns, 7 * numRows) );
+  CMR_CHRMAT* matrix = *pmatrix;
+  matrix->numNonzeros = 0;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    matrix->rowSlice[row] = matrix->numNonzeros;
+    for (size_t column = row % numColumns; column < numColumns && column < row % numColumns + 1 + row % 7; ++column)
+    {
+      matrix->entryColumns[matrix->numNonzeros] = column;
+      matrix->entryValues[matrix->numNonzeros] = 1;
+      matrix->numNonzeros++;
+    }
+  }
+  matrix->rowSlice[numRows] = matrix->numNonzeros;
+}
+
+TEST(Graphic, ReuseWorkspace)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* Tests of matrices of very different sizes alternate, so the workspace is reused as well as replaced. */
+  const size_t sizes[7][2] = { {300, 400}, {5, 4}, {20, 30}, {1000, 600}, {7, 6}, {40, 40}, {3, 1} };
+  for (int round = 0; round < 2; ++round)
+  {
+    for (size_t i = 0; i < 7; ++i)
+    {
+      CMR_CHRMAT* matrix = NULL;
+      if (sizes[i][0] == 7 && sizes[i][1] == 6)
+      {
+        ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "7 6 "
+          " 1 1 0 0 1 0 "
+          " 1 1 1 0 0 1 "
+          " 1 0 0 1 0 0 "
+          " 0 1 1 1 1 0 "
+          " 0 0 1 1 0 0 "
+          " 1 0 1 0 1 1 "
+          " 0 0 0 0 1 1 "
+        ) );
+      }
+      else
+        createIntervalMatrix(cmr, &matrix, sizes[i][0], sizes[i][1]);
+
+      bool isCographic;
+      CMR_GRAPH* graph = NULL;
+      ASSERT_CMR_CALL( CMRtestCographicMatrix(cmr, matrix, &isCographic, &graph, NULL, NULL, NULL, NULL, DBL_MAX) );
+
+      /* Compare with a test in a fresh environment. */
+      CMR* freshCmr = NULL;
+      ASSERT_CMR_CALL( CMRcreateEnvironment(&freshCmr) );
+      bool freshIsCographic;
+      CMR_GRAPH* freshGraph = NULL;
+      ASSERT_CMR_CALL( CMRtestCographicMatrix(freshCmr, matrix, &freshIsCographic, &freshGraph, NULL, NULL, NULL,
+        NULL, DBL_MAX) );
+      ASSERT_EQ(isCographic, freshIsCographic);
+      ASSERT_EQ(isCographic, sizes[i][0] != 7);
+      if (isCographic)
+      {
+        ASSERT_EQ(CMRgraphNumNodes(graph), CMRgraphNumNodes(freshGraph));
+        ASSERT_EQ(CMRgraphNumEdges(graph), CMRgraphNumEdges(freshGraph));
+        ASSERT_CMR_CALL( CMRgraphFree(freshCmr, &freshGraph) );
+        ASSERT_CMR_CALL( CMRgraphFree(cmr, &graph) );
+      }
+      ASSERT_CMR_CALL( CMRfreeEnvironment(&freshCmr) );
+
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+    }
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <stdio.h>
+#include <limits.h>
 
 #include "common.h"
 #include <cmr/matrix.h>
@@ -97,6 +98,266 @@ TEST(Matrix, Read)
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
 
+TEST(Matrix, ReadNumbers)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  const char* input = "2 3\n"
+    "+1.5 0.0 -2e-1\n"
+    "0x10 -0 1.000000000000000000001\n";
+  FILE* stream = fmemopen((char*) input, strlen(input), "r");
+  CMR_DBLMAT* matrix = NULL;
+  ASSERT_CMR_CALL( CMRdblmatCreateFromDenseStream(cmr, stream, &matrix) );
+  fclose(stream);
+  ASSERT_EQ( matrix->numNonzeros, 4UL );
+  ASSERT_EQ( matrix->entryValues[0], 1.5 );
+  ASSERT_EQ( matrix->entryValues[1], -0.2 );
+  ASSERT_EQ( matrix->entryValues[2], 16.0 );
+  ASSERT_EQ( matrix->entryValues[3], 1.0 );
+  ASSERT_CMR_CALL( CMRdblmatFree(cmr, &matrix) );
+
+  const char* badValue = "2 2 2\n"
+    "1 1 1\n"
+    "2 2 1.5\n";
+  stream = fmemopen((char*) badValue, strlen(badValue), "r");
+  CMR_INTMAT* intMatrix = NULL;
+  ASSERT_EQ( CMRintmatCreateFromSparseStream(cmr, stream, &intMatrix), CMR_ERROR_INPUT );
+  ASSERT_STREQ( CMRgetErrorMessage(cmr), "Could not read an integer value of nonzero #1." );
+  fclose(stream);
+
+  const char* badIndex = "2 2 1\n"
+    "1 3 1\n";
+  stream = fmemopen((char*) badIndex, strlen(badIndex), "r");
+  CMR_CHRMAT* chrMatrix = NULL;
+  ASSERT_EQ( CMRchrmatCreateFromSparseStream(cmr, stream, &chrMatrix), CMR_ERROR_INPUT );
+  ASSERT_STREQ( CMRgetErrorMessage(cmr), "Could not read nonzero #0." );
+  fclose(stream);
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Matrix, Triples)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  {
+    size_t rows[] = { 2, 0, 2, 1, 0, 2 };
+    size_t columns[] = { 3, 2, 0, 1, 0, 2 };
+    char values[] = { 1, -1, 1, 0, 1, -1 };
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( CMRchrmatCreateFromTriples(cmr, 3, 4, 6, rows, columns, values, &matrix) );
+
+    CMR_CHRMAT* check = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &check, "3 4 "
+      "1 0 -1 0 "
+      "0 0 0 0 "
+      "1 0 -1 1 "
+    ) );
+    ASSERT_TRUE( CMRchrmatCheckEqual(matrix, check) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &check) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  {
+    size_t rows[] = { 1, 0, 1 };
+    size_t columns[] = { 0, 1, 0 };
+    double values[] = { 1.5, 2.0, -1.0 };
+    CMR_DBLMAT* matrix = NULL;
+    ASSERT_EQ( CMRdblmatCreateFromTriples(cmr, 2, 2, 3, rows, columns, values, &matrix), CMR_ERROR_INPUT );
+    ASSERT_STREQ( CMRgetErrorMessage(cmr), "Duplicate nonzero at row 1 and column 0." );
+    ASSERT_EQ( matrix, (CMR_DBLMAT*) NULL );
+
+    rows[2] = 2;
+    CMR_INTMAT* intMatrix = NULL;
+    int intValues[] = { 1, 2, 3 };
+    ASSERT_EQ( CMRintmatCreateFromTriples(cmr, 2, 2, 3, rows, columns, intValues, &intMatrix), CMR_ERROR_INPUT );
+    ASSERT_STREQ( CMRgetErrorMessage(cmr), "Invalid row 2 or column 0 of triple #2." );
+    ASSERT_EQ( intMatrix, (CMR_INTMAT*) NULL );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Matrix, Binary)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "3 4 "
+    "1 0 0 -1 "
+    "0 0 0 0 "
+    "-1 1 0 1 "
+  ) );
+
+  CMR_DBLMAT* dblMatrix = NULL;
+  ASSERT_CMR_CALL( stringToDoubleMatrix(cmr, &dblMatrix, "3 4 "
+    "1 0 0 -1 "
+    "0 0 0 0 "
+    "-1 1 0 1 "
+  ) );
+
+  /* A regular file is memory-mapped if the value types agree and converted otherwise. */
+  FILE* stream = tmpfile();
+  ASSERT_TRUE( stream );
+  ASSERT_CMR_CALL( CMRchrmatPrintBinary(cmr, matrix, stream) );
+  ASSERT_CMR_CALL( CMRchrmatPrintBinary(cmr, matrix, stream) );
+  rewind(stream);
+
+  CMR_CHRMAT* mapped = NULL;
+  ASSERT_CMR_CALL( CMRchrmatCreateFromBinaryStream(cmr, stream, &mapped) );
+  ASSERT_TRUE( CMRchrmatCheckEqual(matrix, mapped) );
+
+  CMR_DBLMAT* converted = NULL;
+  ASSERT_CMR_CALL( CMRdblmatCreateFromBinaryStream(cmr, stream, &converted) );
+  ASSERT_TRUE( CMRdblmatCheckEqual(dblMatrix, converted) );
+  fclose(stream);
+
+  /* The mapping remains valid after closing the file. */
+  CMR_CHRMAT* transpose = NULL;
+  ASSERT_CMR_CALL( CMRchrmatTranspose(cmr, mapped, &transpose) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &transpose) );
+
+  /* Resizing copies the arrays of a memory-mapped matrix. */
+  ASSERT_CMR_CALL( CMRchrmatChangeNumNonzeros(cmr, mapped, mapped->numNonzeros + 1) );
+  ASSERT_CMR_CALL( CMRchrmatChangeNumNonzeros(cmr, mapped, mapped->numNonzeros - 1) );
+  ASSERT_TRUE( CMRchrmatCheckEqual(matrix, mapped) );
+
+  /* Non-integral values cannot be converted. */
+  dblMatrix->entryValues[0] = 0.5;
+  char buffer[1024];
+  stream = fmemopen(buffer, sizeof(buffer), "w+");
+  ASSERT_CMR_CALL( CMRdblmatPrintBinary(cmr, dblMatrix, stream) );
+  rewind(stream);
+  CMR_INTMAT* intMatrix = NULL;
+  ASSERT_EQ( CMRintmatCreateFromBinaryStream(cmr, stream, &intMatrix), CMR_ERROR_INPUT );
+  ASSERT_FALSE( intMatrix );
+  rewind(stream);
+  CMR_DBLMAT* copy = NULL;
+  ASSERT_CMR_CALL( CMRdblmatCreateFromBinaryStream(cmr, stream, &copy) );
+  ASSERT_TRUE( CMRdblmatCheckEqual(dblMatrix, copy) );
+  fclose(stream);
+
+  ASSERT_CMR_CALL( CMRdblmatFree(cmr, &copy) );
+  ASSERT_CMR_CALL( CMRdblmatFree(cmr, &converted) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &mapped) );
+  ASSERT_CMR_CALL( CMRdblmatFree(cmr, &dblMatrix) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+/**
+ * \brief Overwrites 8 bytes at \p offset of the binary file of \p matrix and checks that reading it fails.
+ */
+
+static
+void testCorruptBinary(CMR* cmr, CMR_CHRMAT* matrix, size_t offset, uint64_t value)
+{
+  char buffer[1024];
+  FILE* stream = fmemopen(buffer, sizeof(buffer), "w+");
+  ASSERT_CMR_CALL( CMRchrmatPrintBinary(cmr, matrix, stream) );
+  size_t length = ftell(stream);
+  fclose(stream);
+  memcpy(buffer + offset, &value, sizeof(value));
+
+  /* The file is read from a memory stream and memory-mapped from a regular file. */
+  stream = fmemopen(buffer, length, "r");
+  CMR_CHRMAT* result = NULL;
+  ASSERT_EQ( CMRchrmatCreateFromBinaryStream(cmr, stream, &result), CMR_ERROR_INPUT );
+  ASSERT_FALSE( result );
+  fclose(stream);
+
+  stream = tmpfile();
+  ASSERT_TRUE( stream );
+  ASSERT_EQ( fwrite(buffer, 1, length, stream), length );
+  rewind(stream);
+  ASSERT_EQ( CMRchrmatCreateFromBinaryStream(cmr, stream, &result), CMR_ERROR_INPUT );
+  ASSERT_FALSE( result );
+  fclose(stream);
+}
+
+TEST(Matrix, BinaryInvalid)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "3 4 "
+    "1 0 0 -1 "
+    "0 0 0 0 "
+    "-1 1 0 1 "
+  ) );
+
+  /* The 64-byte header is followed by the row slices 0, 2, 2, 5, the entry columns 0, 3, 0, 1, 3 and the values. */
+  const size_t rowSlice = 64;
+  const size_t entryColumns = rowSlice + 4 * sizeof(size_t);
+  const size_t entryValues = entryColumns + 5 * sizeof(size_t);
+  testCorruptBinary(cmr, matrix, 24, SIZE_MAX / sizeof(size_t));
+  testCorruptBinary(cmr, matrix, 40, UINT64_MAX);
+  testCorruptBinary(cmr, matrix, rowSlice + 1 * sizeof(size_t), 3);
+  testCorruptBinary(cmr, matrix, entryColumns + 1 * sizeof(size_t), 4);
+  testCorruptBinary(cmr, matrix, entryColumns + 3 * sizeof(size_t), 0);
+  testCorruptBinary(cmr, matrix, entryValues, 0);
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Matrix, SortNonzeros)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* Rows of length 500 are radix-sorted, the others are insertion-sorted; the matrix is large enough to be sorted
+   * in parallel with 4 threads. */
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+  {
+    ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+
+    size_t numRows = 2000;
+    size_t numColumns = 300000;
+    size_t numNonzeros = 0;
+    for (size_t row = 0; row < numRows; ++row)
+      numNonzeros += (row % 10 == 0) ? 500 : row % 7;
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( CMRchrmatCreate(cmr, &matrix, numRows, numColumns, numNonzeros) );
+    size_t entry = 0;
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      matrix->rowSlice[row] = entry;
+      size_t length = (row % 10 == 0) ? 500 : row % 7;
+      for (size_t i = 0; i < length; ++i)
+      {
+        size_t column = (i * 7919 + row * 31) % numColumns;
+        matrix->entryColumns[entry] = column;
+        matrix->entryValues[entry] = (column % 2) ? 1 : -1;
+        ++entry;
+      }
+    }
+    matrix->rowSlice[numRows] = entry;
+
+    ASSERT_CMR_CALL( CMRchrmatSortNonzeros(cmr, matrix) );
+
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+      {
+        if (e > matrix->rowSlice[row])
+        {
+          ASSERT_LT( matrix->entryColumns[e - 1], matrix->entryColumns[e] );
+        }
+        ASSERT_EQ( matrix->entryValues[e], (matrix->entryColumns[e] % 2) ? 1 : -1 );
+      }
+    }
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
 TEST(Matrix, Transpose)
 {
   CMR* cmr = NULL;
@@ -235,3 +496,46 @@ TEST(Matrix, Submatrix)
 
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+TEST(Matrix, LargeDimensions)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* Only rows and nonzeros are allocated, so column indices beyond the range of int are cheap. */
+  const size_t numColumns = (size_t) INT_MAX + 16;
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( CMRchrmatCreate(cmr, &matrix, 2, numColumns, 3) );
+  matrix->rowSlice[0] = 0;
+  matrix->rowSlice[1] = 2;
+  matrix->rowSlice[2] = 3;
+  matrix->entryColumns[0] = 7;
+  matrix->entryValues[0] = 1;
+  matrix->entryColumns[1] = (size_t) INT_MAX + 3;
+  matrix->entryValues[1] = -1;
+  matrix->entryColumns[2] = numColumns - 1;
+  matrix->entryValues[2] = 1;
+
+  ASSERT_EQ(matrix->numRows, 2UL);
+  ASSERT_EQ(matrix->numColumns, numColumns);
+  ASSERT_EQ(matrix->numNonzeros, 3UL);
+
+  CMR_CHRMAT* copy = NULL;
+  ASSERT_CMR_CALL( CMRchrmatCopy(cmr, matrix, &copy) );
+  ASSERT_EQ(copy->numColumns, numColumns);
+  ASSERT_TRUE(CMRchrmatCheckEqual(matrix, copy));
+
+  size_t entry;
+  ASSERT_CMR_CALL( CMRchrmatFindEntry(copy, 0, (size_t) INT_MAX + 3, &entry) );
+  ASSERT_EQ(entry, 1UL);
+  ASSERT_EQ(copy->entryValues[entry], -1);
+  ASSERT_CMR_CALL( CMRchrmatFindEntry(copy, 1, numColumns - 1, &entry) );
+  ASSERT_EQ(entry, 2UL);
+  ASSERT_CMR_CALL( CMRchrmatFindEntry(copy, 1, (size_t) INT_MAX + 3, &entry) );
+  ASSERT_EQ(entry, SIZE_MAX);
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &copy) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -44,12 +44,12 @@ void testNetworkMatrix(
 
     printf("Basis:");
     for (int r = 0; r < matrix->numRows; ++r)
-      printf(" %d", basis[r]);
+      printf(" %ld", (long) basis[r]);
     printf("\n");
 
     printf("Cobasis:");
     for (int c = 0; c < matrix->numColumns; ++c)
-      printf(" %d", cobasis[c]);
+      printf(" %ld", (long) cobasis[c]);
     printf("\n");
   }
 
@@ -3,6 +3,10 @@
 #include "common.h"
 #include "../src/cmr/one_sum.h"
 
+#include <cmr/graph.h>
+
+#include <string.h>
+
 TEST(OneSum, DoubleToDouble)
 {
   CMR* cmr = NULL;
@@ -31,8 +35,8 @@ TEST(OneSum, DoubleToDouble)
 
   CMR_DBLMAT* check = NULL;
   CMR_DBLMAT* checkTranspose = NULL;
-  ASSERT_CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(double), sizeof(double), &numComponents, &components,
-    rowsToComponents, columnsToComponents, rowsToComponentRows, columnsToComponentColumns) );
+  ASSERT_CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(double), sizeof(double), true, &numComponents,
+    &components, rowsToComponents, columnsToComponents, rowsToComponentRows, columnsToComponentColumns) );
 
   ASSERT_EQ(numComponents, 6);
   stringToDoubleMatrix(cmr, &check, "3 3 "
@@ -208,8 +212,8 @@ TEST(OneSum, IntToInt)
 
   CMR_INTMAT* check = NULL;
   CMR_INTMAT* checkTranspose = NULL;
-  ASSERT_CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(int), sizeof(int), &numComponents, &components,
-    rowsToComponents, columnsToComponents, rowsToComponentRows, columnsToComponentColumns) );
+  ASSERT_CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(int), sizeof(int), true, &numComponents,
+    &components, rowsToComponents, columnsToComponents, rowsToComponentRows, columnsToComponentColumns) );
 
   ASSERT_EQ(numComponents, 6);
   stringToIntMatrix(cmr, &check, "3 3 "
@@ -385,8 +389,8 @@ TEST(OneSum, CharToChar)
 
   CMR_CHRMAT* check = NULL;
   CMR_CHRMAT* checkTranspose = NULL;
-  ASSERT_CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(char), sizeof(char), &numComponents, &components,
-    rowsToComponents, columnsToComponents, rowsToComponentRows, columnsToComponentColumns) );
+  ASSERT_CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(char), sizeof(char), true, &numComponents,
+    &components, rowsToComponents, columnsToComponents, rowsToComponentRows, columnsToComponentColumns) );
 
   ASSERT_EQ(numComponents, 6);
   stringToCharMatrix(cmr, &check, "3 3 "
@@ -533,3 +537,139 @@ TEST(OneSum, CharToChar)
   CMRchrmatFree(cmr, &matrix);
   CMRfreeEnvironment(&cmr);
 }
+
+TEST(OneSum, DoubleToChar)
+{
+  CMR* cmr = NULL;
+  CMRcreateEnvironment(&cmr);
+
+  CMR_DBLMAT* matrix = NULL;
+  stringToDoubleMatrix(cmr, &matrix, "3 4 "
+    "-1 0 0 0 "
+    " 1 1 0 0 "
+    " 0 0 -1 1 "
+  );
+
+  size_t numComponents;
+  CMR_ONESUM_COMPONENT* components = NULL;
+  ASSERT_CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(double), sizeof(char), true, &numComponents,
+    &components, NULL, NULL, NULL, NULL) );
+
+  ASSERT_EQ(numComponents, 2);
+  CMR_CHRMAT* check = NULL;
+  stringToCharMatrix(cmr, &check, "2 2 "
+    "-1 0 "
+    " 1 1 "
+  );
+  ASSERT_TRUE(CMRchrmatCheckEqual(check, (CMR_CHRMAT*) components[0].matrix));
+  CMRchrmatFree(cmr, &check);
+  stringToCharMatrix(cmr, &check, "1 2 "
+    "-1 1 "
+  );
+  ASSERT_TRUE(CMRchrmatCheckEqual(check, (CMR_CHRMAT*) components[1].matrix));
+  CMRchrmatFree(cmr, &check);
+
+  for (int c = 0; c < numComponents; ++c)
+  {
+    CMRchrmatFree(cmr, (CMR_CHRMAT**) &components[c].matrix);
+    CMRchrmatFree(cmr, (CMR_CHRMAT**) &components[c].transpose);
+    CMRfreeBlockArray(cmr, &components[c].rowsToOriginal);
+    CMRfreeBlockArray(cmr, &components[c].columnsToOriginal);
+  }
+  CMRfreeBlockArray(cmr, &components);
+
+  CMRdblmatFree(cmr, &matrix);
+  CMRfreeEnvironment(&cmr);
+}
+
+TEST(OneSum, UnionFindIncremental)
+{
+  CMR* cmr = NULL;
+  CMRcreateEnvironment(&cmr);
+
+  CMR_CHRMAT* matrix = NULL;
+  stringToCharMatrix(cmr, &matrix, "10 10 "
+    "0 1 0 2 0 0 0 0 0 0 "
+    "0 0 0 0 0 0 0 1 0 0 "
+    "0 0 2 0 0 0 0 3 0 0 "
+    "0 0 0 0 0 0 0 0 0 0 "
+    "1 0 0 0 0 0 0 0 0 0 "
+    "0 3 0 4 0 0 0 0 0 0 "
+    "0 0 0 5 0 0 0 0 6 0 "
+    "0 0 0 0 1 0 0 0 0 0 "
+    "0 0 0 0 2 3 4 0 0 0 "
+    "0 0 0 0 0 0 5 0 0 0 "
+  );
+
+  /* Decompose without ordering each component by a search. */
+  size_t numComponents;
+  CMR_ONESUM_COMPONENT* components = NULL;
+  size_t rowsToComponents[10];
+  size_t columnsToComponents[10];
+  ASSERT_CMR_CALL( decomposeOneSum(cmr, (CMR_MATRIX*) matrix, sizeof(char), sizeof(char), false, &numComponents,
+    &components, rowsToComponents, columnsToComponents, NULL, NULL) );
+  ASSERT_EQ(numComponents, 6);
+  ASSERT_EQ(components[1].columnsToOriginal[0], 2);
+  ASSERT_EQ(components[1].columnsToOriginal[1], 7);
+  CMR_CHRMAT* check = NULL;
+  stringToCharMatrix(cmr, &check, "2 2 "
+    "0 1 "
+    "2 3 "
+  );
+  ASSERT_TRUE(CMRchrmatCheckEqual(check, (CMR_CHRMAT*) components[1].matrix));
+  CMRchrmatFree(cmr, &check);
+
+  /* Add the nonzeros in reverse order, as they could arrive while reading a file. */
+  CMR_ONESUM_UNIONFIND unionFind;
+  ASSERT_CMR_CALL( oneSumUnionFindInit(cmr, &unionFind, matrix->numRows, matrix->numColumns) );
+  for (size_t row = matrix->numRows; row > 0; --row)
+  {
+    for (size_t e = matrix->rowSlice[row]; e > matrix->rowSlice[row - 1]; --e)
+      oneSumUnionFindAddNonzero(&unionFind, row - 1, matrix->entryColumns[e - 1]);
+  }
+  size_t nodeLabels[20];
+  ASSERT_EQ(oneSumUnionFindLabel(&unionFind, nodeLabels), numComponents);
+  for (size_t row = 0; row < 10; ++row)
+    ASSERT_EQ(nodeLabels[row], rowsToComponents[row]);
+  for (size_t column = 0; column < 10; ++column)
+    ASSERT_EQ(nodeLabels[10 + column], columnsToComponents[column]);
+  ASSERT_CMR_CALL( oneSumUnionFindClear(cmr, &unionFind) );
+
+  for (int c = 0; c < numComponents; ++c)
+  {
+    CMRchrmatFree(cmr, (CMR_CHRMAT**) &components[c].matrix);
+    CMRchrmatFree(cmr, (CMR_CHRMAT**) &components[c].transpose);
+    CMRfreeBlockArray(cmr, &components[c].rowsToOriginal);
+    CMRfreeBlockArray(cmr, &components[c].columnsToOriginal);
+  }
+  CMRfreeBlockArray(cmr, &components);
+
+  CMRchrmatFree(cmr, &matrix);
+  CMRfreeEnvironment(&cmr);
+}
+
+TEST(OneSum, Overflow)
+{
+  CMR* cmr = NULL;
+  CMRcreateEnvironment(&cmr);
+
+  /* The sizes are checked before anything is accessed, so the matrix need not have any entries. */
+  CMR_CHRMAT matrix;
+  memset(&matrix, 0, sizeof(matrix));
+  size_t numComponents;
+  CMR_ONESUM_COMPONENT* components = NULL;
+
+  matrix.numRows = (size_t) CMR_GRAPH_INDEX_MAX;
+  matrix.numColumns = 1;
+  ASSERT_EQ( decomposeOneSum(cmr, (CMR_MATRIX*) &matrix, sizeof(char), sizeof(char), true, &numComponents,
+    &components, NULL, NULL, NULL, NULL), CMR_ERROR_OVERFLOW );
+
+  matrix.numRows = 1;
+  matrix.numColumns = 1;
+  matrix.numNonzeros = (size_t) CMR_GRAPH_INDEX_MAX + 1;
+  ASSERT_EQ( decomposeOneSum(cmr, (CMR_MATRIX*) &matrix, sizeof(char), sizeof(char), true, &numComponents,
+    &components, NULL, NULL, NULL, NULL), CMR_ERROR_OVERFLOW );
+  ASSERT_EQ( components, (CMR_ONESUM_COMPONENT*) NULL );
+
+  CMRfreeEnvironment(&cmr);
+}
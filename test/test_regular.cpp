@@ -6,6 +6,9 @@
 #include <cmr/separation.h>
 #include <cmr/graphic.h>
 
+#include <thread>
+#include <vector>
+
 TEST(Regular, OneSum)
 {
   CMR* cmr = NULL;
@@ -788,3 +791,246 @@ TEST(Regular, R12)
 
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+/**
+ * \brief Appends a description of the decomposition tree \p dec to \p signature.
+ */
+
+static
+void decompositionSignature(
+  CMR_DEC* dec,           /**< Decomposition node. */
+  std::string& signature  /**< String to append to. */
+)
+{
+  signature += "(" + std::to_string(CMRdecIsSum(dec, NULL, NULL));
+  signature += CMRdecIsRegular(dec) ? "r" : "-";
+  signature += CMRdecIsGraphic(dec) ? "g" : "-";
+  signature += CMRdecIsCographic(dec) ? "c" : "-";
+  signature += CMRdecIsGraphicLeaf(dec) ? "G" : "-";
+  signature += CMRdecIsCographicLeaf(dec) ? "C" : "-";
+  for (size_t c = 0; c < CMRdecNumChildren(dec); ++c)
+    decompositionSignature(CMRdecChild(dec, c), signature);
+  signature += ")";
+}
+
+TEST(Regular, OneSumThreads)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_CHRMAT* K_3_3 = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &K_3_3, "5 4 "
+    " 1 1 0 0 "
+    " 1 1 1 0 "
+    " 1 0 0 1 "
+    " 0 1 1 1 "
+    " 0 0 1 1 "
+  ) );
+  CMR_CHRMAT* K_3_3_dual = NULL;
+  ASSERT_CMR_CALL( CMRchrmatTranspose(cmr, K_3_3, &K_3_3_dual) );
+  CMR_CHRMAT* irregular = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &irregular, "4 4 "
+    "1 0 1 1 "
+    "1 1 1 0 "
+    "0 0 1 1 "
+    "0 1 1 1 "
+  ) );
+  CMR_CHRMAT* R10 = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &R10, "5 5 "
+    "1 0 0 1 1 "
+    "1 1 0 0 1 "
+    "0 1 1 0 1 "
+    "0 0 1 1 1 "
+    "1 1 1 1 1 "
+  ) );
+
+  /* Build a 1-sum with many components, two of which are irregular. */
+  CMR_CHRMAT* blocks[] = { K_3_3, R10, irregular, K_3_3_dual, R10, K_3_3, irregular, K_3_3_dual, R10, K_3_3 };
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( CMRchrmatCopy(cmr, blocks[0], &matrix) );
+  for (size_t b = 1; b < sizeof(blocks) / sizeof(blocks[0]); ++b)
+  {
+    CMR_CHRMAT* sum = NULL;
+    ASSERT_CMR_CALL( CMRoneSum(cmr, matrix, blocks[b], &sum) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+    matrix = sum;
+  }
+
+  for (int completeTree = 0; completeTree < 2; ++completeTree)
+  {
+    std::string sequentialSignature;
+    size_t sequentialGraphicCount = 0;
+    for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+      ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+      ASSERT_EQ( CMRgetNumThreads(cmr), numThreads );
+
+      CMR_REGULAR_PARAMETERS params;
+      ASSERT_CMR_CALL( CMRparamsRegularInit(&params) );
+      params.completeTree = completeTree;
+      CMR_REGULAR_STATISTICS stats;
+      ASSERT_CMR_CALL( CMRstatsRegularInit(&stats) );
+
+      bool isRegular;
+      CMR_DEC* dec = NULL;
+      ASSERT_CMR_CALL( CMRtestBinaryRegular(cmr, matrix, &isRegular, &dec, NULL, &params, &stats, DBL_MAX) );
+      ASSERT_FALSE( isRegular );
+      ASSERT_EQ( CMRdecNumChildren(dec), 10 );
+
+      std::string signature;
+      decompositionSignature(dec, signature);
+      if (numThreads == 1)
+      {
+        sequentialSignature = signature;
+        sequentialGraphicCount = stats.graphic.totalCount;
+      }
+      else
+      {
+        ASSERT_EQ( signature, sequentialSignature );
+        ASSERT_EQ( stats.graphic.totalCount, sequentialGraphicCount );
+      }
+
+      ASSERT_CMR_CALL( CMRdecFree(cmr, &dec) );
+    }
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &R10) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &irregular) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &K_3_3_dual) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &K_3_3) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Regular, TwoSumThreads)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_CHRMAT* K_3_3 = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &K_3_3, "5 4 "
+    " 1 1 0 0 "
+    " 1 1 1 0 "
+    " 1 0 0 1 "
+    " 0 1 1 1 "
+    " 0 0 1 1 "
+  ) );
+  CMR_CHRMAT* K_3_3_dual = NULL;
+  ASSERT_CMR_CALL( CMRchrmatTranspose(cmr, K_3_3, &K_3_3_dual) );
+  CMR_CHRMAT* irregular = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &irregular, "4 4 "
+    "1 0 1 1 "
+    "1 1 1 0 "
+    "0 0 1 1 "
+    "0 1 1 1 "
+  ) );
+  CMR_CHRMAT* R10 = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &R10, "5 5 "
+    "1 0 0 1 1 "
+    "1 1 0 0 1 "
+    "0 1 1 0 1 "
+    "0 0 1 1 1 "
+    "1 1 1 1 1 "
+  ) );
+
+  /* Build a chain of 2-sums, one of whose parts is irregular. */
+  CMR_CHRMAT* blocks[] = { K_3_3, R10, K_3_3_dual, irregular, R10, K_3_3 };
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( CMRchrmatCopy(cmr, blocks[0], &matrix) );
+  for (size_t b = 1; b < sizeof(blocks) / sizeof(blocks[0]); ++b)
+  {
+    CMR_CHRMAT* sum = NULL;
+    ASSERT_CMR_CALL( CMRtwoSum(cmr, matrix, blocks[b], CMRrowToElement(0), CMRcolumnToElement(0), &sum) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+    matrix = sum;
+  }
+
+  for (int completeTree = 0; completeTree < 2; ++completeTree)
+  {
+    std::string sequentialSignature;
+    for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+    {
+      ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+
+      CMR_REGULAR_PARAMETERS params;
+      ASSERT_CMR_CALL( CMRparamsRegularInit(&params) );
+      params.completeTree = completeTree;
+
+      bool isRegular;
+      CMR_DEC* dec = NULL;
+      ASSERT_CMR_CALL( CMRtestBinaryRegular(cmr, matrix, &isRegular, &dec, NULL, &params, NULL, DBL_MAX) );
+      ASSERT_FALSE( isRegular );
+      ASSERT_EQ( CMRdecIsSum(dec, NULL, NULL), 2 );
+
+      std::string signature;
+      decompositionSignature(dec, signature);
+      if (numThreads == 1)
+        sequentialSignature = signature;
+      else
+        ASSERT_EQ( signature, sequentialSignature );
+
+      ASSERT_CMR_CALL( CMRdecFree(cmr, &dec) );
+    }
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &R10) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &irregular) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &K_3_3_dual) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &K_3_3) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Regular, ForkedEnvironments)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_CHRMAT* R10 = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &R10, "5 5 "
+    "1 0 0 1 1 "
+    "1 1 0 0 1 "
+    "0 1 1 0 1 "
+    "0 0 1 1 1 "
+    "1 1 1 1 1 "
+  ) );
+  CMR_CHRMAT* irregular = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &irregular, "4 4 "
+    "1 0 1 1 "
+    "1 1 1 0 "
+    "0 0 1 1 "
+    "0 1 1 1 "
+  ) );
+
+  /* Several threads serve requests concurrently, each with a freshly forked environment. */
+  std::vector<int> numCorrect(4, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numCorrect.size(); ++t)
+  {
+    threads.emplace_back([cmr, R10, irregular, t, &numCorrect]()
+    {
+      for (int request = 0; request < 20; ++request)
+      {
+        CMR* child = NULL;
+        if (CMRforkEnvironment(cmr, &child) != CMR_OKAY)
+          return;
+        bool expected = (request + t) % 2;
+        bool isRegular;
+        if (CMRtestBinaryRegular(child, expected ? R10 : irregular, &isRegular, NULL, NULL, NULL, NULL, DBL_MAX)
+          == CMR_OKAY && isRegular == expected)
+        {
+          ++numCorrect[t];
+        }
+        CMRfreeEnvironment(&child);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+  for (size_t t = 0; t < numCorrect.size(); ++t)
+    ASSERT_EQ( numCorrect[t], 20 );
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &irregular) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &R10) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -6,6 +6,8 @@
 #include <cmr/separation.h>
 #include <cmr/graphic.h>
 
+#include "../src/cmr/threadpool.h"
+
 TEST(TotallyUnimodular, OneSum)
 {
   CMR* cmr = NULL;
@@ -42,10 +44,10 @@ TEST(TotallyUnimodular, OneSum)
     ASSERT_FALSE( CMRdecHasTranspose(dec) ); /* Default settings should mean that the transpose is never computed. */
     ASSERT_EQ( CMRdecIsSum(dec, NULL, NULL), 1 );
     ASSERT_EQ( CMRdecNumChildren(dec), 2 );
-    ASSERT_FALSE( CMRdecIsGraphic(CMRdecChild(dec, 0)) );
-    ASSERT_TRUE( CMRdecIsCographic(CMRdecChild(dec, 0)) );
-    ASSERT_TRUE( CMRdecIsGraphic(CMRdecChild(dec, 1)) );
-    ASSERT_FALSE( CMRdecIsCographic(CMRdecChild(dec, 1)) );
+    ASSERT_TRUE( CMRdecIsGraphic(CMRdecChild(dec, 0)) );
+    ASSERT_FALSE( CMRdecIsCographic(CMRdecChild(dec, 0)) );
+    ASSERT_FALSE( CMRdecIsGraphic(CMRdecChild(dec, 1)) );
+    ASSERT_TRUE( CMRdecIsCographic(CMRdecChild(dec, 1)) );
     
     ASSERT_CMR_CALL( CMRdecFree(cmr, &dec) );
 
@@ -830,3 +832,474 @@ TEST(TotallyUnimodular, ForbiddenSubmatrix)
 
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+TEST(TotallyUnimodular, ForbiddenSubmatrixThreads)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "14 14 "
+    "1 1 1 0 1 0 1 0  1 1 1 1 1 1 "
+    "1 0 1 0 1 0 1 0  1 1 1 1 1 0 "
+    "0 1 1 0 0 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 1  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 1  1 0 0 0 0 0 "
+    "0 0 0 0 0 0 0 0  1 1 0 0 0 0 "
+    "0 0 0 0 0 0 0 0  0 1 1 0 0 0 "
+    "0 0 0 0 0 0 0 0  0 0 1 1 0 0 "
+    "0 0 0 0 0 0 0 0  0 0 0 1 1 0 "
+    "0 0 0 0 0 0 0 0  0 0 0 0 1 1 "
+  ) );
+
+  /* The speculative parallel search for blocks to remove must find the same submatrix as the sequential one. */
+  CMR_SUBMAT* sequentialSubmatrix = NULL;
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+  {
+    ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+
+    CMR_TU_STATISTICS stats;
+    ASSERT_CMR_CALL( CMRstatsTotalUnimodularityInit(&stats) );
+    bool isTU;
+    CMR_SUBMAT* forbiddenSubmatrix = NULL;
+    ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, matrix, &isTU, NULL, &forbiddenSubmatrix, NULL, &stats,
+      DBL_MAX) );
+    ASSERT_FALSE( isTU );
+    ASSERT_EQ( forbiddenSubmatrix->numRows, 8 );
+    ASSERT_EQ( forbiddenSubmatrix->numColumns, 8 );
+
+    if (!sequentialSubmatrix)
+      sequentialSubmatrix = forbiddenSubmatrix;
+    else
+    {
+      for (size_t row = 0; row < forbiddenSubmatrix->numRows; ++row)
+        ASSERT_EQ( forbiddenSubmatrix->rows[row], sequentialSubmatrix->rows[row] );
+      for (size_t column = 0; column < forbiddenSubmatrix->numColumns; ++column)
+        ASSERT_EQ( forbiddenSubmatrix->columns[column], sequentialSubmatrix->columns[column] );
+      ASSERT_CMR_CALL( CMRsubmatFree(cmr, &forbiddenSubmatrix) );
+    }
+  }
+
+  ASSERT_CMR_CALL( CMRsubmatFree(cmr, &sequentialSubmatrix) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TotallyUnimodular, ForbiddenSubmatrixOneSum)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "6 8 "
+    "1 1 0 0 0 0 0 0 "
+    "0 1 1 0 0 0 0 0 "
+    "0 0 0 1 1 0 1 0 "
+    "0 0 0 1 0 1 1 0 "
+    "0 0 -1 0 0 0 0 0 "
+    "0 0 0 0 1 1 1 1 "
+  ) );
+
+  /* The violator must be found within the irregular 1-connected component. */
+  bool isTU;
+  CMR_SUBMAT* forbiddenSubmatrix = NULL;
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, matrix, &isTU, NULL, &forbiddenSubmatrix, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+  ASSERT_EQ( forbiddenSubmatrix->numRows, 3 );
+  ASSERT_EQ( forbiddenSubmatrix->numColumns, 3 );
+  for (size_t row = 0; row < forbiddenSubmatrix->numRows; ++row)
+  {
+    ASSERT_TRUE( forbiddenSubmatrix->rows[row] == 2 || forbiddenSubmatrix->rows[row] == 3
+      || forbiddenSubmatrix->rows[row] == 5 );
+  }
+  for (size_t column = 0; column < forbiddenSubmatrix->numColumns; ++column)
+    ASSERT_GE( forbiddenSubmatrix->columns[column], 3 );
+
+  CMR_CHRMAT* violator = NULL;
+  ASSERT_CMR_CALL( CMRchrmatZoomSubmat(cmr, matrix, forbiddenSubmatrix, &violator) );
+  bool isViolatorTU;
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, violator, &isViolatorTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isViolatorTU );
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violator) );
+  ASSERT_CMR_CALL( CMRsubmatFree(cmr, &forbiddenSubmatrix) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TotallyUnimodular, ForbiddenSubmatrixMinimal)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "14 14 "
+    "1 1 1 0 1 0 1 0  1 1 1 1 1 1 "
+    "1 0 1 0 1 0 1 0  1 1 1 1 1 0 "
+    "0 1 1 0 0 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 1  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 1  1 0 0 0 0 0 "
+    "0 0 0 0 0 0 0 0  1 1 0 0 0 0 "
+    "0 0 0 0 0 0 0 0  0 1 1 0 0 0 "
+    "0 0 0 0 0 0 0 0  0 0 1 1 0 0 "
+    "0 0 0 0 0 0 0 0  0 0 0 1 1 0 "
+    "0 0 0 0 0 0 0 0  0 0 0 0 1 1 "
+  ) );
+
+  bool isTU;
+  CMR_SUBMAT* forbiddenSubmatrix = NULL;
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, matrix, &isTU, NULL, &forbiddenSubmatrix, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+  CMR_CHRMAT* violator = NULL;
+  ASSERT_CMR_CALL( CMRchrmatZoomSubmat(cmr, matrix, forbiddenSubmatrix, &violator) );
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, violator, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+
+  /* Removing any row or column must yield a totally unimodular matrix. */
+  for (size_t removed = 0; removed < violator->numRows + violator->numColumns; ++removed)
+  {
+    bool removeRow = removed < violator->numRows;
+    CMR_SUBMAT* submatrix = NULL;
+    ASSERT_CMR_CALL( CMRsubmatCreate(cmr, violator->numRows - (removeRow ? 1 : 0),
+      violator->numColumns - (removeRow ? 0 : 1), &submatrix) );
+    size_t numRows = 0;
+    for (size_t row = 0; row < violator->numRows; ++row)
+    {
+      if (row != removed)
+        submatrix->rows[numRows++] = row;
+    }
+    size_t numColumns = 0;
+    for (size_t column = 0; column < violator->numColumns; ++column)
+    {
+      if (violator->numRows + column != removed)
+        submatrix->columns[numColumns++] = column;
+    }
+
+    CMR_CHRMAT* reduced = NULL;
+    ASSERT_CMR_CALL( CMRchrmatZoomSubmat(cmr, violator, submatrix, &reduced) );
+    ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, reduced, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+    ASSERT_TRUE( isTU );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &reduced) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &submatrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violator) );
+  ASSERT_CMR_CALL( CMRsubmatFree(cmr, &forbiddenSubmatrix) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TotallyUnimodular, ForbiddenSubmatrixNonBalanceable)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* The matrix is Camion-signed, but its support is not balanceable, so the submatrix in rows 3, 4, 5 and columns
+   * 2, 6, 8 is not Camion-signed. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "8 11 "
+    " 0  1  0  0  1  0  0  0  1 -1  1 "
+    " 1 -1  0  0  0  0  0  0  0  0 -1 "
+    " 0  0  0  0  0  0  0  0  0  0  0 "
+    "-1  0 -1  0 -1  0  0  0 -1  1  0 "
+    " 0  1  0  1  1  0 -1  0  1 -1  1 "
+    " 0  0 -1  0  0  0  1 -1  0  1  0 "
+    " 1  0  0  0  0  0  0 -1  1  0  0 "
+    " 0 -1  0  0 -1 -1  0  0  0  0 -1 "
+  ) );
+
+  bool isTU;
+  CMR_SUBMAT* forbiddenSubmatrix = NULL;
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, matrix, &isTU, NULL, &forbiddenSubmatrix, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+  ASSERT_EQ( forbiddenSubmatrix->numRows, 3UL );
+  ASSERT_EQ( forbiddenSubmatrix->numColumns, 3UL );
+  CMR_CHRMAT* violator = NULL;
+  ASSERT_CMR_CALL( CMRchrmatZoomSubmat(cmr, matrix, forbiddenSubmatrix, &violator) );
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, violator, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violator) );
+  ASSERT_CMR_CALL( CMRsubmatFree(cmr, &forbiddenSubmatrix) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TotallyUnimodular, Interrupt)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, " 4 4 "
+    "1 1 0 0 "
+    "0 1 1 0 "
+    "0 0 1 1 "
+    "1 0 0 1 "
+  ) );
+
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+  {
+    ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+    bool isTU;
+
+    /* A forked environment shares the interrupt flag. */
+    CMR* child = NULL;
+    ASSERT_CMR_CALL( CMRforkEnvironment(cmr, &child) );
+    CMRinterrupt(child);
+    ASSERT_EQ( CMRtestTotalUnimodularity(cmr, matrix, &isTU, NULL, NULL, NULL, NULL, DBL_MAX), CMR_ERROR_TIMEOUT );
+    ASSERT_CMR_CALL( CMRfreeEnvironment(&child) );
+
+    CMRclearInterrupt(cmr);
+    ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, matrix, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+    ASSERT_TRUE( isTU );
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TotallyUnimodular, Batch)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  const char* strings[] = {
+    " 4 4 "
+    "1 1 0 0 "
+    "0 1 1 0 "
+    "0 0 1 1 "
+    "1 0 0 1 ",
+    " 3 3 "
+    "1 1 0 "
+    "0 1 1 "
+    "1 0 1 ",
+    " 2 2 "
+    "1 2 "
+    "0 1 ",
+    NULL, /* 2x3 zero matrix, created below. */
+    " 5 5 "
+    "1 -1  0  0 -1 "
+    "-1 1 -1  0  0 "
+    "0 -1  1 -1  0 "
+    "0  0 -1  1 -1 "
+    "-1 0  0 -1  1 ",
+    " 3 4 "
+    "1 1 1 0 "
+    "0 1 1 1 "
+    "1 1 0 1 ",
+  };
+  const size_t numMatrices = sizeof(strings) / sizeof(strings[0]);
+  CMR_CHRMAT* matrices[numMatrices];
+  bool expected[numMatrices];
+  for (size_t i = 0; i < numMatrices; ++i)
+  {
+    matrices[i] = NULL;
+    if (strings[i])
+      ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrices[i], strings[i]) );
+    else
+    {
+      ASSERT_CMR_CALL( CMRchrmatCreate(cmr, &matrices[i], 2, 3, 0) );
+      for (size_t row = 0; row <= 2; ++row)
+        matrices[i]->rowSlice[row] = 0;
+    }
+    ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, matrices[i], &expected[i], NULL, NULL, NULL, NULL, DBL_MAX) );
+  }
+  ASSERT_TRUE( expected[0] );
+  ASSERT_FALSE( expected[1] );
+  ASSERT_FALSE( expected[2] );
+  ASSERT_TRUE( expected[3] );
+
+  for (int numThreads = 1; numThreads <= 4; numThreads += 3)
+  {
+    ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
+    CMR_TU_RESULT results[numMatrices];
+    CMR_TU_STATISTICS stats;
+    ASSERT_CMR_CALL( CMRstatsTotalUnimodularityInit(&stats) );
+    ASSERT_CMR_CALL( CMRtestTotalUnimodularityBatch(cmr, numMatrices, matrices, results, NULL, &stats, DBL_MAX) );
+    for (size_t i = 0; i < numMatrices; ++i)
+    {
+      ASSERT_EQ( results[i].isTotallyUnimodular, expected[i] );
+      ASSERT_GE( results[i].time, 0.0 );
+    }
+    ASSERT_EQ( stats.totalCount, numMatrices );
+
+    CMRinterrupt(cmr);
+    ASSERT_EQ( CMRtestTotalUnimodularityBatch(cmr, numMatrices, matrices, results, NULL, NULL, DBL_MAX),
+      CMR_ERROR_TIMEOUT );
+    CMRclearInterrupt(cmr);
+  }
+
+  for (size_t i = 0; i < numMatrices; ++i)
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrices[i]) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TotallyUnimodular, ResultCache)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  ASSERT_CMR_CALL( CMRsetResultCacheCapacity(cmr, 2) );
+
+  CMR_CHRMAT* interval = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &interval, " 4 5 "
+    "1 1 0 0 0 "
+    "1 1 1 0 0 "
+    "0 1 1 1 0 "
+    "0 0 1 1 1 "
+  ) );
+  /* Rows reversed and columns ordered as 4, 2, 0, 1, 3. */
+  CMR_CHRMAT* permuted = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &permuted, " 4 5 "
+    "1 1 0 0 1 "
+    "0 1 0 1 1 "
+    "0 1 1 1 0 "
+    "0 0 1 1 0 "
+  ) );
+  CMR_CHRMAT* violator = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &violator, " 2 2 "
+    "1  1 "
+    "1 -1 "
+  ) );
+  CMR_CHRMAT* identity = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &identity, " 3 3 "
+    "1 0 0 "
+    "0 1 0 "
+    "0 0 1 "
+  ) );
+
+  CMR_TU_STATISTICS stats;
+  ASSERT_CMR_CALL( CMRstatsTotalUnimodularityInit(&stats) );
+  bool isTU;
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, interval, &isTU, NULL, NULL, NULL, &stats, DBL_MAX) );
+  ASSERT_TRUE( isTU );
+  ASSERT_EQ( stats.cacheHitCount, 0UL );
+  ASSERT_EQ( stats.cacheMissCount, 1UL );
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, interval, &isTU, NULL, NULL, NULL, &stats, DBL_MAX) );
+  ASSERT_TRUE( isTU );
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, permuted, &isTU, NULL, NULL, NULL, &stats, DBL_MAX) );
+  ASSERT_TRUE( isTU );
+  ASSERT_EQ( stats.cacheHitCount, 2UL );
+  ASSERT_EQ( stats.totalCount, 1UL );
+
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, violator, &isTU, NULL, NULL, NULL, &stats, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, violator, &isTU, NULL, NULL, NULL, &stats, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+  ASSERT_EQ( stats.cacheHitCount, 3UL );
+
+  /* Requesting a submatrix bypasses the cache. */
+  CMR_SUBMAT* submatrix = NULL;
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, violator, &isTU, NULL, &submatrix, NULL, &stats, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+  ASSERT_TRUE( submatrix );
+  ASSERT_CMR_CALL( CMRsubmatFree(cmr, &submatrix) );
+  ASSERT_EQ( stats.cacheHitCount + stats.cacheMissCount, 5UL );
+
+  /* The least recently used result, that of the interval matrix, is evicted. */
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, identity, &isTU, NULL, NULL, NULL, &stats, DBL_MAX) );
+  ASSERT_TRUE( isTU );
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, interval, &isTU, NULL, NULL, NULL, &stats, DBL_MAX) );
+  ASSERT_TRUE( isTU );
+  ASSERT_EQ( stats.cacheHitCount, 3UL );
+  ASSERT_EQ( stats.cacheMissCount, 4UL );
+
+  /* Regularity results are distinguished from total unimodularity results. */
+  CMR_REGULAR_STATISTICS regularStats;
+  ASSERT_CMR_CALL( CMRstatsRegularInit(&regularStats) );
+  bool isRegular;
+  ASSERT_CMR_CALL( CMRtestBinaryRegular(cmr, identity, &isRegular, NULL, NULL, NULL, &regularStats, DBL_MAX) );
+  ASSERT_CMR_CALL( CMRtestBinaryRegular(cmr, identity, &isRegular, NULL, NULL, NULL, &regularStats, DBL_MAX) );
+  ASSERT_TRUE( isRegular );
+  ASSERT_EQ( regularStats.cacheHitCount, 1UL );
+  ASSERT_EQ( regularStats.cacheMissCount, 1UL );
+
+  /* Forked environments share the cache. */
+  CMR* child = NULL;
+  ASSERT_CMR_CALL( CMRforkEnvironment(cmr, &child) );
+  ASSERT_EQ( CMRsetResultCacheCapacity(child, 1), CMR_ERROR_INVALID );
+  ASSERT_CMR_CALL( CMRtestBinaryRegular(child, identity, &isRegular, NULL, NULL, NULL, &regularStats, DBL_MAX) );
+  ASSERT_TRUE( isRegular );
+  ASSERT_EQ( regularStats.cacheHitCount, 2UL );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&child) );
+
+  /* Batches may use the cache from several threads. */
+  ASSERT_CMR_CALL( CMRsetNumThreads(cmr, 4) );
+  CMR_CHRMAT* batch[] = { interval, violator, permuted, identity, violator, interval, identity, permuted };
+  CMR_TU_RESULT results[8];
+  CMR_TU_STATISTICS batchStats;
+  ASSERT_CMR_CALL( CMRstatsTotalUnimodularityInit(&batchStats) );
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularityBatch(cmr, 8, batch, results, NULL, &batchStats, DBL_MAX) );
+  for (size_t i = 0; i < 8; ++i)
+    ASSERT_EQ( results[i].isTotallyUnimodular, batch[i] != violator );
+  ASSERT_EQ( batchStats.cacheHitCount + batchStats.cacheMissCount, 8UL );
+
+  ASSERT_CMR_CALL( CMRsetResultCacheCapacity(cmr, 0) );
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, interval, &isTU, NULL, NULL, NULL, &stats, DBL_MAX) );
+  ASSERT_EQ( stats.cacheHitCount + stats.cacheMissCount, 7UL );
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &identity) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violator) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &permuted) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &interval) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+typedef struct
+{
+  CMR_CHRMAT* matrix;    /**< Matrix to test. */
+  CMR_TASK_GROUP* group; /**< Group of the task. */
+} CancelledTestTask;
+
+static
+CMR_ERROR cancelledTestTask(CMR* cmr, void* data)
+{
+  CancelledTestTask* task = (CancelledTestTask*) data;
+  CMRtaskGroupCancel(task->group);
+
+  bool isTU;
+  CMR_CALL( CMRtestTotalUnimodularity(cmr, task->matrix, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+  bool isRegular;
+  CMR_CALL( CMRtestBinaryRegular(cmr, task->matrix, &isRegular, NULL, NULL, NULL, NULL, DBL_MAX) );
+
+  return CMR_OKAY;
+}
+
+TEST(TotallyUnimodular, ResultCacheCancelled)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  ASSERT_CMR_CALL( CMRsetResultCacheCapacity(cmr, 16) );
+
+  /* Camion-signed version of the Fano matrix, which is rejected only by the regularity test. */
+  CMR_CHRMAT* fano = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &fano, " 3 4 "
+    "1 1  0 1 "
+    "1 0  1 1 "
+    "0 1 -1 1 "
+  ) );
+
+  /* The tests within a cancelled task return early, and their answers must not be cached. */
+  CMR_TASK_GROUP group;
+  ASSERT_CMR_CALL( CMRtaskGroupInit(cmr, &group) );
+  CancelledTestTask task = { fano, &group };
+  ASSERT_CMR_CALL( CMRtaskSpawn(cmr, &group, cancelledTestTask, &task) );
+  ASSERT_CMR_CALL( CMRtaskWait(cmr, &group) );
+
+  bool isTU;
+  ASSERT_CMR_CALL( CMRtestTotalUnimodularity(cmr, fano, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isTU );
+  bool isRegular;
+  ASSERT_CMR_CALL( CMRtestBinaryRegular(cmr, fano, &isRegular, NULL, NULL, NULL, NULL, DBL_MAX) );
+  ASSERT_FALSE( isRegular );
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &fano) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}